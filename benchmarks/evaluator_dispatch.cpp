@@ -0,0 +1,157 @@
+// Virtual vs type-tag dispatch in the evaluators.
+//
+// Evaluates the same expressions with apply() reaching each node through
+// accept() (evaluator_dispatch::virtual_call) and through the switch on the
+// node id (evaluator_dispatch::type_tag), and prints the time per apply()
+// for both:
+//
+//   polynomial   expanded (x + y + z + 1)^6 with scalar_evaluator
+//   random       random scalar trees over + * pow sin cos exp log, depth <= 5
+//   energy       compressible Neo-Hooke energy in the invariants of C,
+//                tensor_to_scalar_evaluator on a 3x3 view
+//   stress       tensor expression with nested t2s factors,
+//                tensor_evaluator on a 3x3 view
+//
+// The two modes are interleaved round by round and the fastest round of
+// each is reported, so frequency changes hit both alike. Nothing is
+// asserted; the results of both modes are compared and a mismatch is
+// printed.
+
+#include <numsim_cas/numsim_cas.h>
+#include <numsim_cas/scalar/scalar_expand.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace numsim::cas;
+using expr_t = expression_holder<scalar_expression>;
+
+namespace {
+
+constexpr int rounds = 7;
+
+// ns per call of `reps` calls of fn().
+template <typename Fn> double time_ns(int reps, Fn &&fn) {
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reps; ++i)
+    fn();
+  auto const stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(stop - start).count() / reps;
+}
+
+// Times `eval` (which receives the evaluator) in both modes.
+template <typename Evaluator, typename Eval>
+void row(char const *name, int reps, Evaluator &ev, Eval eval) {
+  ev.set_dispatch(evaluator_dispatch::virtual_call);
+  auto const r_virtual = eval(ev);
+  ev.set_dispatch(evaluator_dispatch::type_tag);
+  auto const r_tag = eval(ev);
+
+  double t_virtual = std::numeric_limits<double>::max();
+  double t_tag = std::numeric_limits<double>::max();
+  for (int round = 0; round < rounds; ++round) {
+    ev.set_dispatch(evaluator_dispatch::virtual_call);
+    t_virtual = std::min(t_virtual, time_ns(reps, [&] { eval(ev); }));
+    ev.set_dispatch(evaluator_dispatch::type_tag);
+    t_tag = std::min(t_tag, time_ns(reps, [&] { eval(ev); }));
+  }
+  std::printf("%-12s %14.1f %14.1f %9.2fx%s\n", name, t_virtual, t_tag,
+              t_virtual / t_tag, r_virtual == r_tag ? "" : "  (results differ)");
+}
+
+expr_t random_tree(std::mt19937 &rng, std::vector<expr_t> const &leaves,
+                   int depth) {
+  std::uniform_int_distribution<int> op(0, depth > 0 ? 9 : 0);
+  std::uniform_int_distribution<std::size_t> leaf(0, leaves.size() - 1);
+  switch (op(rng)) {
+  case 1:
+  case 2:
+    return random_tree(rng, leaves, depth - 1) +
+           random_tree(rng, leaves, depth - 1);
+  case 3:
+  case 4:
+    return random_tree(rng, leaves, depth - 1) *
+           random_tree(rng, leaves, depth - 1);
+  case 5:
+    return pow(random_tree(rng, leaves, depth - 1),
+               make_scalar_constant(static_cast<int>(rng() % 3) + 2));
+  case 6:
+    return sin(random_tree(rng, leaves, depth - 1));
+  case 7:
+    return cos(random_tree(rng, leaves, depth - 1));
+  case 8:
+    return exp(sin(random_tree(rng, leaves, depth - 1)));
+  case 9:
+    return log(2 + pow(random_tree(rng, leaves, depth - 1), 2));
+  default:
+    return leaves[leaf(rng)];
+  }
+}
+
+} // namespace
+
+int main() {
+  std::printf("%-12s %14s %14s %10s\n", "expression", "virtual ns",
+              "type tag ns", "speedup");
+
+  auto [x, y, z] = make_scalar_variable("x", "y", "z");
+  {
+    auto const poly = expand(pow(x + y + z + 1, 6));
+    scalar_evaluator<double> ev;
+    ev.set(x, 0.3);
+    ev.set(y, -1.1);
+    ev.set(z, 0.7);
+    row("polynomial", 2000, ev, [&](auto &e) { return e.apply(poly); });
+  }
+  {
+    std::vector<expr_t> const leaves{x, y, z, make_scalar_constant(2),
+                                     make_scalar_constant(3)};
+    std::mt19937 rng(42);
+    std::vector<expr_t> trees;
+    for (int i = 0; i < 200; ++i)
+      trees.push_back(random_tree(rng, leaves, 5));
+    scalar_evaluator<double> ev;
+    ev.set(x, 0.3);
+    ev.set(y, 0.9);
+    ev.set(z, 0.7);
+    row("random", 50, ev, [&](auto &e) {
+      double sum = 0;
+      for (auto const &t : trees)
+        sum += e.apply(t);
+      return sum;
+    });
+  }
+
+  auto [C] = make_tensor_variable(std::tuple{"C", 3, 2});
+  auto [mu, lambda] = make_scalar_variable("mu", "lambda");
+  std::array<double, 9> const c_val{1.2, 0.1, 0.05, 0.1,  0.9,
+                                    0.02, 0.05, 0.02, 1.1};
+  {
+    auto const J = sqrt(det(C));
+    auto const psi = mu / 2 * (trace(C) - 3) - mu * log(J) +
+                     lambda / 2 * pow(log(J), 2);
+    tensor_to_scalar_evaluator<double> ev;
+    ev.set_view(C, c_val.data());
+    ev.set_scalar(mu, 80.0);
+    ev.set_scalar(lambda, 120.0);
+    row("energy", 20000, ev, [&](auto &e) { return e.apply(psi); });
+  }
+  {
+    auto const I = make_expression<identity_tensor>(3, 2);
+    auto const S = mu * (I - inv(C)) + lambda * log(sqrt(det(C))) * inv(C) +
+                   trace(C) * dev(C);
+    tensor_evaluator<double> ev;
+    ev.set_view(C, c_val.data());
+    ev.set_scalar(mu, 80.0);
+    ev.set_scalar(lambda, 120.0);
+    row("stress", 5000, ev,
+        [&](auto &e) { return e.apply(S)->raw_data()[0]; });
+  }
+  return 0;
+}
@@ -0,0 +1,318 @@
+// Collision-rate benchmark for expression hashing.
+//
+// Builds three corpora that look like what the simplifier actually sees and
+// counts, for each, how many structurally distinct expressions share a hash
+// with another one without being like terms:
+//
+//   symbols      generated variable names (x0.., sigma_i_j, two-letter names)
+//   monomials    coefficient * x^i * y^j * z^k and sums of two monomials
+//   random       random scalar trees over + * pow sin cos exp log, depth <= 4
+//
+// Each corpus is hashed twice: with the library's current hash_value() and
+// with the previous scheme (boost-style hash_combine, one combine per name
+// character, sorted child hashes for add/mul), re-implemented below so the
+// two can be compared on identical input. Output is one table row per
+// corpus; nothing is asserted.
+//
+// What remains on the random corpus under the new scheme is structural:
+// n-ary hashes ignore the coefficient, so sin(2*h) and sin(4*h) see the
+// same child hash. The mixer cannot separate those.
+
+#include <numsim_cas/numsim_cas.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace numsim::cas;
+using expr_t = expression_holder<scalar_expression>;
+
+namespace legacy {
+
+template <typename T> void combine(std::size_t &seed, T const &value) {
+  seed ^= static_cast<std::size_t>(value) +
+          static_cast<std::size_t>(0x9e3779b9) + (seed << 6) + (seed >> 2);
+}
+
+std::size_t name_hash(std::string const &name) {
+  std::size_t seed = 0;
+  for (char c : name)
+    combine(seed, c);
+  return seed;
+}
+
+std::size_t hash(expr_t const &e);
+
+template <typename Node> bool unary(expr_t const &e, std::size_t &seed) {
+  if (!is_same<Node>(e))
+    return false;
+  combine(seed, e.get().id());
+  combine(seed, hash(e.template get<Node>().expr()));
+  return true;
+}
+
+template <typename Node> std::size_t n_ary(Node const &node) {
+  std::size_t seed = 0;
+  combine(seed, node.id());
+  std::vector<std::size_t> children;
+  for (auto const &child : node.symbol_map_values())
+    children.push_back(hash(child));
+  std::ranges::sort(children);
+  for (auto h : children)
+    combine(seed, h);
+  return seed;
+}
+
+std::size_t hash(expr_t const &e) {
+  std::size_t seed = 0;
+  if (is_same<scalar>(e))
+    return name_hash(e.get<scalar>().name());
+  if (is_same<scalar_constant>(e)) {
+    combine(seed, e.get().id());
+    std::visit(
+        [&](auto const &v) {
+          using V = std::decay_t<decltype(v)>;
+          if constexpr (std::is_same_v<V, rational_t>) {
+            combine(seed, v.num);
+            combine(seed, v.den);
+          } else if constexpr (std::is_arithmetic_v<V>) {
+            combine(seed, v);
+          } else {
+            combine(seed, v.real());
+            combine(seed, v.imag());
+          }
+        },
+        e.get<scalar_constant>().value().raw());
+    return seed;
+  }
+  if (is_same<scalar_add>(e))
+    return n_ary(e.get<scalar_add>());
+  if (is_same<scalar_mul>(e))
+    return n_ary(e.get<scalar_mul>());
+  if (is_same<scalar_pow>(e)) {
+    auto const &pow_node = e.get<scalar_pow>();
+    combine(seed, pow_node.id());
+    combine(seed, hash(pow_node.expr_lhs()));
+    combine(seed, hash(pow_node.expr_rhs()));
+    return seed;
+  }
+  if (unary<scalar_negative>(e, seed) || unary<scalar_sin>(e, seed) ||
+      unary<scalar_cos>(e, seed) || unary<scalar_exp>(e, seed) ||
+      unary<scalar_log>(e, seed))
+    return seed;
+  // scalar_one / scalar_zero and anything else: the type alone.
+  combine(seed, e.get().id());
+  return seed;
+}
+
+} // namespace legacy
+
+namespace {
+
+struct corpus_stats {
+  std::size_t distinct{0};
+  std::size_t like_terms{0};
+  std::size_t collisions_old{0};
+  std::size_t collisions_new{0};
+};
+
+// Structurally distinct expressions, deduplicated with == inside equal-hash
+// buckets (so a hash collision can never hide a distinct expression).
+std::vector<expr_t> distinct(std::vector<expr_t> const &corpus) {
+  std::unordered_map<std::size_t, std::vector<expr_t>> buckets;
+  std::vector<expr_t> out;
+  for (auto const &e : corpus) {
+    auto &bucket = buckets[e.get().hash_value()];
+    if (std::ranges::none_of(bucket, [&](auto const &o) { return o == e; })) {
+      bucket.push_back(e);
+      out.push_back(e);
+    }
+  }
+  return out;
+}
+
+// Like terms (2*x*y vs 3*x*y) share a hash on purpose: the n-ary trees
+// find merge partners through it. Those are reported apart from the
+// accidental collisions, which are what the mixer is responsible for.
+bool like_terms(expr_t const &a, expr_t const &b) {
+  return a.get().like_term_of(b.get()) || b.get().like_term_of(a.get());
+}
+
+template <typename Hash>
+std::size_t collisions(std::vector<expr_t> const &unique, Hash hash) {
+  std::unordered_map<std::size_t, std::vector<expr_t>> classes;
+  std::size_t count = 0;
+  for (auto const &e : unique) {
+    auto &reps = classes[hash(e)];
+    if (std::ranges::none_of(reps,
+                             [&](auto const &r) { return like_terms(r, e); })) {
+      count += reps.empty() ? 0 : 1;
+      reps.push_back(e);
+    }
+  }
+  return count;
+}
+
+std::size_t like_term_groups(std::vector<expr_t> const &unique) {
+  std::unordered_map<std::size_t, std::vector<expr_t>> classes;
+  std::size_t count = 0;
+  for (auto const &e : unique) {
+    auto &reps = classes[e.get().hash_value()];
+    if (std::ranges::any_of(reps,
+                            [&](auto const &r) { return like_terms(r, e); }))
+      ++count;
+    else
+      reps.push_back(e);
+  }
+  return count;
+}
+
+corpus_stats measure(std::vector<expr_t> const &corpus) {
+  auto const unique = distinct(corpus);
+  return {unique.size(), like_term_groups(unique),
+          collisions(unique, legacy::hash),
+          collisions(unique, [](expr_t const &e) {
+            return e.get().hash_value();
+          })};
+}
+
+std::vector<std::string> symbol_names() {
+  std::vector<std::string> names;
+  for (int i = 0; i < 20000; ++i)
+    names.push_back("x" + std::to_string(i));
+  for (int i = 0; i < 100; ++i)
+    for (int j = 0; j < 100; ++j)
+      names.push_back("sigma_" + std::to_string(i) + "_" + std::to_string(j));
+  for (char a = 'a'; a <= 'z'; ++a)
+    for (char b = 'a'; b <= 'z'; ++b)
+      names.push_back(std::string{a, b});
+  return names;
+}
+
+std::vector<expr_t> symbol_corpus(std::vector<std::string> const &names) {
+  std::vector<expr_t> out;
+  for (auto const &n : names)
+    out.push_back(make_expression<scalar>(n));
+  return out;
+}
+
+std::vector<expr_t> monomial_corpus() {
+  auto [x, y, z] = make_scalar_variable("x", "y", "z");
+  std::vector<expr_t> monomials;
+  for (int i = 0; i <= 12; ++i)
+    for (int j = 0; j <= 12; ++j)
+      for (int k = 0; k <= 12; ++k) {
+        if (i + j + k == 0)
+          continue;
+        expr_t m = make_scalar_constant(1 + (i * 7 + j * 3 + k) % 5);
+        if (i)
+          m = m * pow(x, make_scalar_constant(i));
+        if (j)
+          m = m * pow(y, make_scalar_constant(j));
+        if (k)
+          m = m * pow(z, make_scalar_constant(k));
+        monomials.push_back(m);
+      }
+  std::vector<expr_t> out = monomials;
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<std::size_t> pick(0, monomials.size() - 1);
+  for (int n = 0; n < 20000; ++n)
+    out.push_back(monomials[pick(rng)] + monomials[pick(rng)]);
+  return out;
+}
+
+expr_t random_tree(std::mt19937 &rng, std::vector<expr_t> const &leaves,
+                   int depth) {
+  std::uniform_int_distribution<int> op(0, depth > 0 ? 9 : 0);
+  std::uniform_int_distribution<std::size_t> leaf(0, leaves.size() - 1);
+  switch (op(rng)) {
+  case 1:
+  case 2:
+    return random_tree(rng, leaves, depth - 1) +
+           random_tree(rng, leaves, depth - 1);
+  case 3:
+  case 4:
+    return random_tree(rng, leaves, depth - 1) *
+           random_tree(rng, leaves, depth - 1);
+  case 5:
+    return pow(random_tree(rng, leaves, depth - 1),
+               make_scalar_constant(static_cast<int>(rng() % 4) + 2));
+  case 6:
+    return sin(random_tree(rng, leaves, depth - 1));
+  case 7:
+    return cos(random_tree(rng, leaves, depth - 1));
+  case 8:
+    return exp(random_tree(rng, leaves, depth - 1));
+  case 9:
+    return log(random_tree(rng, leaves, depth - 1));
+  default:
+    return leaves[leaf(rng)];
+  }
+}
+
+std::vector<expr_t> random_corpus() {
+  std::vector<expr_t> leaves;
+  for (char c = 'a'; c <= 'h'; ++c)
+    leaves.push_back(make_expression<scalar>(std::string{c}));
+  for (int i = 1; i <= 4; ++i)
+    leaves.push_back(make_scalar_constant(i));
+  std::mt19937 rng(42);
+  std::vector<expr_t> out;
+  for (int n = 0; n < 50000; ++n)
+    out.push_back(random_tree(rng, leaves, 4));
+  return out;
+}
+
+template <typename Fn>
+double ns_per_name(std::vector<std::string> const &names, Fn fn) {
+  std::size_t sink = 0;
+  auto const start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < 20; ++rep)
+    for (auto const &n : names)
+      sink += fn(n);
+  auto const stop = std::chrono::steady_clock::now();
+  volatile std::size_t keep = sink;
+  (void)keep;
+  return std::chrono::duration<double, std::nano>(stop - start).count() /
+         (20.0 * static_cast<double>(names.size()));
+}
+
+void row(char const *name, std::size_t total, corpus_stats const &s) {
+  auto pct = [&](std::size_t c) {
+    return s.distinct ? 100.0 * static_cast<double>(c) /
+                            static_cast<double>(s.distinct)
+                      : 0.0;
+  };
+  std::printf("%-12s %8zu %9zu %11zu %10zu (%6.3f%%) %10zu (%6.3f%%)\n",
+              name, total, s.distinct, s.like_terms, s.collisions_old,
+              pct(s.collisions_old), s.collisions_new, pct(s.collisions_new));
+}
+
+} // namespace
+
+int main() {
+  auto const names = symbol_names();
+  auto const symbols = symbol_corpus(names);
+  auto const monomials = monomial_corpus();
+  auto const randoms = random_corpus();
+
+  std::printf("%-12s %8s %9s %11s %21s %21s\n", "corpus", "exprs",
+              "distinct", "like terms", "collisions (old)",
+              "collisions (new)");
+  row("symbols", symbols.size(), measure(symbols));
+  row("monomials", monomials.size(), measure(monomials));
+  row("random", randoms.size(), measure(randoms));
+
+  std::printf("\nname hashing: old %.1f ns/name, new %.1f ns/name\n",
+              ns_per_name(names, legacy::name_hash),
+              ns_per_name(names, [](std::string const &n) {
+                return symbol_name_hash(n);
+              }));
+  return 0;
+}
@@ -1,6 +1,7 @@
 #ifndef BASIC_FUNCTIONS_H
 #define BASIC_FUNCTIONS_H
 
+#include "core/profiling.h"
 #include "numsim_cas_forward.h"
 #include "numsim_cas_type_traits.h"
 #include "scalar/scalar_constant.h"
@@ -30,7 +31,7 @@ template <typename Type, typename Base>
 inline auto get_all(n_ary_tree<Base> const &tree) {
   using expr_holder_t = typename Base::expr_holder_t;
   std::vector<expr_holder_t> result;
-  for (const auto &expr : tree.symbol_map() | std::views::values) {
+  for (const auto &expr : tree.symbol_map()) {
     if (is_same<Type>(expr)) {
       result.push_back(expr);
     }
@@ -52,6 +53,7 @@ inline auto get_all(n_ary_vector<Base> const &tree) {
 
 template <typename T, typename... Args>
 [[nodiscard]] auto make_expression(Args &&...args) {
+  NUMSIM_CAS_PROFILE_ALLOC(T);
   return expression_holder<typename T::expr_t>(
       std::make_shared<T>(std::forward<Args>(args)...));
 }
@@ -4,7 +4,14 @@
 #include <numsim_cas/core/core_fwd.h>
 #include <numsim_cas/numsim_cas_type_traits.h>
 #include <numsim_cas/tensor/sequence.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <set>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -82,25 +89,6 @@ inline int cmp_vecseq(const std::vector<sequence> &A,
   return A.size() < B.size() ? -1 : 1;
 }
 
-// ---------- Variant comparators that respect payloads ----------
-struct numeric_assumption_less {
-  bool operator()(numeric_assumption const &a,
-                  numeric_assumption const &b) const noexcept {
-    if (a.index() != b.index())
-      return a.index() < b.index();
-    // all alts are empty tags → equal here
-    return false;
-  }
-};
-
-struct tensor_algebra_assumption_less {
-  bool operator()(tensor_algebra_assumption const &a,
-                  tensor_algebra_assumption const &b) const noexcept {
-    // All alternatives are empty tags → variant index ordering is total.
-    return a.index() < b.index();
-  }
-};
-
 // struct tensor_space_less {
 //   bool operator()(tensor_space const& a,
 //                   tensor_space const& b) const noexcept {
@@ -117,54 +105,238 @@ struct tensor_algebra_assumption_less {
 //   }
 // };
 
+// ---------- Tag sets ----------
+// Set of the alternatives of a variant of empty tags, one bit per
+// alternative (bit i = variant index i). Replaces std::set<Variant>: no
+// allocation, copies are a word, and union / intersection are single
+// operations. Iterates in variant-index order and yields Variant values,
+// so `for (auto const &tag : set)` reads like the set it replaced.
+template <typename Variant> class tag_set {
+public:
+  using mask_type = std::uint32_t;
+  static constexpr std::size_t capacity = std::variant_size_v<Variant>;
+  static_assert(capacity <= 32, "tag_set: too many alternatives");
+
+  constexpr tag_set() noexcept = default;
+  constexpr explicit tag_set(mask_type mask) noexcept : m_mask(mask) {}
+
+  static constexpr mask_type bit(Variant const &tag) noexcept {
+    return mask_type{1} << tag.index();
+  }
+
+  constexpr void insert(Variant const &tag) noexcept { m_mask |= bit(tag); }
+  constexpr void erase(Variant const &tag) noexcept { m_mask &= ~bit(tag); }
+  constexpr bool contains(Variant const &tag) const noexcept {
+    return (m_mask & bit(tag)) != 0;
+  }
+  constexpr bool intersects(tag_set other) const noexcept {
+    return (m_mask & other.m_mask) != 0;
+  }
+  constexpr void merge(tag_set other) noexcept { m_mask |= other.m_mask; }
+  constexpr void clear() noexcept { m_mask = 0; }
+
+  constexpr mask_type mask() const noexcept { return m_mask; }
+  constexpr bool empty() const noexcept { return m_mask == 0; }
+  constexpr std::size_t size() const noexcept {
+    return static_cast<std::size_t>(std::popcount(m_mask));
+  }
+
+  friend constexpr bool operator==(tag_set, tag_set) noexcept = default;
+
+  class iterator {
+  public:
+    using value_type = Variant;
+    using difference_type = std::ptrdiff_t;
+
+    constexpr iterator() noexcept = default;
+    constexpr explicit iterator(mask_type rest) noexcept : m_rest(rest) {}
+
+    Variant const &operator*() const noexcept {
+      return alternatives[static_cast<std::size_t>(std::countr_zero(m_rest))];
+    }
+    constexpr iterator &operator++() noexcept {
+      m_rest &= m_rest - 1;
+      return *this;
+    }
+    constexpr iterator operator++(int) noexcept {
+      auto old{*this};
+      ++*this;
+      return old;
+    }
+    friend constexpr bool operator==(iterator, iterator) noexcept = default;
+
+  private:
+    mask_type m_rest{0};
+  };
+
+  constexpr iterator begin() const noexcept { return iterator{m_mask}; }
+  constexpr iterator end() const noexcept { return iterator{}; }
+
+private:
+  template <std::size_t... I>
+  static constexpr std::array<Variant, capacity>
+  make_alternatives(std::index_sequence<I...>) {
+    return {Variant{std::in_place_index<I>}...};
+  }
+  static constexpr std::array<Variant, capacity> alternatives{
+      make_alternatives(std::make_index_sequence<capacity>{})};
+
+  mask_type m_mask{0};
+};
+
+namespace detail {
+// Reflexive-transitive closure of a one-step implication table: entry i
+// becomes the mask of every tag that tag i implies, itself included.
+template <std::size_t N>
+constexpr std::array<std::uint32_t, N>
+implication_closure(std::array<std::uint32_t, N> direct) {
+  for (std::size_t i = 0; i < N; ++i)
+    direct[i] |= std::uint32_t{1} << i;
+  for (bool changed = true; changed;) {
+    changed = false;
+    for (auto &mask : direct) {
+      auto closed{mask};
+      for (std::size_t j = 0; j < N; ++j)
+        if (mask & (std::uint32_t{1} << j))
+          closed |= direct[j];
+      changed |= closed != mask;
+      mask = closed;
+    }
+  }
+  return direct;
+}
+
+template <typename Variant, typename... Tags>
+constexpr std::uint32_t tag_mask(Tags... tags) {
+  return (tag_set<Variant>::bit(tags) | ... | 0u);
+}
+
+// One-step implications, keyed by tag rather than by position so that
+// reordering a variant cannot silently shift the table.
+template <typename Variant> struct implication_table {
+  std::array<std::uint32_t, std::variant_size_v<Variant>> direct{};
+
+  template <typename... Tags>
+  constexpr implication_table &imply(Variant const &from, Tags... to) {
+    direct[from.index()] |= tag_mask<Variant>(to...);
+    return *this;
+  }
+};
+
+// positive => nonnegative, nonzero; nonnegative => real; integer =>
+// rational => real; even/odd => integer; prime => integer, positive.
+inline constexpr auto numeric_implications{implication_closure(
+    implication_table<numeric_assumption>{}
+        .imply(positive{}, nonnegative{}, nonzero{})
+        .imply(negative{}, nonpositive{}, nonzero{})
+        .imply(nonnegative{}, real_tag{})
+        .imply(nonpositive{}, real_tag{})
+        .imply(integer{}, rational{})
+        .imply(even{}, integer{})
+        .imply(odd{}, integer{})
+        .imply(rational{}, real_tag{})
+        .imply(irrational{}, real_tag{})
+        .imply(prime{}, integer{}, positive{})
+        .direct)};
+
+// PD => PSD. Proper / improper rotations stay separate from orthogonal;
+// is_orthogonal() accepts all three.
+inline constexpr auto tensor_algebra_implications{implication_closure(
+    implication_table<tensor_algebra_assumption>{}
+        .imply(positive_definite{}, positive_semidefinite{})
+        .direct)};
+} // namespace detail
+
+// ---------- Inference generation ----------
+// Counter behind numeric_assumption_manager::inferred(). Changing what is
+// asserted about a symbol invalidates every inferred set derived from the
+// old facts; bumping the generation does that in O(1) without knowing
+// the parents of the symbol. Direct manager edits bypass it, like they
+// bypass the implication closure.
+namespace detail {
+inline std::atomic<std::uint64_t> assumption_generation_counter{1};
+} // namespace detail
+
+inline std::uint64_t assumption_generation() noexcept {
+  return detail::assumption_generation_counter.load(std::memory_order_relaxed);
+}
+
+inline void invalidate_inferred_assumptions() noexcept {
+  detail::assumption_generation_counter.fetch_add(1,
+                                                  std::memory_order_relaxed);
+}
+
 // ---------- Managers ----------
 class numeric_assumption_manager {
 public:
-  void insert(numeric_assumption a) { set_.insert(a); }
-  void erase(numeric_assumption const &a) { set_.erase(a); }
-  bool contains(numeric_assumption const &a) const {
-    return set_.find(a) != set_.end();
+  using tags_type = tag_set<numeric_assumption>;
+
+  void insert(numeric_assumption const &a) noexcept { set_.insert(a); }
+  // Inserts `a` together with everything it implies (positive also sets
+  // nonnegative, nonzero and real_tag, ...). The closure is a table
+  // lookup; this is what the assume helpers use.
+  void insert_implied(numeric_assumption const &a) noexcept {
+    set_.merge(tags_type{detail::numeric_implications[a.index()]});
+  }
+  void erase(numeric_assumption const &a) noexcept { set_.erase(a); }
+  bool contains(numeric_assumption const &a) const noexcept {
+    return set_.contains(a);
+  }
+  void merge(numeric_assumption_manager const &other) noexcept {
+    set_.merge(other.set_);
+  }
+  void clear() noexcept { set_.clear(); }
+  tags_type const &data() const noexcept { return set_; }
+
+  // Cache marker of the assumption inference (infer_assumptions and
+  // scalar_assumption_propagator). inferred() means "this set is complete
+  // for the current assumption generation": the propagators return it
+  // without looking at the children, so each node of a DAG is analysed
+  // at most once. assume() / remove_assumption() on a symbol start a new
+  // generation, which turns every older marker into a miss; the facts
+  // are then derived again from the children on the next query.
+  // Construction-time annotations (scalar_constant, tensor_to_scalar
+  // one/zero) set it as well.
+  bool inferred() const noexcept {
+    return inferred_generation_ == assumption_generation();
+  }
+  void set_inferred() noexcept {
+    inferred_generation_ = assumption_generation();
   }
-  void clear() { set_.clear(); }
-  auto const &data() const { return set_; }
-
-  // Forward-compat marker for the assumption-propagation system.
-  // set_inferred() is called by assume_* helpers (scalar_assume.h) and
-  // construction-time annotations (e.g. tensor_to_scalar_one/zero) to
-  // signal "these facts are already established; an assumption
-  // propagator should treat them as known and skip re-derivation."
-  // No current reader uses inferred(); the flag is purely future-
-  // proofing for the planned propagator. Calls to set_inferred()
-  // exist across the codebase for consistency, but produce no
-  // observable behavior today.
-  bool inferred() const noexcept { return inferred_; }
-  void set_inferred() noexcept { inferred_ = true; }
 
 private:
-  std::set<numeric_assumption, numeric_assumption_less> set_;
-  bool inferred_{false};
+  tags_type set_;
+  std::uint64_t inferred_generation_{0};
 };
 
 // Manager for tensor algebra-property assumptions (orthogonal, PD, PSD).
-// Mirrors numeric_assumption_manager's set-based shape: multiple tags can
-// be active simultaneously, and implications (PD => PSD) are encoded as
-// joint insertions in assume_positive_definite(). NOTE: direct manager
-// access (manager.insert(positive_definite{}) without going through
+// Mirrors numeric_assumption_manager's bitset shape: multiple tags can
+// be active simultaneously, and implications (PD => PSD) are applied by
+// insert_implied(), which assume_positive_definite() uses. NOTE: plain
+// insert() (manager.insert(positive_definite{}) without going through
 // assume_positive_definite) bypasses the implication chain — same leaky
 // abstraction as numeric_assumption_manager. Prefer the assume_* helpers
 // in tensor_assume.h.
 class tensor_algebra_assumption_manager {
 public:
-  void insert(tensor_algebra_assumption a) { set_.insert(a); }
-  void erase(tensor_algebra_assumption const &a) { set_.erase(a); }
-  bool contains(tensor_algebra_assumption const &a) const {
-    return set_.find(a) != set_.end();
+  using tags_type = tag_set<tensor_algebra_assumption>;
+
+  void insert(tensor_algebra_assumption const &a) noexcept { set_.insert(a); }
+  void insert_implied(tensor_algebra_assumption const &a) noexcept {
+    set_.merge(tags_type{detail::tensor_algebra_implications[a.index()]});
+  }
+  void erase(tensor_algebra_assumption const &a) noexcept { set_.erase(a); }
+  bool contains(tensor_algebra_assumption const &a) const noexcept {
+    return set_.contains(a);
+  }
+  void merge(tensor_algebra_assumption_manager const &other) noexcept {
+    set_.merge(other.set_);
   }
-  void clear() { set_.clear(); }
-  auto const &data() const { return set_; }
+  void clear() noexcept { set_.clear(); }
+  tags_type const &data() const noexcept { return set_; }
 
 private:
-  std::set<tensor_algebra_assumption, tensor_algebra_assumption_less> set_;
+  tags_type set_;
 };
 
 // class tensor_space_manager {
@@ -125,6 +125,15 @@ protected:
     base::m_hash_value =
         update_hash<binary_op<ThisBase, BaseLHS, BaseRHS>>()(*this);
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    symbol_set result;
+    if (m_lhs.is_valid())
+      result |= m_lhs.get().free_symbols();
+    if (m_rhs.is_valid())
+      result |= m_rhs.get().free_symbols();
+    return result;
+  }
   /**
    * @brief Holds the left-hand side expression.
    */
@@ -33,6 +33,16 @@ class internal_error : public cas_error {
   using cas_error::cas_error;
 };
 
+class serialization_error : public cas_error {
+  using cas_error::cas_error;
+};
+
+// A sparse_polynomial limit was exceeded (more than eight variables or an
+// exponent above 255), or a polynomial was divided by zero.
+class polynomial_error : public cas_error {
+  using cas_error::cas_error;
+};
+
 } // namespace numsim::cas
 
 #endif // CAS_ERROR_H
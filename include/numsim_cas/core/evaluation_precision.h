@@ -0,0 +1,32 @@
+#ifndef EVALUATION_PRECISION_H
+#define EVALUATION_PRECISION_H
+
+#include <type_traits>
+
+namespace numsim::cas {
+
+// Mixed-precision policy of the evaluators. Nodes that lose most of their
+// digits to cancellation — tensor_inv, det, the spectral nodes
+// (eigenvalues, eigenprojections, eigenvectors, isotropic functions) and the
+// divided differences at (nearly) coincident eigenvalues — are evaluated in
+// `promoted_type` and rounded back to ValueType; rational constants are
+// divided in it as well. Everything else runs in ValueType. float promotes
+// to double; specialize for other value types.
+template <typename ValueType> struct evaluation_precision {
+  using promoted_type = ValueType;
+};
+
+template <> struct evaluation_precision<float> {
+  using promoted_type = double;
+};
+
+template <typename ValueType>
+using promoted_value_t = typename evaluation_precision<ValueType>::promoted_type;
+
+template <typename ValueType>
+inline constexpr bool is_promoted_v =
+    !std::is_same_v<ValueType, promoted_value_t<ValueType>>;
+
+} // namespace numsim::cas
+
+#endif // EVALUATION_PRECISION_H
@@ -2,10 +2,33 @@
 #define EXPRESSION_H
 
 #include "assumptions.h"
+#include "free_symbols.h"
+#include <cstdint>
 #include <cstdlib>
 
 namespace numsim::cas {
 
+/// Expression domain of a node, part of the node header.
+enum class expression_domain : std::uint8_t {
+  scalar,
+  tensor,
+  tensor_to_scalar
+};
+
+/// Per-type node properties kept in the node header. A node class opts in
+/// by declaring `static constexpr std::uint8_t static_node_flags`, which
+/// visitable_impl copies into every instance (symbol_base and n_ary_tree
+/// do this for their subclasses).
+struct node_flags {
+  // Named leaf that accepts user assumptions (symbol_base).
+  static constexpr std::uint8_t symbol{1};
+  // Numeric leaf: zero, one or constant of its domain.
+  static constexpr std::uint8_t number{2};
+  // Overrides like_term_of, so it can be a like term of a node of a
+  // different type (n-ary trees, tensor_scalar_mul).
+  static constexpr std::uint8_t scaled{4};
+};
+
 /**
  * @class expression
  * @brief A base class representing an expression with a hash value.
@@ -42,9 +65,15 @@ public:
    * makes the hash depend on m_assumption, this copy invariant must be
    * re-examined (the assumption set isn't part of the node's structural
    * identity in the current model — it's user-asserted metadata).
+   *
+   * The free-symbol cache is not copied: copies are typically mutated
+   * (n-ary children merged in) and recomputing it costs one pass over the
+   * direct children, whose own caches survive.
    */
   expression(expression const &data)
-      : m_assumption(data.m_assumption), m_hash_value(data.m_hash_value) {}
+      : m_assumption(data.m_assumption), m_hash_value(data.m_hash_value),
+        m_node_id(data.m_node_id), m_node_flags(data.m_node_flags),
+        m_domain(data.m_domain) {}
 
   /**
    * @brief Move constructor.
@@ -52,7 +81,8 @@ public:
    */
   expression(expression &&data) noexcept
       : m_assumption(std::move(data.m_assumption)),
-        m_hash_value(data.m_hash_value) {}
+        m_hash_value(data.m_hash_value), m_node_id(data.m_node_id),
+        m_node_flags(data.m_node_flags), m_domain(data.m_domain) {}
 
   /**
    * @brief Virtual destructor.
@@ -72,7 +102,35 @@ public:
    */
   hash_type const &hash_value() const;
 
-  [[nodiscard]] virtual type_id id() const noexcept = 0;
+  /**
+   * @brief Index of the node type in its domain's node list.
+   *
+   * Read from the node header that visitable_impl fills in on
+   * construction, so equality, ordering and is_same<T> need no virtual
+   * call. Ids are only unique within one domain.
+   */
+  [[nodiscard]] type_id id() const noexcept { return m_node_id; }
+
+  [[nodiscard]] expression_domain domain() const noexcept { return m_domain; }
+
+  /// Numeric leaf (zero, one, constant); negations of numbers are not.
+  [[nodiscard]] bool is_number() const noexcept {
+    return (m_node_flags & node_flags::number) != 0;
+  }
+
+  /// False if like_term_of is plain equality for this node.
+  [[nodiscard]] bool is_scaled() const noexcept {
+    return (m_node_flags & node_flags::scaled) != 0;
+  }
+
+  /**
+   * @brief Over-approximated set of symbols this expression depends on.
+   *
+   * Computed on first use from the children's sets and cached. A symbol
+   * missing from the set is certainly absent from the subtree; see
+   * symbol_set for the false-positive side.
+   */
+  [[nodiscard]] symbol_set const &free_symbols() const;
 
   /**
    * @brief Whether this node is a Symbol (named leaf accepting user
@@ -83,9 +141,12 @@ public:
    * literals) and compound expressions return false; their facts are
    * intrinsic to the type or derived from structure + leaves.
    *
-   * Default: false. Symbol-class nodes override to return true.
+   * Read from the node header: true for symbol_base nodes, and for
+   * tensor_to_scalar_scalar_wrapper when it wraps a Symbol.
    */
-  [[nodiscard]] virtual bool is_symbol() const noexcept { return false; }
+  [[nodiscard]] bool is_symbol() const noexcept {
+    return (m_node_flags & node_flags::symbol) != 0;
+  }
 
   inline auto &assumptions() noexcept { return m_assumption; }
 
@@ -111,12 +172,51 @@ protected:
 
   virtual void update_hash_value() const = 0;
 
+  // Default for nodes that do not enumerate their children: "may depend on
+  // anything", which disables pruning but is always correct.
+  [[nodiscard]] virtual symbol_set compute_free_symbols() const {
+    return symbol_set::all();
+  }
+
+  // Mutating nodes (n_ary_tree) must drop the cache together with the hash.
+  void invalidate_free_symbols() const noexcept {
+    m_free_symbols_valid = false;
+  }
+
+  void set_node_header(type_id id, expression_domain domain,
+                       std::uint8_t flags) noexcept {
+    m_node_id = static_cast<std::uint16_t>(id);
+    m_domain = domain;
+    m_node_flags = flags;
+  }
+
+  void set_node_flag(std::uint8_t flag, bool value) noexcept {
+    m_node_flags = static_cast<std::uint8_t>(value ? m_node_flags | flag
+                                                   : m_node_flags & ~flag);
+  }
+
   numeric_assumption_manager m_assumption{};
   // NOTE: lazy hash caching is not thread-safe. If multithreading is
   // introduced, protect update_hash_value() with synchronization.
   mutable hash_type m_hash_value{0};
+  mutable symbol_set m_free_symbols;
+  // Node header and the free-symbol cache flag share the last word, so the
+  // header adds nothing to the node size.
+  std::uint16_t m_node_id{0};
+  std::uint8_t m_node_flags{0};
+  expression_domain m_domain{expression_domain::scalar};
+  mutable bool m_free_symbols_valid{false};
 };
 
+// True unless `expr` provably does not contain the symbol `symbol`. Used by
+// the differentiation and containment visitors to skip constant subtrees.
+// Non-symbol arguments are never pruned.
+[[nodiscard]] inline bool may_depend_on(expression const &expr,
+                                        expression const &symbol) {
+  return !symbol.is_symbol() ||
+         expr.free_symbols().may_contain(symbol.free_symbols());
+}
+
 } // namespace numsim::cas
 
 #endif // EXPRESSION_H
@@ -0,0 +1,146 @@
+#ifndef FLAT_SET_H
+#define FLAT_SET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numsim_cas/core/small_vector.h>
+#include <type_traits>
+#include <utility>
+
+namespace numsim::cas {
+
+// Sorted set over a small_vector of keys.
+//
+// Drop-in for the std::set subset the n_ary trees use: find / contains /
+// lower_bound / erase by key or iterator / ordered iteration. Lookups are a
+// binary search over contiguous storage and the first N keys live inside the
+// owning object, so small sums and products never allocate for their
+// children.
+//
+// Differences from std::set callers must respect:
+//   - insert and erase invalidate iterators at and after the touched position,
+//     and any insert may reallocate. Re-find after mutating.
+// As with std::set, iterators are const: changing a key in place would break
+// the ordering.
+template <typename Key, std::size_t N, typename Compare = std::less<Key>>
+class flat_set {
+public:
+  using key_type = Key;
+  using value_type = Key;
+  using key_compare = Compare;
+  using container_type = small_vector<Key, N>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type const &;
+  using const_reference = value_type const &;
+  using iterator = typename container_type::const_iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using reverse_iterator = typename container_type::const_reverse_iterator;
+  using const_reverse_iterator =
+      typename container_type::const_reverse_iterator;
+
+  static constexpr size_type inline_capacity = N;
+
+  flat_set() = default;
+
+  // ─── iterators ─────────────────────────────────────────────────────
+
+  [[nodiscard]] const_iterator begin() const noexcept { return m_data.begin(); }
+  [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+  [[nodiscard]] const_iterator end() const noexcept { return m_data.end(); }
+  [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+  [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+    return m_data.rbegin();
+  }
+  [[nodiscard]] const_reverse_iterator rend() const noexcept {
+    return m_data.rend();
+  }
+
+  // ─── capacity ──────────────────────────────────────────────────────
+
+  [[nodiscard]] bool empty() const noexcept { return m_data.empty(); }
+  [[nodiscard]] size_type size() const noexcept { return m_data.size(); }
+  void reserve(size_type n) { m_data.reserve(n); }
+  void clear() noexcept { m_data.clear(); }
+
+  // ─── lookup ────────────────────────────────────────────────────────
+
+  template <typename K>
+  [[nodiscard]] const_iterator lower_bound(K const &key) const {
+    return std::lower_bound(begin(), end(), key, Compare{});
+  }
+
+  template <typename K>
+  [[nodiscard]] const_iterator upper_bound(K const &key) const {
+    return std::upper_bound(begin(), end(), key, Compare{});
+  }
+
+  template <typename K>
+  [[nodiscard]] const_iterator find(K const &key) const {
+    auto it = lower_bound(key);
+    return (it != end() && !Compare{}(key, *it)) ? it : end();
+  }
+
+  template <typename K> [[nodiscard]] bool contains(K const &key) const {
+    return find(key) != end();
+  }
+  template <typename K> [[nodiscard]] size_type count(K const &key) const {
+    return contains(key) ? 1 : 0;
+  }
+
+  // ─── modifiers ─────────────────────────────────────────────────────
+
+  template <typename K> std::pair<const_iterator, bool> insert(K &&key) {
+    auto it = lower_bound(key);
+    if (it != end() && !Compare{}(key, *it))
+      return {it, false};
+    return {m_data.emplace(it, std::forward<K>(key)), true};
+  }
+
+  // Bulk insert with std::set::insert(first, last) semantics: a key that is
+  // already present, or repeated in the range, is kept once. The range is
+  // appended, sorted and merged in once, O((n + k) log k) instead of one
+  // shifting insert per entry. Returns the number of keys inserted.
+  template <std::input_iterator It> size_type insert(It first, It last) {
+    auto const old_size{size()};
+    for (; first != last; ++first)
+      m_data.emplace_back(*first);
+    auto const mid{m_data.begin() + static_cast<difference_type>(old_size)};
+    std::stable_sort(mid, m_data.end(), Compare{});
+    std::inplace_merge(m_data.begin(), mid, m_data.end(), Compare{});
+    auto const unique_end{std::unique(
+        m_data.begin(), m_data.end(), [](Key const &lhs, Key const &rhs) {
+          return !Compare{}(lhs, rhs);
+        })};
+    m_data.erase(unique_end, m_data.end());
+    return size() - old_size;
+  }
+
+  const_iterator erase(const_iterator pos) { return m_data.erase(pos); }
+  const_iterator erase(const_iterator first, const_iterator last) {
+    return m_data.erase(first, last);
+  }
+
+  template <typename K>
+  requires(!std::is_convertible_v<K const &, const_iterator>)
+  size_type erase(K const &key) {
+    auto it = find(key);
+    if (it == end())
+      return 0;
+    m_data.erase(it);
+    return 1;
+  }
+
+  void swap(flat_set &other) noexcept(noexcept(m_data.swap(other.m_data))) {
+    m_data.swap(other.m_data);
+  }
+
+private:
+  container_type m_data;
+};
+
+} // namespace numsim::cas
+
+#endif // FLAT_SET_H
@@ -0,0 +1,77 @@
+#ifndef FREE_SYMBOLS_H
+#define FREE_SYMBOLS_H
+
+#include <numsim_cas/core/hash_functions.h>
+
+#include <cstdint>
+#include <string_view>
+
+namespace numsim::cas {
+
+// Over-approximation of the symbols an expression depends on: a 64-bit
+// Bloom filter with one bit per symbol name. A clear bit proves that no
+// symbol of that name occurs below a node; a set bit only says "maybe" and
+// callers fall back to the exact walk. Scalar and tensor symbols of the same
+// name share a bit, which is harmless for the same reason.
+//
+// Every node caches its set (expression::free_symbols()), built bottom-up
+// as the union of its children, so the query is O(1) after the first call.
+class symbol_set {
+public:
+  constexpr symbol_set() noexcept = default;
+
+  [[nodiscard]] static symbol_set of(std::string_view name) noexcept {
+    std::size_t seed = 0;
+    hash_combine(seed, name);
+    return symbol_set{std::uint64_t{1} << (detail::hash_finalize(seed) & 63u)};
+  }
+
+  // Conservative answer for nodes that do not describe their children.
+  [[nodiscard]] static constexpr symbol_set all() noexcept {
+    return symbol_set{~std::uint64_t{0}};
+  }
+
+  constexpr symbol_set &operator|=(symbol_set const &rhs) noexcept {
+    m_bits |= rhs.m_bits;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr symbol_set
+  operator|(symbol_set lhs, symbol_set const &rhs) noexcept {
+    return lhs |= rhs;
+  }
+
+  constexpr symbol_set &operator&=(symbol_set const &rhs) noexcept {
+    m_bits &= rhs.m_bits;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr symbol_set
+  operator&(symbol_set lhs, symbol_set const &rhs) noexcept {
+    return lhs &= rhs;
+  }
+
+  // False only if some symbol of `other` is certainly absent from *this.
+  [[nodiscard]] constexpr bool
+  may_contain(symbol_set const &other) const noexcept {
+    return (m_bits & other.m_bits) == other.m_bits;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept { return m_bits == 0; }
+
+  [[nodiscard]] constexpr std::uint64_t bits() const noexcept {
+    return m_bits;
+  }
+
+  friend constexpr bool operator==(symbol_set const &,
+                                   symbol_set const &) = default;
+
+private:
+  constexpr explicit symbol_set(std::uint64_t bits) noexcept : m_bits(bits) {}
+
+  std::uint64_t m_bits{0};
+};
+
+} // namespace numsim::cas
+
+#endif // FREE_SYMBOLS_H
@@ -1,25 +1,114 @@
 #ifndef HASH_FUNCTIONS_H
 #define HASH_FUNCTIONS_H
 
+#include <bit>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace numsim::cas {
 
-// Helper function for combining hashes
+// Expression hashing.
+//
+// Every node folds its id and children into a 64-bit seed with
+// hash_combine. The mixer is the wyhash "mum" step: a full 64x64->128
+// multiply folded back to 64 bits, so every input bit reaches every output
+// bit in one round. Equality and the n_ary_tree like-term lookup both lean
+// on these hashes, so collisions directly cost extra deep comparisons.
+namespace detail {
+
+inline constexpr std::uint64_t hash_secret0 = 0xa0761d6478bd642full;
+inline constexpr std::uint64_t hash_secret1 = 0xe7037ed1a0b428dbull;
+inline constexpr std::uint64_t hash_secret2 = 0x8ebc6af09c88c6e3ull;
+
+[[nodiscard]] constexpr std::uint64_t hash_mum(std::uint64_t a,
+                                               std::uint64_t b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  __extension__ using u128 = unsigned __int128;
+  auto const r = static_cast<u128>(a) * b;
+  return static_cast<std::uint64_t>(r) ^ static_cast<std::uint64_t>(r >> 64);
+#else
+  std::uint64_t const a_lo = a & 0xffffffffu, a_hi = a >> 32;
+  std::uint64_t const b_lo = b & 0xffffffffu, b_hi = b >> 32;
+  std::uint64_t const ll = a_lo * b_lo, lh = a_lo * b_hi;
+  std::uint64_t const hl = a_hi * b_lo, hh = a_hi * b_hi;
+  std::uint64_t const mid = (ll >> 32) + (lh & 0xffffffffu) + (hl & 0xffffffffu);
+  std::uint64_t const lo = (mid << 32) | (ll & 0xffffffffu);
+  std::uint64_t const hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+  return lo ^ hi;
+#endif
+}
+
+[[nodiscard]] constexpr std::uint64_t hash_mix(std::uint64_t seed,
+                                               std::uint64_t word) noexcept {
+  return hash_mum(seed ^ hash_secret0, word ^ hash_secret1);
+}
+
+// Bijective finalizer; used for the per-child term of commutative hashes so
+// that summing child hashes does not let structured inputs cancel out.
+[[nodiscard]] constexpr std::uint64_t hash_finalize(std::uint64_t h) noexcept {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+// Scalars reduced to one 64-bit word. Integral-valued doubles map to the
+// same word as the integer, so 2 and 2.0 hash alike (scalar_number compares
+// them equal); other doubles use their bit pattern, with -0.0 folded to 0.
+template <typename T>
+[[nodiscard]] constexpr std::uint64_t hash_word(T const &value) noexcept {
+  if constexpr (std::is_enum_v<T>) {
+    return static_cast<std::uint64_t>(
+        static_cast<std::underlying_type_t<T>>(value));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    double const d = static_cast<double>(value);
+    if (d == 0.0)
+      return 0;
+    if (d >= -9.2e18 && d <= 9.2e18 && d == std::trunc(d))
+      return static_cast<std::uint64_t>(static_cast<std::int64_t>(d));
+    return std::bit_cast<std::uint64_t>(d);
+  } else {
+    return static_cast<std::uint64_t>(value);
+  }
+}
+
+} // namespace detail
+
 template <typename T>
 inline void hash_combine(std::size_t &seed, const T &value) {
-  // std::hash<T> hasher;
-  seed ^= static_cast<std::size_t>(value) +
-          static_cast<std::size_t>(0x9e3779b9) + (seed << 6) + (seed >> 2);
+  seed = static_cast<std::size_t>(
+      detail::hash_mix(seed, detail::hash_word(value)));
 }
 
-inline void hash_combine(std::size_t &seed, const std::string &value) {
-  for (const auto &c : value) {
-    hash_combine(seed, c);
+// Bytes are consumed eight at a time instead of one hash_combine per char.
+inline void hash_combine(std::size_t &seed, std::string_view value) {
+  std::uint64_t h = detail::hash_mix(seed, value.size());
+  std::size_t i = 0;
+  for (; i + 8 <= value.size(); i += 8) {
+    std::uint64_t w;
+    std::memcpy(&w, value.data() + i, 8);
+    h = detail::hash_mix(h, w);
   }
+  if (i < value.size()) {
+    std::uint64_t w = 0;
+    std::memcpy(&w, value.data() + i, value.size() - i);
+    h = detail::hash_mix(h, w ^ detail::hash_secret2);
+  }
+  seed = static_cast<std::size_t>(h);
+}
+
+inline void hash_combine(std::size_t &seed, const std::string &value) {
+  hash_combine(seed, std::string_view{value});
 }
+
 template <typename T>
 inline void hash_combine(std::size_t &seed, const std::complex<T> &value) {
   hash_combine(seed, value.real());
@@ -33,6 +122,55 @@ inline void hash_combine(std::size_t &seed, const std::vector<T> &value) {
   }
 }
 
+// Leaf hash for symbol names. The first three bytes are kept big-endian in
+// bits 32..55 so symbols order alphabetically by prefix and below the
+// (uniformly spread) hashes of compound nodes; that is the canonical order
+// the printers rely on ("a+b+x*y"). The low 32 bits mix the full name to
+// split names that share the prefix (sigma_1, sigma_2, ...). symbol_base
+// compares names on a hash tie, so a leftover collision only costs a string
+// compare.
+[[nodiscard]] inline std::size_t symbol_name_hash(std::string_view name) {
+  std::uint64_t prefix = 0;
+  for (std::size_t i = 0; i < 3; ++i) {
+    prefix <<= 8;
+    if (i < name.size())
+      prefix |= static_cast<unsigned char>(name[i]);
+  }
+  std::size_t mixed = 0;
+  hash_combine(mixed, name);
+  return static_cast<std::size_t>(
+      (prefix << 32) | (detail::hash_finalize(mixed) & 0xffffffffu));
+}
+
+// Order-independent accumulator for the children of commutative nodes.
+// Adding and removing a child are O(1), so a node can keep its hash current
+// while children are merged in instead of re-sorting every child hash.
+class commutative_hash {
+public:
+  constexpr void insert(std::size_t h) noexcept {
+    m_sum += detail::hash_finalize(h);
+    ++m_count;
+  }
+  constexpr void erase(std::size_t h) noexcept {
+    m_sum -= detail::hash_finalize(h);
+    --m_count;
+  }
+  constexpr void clear() noexcept { *this = {}; }
+
+  // Folds the accumulated multiset into seed.
+  constexpr void combine_into(std::size_t &seed) const noexcept {
+    seed = static_cast<std::size_t>(detail::hash_mix(
+        detail::hash_mix(seed, m_sum), m_count));
+  }
+
+  friend constexpr bool operator==(commutative_hash const &,
+                                   commutative_hash const &) = default;
+
+private:
+  std::uint64_t m_sum{0};
+  std::uint64_t m_count{0};
+};
+
 } // namespace numsim::cas
 
 #endif // HASH_FUNCTIONS_H
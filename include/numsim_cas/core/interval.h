@@ -0,0 +1,423 @@
+#ifndef INTERVAL_H
+#define INTERVAL_H
+
+#include <numsim_cas/core/cas_error.h>
+
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <limits>
+#include <numbers>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace numsim::cas {
+
+// Closed interval [lower, upper] of a floating-point type, usable as the
+// ValueType of scalar_evaluator and tensor_to_scalar_evaluator to bound an
+// expression over a box of inputs:
+//
+//   scalar_evaluator<interval<double>> ev;
+//   ev.set(eps, interval<double>{-0.02, 0.05});
+//   auto range = ev.apply(log(1 + eps));   // encloses every value
+//
+// Every operation returns an enclosure of the exact range. +, -, *, / and
+// sqrt round outward by at most one ulp, and only when the result is
+// inexact (error-free transformations detect exact results). Transcendental
+// functions are widened by two ulps, which covers the error bounds that
+// common libms document. The elementary functions give the sharp range of
+// the function over the interval, not a Taylor bound: sin/cos include the
+// extrema they pass, and abs/pow of even powers touch zero.
+//
+// An operation whose argument range leaves the function's domain throws
+// evaluation_error: log or sqrt of a range reaching non-positive /
+// negative values, division by a range containing zero, asin/acos outside
+// [-1, 1], tan across a pole. A successful evaluation therefore proves
+// that none of these can happen for any input in the box.
+template <typename T> class interval {
+  static_assert(std::is_floating_point_v<T>,
+                "interval: T must be a floating-point type");
+
+public:
+  using value_type = T;
+
+  constexpr interval() noexcept = default;
+
+  // Point interval; implicit so that constants and `ValueType{0}` work.
+  constexpr interval(T value) noexcept : m_lower(value), m_upper(value) {}
+
+  interval(T lower, T upper) : m_lower(lower), m_upper(upper) {
+    if (!(lower <= upper))
+      throw evaluation_error("interval: lower bound above upper bound");
+  }
+
+  [[nodiscard]] constexpr T lower() const noexcept { return m_lower; }
+  [[nodiscard]] constexpr T upper() const noexcept { return m_upper; }
+  [[nodiscard]] constexpr T width() const noexcept { return m_upper - m_lower; }
+  [[nodiscard]] constexpr T mid() const noexcept {
+    return m_lower + (m_upper - m_lower) / 2;
+  }
+  [[nodiscard]] constexpr bool is_point() const noexcept {
+    return m_lower == m_upper;
+  }
+  [[nodiscard]] constexpr bool contains(T value) const noexcept {
+    return m_lower <= value && value <= m_upper;
+  }
+
+  interval &operator+=(interval const &rhs) { return *this = *this + rhs; }
+  interval &operator-=(interval const &rhs) { return *this = *this - rhs; }
+  interval &operator*=(interval const &rhs) { return *this = *this * rhs; }
+  interval &operator/=(interval const &rhs) { return *this = *this / rhs; }
+
+  // Same bounds, not "certainly equal values" (see interval_eq).
+  friend constexpr bool operator==(interval const &,
+                                   interval const &) = default;
+
+  friend std::ostream &operator<<(std::ostream &os, interval const &x) {
+    return os << '[' << x.m_lower << ", " << x.m_upper << ']';
+  }
+
+private:
+  T m_lower{0};
+  T m_upper{0};
+};
+
+template <typename T> struct is_interval : std::false_type {};
+template <typename T> struct is_interval<interval<T>> : std::true_type {};
+template <typename T>
+inline constexpr bool is_interval_v = is_interval<T>::value;
+
+namespace detail {
+
+template <typename T> T next_down(T x, int ulps = 1) noexcept {
+  while (ulps--)
+    x = std::nextafter(x, -std::numeric_limits<T>::infinity());
+  return x;
+}
+
+template <typename T> T next_up(T x, int ulps = 1) noexcept {
+  while (ulps--)
+    x = std::nextafter(x, std::numeric_limits<T>::infinity());
+  return x;
+}
+
+// [r, r] if the rounded result r is exact, otherwise the one-ulp bracket on
+// the side of the exact value (`error` = exact - r, sign only).
+template <typename T> std::pair<T, T> bracket(T r, T error) noexcept {
+  if (error > 0)
+    return {r, next_up(r)};
+  if (error < 0)
+    return {next_down(r), r};
+  return {r, r};
+}
+
+template <typename T> std::pair<T, T> add_bounds(T a, T b) noexcept {
+  T const s = a + b; // TwoSum
+  T const bb = s - a;
+  return bracket(s, (a - (s - bb)) + (b - bb));
+}
+
+template <typename T> std::pair<T, T> mul_bounds(T a, T b) noexcept {
+  T const p = a * b;
+  return bracket(p, std::fma(a, b, -p));
+}
+
+template <typename T> std::pair<T, T> div_bounds(T a, T b) noexcept {
+  T const q = a / b;
+  T const residual = std::fma(-q, b, a); // a - q*b, exact
+  return bracket(q, b > 0 ? residual : -residual);
+}
+
+// Transcendental results: two ulps outward.
+template <typename T> interval<T> widen(T lower, T upper) {
+  return interval<T>(next_down(lower, 2), next_up(upper, 2));
+}
+
+template <typename T>
+[[noreturn]] void domain_error(char const *function, interval<T> const &x,
+                               char const *requirement) {
+  throw evaluation_error(std::string("interval ") + function +
+                         ": argument [" + std::to_string(x.lower()) + ", " +
+                         std::to_string(x.upper()) + "] " + requirement);
+}
+
+// True if some point c + k*period lies in [lower, upper]. Errs towards true
+// near the boundary, which only loosens the enclosure.
+template <typename T>
+bool hits_periodic(interval<T> const &x, T c, T period) noexcept {
+  constexpr T slack = T(1e-9);
+  auto const k_lo = std::ceil((x.lower() - c) / period - slack);
+  auto const k_hi = std::floor((x.upper() - c) / period + slack);
+  return k_lo <= k_hi;
+}
+
+template <typename T>
+interval<T> periodic_range(interval<T> const &x, T peak, T trough, T fl,
+                           T fu) {
+  constexpr T two_pi = 2 * std::numbers::pi_v<T>;
+  if (x.width() >= two_pi)
+    return interval<T>(-1, 1);
+  T lower = hits_periodic(x, trough, two_pi) ? T(-1)
+                                             : next_down(std::min(fl, fu), 2);
+  T upper = hits_periodic(x, peak, two_pi) ? T(1)
+                                           : next_up(std::max(fl, fu), 2);
+  return interval<T>(std::max(lower, T(-1)), std::min(upper, T(1)));
+}
+
+template <typename T> interval<T> int_pow(interval<T> const &x, long long n) {
+  if (n == 0)
+    return interval<T>(1);
+  if (n < 0) {
+    if (x.contains(0))
+      domain_error("pow", x, "contains zero (negative exponent)");
+    return interval<T>(1) / int_pow(x, -n);
+  }
+  if (n == 1)
+    return x;
+  auto const p = static_cast<T>(n);
+  auto const pl = std::pow(x.lower(), p);
+  auto const pu = std::pow(x.upper(), p);
+  if (n % 2 == 1)
+    return widen(pl, pu);
+  if (x.lower() >= 0)
+    return widen(pl, pu);
+  if (x.upper() <= 0)
+    return widen(pu, pl);
+  return interval<T>(0, next_up(std::max(pl, pu), 2));
+}
+
+} // namespace detail
+
+// ─── Arithmetic ──────────────────────────────────────────────────
+
+template <typename T> interval<T> operator+(interval<T> const &x) {
+  return x;
+}
+
+template <typename T> interval<T> operator-(interval<T> const &x) {
+  return interval<T>(-x.upper(), -x.lower());
+}
+
+template <typename T>
+interval<T> operator+(interval<T> const &a, interval<T> const &b) {
+  return interval<T>(detail::add_bounds(a.lower(), b.lower()).first,
+                     detail::add_bounds(a.upper(), b.upper()).second);
+}
+
+template <typename T>
+interval<T> operator-(interval<T> const &a, interval<T> const &b) {
+  return a + (-b);
+}
+
+template <typename T>
+interval<T> operator*(interval<T> const &a, interval<T> const &b) {
+  auto lower = std::numeric_limits<T>::infinity();
+  auto upper = -std::numeric_limits<T>::infinity();
+  for (auto x : {a.lower(), a.upper()})
+    for (auto y : {b.lower(), b.upper()}) {
+      auto const [lo, hi] = detail::mul_bounds(x, y);
+      lower = std::min(lower, lo);
+      upper = std::max(upper, hi);
+    }
+  return interval<T>(lower, upper);
+}
+
+template <typename T>
+interval<T> operator/(interval<T> const &a, interval<T> const &b) {
+  if (b.contains(0))
+    detail::domain_error("division", b, "contains zero");
+  auto lower = std::numeric_limits<T>::infinity();
+  auto upper = -std::numeric_limits<T>::infinity();
+  for (auto x : {a.lower(), a.upper()})
+    for (auto y : {b.lower(), b.upper()}) {
+      auto const [lo, hi] = detail::div_bounds(x, y);
+      lower = std::min(lower, lo);
+      upper = std::max(upper, hi);
+    }
+  return interval<T>(lower, upper);
+}
+
+// Mixed forms so that `2.0 * x` and `x / 3.0` read naturally.
+template <typename T>
+interval<T> operator+(interval<T> const &a, std::type_identity_t<T> b) {
+  return a + interval<T>(b);
+}
+template <typename T>
+interval<T> operator+(std::type_identity_t<T> a, interval<T> const &b) {
+  return interval<T>(a) + b;
+}
+template <typename T>
+interval<T> operator-(interval<T> const &a, std::type_identity_t<T> b) {
+  return a - interval<T>(b);
+}
+template <typename T>
+interval<T> operator-(std::type_identity_t<T> a, interval<T> const &b) {
+  return interval<T>(a) - b;
+}
+template <typename T>
+interval<T> operator*(interval<T> const &a, std::type_identity_t<T> b) {
+  return a * interval<T>(b);
+}
+template <typename T>
+interval<T> operator*(std::type_identity_t<T> a, interval<T> const &b) {
+  return interval<T>(a) * b;
+}
+template <typename T>
+interval<T> operator/(interval<T> const &a, std::type_identity_t<T> b) {
+  return a / interval<T>(b);
+}
+template <typename T>
+interval<T> operator/(std::type_identity_t<T> a, interval<T> const &b) {
+  return interval<T>(a) / b;
+}
+
+// Smallest interval containing both.
+template <typename T>
+interval<T> hull(interval<T> const &a, interval<T> const &b) {
+  return interval<T>(std::min(a.lower(), b.lower()),
+                     std::max(a.upper(), b.upper()));
+}
+
+// ─── Comparisons ─────────────────────────────────────────────────
+// Indicator enclosures: [1, 1] if the relation holds for every pair of
+// points, [0, 0] if for none, [0, 1] otherwise.
+
+template <typename T>
+interval<T> interval_lt(interval<T> const &a, interval<T> const &b) {
+  if (a.upper() < b.lower())
+    return interval<T>(1);
+  if (a.lower() >= b.upper())
+    return interval<T>(0);
+  return interval<T>(0, 1);
+}
+
+template <typename T>
+interval<T> interval_le(interval<T> const &a, interval<T> const &b) {
+  if (a.upper() <= b.lower())
+    return interval<T>(1);
+  if (a.lower() > b.upper())
+    return interval<T>(0);
+  return interval<T>(0, 1);
+}
+
+template <typename T>
+interval<T> interval_eq(interval<T> const &a, interval<T> const &b) {
+  if (a.is_point() && a == b)
+    return interval<T>(1);
+  if (a.upper() < b.lower() || b.upper() < a.lower())
+    return interval<T>(0);
+  return interval<T>(0, 1);
+}
+
+// ─── Elementary functions (found by ADL) ────────────────────────
+
+template <typename T> interval<T> abs(interval<T> const &x) {
+  if (x.lower() >= 0)
+    return x;
+  if (x.upper() <= 0)
+    return -x;
+  return interval<T>(0, std::max(-x.lower(), x.upper()));
+}
+
+template <typename T> interval<T> sign(interval<T> const &x) {
+  auto sgn = [](T v) { return T((v > 0) - (v < 0)); };
+  return interval<T>(sgn(x.lower()), sgn(x.upper()));
+}
+
+template <typename T>
+interval<T> min(interval<T> const &a, interval<T> const &b) {
+  return interval<T>(std::min(a.lower(), b.lower()),
+                     std::min(a.upper(), b.upper()));
+}
+
+template <typename T>
+interval<T> max(interval<T> const &a, interval<T> const &b) {
+  return interval<T>(std::max(a.lower(), b.lower()),
+                     std::max(a.upper(), b.upper()));
+}
+
+template <typename T> interval<T> sqrt(interval<T> const &x) {
+  if (x.lower() < 0)
+    detail::domain_error("sqrt", x, "reaches below zero");
+  auto bound = [](T v) {
+    T const r = std::sqrt(v);
+    return detail::bracket(r, std::fma(-r, r, v));
+  };
+  return interval<T>(bound(x.lower()).first, bound(x.upper()).second);
+}
+
+template <typename T> interval<T> exp(interval<T> const &x) {
+  auto result = detail::widen(std::exp(x.lower()), std::exp(x.upper()));
+  return interval<T>(std::max(result.lower(), T(0)), result.upper());
+}
+
+template <typename T> interval<T> log(interval<T> const &x) {
+  if (x.lower() <= 0)
+    detail::domain_error("log", x, "is not positive");
+  return detail::widen(std::log(x.lower()), std::log(x.upper()));
+}
+
+template <typename T> interval<T> sin(interval<T> const &x) {
+  constexpr T half_pi = std::numbers::pi_v<T> / 2;
+  return detail::periodic_range(x, half_pi, -half_pi, std::sin(x.lower()),
+                                std::sin(x.upper()));
+}
+
+template <typename T> interval<T> cos(interval<T> const &x) {
+  return detail::periodic_range(x, T(0), std::numbers::pi_v<T>,
+                                std::cos(x.lower()), std::cos(x.upper()));
+}
+
+template <typename T> interval<T> tan(interval<T> const &x) {
+  constexpr T pi = std::numbers::pi_v<T>;
+  if (x.width() >= pi || detail::hits_periodic(x, pi / 2, pi))
+    detail::domain_error("tan", x, "contains a pole");
+  return detail::widen(std::tan(x.lower()), std::tan(x.upper()));
+}
+
+template <typename T> interval<T> asin(interval<T> const &x) {
+  if (x.lower() < -1 || x.upper() > 1)
+    detail::domain_error("asin", x, "leaves [-1, 1]");
+  return detail::widen(std::asin(x.lower()), std::asin(x.upper()));
+}
+
+template <typename T> interval<T> acos(interval<T> const &x) {
+  if (x.lower() < -1 || x.upper() > 1)
+    detail::domain_error("acos", x, "leaves [-1, 1]");
+  return detail::widen(std::acos(x.upper()), std::acos(x.lower()));
+}
+
+template <typename T> interval<T> atan(interval<T> const &x) {
+  return detail::widen(std::atan(x.lower()), std::atan(x.upper()));
+}
+
+// Integer point exponents use the sharp power rule (even powers of a range
+// across zero start at 0; negative powers need a zero-free base). Other
+// exponents need a non-negative base; x^y is monotone in each argument
+// there, so the range is spanned by the four corners.
+template <typename T>
+interval<T> pow(interval<T> const &x, interval<T> const &y) {
+  if (y.is_point() && std::trunc(y.lower()) == y.lower() &&
+      std::abs(y.lower()) <= T(1 << 30))
+    return detail::int_pow(x, static_cast<long long>(y.lower()));
+  if (x.lower() < 0)
+    detail::domain_error("pow", x, "reaches below zero (real exponent)");
+  if (x.lower() == 0 && y.lower() <= 0)
+    detail::domain_error("pow", x, "contains zero (non-positive exponent)");
+  auto lower = std::numeric_limits<T>::infinity();
+  auto upper = -std::numeric_limits<T>::infinity();
+  for (auto b : {x.lower(), x.upper()})
+    for (auto e : {y.lower(), y.upper()}) {
+      auto const v = std::pow(b, e);
+      lower = std::min(lower, v);
+      upper = std::max(upper, v);
+    }
+  auto result = detail::widen(lower, upper);
+  return interval<T>(std::max(result.lower(), T(0)), result.upper());
+}
+
+} // namespace numsim::cas
+
+#endif // INTERVAL_H
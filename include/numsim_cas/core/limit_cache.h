@@ -0,0 +1,84 @@
+#ifndef LIMIT_CACHE_H
+#define LIMIT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/core/hash_functions.h>
+#include <numsim_cas/core/limit_result.h>
+
+namespace numsim::cas {
+
+// Memo for the limit visitors, keyed by (node, limit variable, target).
+//
+// Every limit visitor memoizes the nodes it analyses, so a subexpression
+// shared inside one expression (as diff() produces) is analysed once.
+// To reuse results across several queries, pass one cache to several
+// visitors. For example, check a tangent at λ → 0 and then J → ∞:
+//
+//   limit_cache cache;
+//   scalar_limit_visitor at_zero(lambda, {limit_target::point::zero_plus},
+//                                &cache);
+//   scalar_limit_visitor at_inf(J, {limit_target::point::pos_infinity},
+//                               &cache);
+//
+// Identity is by node address. The cache holds a reference to each node
+// and each limit variable, so an address cannot be reused while its
+// entry exists. Expressions are immutable and limits do not depend on
+// assumptions, so entries never go stale. The cache is not thread-safe.
+class limit_cache {
+public:
+  template <typename NodeBase, typename VarBase>
+  [[nodiscard]] limit_result const *
+  find(expression_holder<NodeBase> const &node,
+       expression_holder<VarBase> const &var, limit_target target) const {
+    auto it = m_entries.find(key{node.data().get(), var.data().get(),
+                                 target.target});
+    return it == m_entries.end() ? nullptr : &it->second.result;
+  }
+
+  template <typename NodeBase, typename VarBase>
+  void insert(expression_holder<NodeBase> const &node,
+              expression_holder<VarBase> const &var, limit_target target,
+              limit_result result) {
+    m_entries.insert_or_assign(
+        key{node.data().get(), var.data().get(), target.target},
+        entry{result, node.data(), var.data()});
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+  void clear() noexcept { m_entries.clear(); }
+
+private:
+  struct key {
+    void const *node;
+    void const *var;
+    limit_target::point target;
+    bool operator==(key const &) const = default;
+  };
+
+  struct key_hash {
+    std::size_t operator()(key const &k) const noexcept {
+      std::size_t seed{0};
+      hash_combine(seed, reinterpret_cast<std::uintptr_t>(k.node));
+      hash_combine(seed, reinterpret_cast<std::uintptr_t>(k.var));
+      hash_combine(seed, k.target);
+      return seed;
+    }
+  };
+
+  struct entry {
+    limit_result result;
+    std::shared_ptr<void const> node;
+    std::shared_ptr<void const> var;
+  };
+
+  std::unordered_map<key, entry, key_hash> m_entries;
+};
+
+} // namespace numsim::cas
+
+#endif // LIMIT_CACHE_H
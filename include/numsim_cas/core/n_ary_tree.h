@@ -5,9 +5,11 @@
 #include <numsim_cas/core/cas_error.h>
 #include <numsim_cas/core/expression_holder.h>
 #include <numsim_cas/core/hash_functions.h>
+#include <numsim_cas/core/profiling.h>
 #include <numsim_cas/numsim_cas_forward.h>
 #include <numsim_cas/numsim_cas_type_traits.h>
 #include <ranges>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -35,6 +37,74 @@ bool nary_coeff_less(Holder const &lhs, Holder const &rhs) {
   return lhs < rhs;
 }
 
+// Child set of an n_ary_tree: expr_flat_set plus an order-independent hash
+// of the children that every insert and erase keeps current, so the owning
+// node rehashes in O(1) instead of collecting and sorting all child hashes.
+template <typename ExprHolder>
+class n_ary_child_map : public expr_flat_set<ExprHolder> {
+  using base_set = expr_flat_set<ExprHolder>;
+
+public:
+  using typename base_set::const_iterator;
+  using typename base_set::iterator;
+  using typename base_set::size_type;
+  using typename base_set::value_type;
+
+  template <typename K> std::pair<const_iterator, bool> insert(K &&child) {
+    auto result = base_set::insert(std::forward<K>(child));
+    if (result.second)
+      m_children_hash.insert(result.first->get().hash_value());
+    return result;
+  }
+
+  // One sort for the whole range; the hash is rebuilt from scratch.
+  template <std::input_iterator It> size_type insert(It first, It last) {
+    auto const inserted{base_set::insert(first, last)};
+    m_children_hash.clear();
+    for (auto const &child : *this)
+      m_children_hash.insert(child.get().hash_value());
+    return inserted;
+  }
+
+  const_iterator erase(const_iterator pos) {
+    m_children_hash.erase(pos->get().hash_value());
+    return base_set::erase(pos);
+  }
+  const_iterator erase(const_iterator first, const_iterator last) {
+    for (auto it = first; it != last; ++it)
+      m_children_hash.erase(it->get().hash_value());
+    return base_set::erase(first, last);
+  }
+
+  template <typename K>
+  requires(!std::is_convertible_v<K const &, const_iterator>)
+  size_type erase(K const &child) {
+    auto it = this->find(child);
+    if (it == this->end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+
+  void clear() noexcept {
+    base_set::clear();
+    m_children_hash.clear();
+  }
+
+  void swap(n_ary_child_map &other) noexcept(
+      noexcept(std::declval<base_set &>().swap(std::declval<base_set &>()))) {
+    base_set::swap(other);
+    std::swap(m_children_hash, other.m_children_hash);
+  }
+
+  [[nodiscard]] commutative_hash const &children_hash() const noexcept {
+    return m_children_hash;
+  }
+
+private:
+  commutative_hash m_children_hash;
+};
+
 } // namespace detail
 
 template <typename Base> class n_ary_tree : public Base {
@@ -43,9 +113,10 @@ public:
   using expr_t = typename Base::expr_t;
   using hash_t = typename expr_t::hash_type;
   using expr_holder_t = expression_holder<expr_t>;
-  using iterator = typename expr_ordered_map<expr_t>::iterator;
-  using const_iterator =
-      typename expr_ordered_map<expr_holder_t>::const_iterator;
+  using map_t = detail::n_ary_child_map<expr_holder_t>;
+  using iterator = typename map_t::iterator;
+  using const_iterator = typename map_t::const_iterator;
+  static constexpr std::uint8_t static_node_flags{node_flags::scaled};
 
   n_ary_tree() noexcept { this->reserve(2); }
 
@@ -76,9 +147,30 @@ public:
     insert_hash(std::move(expr));
   }
 
+  // Bulk push_back for callers that build a large sum or product at once:
+  // the child map is sorted once instead of shifting on every insert. As
+  // with push_back, like terms are not combined and the children must be
+  // distinct; a duplicate throws internal_error after the distinct
+  // children have been inserted.
+  template <std::ranges::input_range R> void append(R &&children) {
+    std::vector<expr_holder_t> entries;
+    if constexpr (std::ranges::sized_range<R>)
+      entries.reserve(std::ranges::size(children));
+    for (auto &&child : children)
+      entries.emplace_back(child);
+    auto const inserted{m_symbol_map.insert(entries.begin(), entries.end())};
+    invalidate_hash();
+    if (inserted != entries.size())
+      throw internal_error("n_ary_tree::append: duplicate child insertion");
+  }
+
   // Copies carry the source's cached hash; any mutation must drop it or
   // == fast-rejects on the stale value and cancellation silently fails.
-  inline void invalidate_hash() noexcept { this->m_hash_value = 0; }
+  // The free-symbol cache goes with it.
+  inline void invalidate_hash() noexcept {
+    this->m_hash_value = 0;
+    this->invalidate_free_symbols();
+  }
 
   // Insert `entry`, combining with any colliding map entry first.
   // After combination, `+` may algebraically simplify to an expression with a
@@ -93,10 +185,12 @@ public:
   // that catches the exception and continues using the tree.
   inline void merge_or_insert(expression_holder<expr_t> entry) {
     while (true) {
+      NUMSIM_CAS_PROFILE_ATTEMPT("n_ary_tree::merge_or_insert");
       auto it = find_like(entry);
       if (it == m_symbol_map.end())
         break;
-      auto combined = it->second + entry;
+      NUMSIM_CAS_PROFILE_HIT("n_ary_tree::merge_or_insert");
+      auto combined = *it + entry;
       m_symbol_map.erase(it);
       entry = std::move(combined);
     }
@@ -108,10 +202,12 @@ public:
   // mul factor maps have no coefficient-bearing like terms.
   inline void merge_or_insert_mul(expression_holder<expr_t> entry) {
     while (true) {
+      NUMSIM_CAS_PROFILE_ATTEMPT("n_ary_tree::merge_or_insert_mul");
       auto it = m_symbol_map.find(entry);
       if (it == m_symbol_map.end())
         break;
-      auto combined = it->second * entry;
+      NUMSIM_CAS_PROFILE_HIT("n_ary_tree::merge_or_insert_mul");
+      auto combined = *it * entry;
       m_symbol_map.erase(it);
       entry = std::move(combined);
     }
@@ -121,32 +217,42 @@ public:
   // Find an entry that combines with `entry` under + (exact or like term).
   // Like terms share the coefficient-blind hash, so only the equal-hash run
   // around lower_bound needs scanning.
-  [[nodiscard]] auto find_like(expression_holder<expr_t> const &entry) {
-    auto cit = std::as_const(*this).find_like(entry);
-    return m_symbol_map.erase(cit, cit); // no-op const_iterator -> iterator
-  }
-
   [[nodiscard]] auto find_like(expression_holder<expr_t> const &entry) const {
+    // Profiling: one attempt per call, one hit per match; the scanned
+    // candidates are counted separately under find_like.compare.
+    NUMSIM_CAS_PROFILE_ATTEMPT("n_ary_tree::find_like");
     const auto h = entry.get().hash_value();
     const auto pos = m_symbol_map.lower_bound(entry);
     for (auto it = pos;
-         it != m_symbol_map.end() && it->second.get().hash_value() == h; ++it) {
-      if (is_like(it->second, entry))
+         it != m_symbol_map.end() && it->get().hash_value() == h; ++it) {
+      NUMSIM_CAS_PROFILE_ATTEMPT("n_ary_tree::find_like.compare");
+      if (is_like(*it, entry)) {
+        NUMSIM_CAS_PROFILE_HIT("n_ary_tree::find_like");
         return it;
+      }
     }
     for (auto it = pos; it != m_symbol_map.begin();) {
       --it;
-      if (it->second.get().hash_value() != h)
+      if (it->get().hash_value() != h)
         break;
-      if (is_like(it->second, entry))
+      NUMSIM_CAS_PROFILE_ATTEMPT("n_ary_tree::find_like.compare");
+      if (is_like(*it, entry)) {
+        NUMSIM_CAS_PROFILE_HIT("n_ary_tree::find_like");
         return it;
+      }
     }
     return m_symbol_map.end();
   }
 
   [[nodiscard]] static bool is_like(expression_holder<expr_t> const &a,
                                     expression_holder<expr_t> const &b) {
-    return a.get().like_term_of(b.get()) || b.get().like_term_of(a.get());
+    auto const &l{a.get()};
+    auto const &r{b.get()};
+    // Without a scaled node on either side like_term_of is plain equality,
+    // which the header rejects for different types without a virtual call.
+    if (!l.is_scaled() && !r.is_scaled())
+      return l == r;
+    return l.like_term_of(r) || r.like_term_of(l);
   }
 
   // Same children, coefficient may differ; cross-type: c*T (single child)
@@ -163,17 +269,15 @@ public:
       auto it_l = m_symbol_map.begin();
       auto it_r = r.m_symbol_map.begin();
       for (; it_l != m_symbol_map.end(); ++it_l, ++it_r) {
-        if (it_l->second != it_r->second)
+        if (*it_l != *it_r)
           return false;
       }
       return true;
     }
-    return size() == 1 && m_symbol_map.begin()->second.get() == rhs;
+    return size() == 1 && m_symbol_map.begin()->get() == rhs;
   }
 
-  inline void reserve([[maybe_unused]] std::size_t size) noexcept {
-    // m_symbol_map.reserve(size);
-  }
+  inline void reserve(std::size_t size) { m_symbol_map.reserve(size); }
 
   [[nodiscard]] inline auto size() const noexcept {
     return m_symbol_map.size();
@@ -184,16 +288,17 @@ public:
   }
 
   [[nodiscard]] inline auto &symbol_map() noexcept { return m_symbol_map; }
-  [[nodiscard]] inline auto symbol_map_values() noexcept {
-    return m_symbol_map | std::views::values;
-  }
   [[nodiscard]] inline auto symbol_map_values() const noexcept {
-    return m_symbol_map | std::views::values;
+    return std::views::all(m_symbol_map);
   }
 
-  inline auto set_coeff(expr_holder_t const &expr) noexcept { m_coeff = expr; }
+  inline auto set_coeff(expr_holder_t const &expr) noexcept {
+    m_coeff = expr;
+    this->invalidate_free_symbols();
+  }
   inline auto set_coeff(expr_holder_t &&expr) noexcept {
     m_coeff = std::move(expr);
+    this->invalidate_free_symbols();
   }
 
   [[nodiscard]] inline auto const &coeff() const noexcept { return m_coeff; }
@@ -222,55 +327,48 @@ public:
                          n_ary_tree<BaseRHS> const &rhs);
 
 protected:
+  // O(1): the child map keeps the commutative part current on every
+  // insert / erase.
   void update_hash_value() const noexcept override {
     this->m_hash_value = 0;
-
     // otherwise we can not provide the order of the symbols
     hash_combine(this->m_hash_value, base_t::get_id());
+    m_symbol_map.children_hash().combine_into(this->m_hash_value);
+  }
 
-    std::vector<std::size_t> hashes(m_symbol_map.size());
-    std::size_t i = 0;
-    for (const auto &child : m_symbol_map | std::views::values) {
-      hashes[i++] = child->hash_value();
-    }
-
-    // Sort for commutative operations like addition
-    std::sort(hashes.begin(), hashes.end());
-
-    // Combine all child hashes
-    for (auto h : hashes) {
-      hash_combine(this->m_hash_value, h);
-    }
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    symbol_set result;
+    if (m_coeff.is_valid())
+      result |= m_coeff.get().free_symbols();
+    for (auto const &child : m_symbol_map)
+      result |= child.get().free_symbols();
+    return result;
   }
 
   expr_holder_t m_coeff;
   // Derived const &m_derived;
 
 private:
-  // x+y+(4*z)+(4*x*y)
-  //-> {hash_value(x), x}
-  //-> {hash_value(y), y}
-  //-> {hash_value(z), 4z}
-  //-> {hash_value(x*y), 4*x*y}
-  expr_ordered_map<expr_holder_t> m_symbol_map;
+  // x+y+(4*z)+(4*x*y) -> {x, y, 4*z, 4*x*y}
+  // Sorted by expression order (hash first), so like terms sharing a hash
+  // sit next to each other for find_like. Small trees stay allocation-free.
+  map_t m_symbol_map;
 
 private:
   void insert_hash(expression_holder<expr_t> const &expr) {
-    if (m_symbol_map.contains(expr)) {
+    if (!m_symbol_map.insert(expr).second) {
       throw internal_error(
           "n_ary_tree::insert_hash: duplicate child insertion");
     }
     invalidate_hash();
-    m_symbol_map[expr] = expr;
   }
 
   void insert_hash(expression_holder<expr_t> &&expr) {
-    if (m_symbol_map.contains(expr)) {
+    if (!m_symbol_map.insert(std::move(expr)).second) {
       throw internal_error(
           "n_ary_tree::insert_hash: duplicate child insertion");
     }
     invalidate_hash();
-    m_symbol_map[expr] = std::move(expr);
   }
 };
 
@@ -279,7 +377,7 @@ bool operator<(symbol_base<BaseSymbol> const &lhs,
                n_ary_tree<BaseTree> const &rhs) {
   if (rhs.size() == 1) {
     return lhs.hash_value() <
-           rhs.symbol_map().begin()->second.get().hash_value();
+           rhs.symbol_map().begin()->get().hash_value();
   }
   return lhs.hash_value() < rhs.hash_value();
 }
@@ -288,7 +386,7 @@ template <typename BaseSymbol, typename BaseTree>
 bool operator<(n_ary_tree<BaseTree> const &lhs,
                symbol_base<BaseSymbol> const &rhs) {
   if (lhs.size() == 1) {
-    return lhs.symbol_map().begin()->second.get().hash_value() <
+    return lhs.symbol_map().begin()->get().hash_value() <
            rhs.hash_value();
   }
   return lhs.hash_value() < rhs.hash_value();
@@ -303,9 +401,9 @@ bool operator<(n_ary_tree<BaseLHS> const &lhs, n_ary_tree<BaseRHS> const &rhs) {
   auto lit = lhs.symbol_map().begin();
   auto rit = rhs.symbol_map().begin();
   for (; lit != lhs.symbol_map().end(); ++lit, ++rit) {
-    if (lit->second < rit->second)
+    if (*lit < *rit)
       return true;
-    if (rit->second < lit->second)
+    if (*rit < *lit)
       return false;
   }
   return detail::nary_coeff_less(lhs.coeff(), rhs.coeff());
@@ -330,7 +428,7 @@ bool operator==(n_ary_tree<BaseLHS> const &lhs,
   auto it_l = lhs.symbol_map().begin();
   auto it_r = rhs.symbol_map().begin();
   for (; it_l != lhs.symbol_map().end(); ++it_l, ++it_r) {
-    if (it_l->second != it_r->second)
+    if (*it_l != *it_r)
       return false;
   }
   return true;
@@ -58,7 +58,10 @@ public:
 
   [[nodiscard]] inline auto &data() noexcept { return m_data; }
 
-  inline auto set_coeff(expr_holder_t const &expr) noexcept { m_coeff = expr; }
+  inline auto set_coeff(expr_holder_t const &expr) noexcept {
+    m_coeff = expr;
+    this->invalidate_free_symbols();
+  }
 
   [[nodiscard]] inline auto const &coeff() const noexcept { return m_coeff; }
   [[nodiscard]] inline auto &coeff() noexcept { return m_coeff; }
@@ -97,6 +100,15 @@ protected:
     }
   }
 
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    symbol_set result;
+    if (m_coeff.is_valid())
+      result |= m_coeff.get().free_symbols();
+    for (auto const &child : m_data)
+      result |= child.get().free_symbols();
+    return result;
+  }
+
   expr_holder_t m_coeff;
 
 private:
@@ -106,6 +118,7 @@ private:
   template <typename T> void insert_hash(T const &expr) noexcept {
     m_data.emplace_back(expr);
     update_hash_value();
+    this->invalidate_free_symbols();
   }
 };
 
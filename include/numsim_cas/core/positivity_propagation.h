@@ -14,8 +14,8 @@
 // simplifier moves the operand (it reuses refcount-1 temporaries, so the
 // holder may be moved-from by the time `result` exists). It also inserts
 // real_tag whenever the operand is real-by-implication (integer/rational/
-// irrational or a numeric constant), so rules only check real_tag. Cost:
-// one small set copy per op — see #310 for removing the eager path.
+// irrational or a numeric constant), so rules only check real_tag. The
+// manager is a bitset, so the snapshot is a word copy with no allocation.
 //
 // Aliasing: `result` may alias an operand (folds like `x*1 → x` return
 // the operand's holder). Rules must therefore only assert tags already
@@ -56,10 +56,7 @@ inline void mark_positive(expression_holder<Expr> const &e) {
   auto &a = e.data()->assumptions();
   NUMSIM_CAS_POSITIVITY_ASSERT_NO_CONTRADICTION(a, numsim::cas::negative{});
   NUMSIM_CAS_POSITIVITY_ASSERT_NO_CONTRADICTION(a, numsim::cas::nonpositive{});
-  a.insert(numsim::cas::positive{});
-  a.insert(numsim::cas::nonnegative{});
-  a.insert(numsim::cas::nonzero{});
-  a.insert(numsim::cas::real_tag{});
+  a.insert_implied(numsim::cas::positive{});
   a.set_inferred();
 }
 
@@ -68,10 +65,7 @@ inline void mark_negative(expression_holder<Expr> const &e) {
   auto &a = e.data()->assumptions();
   NUMSIM_CAS_POSITIVITY_ASSERT_NO_CONTRADICTION(a, numsim::cas::positive{});
   NUMSIM_CAS_POSITIVITY_ASSERT_NO_CONTRADICTION(a, numsim::cas::nonnegative{});
-  a.insert(numsim::cas::negative{});
-  a.insert(numsim::cas::nonpositive{});
-  a.insert(numsim::cas::nonzero{});
-  a.insert(numsim::cas::real_tag{});
+  a.insert_implied(numsim::cas::negative{});
   a.set_inferred();
 }
 
@@ -79,8 +73,7 @@ template <typename Expr>
 inline void mark_nonnegative(expression_holder<Expr> const &e) {
   auto &a = e.data()->assumptions();
   NUMSIM_CAS_POSITIVITY_ASSERT_NO_CONTRADICTION(a, numsim::cas::negative{});
-  a.insert(numsim::cas::nonnegative{});
-  a.insert(numsim::cas::real_tag{});
+  a.insert_implied(numsim::cas::nonnegative{});
   a.set_inferred();
 }
 
@@ -88,8 +81,7 @@ template <typename Expr>
 inline void mark_nonpositive(expression_holder<Expr> const &e) {
   auto &a = e.data()->assumptions();
   NUMSIM_CAS_POSITIVITY_ASSERT_NO_CONTRADICTION(a, numsim::cas::positive{});
-  a.insert(numsim::cas::nonpositive{});
-  a.insert(numsim::cas::real_tag{});
+  a.insert_implied(numsim::cas::nonpositive{});
   a.set_inferred();
 }
 
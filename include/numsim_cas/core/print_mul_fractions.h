@@ -4,6 +4,8 @@
 #include <numsim_cas/basic_functions.h>
 #include <numsim_cas/core/domain_traits.h>
 #include <numsim_cas/core/scalar_number.h>
+#include <algorithm>
+#include <functional>
 #include <utility>
 #include <vector>
 
@@ -14,9 +16,9 @@ template <typename ExprHolder> struct fraction_entry {
   scalar_number pos_exponent;
 };
 
-template <typename Traits, typename HashMap>
+template <typename Traits, typename Children>
 requires basic_expression_domain<typename Traits::expression_type>
-auto partition_mul_fractions(HashMap const &hash_map)
+auto partition_mul_fractions(Children const &children)
     -> std::pair<std::vector<typename Traits::expr_holder_t>,
                  std::vector<fraction_entry<typename Traits::expr_holder_t>>> {
   using expr_holder_t = typename Traits::expr_holder_t;
@@ -25,7 +27,7 @@ auto partition_mul_fractions(HashMap const &hash_map)
   std::vector<expr_holder_t> numerator;
   std::vector<fraction_entry<expr_holder_t>> denominator;
 
-  for (auto const &[key, child] : hash_map) {
+  for (auto const &child : children) {
     if (auto pow_expr = is_same_r<pow_type>(child)) {
       auto const &exponent = pow_expr->get().expr_rhs();
       // numeric_less, not operator< (which is rank-lexicographic order)
@@ -38,6 +40,11 @@ auto partition_mul_fractions(HashMap const &hash_map)
     numerator.push_back(child);
   }
 
+  // Child order is by the pow nodes; order by base instead so a/(x*y) built as
+  // (a/x)/y prints its denominator like the product x*y does.
+  std::ranges::stable_sort(denominator, std::less<>{},
+                           &fraction_entry<expr_holder_t>::base);
+
   return {std::move(numerator), std::move(denominator)};
 }
 
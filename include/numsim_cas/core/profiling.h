@@ -0,0 +1,197 @@
+#ifndef PROFILING_H
+#define PROFILING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Optional simplifier instrumentation.
+//
+// Built only when the library is configured with
+// -DNUMSIM_CAS_ENABLE_PROFILING=ON, which defines NUMSIM_CAS_PROFILING for
+// the library and every consumer (the macros below sit in headers, so both
+// sides must agree). Without it every NUMSIM_CAS_PROFILE_* macro expands to
+// nothing and the hot paths are unchanged.
+//
+// Three kinds of counters are collected:
+//   rules       attempts / hits per named rewrite rule or scan
+//   dispatch    calls and inclusive wall time per simplifier dispatch class
+//   allocations make_expression<T> calls per node type
+//
+// The registry itself (report/reset/snapshot) is always compiled so tools can
+// call it unconditionally; it just stays empty in a non-profiling build.
+
+namespace numsim::cas::profiling {
+
+struct rule_counter {
+  std::atomic<std::uint64_t> attempts{0};
+  std::atomic<std::uint64_t> hits{0};
+};
+
+struct dispatch_counter {
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> nanoseconds{0};
+};
+
+struct allocation_counter {
+  std::atomic<std::uint64_t> count{0};
+};
+
+// Counters have stable addresses for the lifetime of the program; call sites
+// cache the reference in a function-local static.
+[[nodiscard]] rule_counter &rule(std::string_view name);
+[[nodiscard]] dispatch_counter &dispatch(std::string_view name);
+[[nodiscard]] allocation_counter &allocation(std::string_view type_name);
+
+struct rule_entry {
+  std::string name;
+  std::uint64_t attempts;
+  std::uint64_t hits;
+};
+
+struct dispatch_entry {
+  std::string name;
+  std::uint64_t calls;
+  std::uint64_t nanoseconds;
+};
+
+struct allocation_entry {
+  std::string type_name;
+  std::uint64_t count;
+};
+
+// Point-in-time copy of all counters, each list sorted by name. Entries that
+// were registered but never incremented since the last reset() are kept.
+struct snapshot_t {
+  std::vector<rule_entry> rules;
+  std::vector<dispatch_entry> dispatches;
+  std::vector<allocation_entry> allocations;
+};
+
+[[nodiscard]] snapshot_t snapshot();
+
+// Zero every counter (registrations survive so cached references stay valid).
+void reset();
+
+enum class report_format { table, json };
+
+// Human-readable table (rules sorted by attempts, dispatch classes by time,
+// allocations by count) or a JSON object with "rules", "dispatch" and
+// "allocations" arrays.
+[[nodiscard]] std::string report(report_format format = report_format::table);
+
+// True when the instrumentation macros are compiled in.
+[[nodiscard]] constexpr bool enabled() noexcept {
+#ifdef NUMSIM_CAS_PROFILING
+  return true;
+#else
+  return false;
+#endif
+}
+
+// RAII timer accumulating into a dispatch counter.
+class scope_timer {
+public:
+  explicit scope_timer(dispatch_counter &counter) noexcept
+      : m_counter(counter), m_start(std::chrono::steady_clock::now()) {}
+
+  scope_timer(scope_timer const &) = delete;
+  scope_timer &operator=(scope_timer const &) = delete;
+
+  ~scope_timer() {
+    auto const elapsed = std::chrono::steady_clock::now() - m_start;
+    m_counter.calls.fetch_add(1, std::memory_order_relaxed);
+    m_counter.nanoseconds.fetch_add(
+        static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count()),
+        std::memory_order_relaxed);
+  }
+
+private:
+  dispatch_counter &m_counter;
+  std::chrono::steady_clock::time_point m_start;
+};
+
+namespace detail {
+// Unqualified type name extracted from the compiler's function signature,
+// e.g. "scalar_add" for numsim::cas::scalar_add. Falls back to the full
+// signature on compilers with an unknown format.
+template <typename T> [[nodiscard]] std::string_view type_name() noexcept {
+  std::string_view sig = std::source_location::current().function_name();
+  auto const first = sig.find("T = ");
+  if (first == std::string_view::npos)
+    return sig;
+  sig.remove_prefix(first + 4);
+  sig = sig.substr(0, sig.find_first_of(";]"));
+  constexpr std::string_view ns{"numsim::cas::"};
+  if (sig.starts_with(ns))
+    sig.remove_prefix(ns.size());
+  return sig;
+}
+} // namespace detail
+
+} // namespace numsim::cas::profiling
+
+#ifdef NUMSIM_CAS_PROFILING
+
+#define NUMSIM_CAS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define NUMSIM_CAS_PROFILE_CONCAT(a, b) NUMSIM_CAS_PROFILE_CONCAT_IMPL(a, b)
+
+// Count one attempt of `name` (a string literal).
+#define NUMSIM_CAS_PROFILE_ATTEMPT(name)                                       \
+  do {                                                                         \
+    static auto &numsim_cas_profile_counter_ =                                 \
+        ::numsim::cas::profiling::rule(name);                                  \
+    numsim_cas_profile_counter_.attempts.fetch_add(                            \
+        1, std::memory_order_relaxed);                                         \
+  } while (false)
+
+// Count one successful application of `name`.
+#define NUMSIM_CAS_PROFILE_HIT(name)                                           \
+  do {                                                                         \
+    static auto &numsim_cas_profile_counter_ =                                 \
+        ::numsim::cas::profiling::rule(name);                                  \
+    numsim_cas_profile_counter_.hits.fetch_add(1, std::memory_order_relaxed);  \
+  } while (false)
+
+// Time the rest of the enclosing scope under dispatch class `name`.
+#define NUMSIM_CAS_PROFILE_SCOPE(name)                                         \
+  static auto &NUMSIM_CAS_PROFILE_CONCAT(numsim_cas_profile_dispatch_,         \
+                                         __LINE__) =                           \
+      ::numsim::cas::profiling::dispatch(name);                                \
+  ::numsim::cas::profiling::scope_timer NUMSIM_CAS_PROFILE_CONCAT(             \
+      numsim_cas_profile_timer_, __LINE__) {                                   \
+    NUMSIM_CAS_PROFILE_CONCAT(numsim_cas_profile_dispatch_, __LINE__)          \
+  }
+
+// Count one node allocation of type `T`.
+#define NUMSIM_CAS_PROFILE_ALLOC(T)                                            \
+  do {                                                                         \
+    static auto &numsim_cas_profile_counter_ =                                 \
+        ::numsim::cas::profiling::allocation(                                  \
+            ::numsim::cas::profiling::detail::type_name<T>());                 \
+    numsim_cas_profile_counter_.count.fetch_add(1,                             \
+                                                std::memory_order_relaxed);    \
+  } while (false)
+
+#else
+
+#define NUMSIM_CAS_PROFILE_ATTEMPT(name)                                       \
+  do {                                                                         \
+  } while (false)
+#define NUMSIM_CAS_PROFILE_HIT(name)                                           \
+  do {                                                                         \
+  } while (false)
+#define NUMSIM_CAS_PROFILE_SCOPE(name) static_assert(true)
+#define NUMSIM_CAS_PROFILE_ALLOC(T)                                            \
+  do {                                                                         \
+  } while (false)
+
+#endif // NUMSIM_CAS_PROFILING
+
+#endif // PROFILING_H
@@ -3,6 +3,7 @@
 
 #include <numsim_cas/basic_functions.h>
 #include <numsim_cas/core/domain_traits.h>
+#include <numsim_cas/core/profiling.h>
 #include <numsim_cas/core/scalar_number.h>
 #include <numsim_cas/core/simplifier/simplifier_common.h>
 #include <numsim_cas/functions.h>
@@ -77,7 +78,15 @@ public:
     }
   }
 
+  // The node header answers for numbers and symbols; only the remaining
+  // kinds (negations, wrappers) need the try_numeric walk.
   static bool is_numeric_expr(expr_holder_t const &expr) {
+    if (!expr.is_valid())
+      return false;
+    if (expr.get().is_number())
+      return true;
+    if (expr.get().is_symbol())
+      return false;
     return Traits::try_numeric(expr).has_value();
   }
 
@@ -93,6 +102,7 @@ public:
       const bool b_mul{is_same<mul_type>(b)};
       if (!a_mul && !b_mul)
         return expr_holder_t{};
+      NUMSIM_CAS_PROFILE_ATTEMPT("add_dispatch::try_merge_like");
       auto coeff_or_one = [](mul_type const &m) {
         return m.coeff().is_valid() ? m.coeff()
                                     : Traits::make_constant(scalar_number{1});
@@ -102,12 +112,14 @@ public:
         auto const &bm{b.template get<mul_type>()};
         if (!am.like_term_of(bm))
           return expr_holder_t{};
+        NUMSIM_CAS_PROFILE_HIT("add_dispatch::try_merge_like");
         return scaled_copy(am, coeff_or_one(am) + coeff_or_one(bm));
       }
       auto const &m{(a_mul ? a : b).template get<mul_type>()};
       auto const &other{a_mul ? b : a};
-      if (!(m.size() == 1 && m.symbol_map().begin()->second == other))
+      if (!(m.size() == 1 && *m.symbol_map().begin() == other))
         return expr_holder_t{};
+      NUMSIM_CAS_PROFILE_HIT("add_dispatch::try_merge_like");
       return scaled_copy(m, coeff_or_one(m) +
                                 Traits::make_constant(scalar_number{1}));
     }
@@ -124,7 +136,7 @@ public:
     if (val && *val == scalar_number{1}) {
       mul.coeff().free();
       if (mul.size() == 1)
-        return mul.symbol_map().begin()->second;
+        return *mul.symbol_map().begin();
       return expr;
     }
     mul.set_coeff(std::move(coeff));
@@ -334,7 +346,7 @@ public:
       return add.coeff().is_valid() ? add.coeff() : Traits::zero();
     }
     if (add.size() == 1 && !add.coeff().is_valid()) {
-      return add.symbol_map().begin()->second;
+      return *add.symbol_map().begin();
     }
     return expr_add;
   }
@@ -353,7 +365,7 @@ public:
         // stored bare x vs incoming c*x: probe the bare child (review #339)
         auto const &rm{base::m_rhs.template get<mul_type>()};
         if (rm.size() == 1) {
-          pos = add.find_like(rm.symbol_map().begin()->second);
+          pos = add.find_like(*rm.symbol_map().begin());
         }
       } else {
         // stored c*x vs incoming bare x: retry with a bare mul{x}
@@ -367,12 +379,12 @@ public:
       // exact -x cancels — like-terms of -x would nest adds (round-7)
       auto neg_probe{-base::m_rhs};
       pos = add.find_like(neg_probe);
-      if (pos != add.symbol_map().end() && !(pos->second == neg_probe)) {
+      if (pos != add.symbol_map().end() && !(*pos == neg_probe)) {
         pos = add.symbol_map().end();
       }
     }
     if (pos != add.symbol_map().end()) {
-      auto expr{pos->second + base::m_rhs};
+      auto expr{*pos + base::m_rhs};
       add.symbol_map().erase(pos);
       return merge_and_finish(std::move(expr_add), add, std::move(expr));
     }
@@ -395,7 +407,7 @@ public:
   expr_holder_t dispatch(typename Traits::negative_type const &rhs) {
     // map keys compare by hash; confirm deep equality before cancelling
     const auto pos{lhs.symbol_map().find(rhs.expr())};
-    if (pos != lhs.symbol_map().end() && pos->second == rhs.expr()) {
+    if (pos != lhs.symbol_map().end() && *pos == rhs.expr()) {
       auto expr{make_expression<typename Traits::add_type>(lhs)};
       auto &add{expr.template get<typename Traits::add_type>()};
       add.symbol_map().erase(rhs.expr());
@@ -404,7 +416,7 @@ public:
         return add.coeff().is_valid() ? add.coeff() : Traits::zero();
       }
       if (add.size() == 1 && !add.coeff().is_valid()) {
-        return add.symbol_map().begin()->second;
+        return *add.symbol_map().begin();
       }
       return expr;
     }
@@ -459,7 +471,7 @@ public:
   requires(!std::is_void_v<SymbolType>)
   expr_holder_t dispatch(SymbolType const &) {
     // deep single-child check: a map find would alias child x+2 against x
-    if (lhs.size() == 1 && lhs.symbol_map().begin()->second == base::m_rhs) {
+    if (lhs.size() == 1 && *lhs.symbol_map().begin() == base::m_rhs) {
       return base::scaled_copy(
           lhs, Traits::make_constant(get_coefficient<Traits>(lhs, 1) + 1));
     }
@@ -514,7 +526,7 @@ public:
   // x + c*x --> (c+1)*x
   expr_holder_t dispatch(typename Traits::mul_type const &rhs) {
     // deep single-child check: a map find would alias child x+2 against x
-    if (rhs.size() == 1 && rhs.symbol_map().begin()->second == base::m_lhs) {
+    if (rhs.size() == 1 && *rhs.symbol_map().begin() == base::m_lhs) {
       return base::scaled_copy(
           rhs, Traits::make_constant(get_coefficient<Traits>(rhs, 1) + 1));
     }
@@ -40,7 +40,7 @@ finalize_add(expression_holder<typename Traits::expression_type> expr) {
     return add.coeff().is_valid() ? add.coeff() : Traits::zero();
   }
   if (add.symbol_map().size() == 1 && !add.coeff().is_valid()) {
-    return add.symbol_map().begin()->second;
+    return *add.symbol_map().begin();
   }
   return expr;
 }
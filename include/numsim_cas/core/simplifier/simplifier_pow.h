@@ -154,7 +154,7 @@ public:
       // single remaining child: pow(mul{y}, n) is non-canonical and never
       // cancels against pow(y, n) (round-2 review on #345)
       if (mul.symbol_map().size() == 1 && !mul.coeff().is_valid()) {
-        return pow(mul.symbol_map().begin()->second, this->m_rhs) * result;
+        return pow(*mul.symbol_map().begin(), this->m_rhs) * result;
       }
       return pow(mul_expr, this->m_rhs) * result;
     }
@@ -191,7 +191,7 @@ public:
       // single remaining child: pow(mul{y}, n) is non-canonical and never
       // cancels against pow(y, n) (round-2 review on #345)
       if (mul.symbol_map().size() == 1 && !mul.coeff().is_valid()) {
-        return pow(mul.symbol_map().begin()->second, this->m_rhs) * result;
+        return pow(*mul.symbol_map().begin(), this->m_rhs) * result;
       }
       return pow(mul_expr, this->m_rhs) * result;
     }
@@ -174,7 +174,7 @@ public:
     } else {
       add.set_coeff(base::m_lhs);
     }
-    for (auto &child : rhs.symbol_map() | std::views::values) {
+    for (auto &child : rhs.symbol_map()) {
       insert_signed<Traits>(add, -child);
     }
     return finalize_add<Traits>(std::move(add_expr));
@@ -264,11 +264,11 @@ public:
       add.set_coeff(-rhs.coeff());
     }
     std::set<expr_holder_t> used_expr;
-    for (auto &child : lhs.symbol_map() | std::views::values) {
+    for (auto &child : lhs.symbol_map()) {
       auto pos{rhs.symbol_map().find(child)};
       if (pos != rhs.symbol_map().end()) {
-        used_expr.insert(pos->second);
-        auto combined = child - pos->second;
+        used_expr.insert(*pos);
+        auto combined = child - *pos;
         if (!is_same<typename Traits::zero_type>(combined))
           insert_signed<Traits>(add, std::move(combined));
       } else {
@@ -276,7 +276,7 @@ public:
       }
     }
     if (used_expr.size() != rhs.size()) {
-      for (auto &child : rhs.symbol_map() | std::views::values) {
+      for (auto &child : rhs.symbol_map()) {
         if (!used_expr.count(child)) {
           insert_signed<Traits>(add, -child);
         }
@@ -298,7 +298,7 @@ public:
     auto &add{expr_add.template get<typename Traits::add_type>()};
     auto pos{add.symbol_map().find(base::m_rhs)};
     if (pos != add.symbol_map().end()) {
-      auto combined{pos->second - base::m_rhs};
+      auto combined{*pos - base::m_rhs};
       add.symbol_map().erase(pos);
       if (!is_same<typename Traits::zero_type>(combined))
         insert_signed<Traits>(add, std::move(combined));
@@ -339,7 +339,7 @@ public:
   expr_holder_t dispatch(SymbolType const &) {
     if (lhs.symbol_map().size() == 1) {
       // deep-compare: a map find would alias e.g. child x+2 against x
-      if (lhs.symbol_map().begin()->second == base::m_rhs) {
+      if (*lhs.symbol_map().begin() == base::m_rhs) {
         // an invalid mul coefficient means 1, not 0 (round-2 review:
         // ((x*y)*pow(x,-1)) - y evaluated to -3 via the 0 default)
         const auto value{get_coefficient<Traits>(lhs, 1) - 1};
@@ -370,7 +370,7 @@ public:
       const auto abs_result{result.abs()};
       const bool is_negative{numeric_less(result, scalar_number{0})};
       if (abs_result == scalar_number{1} && lhs.size() == 1) {
-        auto child = lhs.symbol_map().begin()->second;
+        auto child = *lhs.symbol_map().begin();
         if (is_negative)
           return make_expression<typename Traits::negative_type>(
               std::move(child));
@@ -424,7 +424,7 @@ public:
   expr_holder_t dispatch(typename Traits::mul_type const &rhs) {
     // c*x is a like term of x only when its single child deep-equals x
     // (hash-based checks alias x against x+2 and never match cross-type)
-    if (rhs.size() == 1 && rhs.symbol_map().begin()->second == base::m_lhs) {
+    if (rhs.size() == 1 && *rhs.symbol_map().begin() == base::m_lhs) {
       const auto value{scalar_number{1} - get_coefficient<Traits>(rhs, 1)};
       if (value == scalar_number{0}) {
         return Traits::zero();
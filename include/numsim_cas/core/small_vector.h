@@ -0,0 +1,347 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace numsim::cas {
+
+// Contiguous sequence container with room for N elements inside the object.
+// Behaves like std::vector (random-access pointer iterators, same
+// invalidation rules) but only touches the heap once the size exceeds N.
+// Used where the element count is almost always tiny: n_ary_tree children,
+// tensor index sequences.
+template <typename T, std::size_t N> class small_vector {
+  static_assert(N > 0, "small_vector: inline capacity must be non-zero");
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T &;
+  using const_reference = T const &;
+  using pointer = T *;
+  using const_pointer = T const *;
+  using iterator = T *;
+  using const_iterator = T const *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type inline_capacity = N;
+
+  small_vector() noexcept = default;
+
+  explicit small_vector(size_type count) { resize(count); }
+
+  small_vector(size_type count, T const &value) { assign(count, value); }
+
+  small_vector(std::initializer_list<T> init) {
+    assign(init.begin(), init.end());
+  }
+
+  template <std::input_iterator It> small_vector(It first, It last) {
+    assign(first, last);
+  }
+
+  small_vector(small_vector const &other) {
+    assign(other.begin(), other.end());
+  }
+
+  small_vector(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    steal(std::move(other));
+  }
+
+  ~small_vector() {
+    destroy_all();
+    release();
+  }
+
+  small_vector &operator=(small_vector const &other) {
+    if (this != &other)
+      assign(other.begin(), other.end());
+    return *this;
+  }
+
+  small_vector &operator=(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      destroy_all();
+      release();
+      steal(std::move(other));
+    }
+    return *this;
+  }
+
+  small_vector &operator=(std::initializer_list<T> init) {
+    assign(init.begin(), init.end());
+    return *this;
+  }
+
+  template <std::input_iterator It> void assign(It first, It last) {
+    clear();
+    if constexpr (std::forward_iterator<It>)
+      reserve(static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first)
+      emplace_back(*first);
+  }
+
+  void assign(size_type count, T const &value) {
+    clear();
+    reserve(count);
+    for (size_type i = 0; i < count; ++i)
+      emplace_back(value);
+  }
+
+  // ─── element access ────────────────────────────────────────────────
+
+  [[nodiscard]] reference operator[](size_type i) noexcept {
+    assert(i < m_size);
+    return data()[i];
+  }
+  [[nodiscard]] const_reference operator[](size_type i) const noexcept {
+    assert(i < m_size);
+    return data()[i];
+  }
+
+  [[nodiscard]] reference at(size_type i) {
+    if (i >= m_size)
+      throw std::out_of_range("small_vector::at");
+    return data()[i];
+  }
+  [[nodiscard]] const_reference at(size_type i) const {
+    if (i >= m_size)
+      throw std::out_of_range("small_vector::at");
+    return data()[i];
+  }
+
+  [[nodiscard]] reference front() noexcept { return *begin(); }
+  [[nodiscard]] const_reference front() const noexcept { return *begin(); }
+  [[nodiscard]] reference back() noexcept { return *(end() - 1); }
+  [[nodiscard]] const_reference back() const noexcept { return *(end() - 1); }
+
+  [[nodiscard]] pointer data() noexcept {
+    return m_heap ? m_heap : inline_data();
+  }
+  [[nodiscard]] const_pointer data() const noexcept {
+    return m_heap ? m_heap : inline_data();
+  }
+
+  // ─── iterators ─────────────────────────────────────────────────────
+
+  [[nodiscard]] iterator begin() noexcept { return data(); }
+  [[nodiscard]] const_iterator begin() const noexcept { return data(); }
+  [[nodiscard]] const_iterator cbegin() const noexcept { return data(); }
+  [[nodiscard]] iterator end() noexcept { return data() + m_size; }
+  [[nodiscard]] const_iterator end() const noexcept { return data() + m_size; }
+  [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+  [[nodiscard]] reverse_iterator rbegin() noexcept {
+    return reverse_iterator(end());
+  }
+  [[nodiscard]] const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator(end());
+  }
+  [[nodiscard]] reverse_iterator rend() noexcept {
+    return reverse_iterator(begin());
+  }
+  [[nodiscard]] const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator(begin());
+  }
+
+  // ─── capacity ──────────────────────────────────────────────────────
+
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+  [[nodiscard]] size_type size() const noexcept { return m_size; }
+  [[nodiscard]] size_type capacity() const noexcept { return m_capacity; }
+  [[nodiscard]] bool is_inline() const noexcept { return m_heap == nullptr; }
+
+  void reserve(size_type new_cap) {
+    if (new_cap > m_capacity)
+      reallocate(new_cap);
+  }
+
+  // ─── modifiers ─────────────────────────────────────────────────────
+
+  void clear() noexcept { destroy_all(); }
+
+  template <typename... Args> reference emplace_back(Args &&...args) {
+    if (m_size == m_capacity) {
+      // Construct first: args may alias an element that reallocation moves.
+      T tmp(std::forward<Args>(args)...);
+      reallocate(grow_to(m_size + 1));
+      ::new (static_cast<void *>(data() + m_size)) T(std::move(tmp));
+    } else {
+      ::new (static_cast<void *>(data() + m_size))
+          T(std::forward<Args>(args)...);
+    }
+    return data()[m_size++];
+  }
+
+  void push_back(T const &value) { emplace_back(value); }
+  void push_back(T &&value) { emplace_back(std::move(value)); }
+
+  void pop_back() noexcept {
+    assert(m_size > 0);
+    std::destroy_at(data() + --m_size);
+  }
+
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args &&...args) {
+    auto const idx = static_cast<size_type>(pos - cbegin());
+    assert(idx <= m_size);
+    T tmp(std::forward<Args>(args)...);
+    if (idx == m_size) {
+      emplace_back(std::move(tmp));
+      return begin() + idx;
+    }
+    if (m_size == m_capacity)
+      reallocate(grow_to(m_size + 1));
+    T *d = data();
+    ::new (static_cast<void *>(d + m_size)) T(std::move(d[m_size - 1]));
+    std::move_backward(d + idx, d + m_size - 1, d + m_size);
+    d[idx] = std::move(tmp);
+    ++m_size;
+    return d + idx;
+  }
+
+  iterator insert(const_iterator pos, T const &value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T &&value) {
+    return emplace(pos, std::move(value));
+  }
+
+  template <std::input_iterator It>
+  iterator insert(const_iterator pos, It first, It last) {
+    auto const idx = static_cast<size_type>(pos - cbegin());
+    auto at = idx;
+    for (; first != last; ++first)
+      emplace(cbegin() + at++, *first);
+    return begin() + idx;
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    T *d = data();
+    auto const f = static_cast<size_type>(first - d);
+    auto const l = static_cast<size_type>(last - d);
+    assert(f <= l && l <= m_size);
+    if (f != l) {
+      std::move(d + l, d + m_size, d + f);
+      std::destroy(d + m_size - (l - f), d + m_size);
+      m_size -= l - f;
+    }
+    return d + f;
+  }
+
+  void resize(size_type count) {
+    if (count < m_size) {
+      std::destroy(data() + count, data() + m_size);
+      m_size = count;
+      return;
+    }
+    reserve(count);
+    std::uninitialized_value_construct(data() + m_size, data() + count);
+    m_size = count;
+  }
+
+  void resize(size_type count, T const &value) {
+    if (count < m_size) {
+      std::destroy(data() + count, data() + m_size);
+      m_size = count;
+      return;
+    }
+    reserve(count);
+    std::uninitialized_fill(data() + m_size, data() + count, value);
+    m_size = count;
+  }
+
+  void swap(small_vector &other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    small_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  // ─── comparison ────────────────────────────────────────────────────
+
+  friend bool operator==(small_vector const &lhs, small_vector const &rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend auto operator<=>(small_vector const &lhs, small_vector const &rhs)
+  requires std::three_way_comparable<T>
+  {
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(),
+                                                  rhs.begin(), rhs.end());
+  }
+
+private:
+  [[nodiscard]] T *inline_data() noexcept {
+    return std::launder(reinterpret_cast<T *>(m_inline));
+  }
+  [[nodiscard]] T const *inline_data() const noexcept {
+    return std::launder(reinterpret_cast<T const *>(m_inline));
+  }
+
+  [[nodiscard]] size_type grow_to(size_type min_cap) const noexcept {
+    return std::max(min_cap, m_capacity * 2);
+  }
+
+  void reallocate(size_type new_cap) {
+    T *fresh = std::allocator<T>{}.allocate(new_cap);
+    T *old = data();
+    std::uninitialized_move(old, old + m_size, fresh);
+    std::destroy(old, old + m_size);
+    release();
+    m_heap = fresh;
+    m_capacity = new_cap;
+  }
+
+  void release() noexcept {
+    if (m_heap) {
+      std::allocator<T>{}.deallocate(m_heap, m_capacity);
+      m_heap = nullptr;
+      m_capacity = N;
+    }
+  }
+
+  void destroy_all() noexcept {
+    std::destroy(data(), data() + m_size);
+    m_size = 0;
+  }
+
+  // Precondition: *this holds no elements and no heap buffer.
+  void steal(small_vector &&other) noexcept(
+      std::is_nothrow_move_constructible_v<T>) {
+    if (other.m_heap) {
+      m_heap = std::exchange(other.m_heap, nullptr);
+      m_capacity = std::exchange(other.m_capacity, N);
+      m_size = std::exchange(other.m_size, 0);
+      return;
+    }
+    std::uninitialized_move(other.begin(), other.end(), inline_data());
+    m_size = other.m_size;
+    other.destroy_all();
+  }
+
+  T *m_heap{nullptr};
+  size_type m_size{0};
+  size_type m_capacity{N};
+  alignas(T) std::byte m_inline[N * sizeof(T)];
+};
+
+} // namespace numsim::cas
+
+#endif // SMALL_VECTOR_H
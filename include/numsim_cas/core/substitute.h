@@ -6,6 +6,10 @@
 #include <numsim_cas/core/tag_invoke.h>
 #include <numsim_cas/numsim_cas_forward.h>
 
+namespace numsim::cas {
+class substitution_map; // core/substitution_map.h
+} // namespace numsim::cas
+
 namespace numsim::cas::detail {
 
 struct substitute_fn {
@@ -48,6 +52,21 @@ struct substitute_fn {
     return (*this)(std::type_identity<ExprBase>{},
                    std::type_identity<TargetBase>{}, expr, old_val, new_val);
   }
+
+  // batch call: substitute(expr, subs) applies every pair of a
+  // substitution_map in one traversal (see core/substitution_map.h)
+  template <class ExprBase>
+  auto operator()(expression_holder<ExprBase> const &expr,
+                  substitution_map const &subs) const
+      -> tag_invoke_result_t<substitute_fn, std::type_identity<ExprBase>,
+                             expression_holder<ExprBase> const &,
+                             substitution_map const &>
+  requires tag_invocable<substitute_fn, std::type_identity<ExprBase>,
+                         expression_holder<ExprBase> const &,
+                         substitution_map const &>
+  {
+    return tag_invoke(*this, std::type_identity<ExprBase>{}, expr, subs);
+  }
 };
 
 inline constexpr substitute_fn substitute{};
@@ -0,0 +1,119 @@
+#ifndef SUBSTITUTION_MAP_H
+#define SUBSTITUTION_MAP_H
+
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/core/substitute.h>
+#include <numsim_cas/numsim_cas_forward.h>
+#include <numsim_cas/numsim_cas_type_traits.h>
+
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace numsim::cas {
+
+// A batch of `old -> new` replacements, possibly spanning all three domains,
+// applied by `substitute(expr, subs)` in a single traversal:
+//
+//   substitution_map subs{{E, make_scalar_constant(210000)},
+//                         {nu, make_scalar_constant(0.3)}};
+//   subs.add(X, Y);                     // tensor pairs in the same batch
+//   auto r = substitute(W, subs);
+//
+// The traversal is memoized per node, so a subexpression shared by several
+// parents is rebuilt once. Subtrees that contain none of the targets (decided
+// in O(1) from the cached free-symbol sets) come back as the original node.
+// Replacements are not applied recursively to the inserted values.
+class substitution_map {
+public:
+  using scalar_holder_t = expression_holder<scalar_expression>;
+  using tensor_holder_t = expression_holder<tensor_expression>;
+  using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+
+  substitution_map() = default;
+
+  substitution_map(
+      std::initializer_list<std::pair<scalar_holder_t, scalar_holder_t>> subs);
+
+  substitution_map(
+      std::initializer_list<std::pair<tensor_holder_t, tensor_holder_t>> subs);
+
+  substitution_map(
+      std::initializer_list<std::pair<t2s_holder_t, t2s_holder_t>> subs);
+
+  // Adds or replaces the entry for old_val. Throws invalid_expression_error
+  // on an invalid holder.
+  template <typename ExprBase>
+  substitution_map &add(expression_holder<ExprBase> const &old_val,
+                        expression_holder<ExprBase> const &new_val) {
+    if (!old_val.is_valid() || !new_val.is_valid())
+      throw invalid_expression_error(
+          "substitution_map::add: invalid expression");
+    select<ExprBase>(*this).insert_or_assign(old_val, new_val);
+    m_targets |= old_val.get().free_symbols();
+    m_has_constant_target =
+        m_has_constant_target || old_val.get().free_symbols().empty();
+    return *this;
+  }
+
+  template <typename ExprBase>
+  [[nodiscard]] expr_ordered_map<expression_holder<ExprBase>> const &
+  entries() const noexcept {
+    return select<ExprBase>(*this);
+  }
+
+  [[nodiscard]] bool empty() const noexcept {
+    return m_scalar.empty() && m_tensor.empty() && m_t2s.empty();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    return m_scalar.size() + m_tensor.size() + m_t2s.size();
+  }
+
+  // False only if no target can occur below `expr`. A target without
+  // symbols (a constant) can occur anywhere.
+  [[nodiscard]] bool may_occur_in(expression const &expr) const {
+    if (m_has_constant_target)
+      return true;
+    auto const &symbols = expr.free_symbols();
+    return !(symbols & m_targets).empty();
+  }
+
+private:
+  template <typename ExprBase, typename Self>
+  [[nodiscard]] static auto &select(Self &self) noexcept {
+    if constexpr (std::is_same_v<ExprBase, scalar_expression>)
+      return self.m_scalar;
+    else if constexpr (std::is_same_v<ExprBase, tensor_expression>)
+      return self.m_tensor;
+    else
+      return self.m_t2s;
+  }
+
+  expr_ordered_map<scalar_holder_t> m_scalar;
+  expr_ordered_map<tensor_holder_t> m_tensor;
+  expr_ordered_map<t2s_holder_t> m_t2s;
+  symbol_set m_targets;
+  bool m_has_constant_target{false};
+};
+
+expression_holder<scalar_expression>
+tag_invoke(detail::substitute_fn, std::type_identity<scalar_expression>,
+           expression_holder<scalar_expression> const &expr,
+           substitution_map const &subs);
+
+expression_holder<tensor_expression>
+tag_invoke(detail::substitute_fn, std::type_identity<tensor_expression>,
+           expression_holder<tensor_expression> const &expr,
+           substitution_map const &subs);
+
+expression_holder<tensor_to_scalar_expression>
+tag_invoke(detail::substitute_fn,
+           std::type_identity<tensor_to_scalar_expression>,
+           expression_holder<tensor_to_scalar_expression> const &expr,
+           substitution_map const &subs);
+
+} // namespace numsim::cas
+
+#endif // SUBSTITUTION_MAP_H
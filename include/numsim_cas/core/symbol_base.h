@@ -1,6 +1,9 @@
 #ifndef SYMBOL_BASE_H
 #define SYMBOL_BASE_H
 
+#include <cstdint>
+#include <numsim_cas/core/expression.h>
+#include <numsim_cas/core/free_symbols.h>
 #include <numsim_cas/core/hash_functions.h>
 
 namespace numsim::cas {
@@ -9,6 +12,7 @@ template <typename BaseExpr> class symbol_base : public BaseExpr {
 public:
   using expr_t = typename BaseExpr::expr_t;
   using base_t = BaseExpr;
+  static constexpr std::uint8_t static_node_flags{node_flags::symbol};
   // using epxr_type_traits = expression_type_traits<expr_type>;
 
   symbol_base() = delete;
@@ -25,8 +29,6 @@ public:
 
   [[nodiscard]] inline auto &name() const noexcept { return m_name; }
 
-  [[nodiscard]] bool is_symbol() const noexcept override { return true; }
-
   template <typename BaseExprT>
   friend bool operator<(symbol_base<BaseExprT> const &lhs,
                         symbol_base<BaseExprT> const &rhs);
@@ -46,7 +48,11 @@ public:
 
 protected:
   void update_hash_value() const override {
-    hash_combine(this->m_hash_value, m_name);
+    this->m_hash_value = symbol_name_hash(m_name);
+  }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return symbol_set::of(m_name);
   }
 
   std::string m_name;
@@ -55,7 +61,9 @@ protected:
 template <typename BaseExprT>
 bool operator<(symbol_base<BaseExprT> const &lhs,
                symbol_base<BaseExprT> const &rhs) {
-  return lhs.hash_value() < rhs.hash_value();
+  if (lhs.hash_value() != rhs.hash_value())
+    return lhs.hash_value() < rhs.hash_value();
+  return lhs.name() < rhs.name();
 }
 
 template <typename BaseExprT>
@@ -67,7 +75,7 @@ bool operator>(symbol_base<BaseExprT> const &lhs,
 template <typename BaseExprT>
 bool operator==(symbol_base<BaseExprT> const &lhs,
                 symbol_base<BaseExprT> const &rhs) {
-  return lhs.hash_value() == rhs.hash_value();
+  return lhs.hash_value() == rhs.hash_value() && lhs.name() == rhs.name();
 }
 
 template <typename BaseExprT>
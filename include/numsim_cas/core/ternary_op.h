@@ -63,11 +63,56 @@ protected:
         update_hash<ternary_op<ThisBase, BaseCond, BaseThen, BaseElse>>()(
             *this);
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    symbol_set result;
+    if (m_cond.is_valid())
+      result |= m_cond.get().free_symbols();
+    if (m_then.is_valid())
+      result |= m_then.get().free_symbols();
+    if (m_else.is_valid())
+      result |= m_else.get().free_symbols();
+    return result;
+  }
   expression_holder<BaseCond> m_cond;
   expression_holder<BaseThen> m_then;
   expression_holder<BaseElse> m_else;
 };
 
+// Without these, equals_same_type / less_than_same_type would resolve to
+// expression::operator== / operator< and recurse.
+template <typename B, typename C, typename T, typename E>
+bool operator<(ternary_op<B, C, T, E> const &lhs,
+               ternary_op<B, C, T, E> const &rhs) {
+  if (lhs.hash_value() != rhs.hash_value())
+    return lhs.hash_value() < rhs.hash_value();
+  if (lhs.expr_cond() != rhs.expr_cond())
+    return lhs.expr_cond() < rhs.expr_cond();
+  if (lhs.expr_then() != rhs.expr_then())
+    return lhs.expr_then() < rhs.expr_then();
+  return lhs.expr_else() < rhs.expr_else();
+}
+
+template <typename B, typename C, typename T, typename E>
+bool operator>(ternary_op<B, C, T, E> const &lhs,
+               ternary_op<B, C, T, E> const &rhs) {
+  return rhs < lhs;
+}
+
+template <typename B, typename C, typename T, typename E>
+bool operator==(ternary_op<B, C, T, E> const &lhs,
+                ternary_op<B, C, T, E> const &rhs) {
+  return lhs.expr_cond() == rhs.expr_cond() &&
+         lhs.expr_then() == rhs.expr_then() &&
+         lhs.expr_else() == rhs.expr_else();
+}
+
+template <typename B, typename C, typename T, typename E>
+bool operator!=(ternary_op<B, C, T, E> const &lhs,
+                ternary_op<B, C, T, E> const &rhs) {
+  return !(lhs == rhs);
+}
+
 template <typename... Args>
 struct update_hash<numsim::cas::ternary_op<Args...>> {
   std::size_t
@@ -57,6 +57,10 @@ protected:
     }
   }
 
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return m_expr.is_valid() ? m_expr.get().free_symbols() : symbol_set{};
+  }
+
   expr_holder_t m_expr;
 };
 
@@ -0,0 +1,47 @@
+#ifndef VISIT_BY_TAG_H
+#define VISIT_BY_TAG_H
+
+#include <cstdint>
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/core/visitor_base.h>
+
+namespace numsim::cas {
+
+// How an evaluator reaches the operator() of a node.
+//   virtual_call: node.accept(visitor), which calls back into the visitor's
+//                 virtual operator() (two indirect calls per node).
+//   type_tag:     visit_by_tag(node, visitor), one switch on the id stored
+//                 in the node header; the visitor is final, so the
+//                 operator() it lands on is a direct call.
+// virtual_call is the default: benchmarks/evaluator_dispatch measures both
+// and the switch is no faster, the time per node goes to the libm calls and
+// to the symbol lookups, not to the two indirect calls.
+enum class evaluator_dispatch : std::uint8_t { virtual_call, type_tag };
+
+} // namespace numsim::cas
+
+// Defines
+//
+//   template <typename Visitor>
+//   decltype(auto) visit_by_tag(BASE const &node, Visitor &&visitor);
+//
+// which calls visitor(static_cast<T const &>(node)) for the node type T of
+// NODE_LIST whose get_index<T, BASE>::index equals node.id(). Every node
+// type has to be complete where this is expanded.
+#define NUMSIM_CAS_VISIT_BY_TAG_CASE(T)                                        \
+  case get_index<T, visit_by_tag_base_t>::index:                               \
+    return visitor(static_cast<T const &>(node));
+
+#define NUMSIM_CAS_DEFINE_VISIT_BY_TAG(BASE, NODE_LIST)                        \
+  template <typename Visitor>                                                  \
+  decltype(auto) visit_by_tag(BASE const &node, Visitor &&visitor) {           \
+    using visit_by_tag_base_t = BASE;                                          \
+    switch (node.id()) {                                                       \
+      NODE_LIST(NUMSIM_CAS_VISIT_BY_TAG_CASE, NUMSIM_CAS_VISIT_BY_TAG_CASE)    \
+    default:                                                                   \
+      break;                                                                   \
+    }                                                                          \
+    throw internal_error("visit_by_tag: unknown node id");                     \
+  }
+
+#endif // VISIT_BY_TAG_H
@@ -2,6 +2,7 @@
 #define VISITOR_BASE_H
 
 #include <cassert>
+#include <cstdint>
 #include <numsim_cas/core/expression_holder.h>
 #include <numsim_cas/numsim_cas_type_traits.h>
 #include <numsim_cas/type_list.h>
@@ -88,11 +89,15 @@ public:
   using return_type = typename visitable<Base, Types...>::return_type;
   using expr_holder_t = expression_holder<Base>;
 
+  // Every constructor fills in the node header; the implicit copy and
+  // move constructors copy it from a node of the same type. There are no
+  // inherited constructors, which would skip this.
   template <typename... Args>
   visitable_impl(Args &&...args)
-      : visitable<Base, Types...>(std::forward<Args>(args)...) {}
-  visitable_impl() = default;
-  using visitable<Base, Types...>::visitable;
+      : visitable<Base, Types...>(std::forward<Args>(args)...) {
+    init_node_header();
+  }
+  visitable_impl() { init_node_header(); }
   ~visitable_impl() override = default;
 
   void accept(visitor<Types...> &v) override {
@@ -111,8 +116,6 @@ public:
     return get_index<typename get_derived<Derived>::derived_type, Base>::index;
   }
 
-  [[nodiscard]] type_id id() const noexcept override { return get_id(); }
-
 protected:
   bool equals_same_type(expression const &rhs) const noexcept override {
     assert(dynamic_cast<Derived const *>(&rhs) != nullptr);
@@ -125,6 +128,14 @@ protected:
     return static_cast<Derived const &>(*this) <
            static_cast<Derived const &>(rhs);
   }
+
+private:
+  void init_node_header() noexcept {
+    std::uint8_t flags{0};
+    if constexpr (requires { Derived::static_node_flags; })
+      flags = Derived::static_node_flags;
+    this->set_node_header(get_id(), Base::node_domain, flags);
+  }
 };
 
 } // namespace numsim::cas
@@ -0,0 +1,61 @@
+#ifndef NUMSIM_CAS_DAG_PRINTER_H
+#define NUMSIM_CAS_DAG_PRINTER_H
+
+#include <string>
+#include <string_view>
+
+#include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/latex_config.h>
+#include <numsim_cas/scalar/scalar_expression.h>
+#include <numsim_cas/tensor/tensor_expression.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_expression.h>
+
+namespace numsim::cas {
+
+// Printing that follows the DAG instead of the tree. A subexpression reached
+// more than once (the same node, in any domain) is printed once as a
+// let-binding and referenced by name afterwards:
+//
+//   to_string_dag(exp(sin(x)+y) * log(sin(x)+y))
+//     let t1 = sin(x)+y;
+//     exp(t1)*log(t1)
+//
+// Bindings come before their first use, so the output grows with the number
+// of distinct nodes rather than the size of the expanded tree, which is what
+// keeps printed derivatives of deep energies small. Leaves (symbols,
+// constants, named expressions, identity, ...) are never bound. Without
+// sharing the result equals to_string / to_latex.
+//
+// Sharing is detected by node identity; structurally equal but separately
+// built subtrees are printed separately.
+struct dag_print_options {
+  std::string_view prefix{"t"}; // t1, t2, ... (t_{1}, ... in LaTeX)
+};
+
+[[nodiscard]] std::string
+to_string_dag(expression_holder<scalar_expression> const &expr,
+              dag_print_options const &options = {});
+[[nodiscard]] std::string
+to_string_dag(expression_holder<tensor_expression> const &expr,
+              dag_print_options const &options = {});
+[[nodiscard]] std::string
+to_string_dag(expression_holder<tensor_to_scalar_expression> const &expr,
+              dag_print_options const &options = {});
+
+// One "t_{1} = ... \\" line per binding, then the expression.
+[[nodiscard]] std::string
+to_latex_dag(expression_holder<scalar_expression> const &expr,
+             latex_config const &cfg = latex_config::default_config(),
+             dag_print_options const &options = {});
+[[nodiscard]] std::string
+to_latex_dag(expression_holder<tensor_expression> const &expr,
+             latex_config const &cfg = latex_config::default_config(),
+             dag_print_options const &options = {});
+[[nodiscard]] std::string
+to_latex_dag(expression_holder<tensor_to_scalar_expression> const &expr,
+             latex_config const &cfg = latex_config::default_config(),
+             dag_print_options const &options = {});
+
+} // namespace numsim::cas
+
+#endif // NUMSIM_CAS_DAG_PRINTER_H
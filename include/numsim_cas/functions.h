@@ -20,7 +20,7 @@ add_insert_signed(n_ary_tree<Derived> &tree,
     if (pos == tree.symbol_map().end()) {
       auto neg{-entry};
       pos = tree.find_like(neg);
-      if (pos != tree.symbol_map().end() && !(pos->second == neg)) {
+      if (pos != tree.symbol_map().end() && !(*pos == neg)) {
         pos = tree.symbol_map().end();
       }
     }
@@ -28,7 +28,7 @@ add_insert_signed(n_ary_tree<Derived> &tree,
       tree.merge_or_insert(std::move(entry));
       return;
     }
-    auto next = pos->second + entry;
+    auto next = *pos + entry;
     tree.symbol_map().erase(pos);
     entry = std::move(next);
   }
@@ -64,9 +64,9 @@ constexpr inline void merge_add(n_ary_tree<Derived> const &lhs,
   }
 
   expr_set<expression_holder<expr_t>> used_expr;
-  for (auto &child : lhs.symbol_map() | std::views::values) {
+  for (auto &child : lhs.symbol_map()) {
     auto pos{rhs.find_like(child)};
-    if (pos != rhs.symbol_map().end() && used_expr.count(pos->second)) {
+    if (pos != rhs.symbol_map().end() && used_expr.count(*pos)) {
       pos = rhs.symbol_map().end();
     }
     if (pos == rhs.symbol_map().end()) {
@@ -74,13 +74,13 @@ constexpr inline void merge_add(n_ary_tree<Derived> const &lhs,
       auto neg_child{-child};
       pos = rhs.find_like(neg_child);
       if (pos != rhs.symbol_map().end() &&
-          (!(pos->second == neg_child) || used_expr.count(pos->second))) {
+          (!(*pos == neg_child) || used_expr.count(*pos))) {
         pos = rhs.symbol_map().end();
       }
     }
     if (pos != rhs.symbol_map().end()) {
-      used_expr.insert(pos->second);
-      auto combined{child + pos->second};
+      used_expr.insert(*pos);
+      auto combined{child + *pos};
       if (!is_zero(combined)) {
         add_insert_signed(result, std::move(combined), is_zero);
       }
@@ -89,7 +89,7 @@ constexpr inline void merge_add(n_ary_tree<Derived> const &lhs,
     }
   }
   if (used_expr.size() != rhs.size()) {
-    for (auto &child : rhs.symbol_map() | std::views::values) {
+    for (auto &child : rhs.symbol_map()) {
       if (!used_expr.count(child)) {
         add_insert_signed(result, child, is_zero);
       }
@@ -0,0 +1,56 @@
+#ifndef NUMSIM_CAS_KERNEL_CACHE_H
+#define NUMSIM_CAS_KERNEL_CACHE_H
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <numsim_cas/kernel_program.h>
+#include <numsim_cas/scalar/scalar_kernel_cache.h>
+
+namespace numsim::cas {
+
+// scalar_kernel_cache for material models: outputs and inputs may be
+// scalar, tensor and tensor-to-scalar expressions.
+//
+//   kernel_cache cache({.directory = "kernels"});
+//   auto f = cache.load({psi, dpsi_dC, d2psi_dCdC}, {C, mu, lambda});
+//   // in:  C[0..8], mu, lambda
+//   // out: psi, dpsi_dC[0..8], d2psi_dCdC[0..80]
+//   f(in, out);
+//
+// The model is lowered by make_kernel_program, so every value has its
+// place in the flat in/out arrays: a tensor takes kernel_size() values in
+// tensor_layout::full order (tensor_layout_convert packs other layouts).
+// The file comment, and with it the key, lists the kind of every input and
+// output, with dimension and rank for tensors, so a model built in 2D and
+// in 3D gives two entries. Without native code the kernel runs on
+// scalar_evaluator, tensor_evaluator and tensor_to_scalar_evaluator
+// (double).
+//
+// Directory, trust checks, statistics and thread safety are those of the
+// scalar_kernel_cache underneath; both can share one directory.
+class kernel_cache {
+public:
+  explicit kernel_cache(scalar_kernel_cache_options options);
+
+  // Throws invalid_expression_error like make_kernel_program.
+  [[nodiscard]] scalar_kernel
+  load(std::vector<kernel_expression> const &outputs,
+       std::vector<kernel_expression> const &inputs);
+
+  // File stem the kernel for this model is stored under.
+  [[nodiscard]] std::string
+  key(std::vector<kernel_expression> const &outputs,
+      std::vector<kernel_expression> const &inputs) const;
+
+  [[nodiscard]] scalar_kernel_cache::statistics stats() const;
+  [[nodiscard]] std::filesystem::path const &directory() const noexcept;
+
+private:
+  scalar_kernel_cache m_cache;
+};
+
+} // namespace numsim::cas
+
+#endif // NUMSIM_CAS_KERNEL_CACHE_H
@@ -0,0 +1,48 @@
+#ifndef NUMSIM_CAS_KERNEL_PROGRAM_H
+#define NUMSIM_CAS_KERNEL_PROGRAM_H
+
+#include <cstddef>
+#include <variant>
+#include <vector>
+
+#include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/scalar/scalar_expression.h>
+#include <numsim_cas/scalar/scalar_program.h>
+#include <numsim_cas/tensor/tensor_expression.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_expression.h>
+
+namespace numsim::cas {
+
+// An input or output of a model kernel (kernel_cache).
+using kernel_expression =
+    std::variant<expression_holder<scalar_expression>,
+                 expression_holder<tensor_expression>,
+                 expression_holder<tensor_to_scalar_expression>>;
+
+// Number of doubles `expr` takes in the input or output array of a kernel:
+// one for a scalar or tensor-to-scalar expression, dim^rank for a tensor,
+// whose components are stored as in tensor_layout::full.
+[[nodiscard]] std::size_t kernel_size(kernel_expression const &expr);
+
+// Lowers a model component by component into a scalar_program. The inputs
+// are scalar and tensor symbols, laid out one after the other in the input
+// array; the outputs are laid out the same way in the output array.
+//
+// Tensor operations become sums of products of their components, with the
+// constant tensors (identity, projectors, Levi-Civita) folded in: a product
+// with a zero component is left out and one with a unit component reduces
+// to the other factor. Contractions are planned like in tensor_evaluator.
+// if_then_else selects per component, so both arms are computed.
+//
+// Nodes without a closed form in the components throw
+// invalid_expression_error: eigenvalues, eigenprojections, eigenvectors,
+// isotropic tensor functions and divided differences, the inverse of a
+// rank-4 tensor, and tensor_pow with a non-constant exponent. So does a
+// symbol that is not an input, as in make_scalar_program.
+[[nodiscard]] scalar_program
+make_kernel_program(std::vector<kernel_expression> const &outputs,
+                    std::vector<kernel_expression> const &inputs);
+
+} // namespace numsim::cas
+
+#endif // NUMSIM_CAS_KERNEL_PROGRAM_H
@@ -31,9 +31,11 @@
 #include <numsim_cas/scalar/scalar_zero.h>
 
 #include <numsim_cas/scalar/scalar_diff.h>
+#include <numsim_cas/scalar/scalar_expand.h>
 #include <numsim_cas/scalar/scalar_operators.h>
 #include <numsim_cas/scalar/scalar_solve.h>
 #include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/scalar/sparse_polynomial.h>
 #include <numsim_cas/scalar/visitors/scalar_differentiation.h>
 #include <numsim_cas/scalar/visitors/scalar_evaluator.h>
 #include <numsim_cas/scalar/visitors/scalar_printer.h>
@@ -65,4 +67,10 @@
 #include <numsim_cas/tensor_to_scalar/tensor_to_scalar_operators.h>
 #include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
 
+// binary DAG format (all domains)
+#include <numsim_cas/serialization.h>
+
+// let-bound printing of shared subexpressions (all domains)
+#include <numsim_cas/dag_printer.h>
+
 #endif // NUMSIM_CAS_H
@@ -7,8 +7,12 @@
 #include <numsim_cas/tensor/tensor_expression.h>
 #include <numsim_cas/tensor_to_scalar/tensor_to_scalar_expression.h>
 
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 namespace numsim::cas::parser {
 
@@ -83,6 +87,69 @@ parse_tensor(std::string_view source, symbol_table &syms);
 [[nodiscard]] expression_holder<tensor_to_scalar_expression>
 parse_t2s(std::string_view source, symbol_table &syms);
 
+/**
+ * @brief Throughput of one `parse_all` / `parse_file` call.
+ *
+ * `elapsed` covers parsing and expression construction, not reading
+ * the file.
+ */
+struct parse_statistics {
+  std::size_t statements{0};
+  std::size_t bytes{0};
+  std::chrono::nanoseconds elapsed{0};
+
+  [[nodiscard]] double seconds() const noexcept {
+    return std::chrono::duration<double>(elapsed).count();
+  }
+  [[nodiscard]] double bytes_per_second() const noexcept {
+    return elapsed.count() > 0 ? static_cast<double>(bytes) / seconds() : 0.0;
+  }
+  [[nodiscard]] double statements_per_second() const noexcept {
+    return elapsed.count() > 0 ? static_cast<double>(statements) / seconds()
+                               : 0.0;
+  }
+};
+
+/// Result of `parse_all` / `parse_file`: one expression per statement,
+/// in source order.
+struct parse_batch {
+  std::vector<parsed_expression> expressions;
+  parse_statistics statistics;
+};
+
+/**
+ * @brief Parse many `;`-separated statements in one pass.
+ *
+ * For bulk input such as files of material definitions:
+ *
+ * ```cpp
+ * symbol_table syms;
+ * auto batch = parse_all("C{rank=2, dim=3}; 2*trace(C); det(C)", syms);
+ * batch.expressions.size();                   // 3
+ * batch.statistics.statements_per_second();
+ * ```
+ *
+ * A trailing `;` and empty statements are allowed. Statements share
+ * `syms`, so a tensor declared in one is known in the next. The source
+ * is read in place and not copied. Error positions are byte offsets
+ * into the whole `source`, and the snippet shows the offending line.
+ *
+ * All-or-nothing: if any statement fails, no expression is returned and
+ * `syms` is rolled back to its state before the call.
+ *
+ * @throws parse_error (or subclass) on the first failing statement.
+ */
+[[nodiscard]] parse_batch parse_all(std::string_view source,
+                                    symbol_table &syms);
+
+/**
+ * @brief Read `path` and parse it with `parse_all`.
+ *
+ * @throws parse_error (position-less) if the file cannot be read.
+ */
+[[nodiscard]] parse_batch parse_file(std::filesystem::path const &path,
+                                     symbol_table &syms);
+
 } // namespace numsim::cas::parser
 
 #endif // NUMSIM_CAS_PARSER_PARSER_H
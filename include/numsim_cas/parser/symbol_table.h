@@ -6,12 +6,14 @@
 #include <numsim_cas/tensor/tensor_expression.h>
 
 #include <cstddef>
+#include <functional>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <variant>
+#include <vector>
 
 namespace numsim::cas::parser {
 
@@ -43,11 +45,12 @@ namespace numsim::cas::parser {
  * sharing one table is undefined behaviour. Use one table per parse,
  * or guard with external synchronisation.
  *
- * **Persistence on parse failure**: declarations are committed as
- * they happen. If parsing throws partway through, declarations made
- * up to that point remain in the table. Callers that want
- * all-or-nothing semantics should discard the table and start over
- * on failure.
+ * **Persistence on parse failure**: the parse entry points open a
+ * `transaction`, so a parse that throws leaves no declarations behind.
+ * Direct calls outside a transaction are committed as they happen.
+ *
+ * Lookups are heterogeneous: a `std::string_view` name is hashed and
+ * compared in place, and only a new declaration allocates its key.
  */
 class symbol_table {
 public:
@@ -115,27 +118,57 @@ private:
   };
   using entry = std::variant<scalar_entry, tensor_entry>;
 
-  std::unordered_map<std::string, entry> m_entries;
+  // Transparent hash + std::equal_to<> enable find(std::string_view).
+  struct name_hash {
+    using is_transparent = void;
+    std::size_t operator()(std::string_view name) const noexcept {
+      return std::hash<std::string_view>{}(name);
+    }
+  };
+
+  // Records a new declaration for rollback while a transaction is open.
+  void journal(std::string_view name) {
+    if (m_open_transactions > 0)
+      m_journal.emplace_back(name);
+  }
+
+  std::unordered_map<std::string, entry, name_hash, std::equal_to<>>
+      m_entries;
+  // Names declared since the outermost open transaction began. Entries
+  // are only ever added, so erasing these undoes the transaction.
+  std::vector<std::string> m_journal;
+  std::size_t m_open_transactions{0};
 
 public:
-  /// RAII rollback guard (#222). Snapshots the table on construction and
-  /// restores it on destruction unless commit() ran — so a parse that
-  /// throws leaves no partial declarations behind. Entries hold
-  /// shared_ptr holders, so the snapshot is a cheap map copy.
+  /// RAII rollback guard (#222). Erases on destruction the declarations
+  /// made since construction unless commit() ran — so a parse that
+  /// throws leaves no partial declarations behind. Costs one journal
+  /// entry per new declaration rather than a copy of the table, so
+  /// parsing many statements against one large table stays linear.
+  /// Transactions nest; an inner commit is undone by an outer rollback.
   class transaction {
   public:
-    explicit transaction(symbol_table &t) : m_table(t), m_saved(t.m_entries) {}
+    explicit transaction(symbol_table &t)
+        : m_table(t), m_mark(t.m_journal.size()) {
+      ++m_table.m_open_transactions;
+    }
     transaction(transaction const &) = delete;
     transaction &operator=(transaction const &) = delete;
     ~transaction() {
-      if (!m_committed)
-        m_table.m_entries = std::move(m_saved);
+      auto &journal = m_table.m_journal;
+      if (!m_committed) {
+        for (auto i = journal.size(); i > m_mark; --i)
+          m_table.m_entries.erase(journal[i - 1]);
+        journal.resize(m_mark);
+      }
+      if (--m_table.m_open_transactions == 0)
+        journal.clear();
     }
     void commit() noexcept { m_committed = true; }
 
   private:
     symbol_table &m_table;
-    std::unordered_map<std::string, entry> m_saved;
+    std::size_t m_mark;
     bool m_committed = false;
   };
 };
@@ -0,0 +1,120 @@
+#ifndef NUMSIM_CAS_PRECISION_CHECK_H
+#define NUMSIM_CAS_PRECISION_CHECK_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+#include <numsim_cas/tensor/data/tensor_data_precision.h>
+#include <numsim_cas/tensor/visitors/tensor_evaluator.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
+
+namespace numsim::cas {
+
+// Deviation of a LowType evaluation from the RefType reference.
+struct precision_error {
+  double max_abs{0}; // max_i |low_i - ref_i|
+  double max_rel{0}; // max_abs / max_i |ref_i| (norm-wise, inf-norm)
+  double ulps{0};    // max_rel in units of epsilon<LowType>
+};
+
+// Evaluates expressions twice, once in LowType and once in RefType, with
+// the same inputs, and reports how far the low-precision result is off.
+// Inputs are given in RefType and rounded once to LowType, so the error
+// measures the evaluation alone, not the input rounding.
+//
+//   precision_check<float> check;
+//   check.set(C, C_data);                 // row-major double array
+//   auto err = check.compare(S);          // S evaluated in float vs double
+//   EXPECT_LT(err.ulps, 64);
+template <typename LowType, typename RefType = double> class precision_check {
+public:
+  using tensor_holder_t = expression_holder<tensor_expression>;
+  using scalar_holder_t = expression_holder<scalar_expression>;
+  using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+
+  precision_check() = default;
+  precision_check(precision_check const &) = delete;
+  precision_check(precision_check &&) = delete;
+  precision_check &operator=(precision_check const &) = delete;
+
+  // Binds `symbol` to a copy of `data` (tensor_layout::full).
+  void set(tensor_holder_t const &symbol, RefType const *data) {
+    auto ref = make_tensor_data_imp<RefType>().evaluate(symbol.get().dim(),
+                                                        symbol.get().rank());
+    auto const size = tensor_layout_size(ref->dim(), ref->rank(),
+                                         tensor_layout::full);
+    std::copy_n(data, size, ref->raw_data());
+    std::shared_ptr<tensor_data_base<LowType>> low =
+        convert_tensor_data<LowType>(*ref);
+    std::shared_ptr<tensor_data_base<RefType>> shared_ref = std::move(ref);
+    m_low_tensor.set(symbol, low);
+    m_low_t2s.set(symbol, low);
+    m_ref_tensor.set(symbol, shared_ref);
+    m_ref_t2s.set(symbol, shared_ref);
+  }
+
+  void set_scalar(scalar_holder_t const &symbol, RefType value) {
+    auto const low = static_cast<LowType>(value);
+    m_low_scalar.set(symbol, low);
+    m_low_tensor.set_scalar(symbol, low);
+    m_low_t2s.set_scalar(symbol, low);
+    m_ref_scalar.set(symbol, value);
+    m_ref_tensor.set_scalar(symbol, value);
+    m_ref_t2s.set_scalar(symbol, value);
+  }
+
+  precision_error compare(tensor_holder_t const &expr) {
+    auto low = m_low_tensor.apply(expr);
+    auto ref = m_ref_tensor.apply(expr);
+    if (!low || !ref)
+      throw evaluation_error("precision_check::compare: invalid expression");
+    auto const size =
+        tensor_layout_size(ref->dim(), ref->rank(), tensor_layout::full);
+    return measure(low->raw_data(), ref->raw_data(), size);
+  }
+
+  precision_error compare(t2s_holder_t const &expr) {
+    auto const low = m_low_t2s.apply(expr);
+    auto const ref = m_ref_t2s.apply(expr);
+    return measure(&low, &ref, 1);
+  }
+
+  precision_error compare(scalar_holder_t const &expr) {
+    auto const low = m_low_scalar.apply(expr);
+    auto const ref = m_ref_scalar.apply(expr);
+    return measure(&low, &ref, 1);
+  }
+
+private:
+  static precision_error measure(LowType const *low, RefType const *ref,
+                                 std::size_t size) {
+    precision_error err;
+    double scale{0};
+    for (std::size_t i = 0; i < size; ++i) {
+      auto const r = static_cast<double>(ref[i]);
+      err.max_abs =
+          std::max(err.max_abs, std::abs(static_cast<double>(low[i]) - r));
+      scale = std::max(scale, std::abs(r));
+    }
+    err.max_rel = scale > 0 ? err.max_abs / scale : err.max_abs;
+    err.ulps = err.max_rel /
+               static_cast<double>(std::numeric_limits<LowType>::epsilon());
+    return err;
+  }
+
+  scalar_evaluator<LowType> m_low_scalar;
+  tensor_evaluator<LowType> m_low_tensor;
+  tensor_to_scalar_evaluator<LowType> m_low_t2s;
+  scalar_evaluator<RefType> m_ref_scalar;
+  tensor_evaluator<RefType> m_ref_tensor;
+  tensor_to_scalar_evaluator<RefType> m_ref_t2s;
+};
+
+} // namespace numsim::cas
+
+#endif // NUMSIM_CAS_PRECISION_CHECK_H
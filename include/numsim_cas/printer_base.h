@@ -3,7 +3,9 @@
 
 #include <algorithm>
 #include <numsim_cas/core/expression_holder.h>
+#include <string>
 #include <string_view>
+#include <type_traits>
 
 namespace numsim::cas {
 // Define a strongly-typed enum class for operation precedence
@@ -17,6 +19,46 @@ enum class Precedence {
   Unary // Unary operations like negation
 };
 
+class scalar_expression;
+class tensor_expression;
+class tensor_to_scalar_expression;
+
+// Hook of the DAG printers (dag_printer.h). While one is active on this
+// thread, every printer's apply() first asks it for a name to print in place
+// of the node. Being thread-wide rather than a printer member, it also
+// reaches the nested printers that cross-domain nodes create.
+class let_binding_hook {
+public:
+  virtual ~let_binding_hook() = default;
+
+  // The name to print instead of `expr`, or nullptr to print the node.
+  template <typename ExprType>
+  std::string const *name_of(expression_holder<ExprType> const &expr) {
+    if constexpr (std::is_same_v<ExprType, scalar_expression>)
+      return scalar_name(expr);
+    else if constexpr (std::is_same_v<ExprType, tensor_expression>)
+      return tensor_name(expr);
+    else
+      return tensor_to_scalar_name(expr);
+  }
+
+  [[nodiscard]] static let_binding_hook *&active() noexcept {
+    static thread_local let_binding_hook *hook{nullptr};
+    return hook;
+  }
+
+protected:
+  // Distinct names rather than overloads: resolving an overload set would
+  // instantiate all three holder types, which are incomplete here.
+  virtual std::string const *
+  scalar_name(expression_holder<scalar_expression> const &expr) = 0;
+  virtual std::string const *
+  tensor_name(expression_holder<tensor_expression> const &expr) = 0;
+  virtual std::string const *
+  tensor_to_scalar_name(
+      expression_holder<tensor_to_scalar_expression> const &expr) = 0;
+};
+
 template <typename Derived, typename StreamType> class printer_base {
 public:
   friend Derived;
@@ -30,6 +72,19 @@ public:
   }
 
 protected:
+  // Prints the let-bound name of `expr` if a DAG printer binds it.
+  template <typename ExprType>
+  bool print_let_name(expression_holder<ExprType> const &expr) {
+    auto *hook{let_binding_hook::active()};
+    if (hook == nullptr)
+      return false;
+    auto const *name{hook->name_of(expr)};
+    if (name == nullptr)
+      return false;
+    m_out << *name;
+    return true;
+  }
+
   template <typename Stream, typename Container>
   static void print_sequence(Stream &out, Container const &data,
                              char spacer) noexcept {
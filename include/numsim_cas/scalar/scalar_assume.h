@@ -23,10 +23,8 @@ void infer_assumptions(expression_holder<scalar_expression> const &expr);
 inline void assume(expression_holder<scalar_expression> const &expr, positive) {
   detail::require_symbol(expr.get(), "assume(positive)");
   auto &a = expr.data()->assumptions();
-  a.insert(positive{});
-  a.insert(nonnegative{});
-  a.insert(nonzero{});
-  a.insert(real_tag{});
+  a.insert_implied(positive{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -34,10 +32,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, positive) {
 inline void assume(expression_holder<scalar_expression> const &expr, negative) {
   detail::require_symbol(expr.get(), "assume(negative)");
   auto &a = expr.data()->assumptions();
-  a.insert(negative{});
-  a.insert(nonpositive{});
-  a.insert(nonzero{});
-  a.insert(real_tag{});
+  a.insert_implied(negative{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -46,8 +42,8 @@ inline void assume(expression_holder<scalar_expression> const &expr,
                    nonnegative) {
   detail::require_symbol(expr.get(), "assume(nonnegative)");
   auto &a = expr.data()->assumptions();
-  a.insert(nonnegative{});
-  a.insert(real_tag{});
+  a.insert_implied(nonnegative{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -56,8 +52,8 @@ inline void assume(expression_holder<scalar_expression> const &expr,
                    nonpositive) {
   detail::require_symbol(expr.get(), "assume(nonpositive)");
   auto &a = expr.data()->assumptions();
-  a.insert(nonpositive{});
-  a.insert(real_tag{});
+  a.insert_implied(nonpositive{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -65,7 +61,8 @@ inline void assume(expression_holder<scalar_expression> const &expr,
 inline void assume(expression_holder<scalar_expression> const &expr, nonzero) {
   detail::require_symbol(expr.get(), "assume(nonzero)");
   auto &a = expr.data()->assumptions();
-  a.insert(nonzero{});
+  a.insert_implied(nonzero{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -73,9 +70,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, nonzero) {
 inline void assume(expression_holder<scalar_expression> const &expr, integer) {
   detail::require_symbol(expr.get(), "assume(integer)");
   auto &a = expr.data()->assumptions();
-  a.insert(integer{});
-  a.insert(rational{});
-  a.insert(real_tag{});
+  a.insert_implied(integer{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -83,10 +79,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, integer) {
 inline void assume(expression_holder<scalar_expression> const &expr, even) {
   detail::require_symbol(expr.get(), "assume(even)");
   auto &a = expr.data()->assumptions();
-  a.insert(even{});
-  a.insert(integer{});
-  a.insert(rational{});
-  a.insert(real_tag{});
+  a.insert_implied(even{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -94,10 +88,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, even) {
 inline void assume(expression_holder<scalar_expression> const &expr, odd) {
   detail::require_symbol(expr.get(), "assume(odd)");
   auto &a = expr.data()->assumptions();
-  a.insert(odd{});
-  a.insert(integer{});
-  a.insert(rational{});
-  a.insert(real_tag{});
+  a.insert_implied(odd{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -105,13 +97,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, odd) {
 inline void assume(expression_holder<scalar_expression> const &expr, prime) {
   detail::require_symbol(expr.get(), "assume(prime)");
   auto &a = expr.data()->assumptions();
-  a.insert(prime{});
-  a.insert(integer{});
-  a.insert(positive{});
-  a.insert(nonnegative{});
-  a.insert(nonzero{});
-  a.insert(rational{});
-  a.insert(real_tag{});
+  a.insert_implied(prime{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -119,8 +106,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, prime) {
 inline void assume(expression_holder<scalar_expression> const &expr, rational) {
   detail::require_symbol(expr.get(), "assume(rational)");
   auto &a = expr.data()->assumptions();
-  a.insert(rational{});
-  a.insert(real_tag{});
+  a.insert_implied(rational{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -128,7 +115,8 @@ inline void assume(expression_holder<scalar_expression> const &expr, rational) {
 inline void assume(expression_holder<scalar_expression> const &expr, real_tag) {
   detail::require_symbol(expr.get(), "assume(real_tag)");
   auto &a = expr.data()->assumptions();
-  a.insert(real_tag{});
+  a.insert_implied(real_tag{});
+  invalidate_inferred_assumptions();
   expr.data()->assumptions().set_inferred();
 }
 
@@ -137,6 +125,7 @@ inline void assume(expression_holder<scalar_expression> const &expr, real_tag) {
 inline void remove_assumption(expression_holder<scalar_expression> const &expr,
                               numeric_assumption const &a) {
   expr.data()->assumptions().erase(a);
+  invalidate_inferred_assumptions();
 }
 
 // ── Query helpers ───────────────────────────────────────────────────────
@@ -15,6 +15,7 @@ namespace numsim::cas {
 class scalar_constant final : public scalar_node_base_t<scalar_constant> {
 public:
   using base = scalar_node_base_t<scalar_constant>;
+  static constexpr std::uint8_t static_node_flags{node_flags::number};
   scalar_constant() = delete;
   template <typename T>
   explicit scalar_constant(T const &v) : base(), m_value(v) {
@@ -65,6 +66,10 @@ protected:
                m_value.raw());
   }
 
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
+
 private:
   scalar_number m_value;
 
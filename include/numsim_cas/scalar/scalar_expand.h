@@ -0,0 +1,35 @@
+#ifndef SCALAR_EXPAND_H
+#define SCALAR_EXPAND_H
+
+#include <cstddef>
+
+#include <numsim_cas/scalar/scalar_expression.h>
+
+namespace numsim::cas {
+
+struct expand_options {
+  // A product with at least this many pairs of terms is multiplied on
+  // several threads.
+  std::size_t parallel_threshold{std::size_t{1} << 16};
+  // Upper bound on those threads; 0 uses std::thread::hardware_concurrency.
+  unsigned max_threads{0};
+};
+
+// Distributes products over sums and expands non-negative integer powers:
+//
+//   expand(a*(b+c))      -> a*b + a*c
+//   expand(pow(x+y, 2))  -> pow(x,2) + 2*x*y + pow(y,2)
+//
+// Every maximal polynomial subtree (sums, products, negations, integer
+// powers and numbers) is expanded at once. Its symbols and other atoms
+// (sin(x), sqrt(x), named expressions, ...) become variables of an exact
+// polynomial whose monomials are packed exponent words in a hash map, and
+// the result is built as one flat sum. Arguments of atoms are expanded as
+// well, so expand(sin(a*(b+c))) is sin(a*b + a*c).
+[[nodiscard]] expression_holder<scalar_expression>
+expand(expression_holder<scalar_expression> const &expr,
+       expand_options const &options = {});
+
+} // namespace numsim::cas
+
+#endif // SCALAR_EXPAND_H
@@ -12,6 +12,7 @@ public:
   using expr_t = scalar_expression;
   using visitor_t = scalar_visitor_t;
   using visitor_const_t = scalar_visitor_const_t;
+  static constexpr expression_domain node_domain{expression_domain::scalar};
 
   template <typename... Args>
   requires(sizeof...(Args) != 1 ||
@@ -0,0 +1,103 @@
+#ifndef SCALAR_JIT_H
+#define SCALAR_JIT_H
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <numsim_cas/scalar/scalar_expression.h>
+
+namespace numsim::cas {
+
+namespace detail {
+struct scalar_kernel_state;
+} // namespace detail
+
+// out[j] = outputs[j](in[0], ..., in[n-1]) for the expressions and inputs
+// given to scalar_jit::compile or scalar_kernel_cache::load. Native code
+// when the library was built with the JIT backend (or the kernel came from
+// the on-disk cache), scalar_evaluator otherwise; both give the same values
+// up to the rounding of the libm calls. Cheap to copy; copies share the
+// code.
+class scalar_kernel {
+public:
+  using function_t = void (*)(double const *in, double *out);
+
+  scalar_kernel() = default;
+
+  // `in` holds inputs() values, `out` receives outputs() values.
+  void operator()(double const *in, double *out) const {
+    if (m_function) [[likely]]
+      m_function(in, out);
+    else
+      evaluate(in, out);
+  }
+
+  // Checked call for a kernel with a single output.
+  [[nodiscard]] double operator()(std::span<double const> in) const;
+
+  [[nodiscard]] std::size_t inputs() const noexcept { return m_inputs; }
+  [[nodiscard]] std::size_t outputs() const noexcept { return m_outputs; }
+  [[nodiscard]] bool is_native() const noexcept { return m_function; }
+  [[nodiscard]] bool is_valid() const noexcept { return m_state != nullptr; }
+
+private:
+  friend class scalar_jit;
+  friend class scalar_kernel_cache;
+
+  void evaluate(double const *in, double *out) const;
+
+  function_t m_function{nullptr};
+  std::shared_ptr<detail::scalar_kernel_state const> m_state;
+  std::size_t m_inputs{0};
+  std::size_t m_outputs{0};
+};
+
+struct scalar_jit_options {
+  // Compile to native code if the backend is available.
+  bool native{true};
+  // Optimization level of the backend, 0-3.
+  unsigned opt_level{2};
+};
+
+// Compiles scalar expressions to scalar_kernels and caches them.
+//
+//   scalar_jit jit;
+//   auto f = jit.compile({residual, dresidual}, {x, y, mu});
+//   double r[2];
+//   f(in, r);
+//
+// The cache is keyed by the hashes of the outputs and inputs, and entries
+// are compared structurally, so compiling an equal expression again (even
+// a separately built one) returns the existing kernel. Thread-safe.
+class scalar_jit {
+public:
+  using expr_holder_t = expression_holder<scalar_expression>;
+
+  explicit scalar_jit(scalar_jit_options options = {});
+  ~scalar_jit();
+  scalar_jit(scalar_jit const &) = delete;
+  scalar_jit &operator=(scalar_jit const &) = delete;
+
+  // Every input has to be a scalar symbol and every symbol of the outputs
+  // an input (invalid_expression_error otherwise).
+  [[nodiscard]] scalar_kernel compile(std::vector<expr_holder_t> const &outputs,
+                                      std::vector<expr_holder_t> const &inputs);
+  [[nodiscard]] scalar_kernel compile(expr_holder_t const &output,
+                                      std::vector<expr_holder_t> const &inputs);
+
+  [[nodiscard]] std::size_t cache_size() const;
+  void clear_cache();
+
+  // True if this build has a JIT backend (NUMSIM_CAS_ENABLE_JIT with LLVM).
+  [[nodiscard]] static bool native_available() noexcept;
+
+private:
+  struct impl;
+  std::unique_ptr<impl> m_impl;
+};
+
+} // namespace numsim::cas
+
+#endif // SCALAR_JIT_H
@@ -0,0 +1,108 @@
+#ifndef SCALAR_KERNEL_CACHE_H
+#define SCALAR_KERNEL_CACHE_H
+
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <numsim_cas/scalar/scalar_jit.h>
+
+namespace numsim::cas {
+
+struct scalar_program;
+
+struct scalar_kernel_cache_options {
+  // Holds <key>.c and <key>.so for every kernel; created with mode 0700 on
+  // first use and made absolute on construction. Empty:
+  // $XDG_CACHE_HOME/numsim_cas/kernels, else $HOME/.cache/numsim_cas/kernels,
+  // else no disk cache at all (every load falls back to scalar_evaluator).
+  std::filesystem::path directory;
+  // C compiler command. Empty: $NUMSIM_CAS_KERNEL_CC, or else "cc".
+  std::string compiler;
+  std::string flags{"-O2 -fPIC -shared"};
+};
+
+// Persistent cache of compiled scalar kernels, shared between runs.
+//
+//   scalar_kernel_cache cache({.directory = "kernels"});
+//   auto f = cache.load({psi, dpsi_dI1, dpsi_dJ}, {I1, J, mu, kappa});
+//
+// load() lowers the expressions with to_c_source. The key is a 64-bit
+// FNV-1a hash of that source, which already spells out the structure, the
+// input order, the number of outputs and the value type (double), together
+// with the compiler command. On a hit <key>.so is dlopen()ed. The stored
+// <key>.c has to match the generated source exactly, so a hash collision or
+// a half-written entry is a miss. On a miss the source is compiled by the
+// C compiler into <key>.so; files are written under temporary names and
+// renamed, so several processes may share the directory.
+//
+// Nothing is loaded from a directory or file that is not owned by the
+// effective user or that the group or others can write to: such a
+// directory disables the disk cache, and such a stored entry is rebuilt.
+//
+// If the compiler fails (its output is kept in <key>.log) or the platform
+// has no dlopen, the kernel falls back to scalar_evaluator, see
+// scalar_kernel::is_native(). Kernels are also kept in memory, so loading
+// the same expressions again does not touch the disk. Thread-safe; the lock
+// is not held while the compiler runs.
+//
+// Tensor and tensor-to-scalar models go through kernel_cache
+// (numsim_cas/kernel_cache.h).
+class scalar_kernel_cache {
+public:
+  using expr_holder_t = expression_holder<scalar_expression>;
+
+  struct statistics {
+    std::size_t memory_hits{0};
+    std::size_t disk_hits{0};
+    std::size_t compiled{0};
+    std::size_t failed{0};
+  };
+
+  explicit scalar_kernel_cache(scalar_kernel_cache_options options);
+  ~scalar_kernel_cache();
+  scalar_kernel_cache(scalar_kernel_cache const &) = delete;
+  scalar_kernel_cache &operator=(scalar_kernel_cache const &) = delete;
+
+  // Same requirements on the inputs as scalar_jit::compile.
+  [[nodiscard]] scalar_kernel load(std::vector<expr_holder_t> const &outputs,
+                                   std::vector<expr_holder_t> const &inputs);
+  [[nodiscard]] scalar_kernel load(expr_holder_t const &output,
+                                   std::vector<expr_holder_t> const &inputs);
+
+  // File stem the kernel for these expressions is stored under.
+  [[nodiscard]] std::string key(std::vector<expr_holder_t> const &outputs,
+                                std::vector<expr_holder_t> const &inputs) const;
+
+  [[nodiscard]] statistics stats() const;
+  [[nodiscard]] std::filesystem::path const &directory() const noexcept;
+
+  // True if this platform can load compiled kernels (dlopen).
+  [[nodiscard]] static bool native_available() noexcept;
+
+private:
+  friend class kernel_cache;
+
+  // First line of the file comment: kind, value type, inputs, outputs.
+  static std::string signature(std::vector<expr_holder_t> const &outputs,
+                               std::vector<expr_holder_t> const &inputs);
+  // The file compiled for `program`: a comment with `header` and the
+  // compiler command, then to_c_source.
+  std::string kernel_source(std::string const &header,
+                            scalar_program const &program) const;
+  static std::string key_of(std::string const &source);
+  // The kernel for `source` from memory, from disk or freshly compiled;
+  // `state` runs it when there is no native code.
+  scalar_kernel load_source(std::string source,
+                            std::shared_ptr<detail::scalar_kernel_state> state,
+                            std::size_t inputs, std::size_t outputs);
+
+  struct impl;
+  std::unique_ptr<impl> m_impl;
+};
+
+} // namespace numsim::cas
+
+#endif // SCALAR_KERNEL_CACHE_H
@@ -9,6 +9,7 @@ namespace numsim::cas {
 class scalar_one final : public scalar_node_base_t<scalar_one> {
 public:
   using base = scalar_node_base_t<scalar_one>;
+  static constexpr std::uint8_t static_node_flags{node_flags::number};
   scalar_one() {}
   scalar_one(scalar_one &&data) noexcept
       : base(std::move(static_cast<base &&>(data))) {}
@@ -35,6 +36,10 @@ private:
   void update_hash_value() const override {
     hash_combine(base::m_hash_value, base::get_id());
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
 };
 
 } // namespace numsim::cas
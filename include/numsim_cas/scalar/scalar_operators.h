@@ -47,6 +47,7 @@ inline expression_holder<scalar_expression> tag_invoke(add_fn, L &&lhs,
   }
 
   auto &_lhs{lhs.template get<scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("scalar::add_base");
   simplifier::add_base visitor(std::forward<L>(lhs), std::forward<R>(rhs));
   return _lhs.accept(visitor);
 }
@@ -59,6 +60,7 @@ requires std::same_as<std::remove_cvref_t<L>,
 inline expression_holder<scalar_expression> tag_invoke(sub_fn, L &&lhs,
                                                        R &&rhs) {
   auto &_lhs{lhs.template get<scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("scalar::sub_base");
   simplifier::sub_base visitor(std::forward<L>(lhs), std::forward<R>(rhs));
   return _lhs.accept(visitor);
 }
@@ -73,6 +75,7 @@ inline expression_holder<scalar_expression> tag_invoke(mul_fn, L &&lhs,
   // #310 — positivity is inferred lazily on query (shallow_inference_visitor
   // via is_positive/infer_assumptions), not propagated eagerly here.
   auto &_lhs{lhs.template get<scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("scalar::mul_base");
   simplifier::mul_base visitor(std::forward<L>(lhs), std::forward<R>(rhs));
   return _lhs.accept(visitor);
 }
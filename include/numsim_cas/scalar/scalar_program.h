@@ -0,0 +1,80 @@
+#ifndef SCALAR_PROGRAM_H
+#define SCALAR_PROGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <numsim_cas/scalar/scalar_expression.h>
+
+namespace numsim::cas {
+
+// Straight-line form of a set of scalar expressions, the input of the code
+// generators (scalar_jit, to_c_source). Every instruction writes one value;
+// its operands are indices of earlier instructions. A node reached more than
+// once in the DAG is lowered once.
+//
+// Comparisons give 1 or 0 like scalar_evaluator. if_then_else becomes a
+// select of both arms: with every symbol bound up front, evaluating the
+// arm that is not taken cannot fail, and its value is discarded.
+struct scalar_program {
+  enum class opcode : std::uint8_t {
+    input,    // in[index]
+    constant, // value
+    add,      // a + b
+    mul,      // a * b
+    neg,      // -a
+    pow,      // pow(a, b)
+    sin,
+    cos,
+    tan,
+    asin,
+    acos,
+    atan,
+    sqrt,
+    log,
+    exp,
+    abs,
+    sign,   // 1, -1 or 0
+    lt,     // a < b
+    le,     // a <= b
+    eq,     // a == b
+    ne,     // a != b
+    max,    // a < b ? b : a   (std::max)
+    min,    // b < a ? b : a   (std::min)
+    select, // a != 0 ? b : c
+  };
+
+  struct instruction {
+    opcode op;
+    std::uint32_t a{0};
+    std::uint32_t b{0};
+    std::uint32_t c{0};
+    // constant: the value; input: the input position.
+    double value{0};
+  };
+
+  std::vector<instruction> code;
+  // Instruction index of each output.
+  std::vector<std::uint32_t> outputs;
+  std::size_t inputs{0};
+};
+
+// Lowers `outputs` with `inputs[k]` read from in[k]. Every input has to be
+// a scalar symbol and every symbol of the outputs an input, otherwise
+// invalid_expression_error is thrown.
+[[nodiscard]] scalar_program make_scalar_program(
+    std::vector<expression_holder<scalar_expression>> const &outputs,
+    std::vector<expression_holder<scalar_expression>> const &inputs);
+
+// C99 source of `void name(double const *in, double *out)` computing
+// `program`, for compilation by an external C compiler
+// (scalar_kernel_cache). Constants are written as hex floats, so the
+// generated code uses exactly the values of the expression.
+[[nodiscard]] std::string to_c_source(scalar_program const &program,
+                                      std::string const &name);
+
+} // namespace numsim::cas
+
+#endif // SCALAR_PROGRAM_H
@@ -20,7 +20,11 @@ public:
   std::vector<expr_holder_t> solve() const;
 
 private:
+  // Exact path through sparse_polynomial; falls back to
+  // classify_term_symbolic when the polynomial is too large for it.
   std::optional<poly_map> classify_term(expr_holder_t const &expr) const;
+  std::optional<poly_map>
+  classify_term_symbolic(expr_holder_t const &expr) const;
 
   static void merge_into(poly_map &pm, long long degree,
                          expr_holder_t const &coeff);
@@ -34,7 +38,9 @@ private:
 };
 
 // Extract polynomial coefficients: expr decomposed as sum of coeff_i * x^i.
-// Returns nullopt if not polynomial in x (e.g., sin(x), pow(x, non-integer)).
+// Products and integer powers of sums are expanded, so pow(x+1, 2) yields
+// {2: 1, 1: 2, 0: 1}. Returns nullopt if not polynomial in x (e.g., sin(x),
+// pow(x, non-integer)).
 std::optional<std::map<long long, expression_holder<scalar_expression>>>
 polynomial_coefficients(expression_holder<scalar_expression> const &expr,
                         expression_holder<scalar_expression> const &x);
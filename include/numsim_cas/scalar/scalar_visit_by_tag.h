@@ -0,0 +1,13 @@
+#ifndef SCALAR_VISIT_BY_TAG_H
+#define SCALAR_VISIT_BY_TAG_H
+
+#include <numsim_cas/core/visit_by_tag.h>
+#include <numsim_cas/scalar/scalar_all.h>
+
+namespace numsim::cas {
+
+NUMSIM_CAS_DEFINE_VISIT_BY_TAG(scalar_expression, NUMSIM_CAS_SCALAR_NODE_LIST)
+
+} // namespace numsim::cas
+
+#endif // SCALAR_VISIT_BY_TAG_H
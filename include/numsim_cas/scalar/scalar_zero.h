@@ -9,6 +9,7 @@ namespace numsim::cas {
 class scalar_zero final : public scalar_node_base_t<scalar_zero> {
 public:
   using base = scalar_node_base_t<scalar_zero>;
+  static constexpr std::uint8_t static_node_flags{node_flags::number};
 
   scalar_zero() {}
   scalar_zero(scalar_zero &&data) noexcept : base(static_cast<base &&>(data)) {}
@@ -36,6 +37,10 @@ private:
   void update_hash_value() const override {
     hash_combine(base::m_hash_value, base::get_id());
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
 };
 
 } // namespace numsim::cas
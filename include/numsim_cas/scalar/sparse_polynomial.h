@@ -0,0 +1,201 @@
+#ifndef SPARSE_POLYNOMIAL_H
+#define SPARSE_POLYNOMIAL_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <numsim_cas/core/scalar_number.h>
+#include <numsim_cas/scalar/scalar_expression.h>
+
+namespace numsim::cas {
+
+// Exponents of up to eight variables packed into one word, one byte per
+// variable and variable 0 in the most significant byte. Comparing two
+// words compares the exponent vectors lexicographically, and the product
+// of two monomials is the byte-wise sum of their words.
+class monomial {
+public:
+  static constexpr std::size_t max_variables{8};
+  static constexpr unsigned max_degree{255};
+
+  constexpr monomial() noexcept = default;
+
+  // x_index^degree. Throws polynomial_error past the limits above.
+  [[nodiscard]] static monomial variable(std::size_t index,
+                                         unsigned degree = 1);
+
+  [[nodiscard]] constexpr unsigned degree(std::size_t index) const noexcept {
+    return static_cast<unsigned>((m_packed >> shift(index)) & 0xffu);
+  }
+  [[nodiscard]] unsigned total_degree() const noexcept;
+  [[nodiscard]] constexpr bool is_constant() const noexcept {
+    return m_packed == 0;
+  }
+  [[nodiscard]] constexpr std::uint64_t packed() const noexcept {
+    return m_packed;
+  }
+
+  // True if every exponent of `other` is at most the one here.
+  [[nodiscard]] bool divisible_by(monomial other) const noexcept;
+
+  // Throws polynomial_error if an exponent would exceed max_degree.
+  friend monomial operator*(monomial lhs, monomial rhs);
+  // Requires lhs.divisible_by(rhs).
+  friend monomial operator/(monomial lhs, monomial rhs) noexcept;
+
+  friend constexpr bool operator==(monomial, monomial) noexcept = default;
+  friend constexpr auto operator<=>(monomial, monomial) noexcept = default;
+
+private:
+  constexpr explicit monomial(std::uint64_t packed) noexcept
+      : m_packed(packed) {}
+  static constexpr unsigned shift(std::size_t index) noexcept {
+    return static_cast<unsigned>(8 * (max_variables - 1 - index));
+  }
+
+  std::uint64_t m_packed{0};
+};
+
+// Sparse multivariate polynomial with exact scalar_number coefficients,
+// stored as one vector of (monomial, coefficient) terms in decreasing
+// lexicographic order without zero coefficients. Arithmetic works on the
+// numbers directly and never builds expression nodes; conversion from and
+// to scalar expressions happens only at the boundary (polynomial_converter).
+//
+// Integer and rational coefficients are exact. gcd/cancel/divide_exact
+// assume exact coefficients; with floating-point ones they only find
+// factors that cancel exactly.
+class sparse_polynomial {
+public:
+  struct term {
+    monomial exponents;
+    scalar_number coefficient;
+  };
+
+  sparse_polynomial() = default; // zero
+  explicit sparse_polynomial(scalar_number const &constant);
+  sparse_polynomial(monomial exponents, scalar_number const &coefficient);
+
+  [[nodiscard]] static sparse_polynomial variable(std::size_t index,
+                                                  unsigned degree = 1);
+
+  [[nodiscard]] std::span<term const> terms() const noexcept {
+    return m_terms;
+  }
+  [[nodiscard]] std::size_t size() const noexcept { return m_terms.size(); }
+  [[nodiscard]] bool is_zero() const noexcept { return m_terms.empty(); }
+  [[nodiscard]] bool is_constant() const noexcept;
+
+  // Requires !is_zero().
+  [[nodiscard]] term const &leading_term() const { return m_terms.front(); }
+  [[nodiscard]] unsigned degree(std::size_t index) const noexcept;
+  // Lowest-index variable that occurs, nullopt for a constant.
+  [[nodiscard]] std::optional<std::size_t> main_variable() const noexcept;
+
+  // Sum of the terms with x_index^degree, with that power divided out.
+  [[nodiscard]] sparse_polynomial coefficient(std::size_t index,
+                                              unsigned degree) const;
+
+  // Scaled so that the leading coefficient is 1; zero stays zero.
+  [[nodiscard]] sparse_polynomial monic() const;
+
+  sparse_polynomial &operator+=(sparse_polynomial const &rhs);
+  sparse_polynomial &operator-=(sparse_polynomial const &rhs);
+  sparse_polynomial &operator*=(sparse_polynomial const &rhs);
+
+  friend sparse_polynomial operator+(sparse_polynomial lhs,
+                                     sparse_polynomial const &rhs) {
+    return lhs += rhs;
+  }
+  friend sparse_polynomial operator-(sparse_polynomial lhs,
+                                     sparse_polynomial const &rhs) {
+    return lhs -= rhs;
+  }
+  friend sparse_polynomial operator*(sparse_polynomial const &lhs,
+                                     sparse_polynomial const &rhs);
+  friend sparse_polynomial operator-(sparse_polynomial const &operand);
+  friend bool operator==(sparse_polynomial const &lhs,
+                         sparse_polynomial const &rhs);
+
+  friend sparse_polynomial pow(sparse_polynomial const &base,
+                               unsigned exponent);
+
+  // lhs / rhs if rhs divides lhs, nullopt otherwise. Throws
+  // polynomial_error for a zero divisor.
+  friend std::optional<sparse_polynomial>
+  divide_exact(sparse_polynomial const &lhs, sparse_polynomial const &rhs);
+
+  // Monic greatest common divisor over the rationals: recursive in the
+  // main variable, with contents split off and a primitive pseudo-
+  // remainder sequence. gcd(0, 0) is 0.
+  friend sparse_polynomial gcd(sparse_polynomial const &lhs,
+                               sparse_polynomial const &rhs);
+
+private:
+  // Sorts by decreasing monomial, merges equal monomials, drops zeros.
+  void normalize();
+
+  std::vector<term> m_terms;
+};
+
+struct polynomial_fraction {
+  sparse_polynomial numerator;
+  sparse_polynomial denominator;
+};
+
+// numerator / denominator with the gcd divided out and a monic
+// denominator. No factorisation beyond the gcd is attempted. Throws
+// polynomial_error for a zero denominator.
+[[nodiscard]] polynomial_fraction cancel(sparse_polynomial const &numerator,
+                                         sparse_polynomial const &denominator);
+
+// Boundary between scalar expressions and sparse_polynomial. Generator i
+// of the polynomial ring is generators()[i]. The first generators are
+// the given variables. With `collect_atoms`, any other subexpression
+// that is not a sum, product, negation, integer power or number, and is
+// free of the given variables, becomes a further generator (a symbol,
+// sin(y), pow(y, 1/2), ...). Without it, such a subexpression makes the
+// conversion fail.
+class polynomial_converter {
+public:
+  using expr_holder_t = expression_holder<scalar_expression>;
+
+  explicit polynomial_converter(std::vector<expr_holder_t> variables,
+                                bool collect_atoms = false);
+
+  // nullopt if `expr` is not a polynomial in the generators. Throws
+  // polynomial_error past the monomial limits.
+  [[nodiscard]] std::optional<sparse_polynomial>
+  to_polynomial(expr_holder_t const &expr);
+
+  [[nodiscard]] expr_holder_t
+  to_expression(sparse_polynomial const &poly) const;
+
+  [[nodiscard]] std::span<expr_holder_t const> generators() const noexcept {
+    return m_generators;
+  }
+
+private:
+  std::optional<std::size_t> generator_index(expr_holder_t const &expr);
+  bool is_free_of_variables(expr_holder_t const &expr) const;
+
+  std::vector<expr_holder_t> m_generators;
+  std::size_t m_variable_count;
+  bool m_collect_atoms;
+};
+
+// Cancels the common polynomial factors of numerator / denominator, over
+// all symbols and atoms they contain. Returns numerator / denominator
+// unchanged if either side is not a polynomial or too large for
+// sparse_polynomial.
+[[nodiscard]] expression_holder<scalar_expression>
+cancel(expression_holder<scalar_expression> const &numerator,
+       expression_holder<scalar_expression> const &denominator);
+
+} // namespace numsim::cas
+
+#endif // SPARSE_POLYNOMIAL_H
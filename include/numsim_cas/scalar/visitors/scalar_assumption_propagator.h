@@ -63,6 +63,9 @@ private:
 };
 
 /// Convenience: propagate assumptions bottom-up through the expression tree.
+/// Results are cached on the nodes (see numeric_assumption_manager::
+/// inferred()), so each node of the DAG is analysed once until a symbol's
+/// assumptions change.
 numeric_assumption_manager
 propagate_assumptions(expression_holder<scalar_expression> const &expr);
 
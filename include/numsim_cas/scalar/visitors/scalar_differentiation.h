@@ -351,7 +351,8 @@ private:
    */
   expr_holder_t apply_imp(expr_holder_t const &expr) {
     m_result = expr_holder_t{};
-    if (expr.is_valid()) {
+    // Subtrees free of m_arg differentiate to zero without a walk.
+    if (expr.is_valid() && may_depend_on(expr.get(), m_arg.get())) {
       m_expr = expr;
       expr.get<scalar_visitable_t>().accept(*this);
     }
@@ -3,10 +3,13 @@
 
 #include <cmath>
 #include <complex>
+#include <numsim_cas/core/evaluation_precision.h>
 #include <numsim_cas/core/evaluator_base.h>
+#include <numsim_cas/core/interval.h>
 #include <numsim_cas/scalar/scalar_all.h>
 #include <numsim_cas/scalar/scalar_operators.h>
 #include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/scalar/scalar_visit_by_tag.h>
 #include <ranges>
 #include <variant>
 
@@ -28,13 +31,23 @@ public:
 
   ValueType apply(expr_holder_t const &expr) {
     if (expr.is_valid()) {
-      base::m_current_expr = base::to_base_holder(expr);
-      expr.template get<scalar_visitable_t>().accept(*this);
+      // Only the symbol lookup needs the holder; copying it for every
+      // node costs two atomic reference count updates.
+      if (expr.get().is_symbol())
+        base::m_current_expr = base::to_base_holder(expr);
+      if (m_dispatch == evaluator_dispatch::type_tag)
+        visit_by_tag(expr.get(), *this);
+      else
+        expr.template get<scalar_visitable_t>().accept(*this);
       return m_result;
     }
     return ValueType{0};
   }
 
+  // How apply() reaches the operator() of a node, see evaluator_dispatch.
+  void set_dispatch(evaluator_dispatch mode) noexcept { m_dispatch = mode; }
+  evaluator_dispatch dispatch_mode() const noexcept { return m_dispatch; }
+
   // Forward every stored (scalar_symbol -> ValueType) entry into `target` via
   // target.set_scalar(...). Skips entries whose stored std::any type does not
   // match ValueType (defensive against future precision-mixing). Skips entries
@@ -72,8 +85,11 @@ public:
           if constexpr (std::is_same_v<V, std::complex<double>>) {
             return static_cast<ValueType>(v.real());
           } else if constexpr (std::is_same_v<V, rational_t>) {
-            return static_cast<ValueType>(v.num) /
-                   static_cast<ValueType>(v.den);
+            // One rounding of the exact quotient for narrow types
+            // instead of three (num, den, division).
+            using W = promoted_value_t<ValueType>;
+            return static_cast<ValueType>(static_cast<W>(v.num) /
+                                          static_cast<W>(v.den));
           } else {
             return static_cast<ValueType>(v);
           }
@@ -86,7 +102,7 @@ public:
     if (visitable.coeff().is_valid()) {
       result += apply(visitable.coeff());
     }
-    for (auto const &child : visitable.symbol_map() | std::views::values) {
+    for (auto const &child : visitable.symbol_map()) {
       result += apply(child);
     }
     m_result = result;
@@ -97,7 +113,7 @@ public:
     if (visitable.coeff().is_valid()) {
       result = apply(visitable.coeff());
     }
-    for (auto const &child : visitable.symbol_map() | std::views::values) {
+    for (auto const &child : visitable.symbol_map()) {
       result *= apply(child);
     }
     m_result = result;
@@ -108,58 +124,72 @@ public:
   }
 
   void operator()(scalar_pow const &visitable) override {
-    m_result =
-        std::pow(apply(visitable.expr_lhs()), apply(visitable.expr_rhs()));
+    using std::pow;
+    m_result = pow(apply(visitable.expr_lhs()), apply(visitable.expr_rhs()));
   }
 
   void operator()(scalar_sin const &visitable) override {
-    m_result = std::sin(apply(visitable.expr()));
+    using std::sin;
+    m_result = sin(apply(visitable.expr()));
   }
 
   void operator()(scalar_cos const &visitable) override {
-    m_result = std::cos(apply(visitable.expr()));
+    using std::cos;
+    m_result = cos(apply(visitable.expr()));
   }
 
   void operator()(scalar_tan const &visitable) override {
-    m_result = std::tan(apply(visitable.expr()));
+    using std::tan;
+    m_result = tan(apply(visitable.expr()));
   }
 
   void operator()(scalar_asin const &visitable) override {
-    m_result = std::asin(apply(visitable.expr()));
+    using std::asin;
+    m_result = asin(apply(visitable.expr()));
   }
 
   void operator()(scalar_acos const &visitable) override {
-    m_result = std::acos(apply(visitable.expr()));
+    using std::acos;
+    m_result = acos(apply(visitable.expr()));
   }
 
   void operator()(scalar_atan const &visitable) override {
-    m_result = std::atan(apply(visitable.expr()));
+    using std::atan;
+    m_result = atan(apply(visitable.expr()));
   }
 
   void operator()(scalar_sqrt const &visitable) override {
-    m_result = std::sqrt(apply(visitable.expr()));
+    using std::sqrt;
+    m_result = sqrt(apply(visitable.expr()));
   }
 
   void operator()(scalar_log const &visitable) override {
-    m_result = std::log(apply(visitable.expr()));
+    using std::log;
+    m_result = log(apply(visitable.expr()));
   }
 
   void operator()(scalar_exp const &visitable) override {
-    m_result = std::exp(apply(visitable.expr()));
+    using std::exp;
+    m_result = exp(apply(visitable.expr()));
   }
 
   void operator()(scalar_sign const &visitable) override {
     const ValueType u{apply(visitable.expr())};
-    if (u > ValueType{0})
-      m_result = ValueType{1};
-    else if (u < ValueType{0})
-      m_result = ValueType{-1};
-    else
-      m_result = ValueType{0};
+    if constexpr (is_interval_v<ValueType>) {
+      m_result = sign(u);
+    } else {
+      if (u > ValueType{0})
+        m_result = ValueType{1};
+      else if (u < ValueType{0})
+        m_result = ValueType{-1};
+      else
+        m_result = ValueType{0};
+    }
   }
 
   void operator()(scalar_abs const &visitable) override {
-    m_result = std::abs(apply(visitable.expr()));
+    using std::abs;
+    m_result = abs(apply(visitable.expr()));
   }
 
   void operator()(scalar_named_expression const &visitable) override {
@@ -173,36 +203,33 @@ public:
   // gives if_then_else a uniform Real-typed condition.
 
   void operator()(scalar_lt const &v) override {
-    m_result =
-        apply(v.expr_lhs()) < apply(v.expr_rhs()) ? ValueType{1} : ValueType{0};
+    m_result = indicator(apply(v.expr_lhs()), apply(v.expr_rhs()), less);
   }
   void operator()(scalar_gt const &v) override {
-    m_result =
-        apply(v.expr_lhs()) > apply(v.expr_rhs()) ? ValueType{1} : ValueType{0};
+    m_result = indicator(apply(v.expr_rhs()), apply(v.expr_lhs()), less);
   }
   void operator()(scalar_le const &v) override {
-    m_result = apply(v.expr_lhs()) <= apply(v.expr_rhs()) ? ValueType{1}
-                                                          : ValueType{0};
+    m_result = indicator(apply(v.expr_lhs()), apply(v.expr_rhs()), less_equal);
   }
   void operator()(scalar_ge const &v) override {
-    m_result = apply(v.expr_lhs()) >= apply(v.expr_rhs()) ? ValueType{1}
-                                                          : ValueType{0};
+    m_result = indicator(apply(v.expr_rhs()), apply(v.expr_lhs()), less_equal);
   }
   void operator()(scalar_eq const &v) override {
-    m_result = apply(v.expr_lhs()) == apply(v.expr_rhs()) ? ValueType{1}
-                                                          : ValueType{0};
+    m_result = indicator(apply(v.expr_lhs()), apply(v.expr_rhs()), equal);
   }
   void operator()(scalar_ne const &v) override {
-    m_result = apply(v.expr_lhs()) != apply(v.expr_rhs()) ? ValueType{1}
-                                                          : ValueType{0};
+    m_result = ValueType{1} -
+               indicator(apply(v.expr_lhs()), apply(v.expr_rhs()), equal);
   }
 
   // ─── Min / max (#137) ────────────────────────────────────────────
   void operator()(scalar_max const &v) override {
-    m_result = std::max(apply(v.expr_lhs()), apply(v.expr_rhs()));
+    using std::max;
+    m_result = max(apply(v.expr_lhs()), apply(v.expr_rhs()));
   }
   void operator()(scalar_min const &v) override {
-    m_result = std::min(apply(v.expr_lhs()), apply(v.expr_rhs()));
+    using std::min;
+    m_result = min(apply(v.expr_lhs()), apply(v.expr_rhs()));
   }
 
   // ─── if_then_else (#135) ─────────────────────────────────────────
@@ -210,8 +237,18 @@ public:
   // Lazy evaluation: only apply the selected branch to avoid
   // triggering symbolic errors in the non-taken arm (e.g. evaluating
   // log(x) when x ≤ 0 in the wrong branch).
+  // For intervals a condition that may go either way evaluates both arms
+  // and returns their hull.
   void operator()(scalar_if_then_else const &v) override {
-    if (apply(v.expr_cond()) != ValueType{0})
+    const ValueType cond{apply(v.expr_cond())};
+    if constexpr (is_interval_v<ValueType>) {
+      if (cond.contains(0) && !cond.is_point()) {
+        const ValueType then_value{apply(v.expr_then())};
+        m_result = hull(then_value, apply(v.expr_else()));
+        return;
+      }
+    }
+    if (cond != ValueType{0})
       m_result = apply(v.expr_then());
     else
       m_result = apply(v.expr_else());
@@ -221,6 +258,32 @@ public:
     static_assert(sizeof(T) == 0,
                   "scalar_evaluator: missing overload for this node type");
   }
+
+private:
+  enum comparison { less, less_equal, equal };
+
+  // 1 if the comparison holds, 0 otherwise; for intervals the enclosure
+  // of that indicator ([0, 1] if it depends on the point).
+  static ValueType indicator(ValueType const &lhs, ValueType const &rhs,
+                             comparison cmp) {
+    if constexpr (is_interval_v<ValueType>) {
+      switch (cmp) {
+      case less:
+        return interval_lt(lhs, rhs);
+      case less_equal:
+        return interval_le(lhs, rhs);
+      default:
+        return interval_eq(lhs, rhs);
+      }
+    } else {
+      bool const holds = cmp == less         ? lhs < rhs
+                         : cmp == less_equal ? lhs <= rhs
+                                             : lhs == rhs;
+      return holds ? ValueType{1} : ValueType{0};
+    }
+  }
+
+  evaluator_dispatch m_dispatch{evaluator_dispatch::virtual_call};
 };
 
 } // namespace numsim::cas
@@ -2,6 +2,7 @@
 #define SCALAR_LIMIT_VISITOR_H
 
 #include <numsim_cas/core/limit_algebra.h>
+#include <numsim_cas/core/limit_cache.h>
 #include <numsim_cas/core/limit_result.h>
 #include <numsim_cas/scalar/scalar_all.h>
 
@@ -12,7 +13,11 @@ class scalar_limit_visitor final : public scalar_visitor_const_t,
 public:
   using expr_holder_t = expression_holder<scalar_expression>;
 
-  scalar_limit_visitor(expr_holder_t const &limit_var, limit_target target);
+  // Results are memoized per node. Pass `cache` to share them with other
+  // visitors (other limit variables or targets); otherwise the visitor
+  // keeps its own.
+  scalar_limit_visitor(expr_holder_t const &limit_var, limit_target target,
+                       limit_cache *cache = nullptr);
 
   limit_result apply(expr_holder_t const &expr);
 
@@ -57,9 +62,13 @@ public:
   void operator()(scalar_if_then_else const &) override;
 
 private:
+  limit_cache &cache() noexcept { return m_cache ? *m_cache : m_own_cache; }
+
   expr_holder_t m_limit_var;
   limit_target m_target;
   limit_result m_result;
+  limit_cache *m_cache;
+  limit_cache m_own_cache;
 };
 
 } // namespace numsim::cas
@@ -16,14 +16,14 @@ struct scalar_pretty_printer {
       if (is_same<scalar_add>(expr)) {
         const auto &add{expr.get<scalar_add>()};
         if (add.symbol_map().size() == 1) {
-          return add.symbol_map().begin()->second;
+          return *add.symbol_map().begin();
         }
       }
 
       if (is_same<scalar_mul>(expr)) {
         const auto &add{expr.get<scalar_mul>()};
         if (add.symbol_map().size() == 1) {
-          return add.symbol_map().begin()->second;
+          return *add.symbol_map().begin();
         }
       }
 
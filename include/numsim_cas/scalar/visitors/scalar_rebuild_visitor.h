@@ -37,7 +37,7 @@ public:
     expr_holder_t result;
     if (v.coeff().is_valid())
       result += apply(v.coeff());
-    for (auto &child : v.symbol_map() | std::views::values)
+    for (auto &child : v.symbol_map())
       result += apply(child);
     m_result = std::move(result);
   }
@@ -46,7 +46,7 @@ public:
     expr_holder_t result;
     if (v.coeff().is_valid())
       result *= apply(v.coeff());
-    for (auto &child : v.symbol_map() | std::views::values)
+    for (auto &child : v.symbol_map())
       result *= apply(child);
     m_result = std::move(result);
   }
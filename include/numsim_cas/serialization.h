@@ -0,0 +1,79 @@
+#ifndef NUMSIM_CAS_SERIALIZATION_H
+#define NUMSIM_CAS_SERIALIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iosfwd>
+#include <span>
+#include <variant>
+#include <vector>
+
+#include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/scalar/scalar_expression.h>
+#include <numsim_cas/tensor/tensor_expression.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_expression.h>
+
+namespace numsim::cas {
+
+// Binary DAG format for caching expressions between runs.
+//
+//   auto bytes = serialize_dag({dW_dC, S});           // any domains, mixed
+//   ...
+//   auto roots = deserialize_dag(bytes);              // or a mapped file
+//   auto S2 = std::get<expression_holder<tensor_expression>>(roots[1]);
+//
+// Every node is written once, children before parents, so a subexpression
+// shared between roots or inside one root is shared again after loading.
+// Symbols keep their numeric assumptions, tensor nodes their tensor_space
+// and tensor symbols their algebra assumptions (orthogonal, PD, ...).
+//
+// Layout (all integers little-endian, no padding or alignment needs):
+//
+//   header    "NSCASDAG", u32 version, u64 node-set fingerprint,
+//             u32 node count, u32 child count, u32 root count,
+//             u64 payload size                                  (40 bytes)
+//   nodes     per node: u8 domain, u8 flags, u16 type id (position in the
+//             domain's node list), u32 first child, u32 child count,
+//             u32 payload offset, u32 payload size              (20 bytes)
+//   children  u32 node index per edge
+//   roots     u32 node index per root
+//   payload   names, constants, index sequences, kinds, assumptions
+//
+// The fingerprint is a hash of the node type names of all three domains in
+// list order, so a file written by a build with a different node set (one
+// added, removed, renamed or moved) is rejected instead of misread. Sums
+// and products are rebuilt with their children as stored, without running
+// the simplifier over them again.
+// deserialize_dag reads the buffer in place and never copies it, so a
+// memory-mapped file can be passed directly. The nodes are rebuilt through
+// the same factories as the rebuild visitors.
+using serialized_expression =
+    std::variant<expression_holder<scalar_expression>,
+                 expression_holder<tensor_expression>,
+                 expression_holder<tensor_to_scalar_expression>>;
+
+inline constexpr std::uint32_t dag_format_version{2};
+
+// Throws invalid_expression_error for an invalid root.
+[[nodiscard]] std::vector<std::byte>
+serialize_dag(std::span<serialized_expression const> roots);
+
+[[nodiscard]] inline std::vector<std::byte>
+serialize_dag(std::initializer_list<serialized_expression> roots) {
+  return serialize_dag(std::span<serialized_expression const>(roots));
+}
+
+void write_dag(std::ostream &out,
+               std::span<serialized_expression const> roots);
+
+// Throws serialization_error for a truncated, foreign or corrupt buffer.
+[[nodiscard]] std::vector<serialized_expression>
+deserialize_dag(std::span<std::byte const> buffer);
+
+// Reads the remainder of `in` into memory and deserializes it.
+[[nodiscard]] std::vector<serialized_expression> read_dag(std::istream &in);
+
+} // namespace numsim::cas
+
+#endif // NUMSIM_CAS_SERIALIZATION_H
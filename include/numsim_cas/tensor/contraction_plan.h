@@ -0,0 +1,65 @@
+#ifndef CONTRACTION_PLAN_H
+#define CONTRACTION_PLAN_H
+
+#include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/numsim_cas_forward.h>
+#include <numsim_cas/tensor/index_list.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace numsim::cas {
+
+class inner_product_wrapper;
+class tensor_mul;
+
+// One pairwise contraction of an evaluation plan. The result replaces the
+// lhs slot; its indices are the free lhs indices followed by the free rhs
+// indices, each in their original order (tensor_data_inner_product).
+struct contraction_step {
+  std::size_t lhs{0};
+  std::size_t rhs{0};
+  index_list lhs_indices;
+  index_list rhs_indices;
+  std::size_t result_rank{0};
+};
+
+// Evaluation order for a network of nested tensor_mul chains and
+// inner_product_wrapper nodes, matrix-chain / opt_einsum style.
+//
+// The network is flattened into its operands (every child that is not
+// itself a tensor_mul without coefficient or an inner_product_wrapper; an
+// inner product with a projector on the left stays an operand so the
+// evaluator keeps its sym/dev/vol/skew shortcut). Each operand index gets a
+// label, contracted pairs share one. A subset DP over the operands then
+// picks the association that minimises the multiply count, which for
+// equal dims is d^(#indices touched) per pairwise contraction. Products
+// without a shared index (outer products) and intermediates above the
+// evaluator's rank limit are never formed.
+//
+// Networks with more than max_planned_operands operands, or where the DP
+// finds nothing cheaper, keep the order written in the expression.
+struct contraction_plan {
+  static constexpr std::size_t max_planned_operands = 10;
+
+  // Evaluated by the caller, one slot each.
+  std::vector<expression_holder<tensor_expression>> operands;
+  std::vector<contraction_step> steps;
+  std::size_t result_slot{0};
+  // Applied to the final slot when the planned order leaves the indices
+  // in a different order (tensor_data_permute_indices convention); empty
+  // when no permutation is needed.
+  index_list permutation;
+  // Estimated multiplies of the chosen and of the as-written order.
+  std::size_t cost{0};
+  std::size_t written_cost{0};
+};
+
+// The plan of the network rooted at `node`, built on first use and cached
+// on the node. A tensor_mul coefficient is not part of the plan.
+contraction_plan const &plan_contractions(inner_product_wrapper const &node);
+contraction_plan const &plan_contractions(tensor_mul const &node);
+
+} // namespace numsim::cas
+
+#endif // CONTRACTION_PLAN_H
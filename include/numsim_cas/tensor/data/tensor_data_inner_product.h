@@ -5,7 +5,7 @@
 #include "tensor_data_permute_indices.h"
 #include <cstdlib>
 #include <numsim_cas/core/cas_error.h>
-#include <vector>
+#include <numsim_cas/tensor/index_list.h>
 
 namespace numsim::cas {
 
@@ -17,8 +17,8 @@ public:
   tensor_data_inner_product(tensor_data_base<ValueType> &result,
                             tensor_data_base<ValueType> const &lhs,
                             tensor_data_base<ValueType> const &rhs,
-                            std::vector<std::size_t> const &lhs_indices,
-                            std::vector<std::size_t> const &rhs_indices)
+                            index_list const &lhs_indices,
+                            index_list const &rhs_indices)
       : m_result(result), m_lhs(lhs), m_rhs(rhs), m_lhs_indices(lhs_indices),
         m_rhs_indices(rhs_indices) {}
 
@@ -26,35 +26,31 @@ public:
   void evaluate_imp() {
     const auto size_lhs{m_lhs_indices.size()};
     const auto size_rhs{m_rhs_indices.size()};
-    std::vector<std::size_t> lhs_indices(m_lhs_indices);
-    std::vector<std::size_t> rhs_indices(m_rhs_indices);
-    std::vector<std::size_t> lhs_sequence(RankLHS);
-    std::vector<std::size_t> rhs_sequence(RankRHS);
-    std::vector<std::size_t> sequence_outer_lhs;
-    std::vector<std::size_t> sequence_outer_rhs;
-    std::vector<std::size_t> new_basis_lhs;
-    std::vector<std::size_t> new_basis_rhs;
+    index_list lhs_indices(m_lhs_indices);
+    index_list rhs_indices(m_rhs_indices);
+    index_list lhs_sequence(RankLHS);
+    index_list rhs_sequence(RankRHS);
+    index_list sequence_outer_lhs;
+    index_list sequence_outer_rhs;
+    index_list new_basis_lhs;
+    index_list new_basis_rhs;
 
     std::sort(lhs_indices.begin(), lhs_indices.end());
     std::sort(rhs_indices.begin(), rhs_indices.end());
-    std::iota(lhs_sequence.begin(), lhs_sequence.end(), 0ul);
-    std::iota(rhs_sequence.begin(), rhs_sequence.end(), 0ul);
-    sequence_outer_lhs.reserve(RankLHS);
+    std::iota(lhs_sequence.begin(), lhs_sequence.end(), std::uint8_t{0});
+    std::iota(rhs_sequence.begin(), rhs_sequence.end(), std::uint8_t{0});
     std::set_difference(lhs_sequence.begin(), lhs_sequence.end(),
                         lhs_indices.begin(), lhs_indices.end(),
                         std::back_inserter(sequence_outer_lhs));
-    sequence_outer_rhs.reserve(RankRHS);
     std::set_difference(rhs_sequence.begin(), rhs_sequence.end(),
                         rhs_indices.begin(), rhs_indices.end(),
                         std::back_inserter(sequence_outer_rhs));
 
-    new_basis_lhs.reserve(RankLHS);
     new_basis_lhs.insert(new_basis_lhs.end(), sequence_outer_lhs.begin(),
                          sequence_outer_lhs.end());
     new_basis_lhs.insert(new_basis_lhs.end(), m_lhs_indices.begin(),
                          m_lhs_indices.end());
 
-    new_basis_rhs.reserve(RankRHS);
     new_basis_rhs.insert(new_basis_rhs.end(), m_rhs_indices.begin(),
                          m_rhs_indices.end());
     new_basis_rhs.insert(new_basis_rhs.end(), sequence_outer_rhs.begin(),
@@ -65,13 +61,13 @@ public:
     // which original dim goes to position k). permute_indices needs the
     // inverse: m[k] = which output index feeds into the k-th slot of the
     // source.
-    std::vector<std::size_t> inv_basis_lhs(RankLHS);
+    index_list inv_basis_lhs(RankLHS);
     for (std::size_t i = 0; i < RankLHS; ++i)
-      inv_basis_lhs[new_basis_lhs[i]] = i;
+      inv_basis_lhs[new_basis_lhs[i]] = static_cast<std::uint8_t>(i);
 
-    std::vector<std::size_t> inv_basis_rhs(RankRHS);
+    index_list inv_basis_rhs(RankRHS);
     for (std::size_t i = 0; i < RankRHS; ++i)
-      inv_basis_rhs[new_basis_rhs[i]] = i;
+      inv_basis_rhs[new_basis_rhs[i]] = static_cast<std::uint8_t>(i);
 
     bool permute_indices_lhs{false};
     if (lhs_sequence != new_basis_lhs) {
@@ -161,8 +157,8 @@ private:
   tensor_data_base<ValueType> &m_result;
   tensor_data_base<ValueType> const &m_lhs;
   tensor_data_base<ValueType> const &m_rhs;
-  std::vector<std::size_t> const &m_lhs_indices;
-  std::vector<std::size_t> const &m_rhs_indices;
+  index_list const &m_lhs_indices;
+  index_list const &m_rhs_indices;
   std::unique_ptr<tensor_data_base<ValueType>> m_lhs_temp;
   std::unique_ptr<tensor_data_base<ValueType>> m_rhs_temp;
 };
@@ -0,0 +1,218 @@
+#ifndef TENSOR_DATA_LAYOUT_H
+#define TENSOR_DATA_LAYOUT_H
+
+#include <numsim_cas/core/cas_error.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <numbers>
+#include <string>
+#include <utility>
+
+namespace numsim::cas {
+
+// Memory layout of caller-owned tensor arrays (tensor_evaluator::set_view,
+// tensor_evaluator::apply_into).
+//
+//   full    all d^r components, row-major (same as tensor_data::raw_data)
+//   voigt         rank 2 or 4 with minor symmetry; the index pairs are
+//                 numbered 11, 22, 33, 23, 13, 12 (2D: 11, 22, 12; 1D: 11).
+//                 Components are stored as they are (stress-like, and the
+//                 stiffness C_KL), a rank-4 tensor as an n x n matrix,
+//                 row-major
+//   voigt_strain  like voigt, but every shear pair carries a factor 2
+//                 (strain-like: engineering shear 2 e_12, compliance with 2
+//                 and 4 on the shear rows/columns), so that a stress in voigt
+//                 dotted with a strain in voigt_strain is a:b
+//   mandel        like voigt, but every shear pair carries a factor sqrt(2),
+//                 so that a:b and C:a become plain dot / matrix-vector
+//                 products in a single layout
+//
+// Packing into the reduced layouts symmetrizes over the minor pairs; unpacking
+// writes every symmetric partner.
+enum class tensor_layout { full, voigt, voigt_strain, mandel };
+
+// Non-owning binding of a tensor symbol to a caller array in `layout`.
+template <typename ValueType> struct tensor_data_view {
+  ValueType const *data{nullptr};
+  std::size_t dim{0};
+  std::size_t rank{0};
+  tensor_layout layout{tensor_layout::full};
+};
+
+namespace detail {
+
+inline std::size_t layout_pow(std::size_t d, std::size_t r) noexcept {
+  std::size_t size{1};
+  for (std::size_t i{0}; i < r; ++i)
+    size *= d;
+  return size;
+}
+
+// Index pair of the K-th Voigt component.
+inline std::pair<std::size_t, std::size_t> voigt_pair(std::size_t dim,
+                                                      std::size_t k) noexcept {
+  static constexpr std::array<std::pair<std::size_t, std::size_t>, 6> pairs3{
+      {{0, 0}, {1, 1}, {2, 2}, {1, 2}, {0, 2}, {0, 1}}};
+  static constexpr std::array<std::pair<std::size_t, std::size_t>, 3> pairs2{
+      {{0, 0}, {1, 1}, {0, 1}}};
+  if (dim == 3)
+    return pairs3[k];
+  if (dim == 2)
+    return pairs2[k];
+  return {0, 0};
+}
+
+inline void check_layout(char const *caller, std::size_t dim, std::size_t rank,
+                         tensor_layout layout) {
+  if (dim == 0 || dim > 3)
+    throw evaluation_error(std::string(caller) + ": dim must be 1, 2 or 3");
+  if (layout != tensor_layout::full && rank != 2 && rank != 4)
+    throw evaluation_error(std::string(caller) +
+                           ": voigt/voigt_strain/mandel layouts need rank 2 "
+                           "or 4");
+}
+
+template <typename ValueType>
+ValueType layout_weight(std::size_t dim, std::size_t k,
+                        tensor_layout layout) noexcept {
+  auto const [i, j] = voigt_pair(dim, k);
+  if (i == j)
+    return ValueType{1};
+  if (layout == tensor_layout::mandel)
+    return static_cast<ValueType>(std::numbers::sqrt2);
+  if (layout == tensor_layout::voigt_strain)
+    return ValueType{2};
+  return ValueType{1};
+}
+
+} // namespace detail
+
+// Number of values of a (dim, rank) tensor in `layout`.
+inline std::size_t tensor_layout_size(std::size_t dim, std::size_t rank,
+                                      tensor_layout layout) {
+  detail::check_layout("tensor_layout_size", dim, rank, layout);
+  if (layout == tensor_layout::full)
+    return detail::layout_pow(dim, rank);
+  return detail::layout_pow(dim * (dim + 1) / 2, rank / 2);
+}
+
+// full (row-major d^r) -> layout
+template <typename ValueType>
+void tensor_layout_pack(ValueType *out, ValueType const *full, std::size_t dim,
+                        std::size_t rank, tensor_layout layout) {
+  detail::check_layout("tensor_layout_pack", dim, rank, layout);
+  if (layout == tensor_layout::full) {
+    std::memcpy(out, full, detail::layout_pow(dim, rank) * sizeof(ValueType));
+    return;
+  }
+  auto const n = dim * (dim + 1) / 2;
+  auto const half = ValueType{1} / ValueType{2};
+  if (rank == 2) {
+    for (std::size_t k = 0; k < n; ++k) {
+      auto const [i, j] = detail::voigt_pair(dim, k);
+      out[k] = detail::layout_weight<ValueType>(dim, k, layout) * half *
+               (full[i * dim + j] + full[j * dim + i]);
+    }
+    return;
+  }
+  auto const quarter = half * half;
+  auto at = [&](std::size_t i, std::size_t j, std::size_t k, std::size_t l) {
+    return full[((i * dim + j) * dim + k) * dim + l];
+  };
+  for (std::size_t K = 0; K < n; ++K) {
+    auto const [i, j] = detail::voigt_pair(dim, K);
+    for (std::size_t L = 0; L < n; ++L) {
+      auto const [k, l] = detail::voigt_pair(dim, L);
+      out[K * n + L] = detail::layout_weight<ValueType>(dim, K, layout) *
+                       detail::layout_weight<ValueType>(dim, L, layout) *
+                       quarter *
+                       (at(i, j, k, l) + at(j, i, k, l) + at(i, j, l, k) +
+                        at(j, i, l, k));
+    }
+  }
+}
+
+// layout -> full (row-major d^r)
+template <typename ValueType>
+void tensor_layout_unpack(ValueType *full, ValueType const *packed,
+                          std::size_t dim, std::size_t rank,
+                          tensor_layout layout) {
+  detail::check_layout("tensor_layout_unpack", dim, rank, layout);
+  if (layout == tensor_layout::full) {
+    std::memcpy(full, packed,
+                detail::layout_pow(dim, rank) * sizeof(ValueType));
+    return;
+  }
+  auto const n = dim * (dim + 1) / 2;
+  if (rank == 2) {
+    for (std::size_t k = 0; k < n; ++k) {
+      auto const [i, j] = detail::voigt_pair(dim, k);
+      auto const value =
+          packed[k] / detail::layout_weight<ValueType>(dim, k, layout);
+      full[i * dim + j] = value;
+      full[j * dim + i] = value;
+    }
+    return;
+  }
+  auto at = [&](std::size_t i, std::size_t j, std::size_t k,
+                std::size_t l) -> ValueType & {
+    return full[((i * dim + j) * dim + k) * dim + l];
+  };
+  for (std::size_t K = 0; K < n; ++K) {
+    auto const [i, j] = detail::voigt_pair(dim, K);
+    for (std::size_t L = 0; L < n; ++L) {
+      auto const [k, l] = detail::voigt_pair(dim, L);
+      auto const value =
+          packed[K * n + L] /
+          (detail::layout_weight<ValueType>(dim, K, layout) *
+           detail::layout_weight<ValueType>(dim, L, layout));
+      at(i, j, k, l) = value;
+      at(j, i, k, l) = value;
+      at(i, j, l, k) = value;
+      at(j, i, l, k) = value;
+    }
+  }
+}
+
+// in_layout -> out_layout without going through a full tensor where the
+// two layouts allow it (between voigt, voigt_strain and mandel only the
+// shear pairs are rescaled).
+template <typename ValueType>
+void tensor_layout_convert(ValueType *out, tensor_layout out_layout,
+                           ValueType const *in, tensor_layout in_layout,
+                           std::size_t dim, std::size_t rank) {
+  detail::check_layout("tensor_layout_convert", dim, rank, in_layout);
+  detail::check_layout("tensor_layout_convert", dim, rank, out_layout);
+  if (in_layout == out_layout) {
+    std::memcpy(out, in,
+                tensor_layout_size(dim, rank, in_layout) * sizeof(ValueType));
+    return;
+  }
+  if (in_layout == tensor_layout::full) {
+    tensor_layout_pack(out, in, dim, rank, out_layout);
+    return;
+  }
+  if (out_layout == tensor_layout::full) {
+    tensor_layout_unpack(out, in, dim, rank, in_layout);
+    return;
+  }
+  auto const n = dim * (dim + 1) / 2;
+  auto scale = [&](std::size_t k) {
+    return detail::layout_weight<ValueType>(dim, k, out_layout) /
+           detail::layout_weight<ValueType>(dim, k, in_layout);
+  };
+  if (rank == 2) {
+    for (std::size_t k = 0; k < n; ++k)
+      out[k] = scale(k) * in[k];
+    return;
+  }
+  for (std::size_t K = 0; K < n; ++K)
+    for (std::size_t L = 0; L < n; ++L)
+      out[K * n + L] = scale(K) * scale(L) * in[K * n + L];
+}
+
+} // namespace numsim::cas
+
+#endif // TENSOR_DATA_LAYOUT_H
@@ -4,6 +4,7 @@
 #include "../../numsim_cas_type_traits.h"
 #include "tensor_data.h"
 #include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/tensor/index_list.h>
 
 namespace numsim::cas {
 
@@ -15,8 +16,8 @@ public:
   tensor_data_outer_product(tensor_data_base<ValueType> &result,
                             tensor_data_base<ValueType> const &lhs,
                             tensor_data_base<ValueType> const &rhs,
-                            std::vector<std::size_t> const &lhs_indices,
-                            std::vector<std::size_t> const &rhs_indices)
+                            index_list const &lhs_indices,
+                            index_list const &rhs_indices)
       : m_result(result), m_lhs(lhs), m_rhs(rhs), m_lhs_indices(lhs_indices),
         m_rhs_indices(rhs_indices) {}
 
@@ -68,8 +69,8 @@ private:
   tensor_data_base<ValueType> &m_result;
   tensor_data_base<ValueType> const &m_lhs;
   tensor_data_base<ValueType> const &m_rhs;
-  std::vector<std::size_t> const &m_lhs_indices;
-  std::vector<std::size_t> const &m_rhs_indices;
+  index_list const &m_lhs_indices;
+  index_list const &m_rhs_indices;
 };
 
 } // namespace numsim::cas
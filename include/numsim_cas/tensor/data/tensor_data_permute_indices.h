@@ -2,6 +2,7 @@
 #define TENSOR_DATA_PERMUTE_INDICES_H
 
 #include "tensor_data.h"
+#include <numsim_cas/tensor/index_list.h>
 #include <numsim_cas/core/cas_error.h>
 
 namespace numsim::cas {
@@ -13,7 +14,7 @@ class tensor_data_permute_indices final
 public:
   tensor_data_permute_indices(tensor_data_base<ValueType> &lhs,
                               tensor_data_base<ValueType> const &rhs,
-                              std::vector<std::size_t> const &indices)
+                              index_list const &indices)
       : m_lhs(lhs), m_rhs(rhs), m_indices(indices) {}
 
   tensor_data_permute_indices(tensor_data_permute_indices const &) = delete;
@@ -26,11 +27,11 @@ public:
   inline void evaluate_imp() noexcept {
     using Tensor = tensor_data<ValueType, Dim, Rank>;
     auto func = [&](auto... args) {
-      using sequence = std::make_index_sequence<Rank>;
+      using index_sequence = std::make_index_sequence<Rank>;
       std::array<std::size_t, Rank> input{args...};
       auto &lhs{static_cast<Tensor &>(m_lhs).data()};
       const auto &rhs{static_cast<const Tensor &>(m_rhs).data()};
-      lhs(args...) = tuple_call(rhs, m_indices, input, sequence());
+      lhs(args...) = tuple_call(rhs, m_indices, input, index_sequence());
     };
     tmech::detail::for_loop_t<Rank - 1, Dim>::for_loop(func);
   }
@@ -57,7 +58,7 @@ private:
 
   tensor_data_base<ValueType> &m_lhs;
   tensor_data_base<ValueType> const &m_rhs;
-  std::vector<std::size_t> const &m_indices;
+  index_list const &m_indices;
 };
 
 } // namespace numsim::cas
@@ -0,0 +1,62 @@
+#ifndef TENSOR_DATA_PRECISION_H
+#define TENSOR_DATA_PRECISION_H
+
+#include "tensor_data.h"
+#include "tensor_data_make_imp.h"
+#include <numsim_cas/core/evaluation_precision.h>
+
+#include <cstddef>
+#include <memory>
+
+namespace numsim::cas {
+
+// Elementwise copy of `src` into a new tensor of value type To.
+template <typename To, typename From>
+std::unique_ptr<tensor_data_base<To>>
+convert_tensor_data(tensor_data_base<From> const &src) {
+  auto result = make_tensor_data_imp<To>().evaluate(src.dim(), src.rank());
+  std::size_t size{1};
+  for (std::size_t i{0}; i < src.rank(); ++i)
+    size *= src.dim();
+  auto const *in = src.raw_data();
+  auto *out = result->raw_data();
+  for (std::size_t i{0}; i < size; ++i)
+    out[i] = static_cast<To>(in[i]);
+  return result;
+}
+
+// Runs the tensor -> tensor kernel `f(result, input)` in the promoted
+// precision of ValueType. `f` is called with tensor_data_base<W> arguments,
+// W being either ValueType or promoted_value_t<ValueType>.
+template <typename ValueType, typename F>
+std::unique_ptr<tensor_data_base<ValueType>>
+evaluate_promoted(tensor_data_base<ValueType> const &src, std::size_t dim,
+                  std::size_t rank, F &&f) {
+  if constexpr (is_promoted_v<ValueType>) {
+    using W = promoted_value_t<ValueType>;
+    auto wide = convert_tensor_data<W>(src);
+    auto wide_result = make_tensor_data_imp<W>().evaluate(dim, rank);
+    f(*wide_result, *wide);
+    return convert_tensor_data<ValueType>(*wide_result);
+  } else {
+    auto result = make_tensor_data_imp<ValueType>().evaluate(dim, rank);
+    f(*result, src);
+    return result;
+  }
+}
+
+// Tensor -> scalar variant: `f(input)` returns the promoted scalar.
+template <typename ValueType, typename F>
+ValueType evaluate_promoted_scalar(tensor_data_base<ValueType> const &src,
+                                   F &&f) {
+  if constexpr (is_promoted_v<ValueType>) {
+    auto wide = convert_tensor_data<promoted_value_t<ValueType>>(src);
+    return static_cast<ValueType>(f(*wide));
+  } else {
+    return f(src);
+  }
+}
+
+} // namespace numsim::cas
+
+#endif // TENSOR_DATA_PRECISION_H
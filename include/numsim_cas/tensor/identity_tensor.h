@@ -143,6 +143,10 @@ public:
     hash_combine(base::m_hash_value, this->rank());
   }
 
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
+
   // Closed-form constant: the structural classification is intrinsic to the
   // type and cannot be removed. Override the base's clear_space() to a
   // no-op so an external caller invoking clear_space() through a
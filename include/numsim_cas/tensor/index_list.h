@@ -0,0 +1,23 @@
+#ifndef INDEX_LIST_H
+#define INDEX_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <numsim_cas/core/small_vector.h>
+
+namespace numsim::cas {
+
+// Highest rank the tensor_data evaluators are instantiated for
+// (tensor_data_eval_up_unary / tensor_data_eval_up_binary).
+inline constexpr std::size_t max_eval_rank{8};
+
+// 0-based index positions of one tensor: a permutation, the contracted
+// slots of an inner product, the lhs/rhs split of an outer product. A
+// position always fits in a byte, and up to max_eval_rank of them are kept
+// inside the object, so sequences and the tensor_data kernels do not
+// allocate for any rank that can be evaluated.
+using index_list = small_vector<std::uint8_t, max_eval_rank>;
+
+} // namespace numsim::cas
+
+#endif // INDEX_LIST_H
@@ -108,6 +108,10 @@ public:
     hash_combine(base::m_hash_value, this->dim());
     // rank == dim, no need to fold it in separately.
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
 };
 
 inline bool operator<(levi_civita_tensor const &lhs,
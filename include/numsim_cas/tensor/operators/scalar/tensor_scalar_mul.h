@@ -14,6 +14,7 @@ class tensor_scalar_mul final
 public:
   using base = binary_op<tensor_node_base_t<tensor_scalar_mul>,
                          scalar_expression, tensor_expression>;
+  static constexpr std::uint8_t static_node_flags{node_flags::scaled};
 
   template <typename LHS, typename RHS>
   tensor_scalar_mul(LHS &&lhs, RHS &&rhs)
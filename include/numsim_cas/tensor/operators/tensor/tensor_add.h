@@ -41,7 +41,7 @@ public:
   inline void recompute_space() {
     this->clear_space();
     bool first{true};
-    for (auto const &child : this->symbol_map() | std::views::values) {
+    for (auto const &child : this->symbol_map()) {
       if (first) {
         if (auto const &sp = child.get().space())
           this->set_space(*sp);
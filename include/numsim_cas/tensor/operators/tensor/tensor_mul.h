@@ -4,8 +4,12 @@
 #include <numsim_cas/core/n_ary_vector.h>
 #include <numsim_cas/tensor/tensor_expression.h>
 
+#include <memory>
+
 namespace numsim::cas {
 
+struct contraction_plan;
+
 class tensor_mul final : public n_ary_vector<tensor_node_base_t<tensor_mul>> {
 public:
   using base = n_ary_vector<tensor_node_base_t<tensor_mul>>;
@@ -24,6 +28,16 @@ public:
   }
   ~tensor_mul() override = default;
   const tensor_mul &operator=(tensor_mul &&) = delete;
+
+  // Evaluation order of the chain, filled in by plan_contractions()
+  // (tensor/contraction_plan.h) on first evaluation. Not copied: a copy is
+  // usually made to be modified.
+  [[nodiscard]] auto &contraction_plan_cache() const noexcept {
+    return m_contraction_plan;
+  }
+
+private:
+  mutable std::shared_ptr<contraction_plan const> m_contraction_plan;
 };
 
 } // NAMESPACE numsim::cas
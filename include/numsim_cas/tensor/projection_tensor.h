@@ -104,6 +104,10 @@ public:
         sp.trace);
   }
 
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
+
 private:
   std::size_t r_;
 };
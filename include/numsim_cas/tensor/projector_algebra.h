@@ -2,6 +2,7 @@
 #define PROJECTOR_ALGEBRA_H
 
 #include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/profiling.h>
 #include <numsim_cas/tensor/projection_tensor.h>
 #include <numsim_cas/tensor/wrappers/inner_product_wrapper.h>
 #include <optional>
@@ -81,8 +82,9 @@ as_projector_contraction(expression_holder<tensor_expression> const &expr) {
 
 enum class ContractionRule { Idempotent, Zero, LhsSubspace, RhsSubspace };
 
-inline std::optional<ContractionRule> contraction_rule(ProjKind lhs,
-                                                       ProjKind rhs) {
+namespace detail {
+inline std::optional<ContractionRule> contraction_rule_table(ProjKind lhs,
+                                                             ProjKind rhs) {
   if (lhs == rhs)
     return ContractionRule::Idempotent;
 
@@ -113,14 +115,27 @@ inline std::optional<ContractionRule> contraction_rule(ProjKind lhs,
 
   return std::nullopt;
 }
+} // namespace detail
+
+inline std::optional<ContractionRule> contraction_rule(ProjKind lhs,
+                                                       ProjKind rhs) {
+  NUMSIM_CAS_PROFILE_ATTEMPT("projector_algebra::contraction_rule");
+  auto rule = detail::contraction_rule_table(lhs, rhs);
+  if (rule)
+    NUMSIM_CAS_PROFILE_HIT("projector_algebra::contraction_rule");
+  return rule;
+}
 
 /// Try to combine two projectors via addition.
 /// Returns the combined ProjKind or std::nullopt.
 inline std::optional<ProjKind> addition_rule(ProjKind a, ProjKind b) {
+  NUMSIM_CAS_PROFILE_ATTEMPT("projector_algebra::addition_rule");
   // Vol + Dev = Sym
   if ((a == ProjKind::Vol && b == ProjKind::Dev) ||
-      (a == ProjKind::Dev && b == ProjKind::Vol))
+      (a == ProjKind::Dev && b == ProjKind::Vol)) {
+    NUMSIM_CAS_PROFILE_HIT("projector_algebra::addition_rule");
     return ProjKind::Sym;
+  }
 
   // Sym + Skew = identity (not a projector - handled specially)
   // We return std::nullopt and handle it in the caller.
@@ -150,6 +165,7 @@ try_simplify_projector_contraction(
   if (outer == ProjKind::Other)
     return std::nullopt;
 
+  NUMSIM_CAS_PROFILE_ATTEMPT("projector_algebra::simplify_contraction");
   auto inner = as_projector_contraction(expr);
   if (!inner)
     return std::nullopt;
@@ -177,6 +193,7 @@ try_simplify_projector_contraction(
     break;
   }
 
+  NUMSIM_CAS_PROFILE_HIT("projector_algebra::simplify_contraction");
   return contraction_simplification{*rule, result, inner->argument,
                                     inner->proj->dim()};
 }
@@ -3,7 +3,9 @@
 
 #include <cstddef>
 #include <initializer_list>
+#include <limits>
 #include <numsim_cas/core/hash_functions.h>
+#include <numsim_cas/tensor/index_list.h>
 #include <ostream>
 #include <span>
 #include <stdexcept>
@@ -11,9 +13,12 @@
 
 namespace numsim::cas {
 
+// Ordered list of 0-based tensor index positions, written 1-based in the
+// initializer-list constructor and in operator<<. Stored as an index_list,
+// so a sequence up to max_eval_rank entries never touches the heap.
 class sequence {
 public:
-  using index_t = std::size_t;
+  using index_t = index_list::value_type;
 
   sequence() = default;
 
@@ -21,11 +26,14 @@ public:
   explicit sequence(std::size_t n) : m_data(n) {}
 
   // 1-based input -> store 0-based
-  sequence(std::initializer_list<index_t> one_based) : m_data(one_based) {
-    for (auto &i : m_data) {
+  sequence(std::initializer_list<std::size_t> one_based) {
+    m_data.reserve(one_based.size());
+    for (auto i : one_based) {
       if (i == 0)
         throw std::out_of_range("sequence: 1-based index cannot be 0");
-      --i;
+      if (i > std::size_t{std::numeric_limits<index_t>::max()} + 1)
+        throw std::out_of_range("sequence: index out of range");
+      m_data.push_back(static_cast<index_t>(i - 1));
     }
   }
 
@@ -45,12 +53,11 @@ public:
   index_t operator[](std::size_t i) const { return m_data[i]; }
 
   template <class InputIt>
-  void insert(typename std::vector<index_t>::iterator pos, InputIt first,
-              InputIt last) {
+  void insert(index_list::const_iterator pos, InputIt first, InputIt last) {
     m_data.insert(pos, first, last);
   }
 
-  const std::vector<index_t> &indices() const noexcept { return m_data; }
+  const index_list &indices() const noexcept { return m_data; }
 
   // comparisons (C++20)
   friend bool operator==(sequence const &, sequence const &) = default;
@@ -64,17 +71,17 @@ public:
     for (std::size_t i = 0; i < s.m_data.size(); ++i) {
       if (i)
         os << ", ";
-      os << (s.m_data[i] + 1);
+      os << (std::size_t{s.m_data[i]} + 1);
     }
     return os << '}';
   }
 
 private:
-  std::vector<index_t> m_data;
+  index_list m_data;
 };
 
 inline void hash_combine(std::size_t &seed, const sequence &value) {
-  for (const auto &c : value.indices()) {
+  for (std::size_t c : value.indices()) {
     hash_combine(seed, c);
   }
 }
@@ -148,7 +155,7 @@ inline std::vector<sequence> split_many(sequence const &s,
 // Permute by 0-based positions: perm[i] is in [0, n).
 // out[i] = in[perm[i]]
 inline sequence permute(sequence const &in,
-                        std::span<const sequence::index_t> perm) {
+                        std::span<const std::size_t> perm) {
   if (perm.size() != in.size())
     throw std::invalid_argument("permute: size mismatch");
 
@@ -174,7 +181,7 @@ inline sequence invert_perm(std::span<const std::size_t> perm) {
     if (seen[p])
       throw std::invalid_argument("invert_perm: duplicate entry");
     seen[p] = true;
-    inv[p] = i;
+    inv[p] = static_cast<sequence::index_t>(i);
   }
   return inv;
 }
@@ -55,7 +55,7 @@ protected:
                                           m_lhs.get().rank());
     }
     if (add.size() == 1 && !add.coeff().is_valid()) {
-      return add.symbol_map().begin()->second;
+      return *add.symbol_map().begin();
     }
     return add_new;
   }
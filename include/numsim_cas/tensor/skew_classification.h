@@ -2,6 +2,7 @@
 #define NUMSIM_CAS_TENSOR_SKEW_CLASSIFICATION_H
 
 #include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/profiling.h>
 #include <numsim_cas/tensor/operators/scalar/tensor_scalar_mul.h>
 #include <numsim_cas/tensor/operators/tensor/tensor_add.h>
 #include <numsim_cas/tensor/operators/tensor/tensor_mul.h>
@@ -32,17 +33,22 @@ namespace numsim::cas {
 is_provably_skew(expression_holder<tensor_expression> const &e) {
   if (!e.is_valid())
     return false;
+  NUMSIM_CAS_PROFILE_ATTEMPT("skew_classification::is_provably_skew");
   if (auto const &sp = e.get().space()) {
-    if (std::holds_alternative<Skew>(sp->perm))
+    if (std::holds_alternative<Skew>(sp->perm)) {
+      NUMSIM_CAS_PROFILE_HIT("skew_classification::space_annotation");
       return true;
+    }
   }
   // inner_product(P_skew, {3,4}, X, {1,2}) — the skew() projection
   if (is_same<inner_product_wrapper>(e)) {
     auto const &ip = e.template get<inner_product_wrapper>();
     if (is_same<tensor_projector>(ip.expr_lhs())) {
       auto const &proj = ip.expr_lhs().template get<tensor_projector>();
-      if (std::holds_alternative<Skew>(proj.space().perm))
+      if (std::holds_alternative<Skew>(proj.space().perm)) {
+        NUMSIM_CAS_PROFILE_HIT("skew_classification::skew_projection");
         return true;
+      }
     }
   }
   // tensor_add with exactly two children: trans(X) + (-X)
@@ -50,9 +56,9 @@ is_provably_skew(expression_holder<tensor_expression> const &e) {
     auto const &add = e.template get<tensor_add>();
     if (add.symbol_map().size() == 2) {
       auto it = add.symbol_map().begin();
-      auto const &c0 = it->second;
+      auto const &c0 = *it;
       ++it;
-      auto const &c1 = it->second;
+      auto const &c1 = *it;
       auto trans_of_neg = [](auto const &a, auto const &b) {
         if (!is_same<permute_indices_wrapper>(a))
           return false;
@@ -63,8 +69,10 @@ is_provably_skew(expression_holder<tensor_expression> const &e) {
           return false;
         return bc.expr() == b.template get<tensor_negative>().expr();
       };
-      if (trans_of_neg(c0, c1) || trans_of_neg(c1, c0))
+      if (trans_of_neg(c0, c1) || trans_of_neg(c1, c0)) {
+        NUMSIM_CAS_PROFILE_HIT("skew_classification::trans_minus_self");
         return true;
+      }
     }
   }
   return false;
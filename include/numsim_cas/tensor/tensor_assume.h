@@ -135,9 +135,8 @@ inline void
 assume_positive_definite(expression_holder<tensor_expression> const &expr) {
   detail::require_symbol(expr.get(), "assume_positive_definite");
   auto &a = expr.data()->tensor_algebra_assumptions();
-  a.insert(positive_definite{});
   // PD => PSD by definition.
-  a.insert(positive_semidefinite{});
+  a.insert_implied(positive_definite{});
   // PD => symmetric (cross-mechanism implication onto the space field).
   detail::set_symmetric_unless_more_specific(expr.data().get());
 }
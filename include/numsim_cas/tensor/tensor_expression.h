@@ -13,6 +13,7 @@ namespace numsim::cas {
 class tensor_expression : public expression {
 public:
   using expr_t = tensor_expression;
+  static constexpr expression_domain node_domain{expression_domain::tensor};
 
   tensor_expression() = default;
   tensor_expression(std::size_t dim, std::size_t rank)
@@ -507,6 +507,47 @@ template <tensor_expr_holder Expr>
   return make_expression<tensor_inv>(std::forward<Expr>(expr));
 }
 
+// Partial products of a contracted chain f_0 * ... * f_{n-1} (last index
+// of the left factor with the first index of the right one), used by the
+// tensor_mul product rules. prefix[j] = f_0 * ... * f_{j-1} for j <= last,
+// suffix[j] = f_{j+1} * ... * f_{n-1} for j >= first; empty products are
+// invalid holders. Each product is built once from its neighbour, so all
+// product-rule terms share them.
+struct chain_partial_products {
+  std::vector<expression_holder<tensor_expression>> prefix;
+  std::vector<expression_holder<tensor_expression>> suffix;
+};
+
+[[nodiscard]] inline chain_partial_products make_chain_partial_products(
+    expr_vector<expression_holder<tensor_expression>> const &factors,
+    std::size_t first, std::size_t last) {
+  auto const n = factors.size();
+  chain_partial_products result{
+      std::vector<expression_holder<tensor_expression>>(last + 1),
+      std::vector<expression_holder<tensor_expression>>(n)};
+  auto &prefix = result.prefix;
+  for (std::size_t j = 1; j <= last; ++j) {
+    if (!prefix[j - 1].is_valid()) {
+      prefix[j] = factors[j - 1];
+    } else {
+      auto rank_lhs = prefix[j - 1].get().rank();
+      prefix[j] = inner_product(prefix[j - 1], sequence{rank_lhs},
+                                factors[j - 1], sequence{1});
+    }
+  }
+  auto &suffix = result.suffix;
+  for (std::size_t j = n - 1; j-- > first;) {
+    if (!suffix[j + 1].is_valid()) {
+      suffix[j] = factors[j + 1];
+    } else {
+      auto rank_lhs = factors[j + 1].get().rank();
+      suffix[j] = inner_product(factors[j + 1], sequence{rank_lhs},
+                                suffix[j + 1], sequence{1});
+    }
+  }
+  return result;
+}
+
 // Eigenprojections E_i = n_i ⊗ n_i and eigenvectors n_i live behind the
 // eigen_decomposition facade (numsim_cas/eigen_decomposition.h):
 // eigen_decomposition(A).basis(i) and eigen_decomposition(A).normal(i).
@@ -124,6 +124,7 @@ inline expression_holder<tensor_expression> tag_invoke(add_fn, L &&lhs,
     };
     if (is_trans_of_neg(lhs, rhs) || is_trans_of_neg(rhs, lhs)) {
       auto &_lhs{lhs.template get<tensor_visitable_t>()};
+      NUMSIM_CAS_PROFILE_SCOPE("tensor::add_base");
       simplifier::tensor_detail::add_base visitor(std::forward<L>(lhs),
                                                   std::forward<R>(rhs));
       auto result = _lhs.accept(visitor);
@@ -139,6 +140,7 @@ inline expression_holder<tensor_expression> tag_invoke(add_fn, L &&lhs,
     // above, so a match here means a genuine plus. Closes #390.
     if (is_trans_of(lhs, rhs) || is_trans_of(rhs, lhs)) {
       auto &_lhs{lhs.template get<tensor_visitable_t>()};
+      NUMSIM_CAS_PROFILE_SCOPE("tensor::add_base");
       simplifier::tensor_detail::add_base visitor(std::forward<L>(lhs),
                                                   std::forward<R>(rhs));
       auto result = _lhs.accept(visitor);
@@ -149,6 +151,7 @@ inline expression_holder<tensor_expression> tag_invoke(add_fn, L &&lhs,
   }
 
   auto &_lhs{lhs.template get<tensor_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor::add_base");
   simplifier::tensor_detail::add_base visitor(std::forward<L>(lhs),
                                               std::forward<R>(rhs));
   return _lhs.accept(visitor);
@@ -175,6 +178,7 @@ inline expression_holder<tensor_expression> tag_invoke(sub_fn, L &&lhs,
   if (lhs.get().rank() == 2) {
     if (is_trans_of(lhs, rhs) || is_trans_of(rhs, lhs)) {
       auto &_lhs{lhs.template get<tensor_visitable_t>()};
+      NUMSIM_CAS_PROFILE_SCOPE("tensor::sub_base");
       tensor_detail::simplifier::sub_base visitor(std::forward<L>(lhs),
                                                   std::forward<R>(rhs));
       auto result = _lhs.accept(visitor);
@@ -188,6 +192,7 @@ inline expression_holder<tensor_expression> tag_invoke(sub_fn, L &&lhs,
     }
   }
   auto &_lhs{lhs.template get<tensor_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor::sub_base");
   tensor_detail::simplifier::sub_base visitor(std::forward<L>(lhs),
                                               std::forward<R>(rhs));
   return _lhs.accept(visitor);
@@ -235,6 +240,7 @@ tag_invoke(mul_fn, L &&lhs, [[maybe_unused]] R &&rhs) {
     // PD). Closes #389.
     if (is_trans_of(lhs, rhs) || is_trans_of(rhs, lhs)) {
       auto &_lhs{lhs.template get<tensor_visitable_t>()};
+      NUMSIM_CAS_PROFILE_SCOPE("tensor::mul_base");
       tensor_detail::simplifier::mul_base visitor(std::forward<L>(lhs),
                                                   std::forward<R>(rhs));
       auto result = _lhs.accept(visitor);
@@ -247,6 +253,7 @@ tag_invoke(mul_fn, L &&lhs, [[maybe_unused]] R &&rhs) {
     }
   }
   auto &_lhs{lhs.template get<tensor_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor::mul_base");
   tensor_detail::simplifier::mul_base visitor(std::forward<L>(lhs),
                                               std::forward<R>(rhs));
   auto result = _lhs.accept(visitor);
@@ -296,6 +303,7 @@ inline expression_holder<tensor_expression> tag_invoke(mul_fn, L &&lhs,
       lhs.get().tensor_algebra_assumptions().contains(positive_definite{});
   const bool t_psd = t_pd || lhs.get().tensor_algebra_assumptions().contains(
                                  positive_semidefinite{});
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_with_scalar::mul_base");
   tensor_with_scalar_detail::simplifier::mul_base visitor(std::forward<R>(rhs),
                                                           std::forward<L>(lhs));
   auto result = _lhs.accept(visitor);
@@ -329,6 +337,7 @@ inline expression_holder<tensor_expression> tag_invoke(mul_fn, L &&lhs,
       rhs.get().tensor_algebra_assumptions().contains(positive_definite{});
   const bool t_psd = t_pd || rhs.get().tensor_algebra_assumptions().contains(
                                  positive_semidefinite{});
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_with_scalar::mul_base");
   tensor_with_scalar_detail::simplifier::mul_base visitor(std::forward<L>(lhs),
                                                           std::forward<R>(rhs));
   auto result = _rhs.accept(visitor);
@@ -377,6 +386,7 @@ inline expression_holder<tensor_expression> tag_invoke(mul_fn, L &&lhs,
   // dereferencing `_lhs` after the forward is safe. This is the same
   // pattern used by the `(tensor, scalar)` overload above.
   auto &_lhs{lhs.template get<tensor_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_with_tensor_to_scalar::mul_base");
   tensor_with_tensor_to_scalar_detail::simplifier::mul_base visitor(
       std::forward<L>(lhs), std::forward<R>(rhs));
   return _lhs.accept(visitor);
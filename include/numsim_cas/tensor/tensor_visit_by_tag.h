@@ -0,0 +1,13 @@
+#ifndef TENSOR_VISIT_BY_TAG_H
+#define TENSOR_VISIT_BY_TAG_H
+
+#include <numsim_cas/core/visit_by_tag.h>
+#include <numsim_cas/tensor/tensor_definitions.h>
+
+namespace numsim::cas {
+
+NUMSIM_CAS_DEFINE_VISIT_BY_TAG(tensor_expression, NUMSIM_CAS_TENSOR_NODE_LIST)
+
+} // namespace numsim::cas
+
+#endif // TENSOR_VISIT_BY_TAG_H
@@ -37,6 +37,10 @@ public:
   void update_hash_value() const override {
     hash_combine(base::m_hash_value, base::get_id());
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
 };
 
 } // namespace numsim::cas
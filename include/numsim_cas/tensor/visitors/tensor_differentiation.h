@@ -56,7 +56,8 @@ public:
     if (expr.is_valid()) {
       m_expr = expr;
       m_rank_result = expr.get().rank() + m_rank_arg;
-      expr.get<tensor_visitable_t>().accept(*this);
+      if (may_depend_on(expr.get(), m_arg.get()))
+        expr.get<tensor_visitable_t>().accept(*this);
     }
     if (!m_result.is_valid()) {
       return make_expression<tensor_zero>(m_dim, m_rank_result);
@@ -145,7 +146,7 @@ public:
 
   void operator()(tensor_add const &visitable) override {
     tensor_holder_t sum;
-    for (auto &child : visitable.symbol_map() | std::views::values) {
+    for (auto &child : visitable.symbol_map()) {
       auto d = diff(child, m_arg);
       if (d.is_valid()) {
         sum += d;
@@ -60,7 +60,8 @@ public:
     if (expr.is_valid()) {
       m_dim = expr.get().dim();
       m_rank_result = expr.get().rank();
-      expr.get<tensor_visitable_t>().accept(*this);
+      if (may_depend_on(expr.get(), m_arg.get()))
+        expr.get<tensor_visitable_t>().accept(*this);
     }
     if (!m_result.is_valid()) {
       return make_expression<tensor_zero>(m_dim, m_rank_result);
@@ -81,7 +82,7 @@ public:
 
   void operator()(tensor_add const &visitable) override {
     tensor_holder_t sum;
-    for (auto &child : visitable.symbol_map() | std::views::values) {
+    for (auto &child : visitable.symbol_map()) {
       auto d = diff(child, m_arg);
       // Pass-1 review: suppress canonical tensor_zero so trivial
       // children don't inflate the printed sum. Mirrors the pattern
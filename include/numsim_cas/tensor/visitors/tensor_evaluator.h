@@ -12,18 +12,22 @@
 #include <numsim_cas/core/expression.h>
 #include <numsim_cas/core/expression_holder.h>
 #include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+#include <numsim_cas/tensor/contraction_plan.h>
 #include <numsim_cas/tensor/data/tensor_data.h>
 #include <numsim_cas/tensor/data/tensor_data_add.h>
 #include <numsim_cas/tensor/data/tensor_data_inner_product.h>
 #include <numsim_cas/tensor/data/tensor_data_isotropic.h>
+#include <numsim_cas/tensor/data/tensor_data_layout.h>
 #include <numsim_cas/tensor/data/tensor_data_outer_product.h>
 #include <numsim_cas/tensor/data/tensor_data_permute_indices.h>
+#include <numsim_cas/tensor/data/tensor_data_precision.h>
 #include <numsim_cas/tensor/data/tensor_data_projector.h>
 #include <numsim_cas/tensor/data/tensor_data_scalar_mul.h>
 #include <numsim_cas/tensor/data/tensor_data_sub.h>
 #include <numsim_cas/tensor/data/tensor_data_unary_wrapper.h>
 #include <numsim_cas/tensor/tensor_definitions.h>
 #include <numsim_cas/tensor/tensor_functions.h>
+#include <numsim_cas/tensor/tensor_visit_by_tag.h>
 
 namespace numsim::cas {
 
@@ -33,6 +37,31 @@ public:
   using expr_holder_t = expression_holder<tensor_expression>;
   using data_ptr = std::unique_ptr<tensor_data_base<ValueType>>;
 
+  // Read-only handle on an operand: the tensor bound to a symbol, used in
+  // place, or a freshly evaluated subexpression owned by the handle.
+  class operand_ref {
+  public:
+    operand_ref() = default;
+    explicit operand_ref(tensor_data_base<ValueType> const &bound) noexcept
+        : m_data(&bound) {}
+    explicit operand_ref(data_ptr owned) noexcept
+        : m_owned(std::move(owned)), m_data(m_owned.get()) {}
+
+    tensor_data_base<ValueType> const &operator*() const noexcept {
+      return *m_data;
+    }
+    tensor_data_base<ValueType> const *operator->() const noexcept {
+      return m_data;
+    }
+    explicit operator bool() const noexcept { return m_data != nullptr; }
+    [[nodiscard]] bool is_owned() const noexcept { return m_owned != nullptr; }
+
+  private:
+    friend class tensor_evaluator;
+    data_ptr m_owned;
+    tensor_data_base<ValueType> const *m_data{nullptr};
+  };
+
   tensor_evaluator() = default;
   tensor_evaluator(tensor_evaluator const &) = delete;
   tensor_evaluator(tensor_evaluator &&) = delete;
@@ -41,7 +70,27 @@ public:
   template <typename ExprBase>
   void set(expression_holder<ExprBase> const &symbol,
            std::shared_ptr<tensor_data_base<ValueType>> val) {
-    m_tensor_values[to_base_holder(symbol)] = std::move(val);
+    auto key = to_base_holder(symbol);
+    m_tensor_views.erase(key);
+    m_tensor_values[std::move(key)] = std::move(val);
+  }
+
+  // Binds `symbol` to caller-owned memory without copying it; the array is
+  // read (and unpacked from `layout` into a working tensor kept with the
+  // binding) each time the symbol is evaluated, so it must stay alive and
+  // may change between apply() calls.
+  void set_view(expr_holder_t const &symbol, ValueType const *data,
+                tensor_layout layout = tensor_layout::full) {
+    set_view(symbol, tensor_data_view<ValueType>{data, symbol.get().dim(),
+                                                 symbol.get().rank(), layout});
+  }
+
+  template <typename ExprBase>
+  void set_view(expression_holder<ExprBase> const &symbol,
+                tensor_data_view<ValueType> view) {
+    auto key = to_base_holder(symbol);
+    m_tensor_values.erase(key);
+    m_tensor_views[std::move(key)] = bound_view{view, nullptr};
   }
 
   template <typename ExprBase>
@@ -51,13 +100,58 @@ public:
 
   data_ptr apply(expr_holder_t const &expr) {
     if (expr.is_valid()) {
-      m_current_expr = to_base_holder(expr);
-      expr.template get<tensor_visitable_t>().accept(*this);
+      if (expr.get().is_symbol()) // see scalar_evaluator::apply
+        m_current_expr = to_base_holder(expr);
+      if (m_dispatch == evaluator_dispatch::type_tag)
+        visit_by_tag(expr.get(), *this);
+      else
+        expr.template get<tensor_visitable_t>().accept(*this);
       return std::move(m_result);
     }
     return nullptr;
   }
 
+  // How apply() reaches the operator() of a node, see evaluator_dispatch;
+  // the scalar and tensor_to_scalar evaluators used below it follow along.
+  void set_dispatch(evaluator_dispatch mode) noexcept {
+    m_dispatch = mode;
+    m_scalar_eval.set_dispatch(mode);
+  }
+  evaluator_dispatch dispatch_mode() const noexcept { return m_dispatch; }
+
+  // Like apply(), but a bound symbol is not copied: a set() value is used
+  // as is, a view is unpacked into the working tensor of its binding. The
+  // handle is valid until the symbol is bound again.
+  operand_ref operand(expr_holder_t const &expr) {
+    if (expr.is_valid() && expr.get().is_symbol())
+      if (auto const *bound = find_bound(to_base_holder(expr)))
+        return operand_ref(*bound);
+    return operand_ref(apply(expr));
+  }
+
+  // Evaluates `expr` and writes the result to `out` in `layout`
+  // (tensor_layout_size(dim, rank, layout) values). A viewed symbol is
+  // converted from its array straight into `out`, any other result is
+  // packed from the tensor it was evaluated into.
+  void apply_into(expr_holder_t const &expr, ValueType *out,
+                  tensor_layout layout = tensor_layout::full) {
+    if (expr.is_valid() && expr.get().is_symbol()) {
+      if (auto it = m_tensor_views.find(to_base_holder(expr));
+          it != m_tensor_views.end()) {
+        auto const &view = it->second.view;
+        tensor_layout_convert(out, layout, view.data, view.layout, view.dim,
+                              view.rank);
+        return;
+      }
+    }
+    auto result = operand(expr);
+    if (!result)
+      throw evaluation_error(
+          "tensor_evaluator::apply_into: invalid expression");
+    tensor_layout_pack(out, result->raw_data(), result->dim(), result->rank(),
+                       layout);
+  }
+
   // ─── Symbol ──────────────────────────────────────────────────
 
   void operator()(tensor const &) override { dispatch_tensor(); }
@@ -82,12 +176,12 @@ public:
     auto result =
         make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
     if (visitable.coeff().is_valid()) {
-      auto temp = apply(visitable.coeff());
+      auto temp = operand(visitable.coeff());
       tensor_data_add<ValueType> add(*result, *temp);
       add.evaluate(visitable.dim(), visitable.rank());
     }
-    for (auto const &child : visitable.symbol_map() | std::views::values) {
-      auto temp = apply(child);
+    for (auto const &child : visitable.symbol_map()) {
+      auto temp = operand(child);
       tensor_data_add<ValueType> add(*result, *temp);
       add.evaluate(visitable.dim(), visitable.rank());
     }
@@ -121,7 +215,7 @@ public:
 
   void operator()(tensor_scalar_mul const &visitable) override {
     const auto scalar_val = m_scalar_eval.apply(visitable.expr_lhs());
-    auto src = apply(visitable.expr_rhs());
+    auto src = operand(visitable.expr_rhs());
     m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
     tensor_data_scalar_mul<ValueType> op(*m_result, *src, scalar_val);
     op.evaluate(visitable.dim(), visitable.rank());
@@ -162,19 +256,14 @@ public:
         }
       }
     }
-    // Generic inner product
-    auto lhs_data = apply(visitable.expr_lhs());
-    auto rhs_data = apply(visitable.expr_rhs());
-    m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
-    tensor_data_inner_product<ValueType> ip(*m_result, *lhs_data, *rhs_data,
-                                            visitable.indices_lhs().indices(),
-                                            visitable.indices_rhs().indices());
-    ip.evaluate(visitable.dim(), rhs_data->rank(), lhs_data->rank());
+    // Generic inner product, possibly over a whole nested network
+    m_result = eval_contraction_plan(plan_contractions(visitable),
+                                     visitable.dim());
   }
 
   void operator()(outer_product_wrapper const &visitable) override {
-    auto lhs_data = apply(visitable.expr_lhs());
-    auto rhs_data = apply(visitable.expr_rhs());
+    auto lhs_data = operand(visitable.expr_lhs());
+    auto rhs_data = operand(visitable.expr_rhs());
     m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
     tensor_data_outer_product<ValueType> op(*m_result, *lhs_data, *rhs_data,
                                             visitable.indices_lhs().indices(),
@@ -183,7 +272,7 @@ public:
   }
 
   void operator()(permute_indices_wrapper const &visitable) override {
-    auto temp = apply(visitable.expr());
+    auto temp = operand(visitable.expr());
     m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
     tensor_data_permute_indices<ValueType> bc(*m_result, *temp,
                                               visitable.indices().indices());
@@ -196,23 +285,23 @@ public:
       m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
       return;
     }
-    auto accumulated = apply(children.front());
+    auto accumulated = operand(children.front());
     for (std::size_t i = 1; i < children.size(); ++i) {
-      auto rhs_data = apply(children[i]);
+      auto rhs_data = operand(children[i]);
       const auto lhs_rank = accumulated->rank();
       const auto rhs_rank = rhs_data->rank();
       const auto result_rank = lhs_rank + rhs_rank;
       auto result = make_tensor_data<ValueType>(visitable.dim(), result_rank);
-      sequence lhs_seq(lhs_rank), rhs_seq(rhs_rank);
-      std::iota(lhs_seq.begin(), lhs_seq.end(), 0);
-      std::iota(rhs_seq.begin(), rhs_seq.end(), lhs_rank);
+      index_list lhs_seq(lhs_rank), rhs_seq(rhs_rank);
+      std::iota(lhs_seq.begin(), lhs_seq.end(), std::uint8_t{0});
+      std::iota(rhs_seq.begin(), rhs_seq.end(),
+                static_cast<std::uint8_t>(lhs_rank));
       tensor_data_outer_product<ValueType> op(*result, *accumulated, *rhs_data,
-                                              lhs_seq.indices(),
-                                              rhs_seq.indices());
+                                              lhs_seq, rhs_seq);
       op.evaluate(visitable.dim(), rhs_rank, lhs_rank);
-      accumulated = std::move(result);
+      accumulated = operand_ref(std::move(result));
     }
-    m_result = std::move(accumulated);
+    m_result = take(std::move(accumulated));
   }
 
   void operator()(tensor_mul const &visitable) override {
@@ -221,23 +310,10 @@ public:
       m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
       return;
     }
-    auto accumulated = apply(children.front());
-    for (std::size_t i = 1; i < children.size(); ++i) {
-      auto rhs_data = apply(children[i]);
-      const auto lhs_rank = accumulated->rank();
-      const auto rhs_rank = rhs_data->rank();
-      const auto result_rank = lhs_rank + rhs_rank - 2; // single contraction
-      auto result = make_tensor_data<ValueType>(visitable.dim(), result_rank);
-      // contract last index of LHS with first index of RHS
-      std::vector<std::size_t> lhs_idx{lhs_rank - 1};
-      std::vector<std::size_t> rhs_idx{0};
-      tensor_data_inner_product<ValueType> ip(*result, *accumulated, *rhs_data,
-                                              lhs_idx, rhs_idx);
-      ip.evaluate(visitable.dim(), rhs_rank, lhs_rank);
-      accumulated = std::move(result);
-    }
+    auto accumulated =
+        eval_contraction_plan(plan_contractions(visitable), visitable.dim());
     if (visitable.coeff().is_valid()) {
-      auto coeff_data = apply(visitable.coeff());
+      auto coeff_data = operand(visitable.coeff());
       auto temp =
           make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
       const auto size = compute_size(visitable.dim(), visitable.rank());
@@ -255,7 +331,7 @@ public:
   // ─── Tensor functions (tmech wrappers) ─────────────────────
 
   void operator()(tensor_pow const &visitable) override {
-    auto base_data = apply(visitable.expr_lhs());
+    auto base_data = operand(visitable.expr_lhs());
     const auto exp_val = m_scalar_eval.apply(visitable.expr_rhs());
     const auto n = static_cast<int>(exp_val);
     const auto d = visitable.dim();
@@ -268,23 +344,17 @@ public:
       return;
     }
     if (n == 1) {
-      m_result = std::move(base_data);
+      m_result = take(std::move(base_data));
       return;
     }
-    // Repeated contraction for positive integer exponents
-    auto accumulated = make_tensor_data<ValueType>(d, r);
-    std::memcpy(accumulated->raw_data(), base_data->raw_data(),
-                compute_size(d, r) * sizeof(ValueType));
-    for (int k = 1; k < std::abs(n); ++k) {
-      auto temp = make_tensor_data<ValueType>(d, r);
-      std::vector<std::size_t> lhs_idx{r - 1};
-      std::vector<std::size_t> rhs_idx{0};
-      tensor_data_inner_product<ValueType> ip(*temp, *accumulated, *base_data,
-                                              lhs_idx, rhs_idx);
-      ip.evaluate(d, r, r);
-      accumulated = std::move(temp);
+    const auto m = static_cast<std::size_t>(std::abs(n));
+    // Rank-2 in 2D/3D: Cayley-Hamilton reduces A^m to a combination of
+    // I, A (and A^2), i.e. at most one contraction for any m.
+    if (r == 2 && (d == 2 || d == 3) && m >= 3) {
+      m_result = pow_cayley_hamilton(*base_data, m, d);
+      return;
     }
-    m_result = std::move(accumulated);
+    m_result = pow_by_squaring(std::move(base_data), m, d, r);
   }
 
   void operator()(tensor_inv const &v) override {
@@ -327,11 +397,11 @@ public:
       bool minor_major_voigt =
           sp && std::holds_alternative<MinorMajor>(sp->perm);
       if (!minor_major_voigt) {
-        eval_unary_tmech<tmech_ops::invf>(v);
+        eval_unary_tmech_promoted<tmech_ops::invf>(v);
         return;
       }
     }
-    eval_unary_tmech<tmech_ops::inv>(v);
+    eval_unary_tmech_promoted<tmech_ops::inv>(v);
   }
 
   void operator()(tensor_projector const &visitable) override {
@@ -342,30 +412,42 @@ public:
     proj.evaluate(d, r);
   }
 
+  // The spectral nodes run in promoted_value_t<ValueType> (see
+  // tensor_data_precision.h).
   void operator()(tensor_eigenprojection const &v) override {
-    auto temp = apply(v.expr());
+    auto temp = operand(v.expr());
     const auto dim = v.dim();
-    m_result = make_tensor_data<ValueType>(dim, 2);
-    tensor_data_eigenprojection_wrapper<ValueType> op(*m_result, *temp,
-                                                      v.index());
-    op.evaluate(dim, 2);
+    m_result = evaluate_promoted(
+        *temp, dim, 2,
+        [&]<typename W>(tensor_data_base<W> &out,
+                        tensor_data_base<W> const &in) {
+          tensor_data_eigenprojection_wrapper<W> op(out, in, v.index());
+          op.evaluate(dim, 2);
+        });
   }
 
   void operator()(tensor_eigenvector const &v) override {
-    auto temp = apply(v.expr());
+    auto temp = operand(v.expr());
     const auto dim = v.dim();
-    m_result = make_tensor_data<ValueType>(dim, 1);
-    tensor_data_eigenvector_wrapper<ValueType> op(*m_result, *temp, v.index());
-    op.evaluate(dim, 1);
+    m_result = evaluate_promoted(
+        *temp, dim, 1,
+        [&]<typename W>(tensor_data_base<W> &out,
+                        tensor_data_base<W> const &in) {
+          tensor_data_eigenvector_wrapper<W> op(out, in, v.index());
+          op.evaluate(dim, 1);
+        });
   }
 
   void operator()(tensor_isotropic_function const &v) override {
-    auto temp = apply(v.expr());
+    auto temp = operand(v.expr());
     const auto dim = v.dim();
-    m_result = make_tensor_data<ValueType>(dim, 2);
-    tensor_data_isotropic_value_wrapper<ValueType> op(*m_result, *temp,
-                                                      v.kind());
-    op.evaluate(dim, 2);
+    m_result = evaluate_promoted(
+        *temp, dim, 2,
+        [&]<typename W>(tensor_data_base<W> &out,
+                        tensor_data_base<W> const &in) {
+          tensor_data_isotropic_value_wrapper<W> op(out, in, v.kind());
+          op.evaluate(dim, 2);
+        });
   }
 
   // ─── Cross-domain ────────────────────────────────────────────
@@ -380,11 +462,138 @@ public:
   }
 
 private:
+  // ─── Contraction networks (tensor_mul / inner_product_wrapper) ───
+
+  data_ptr eval_contraction_plan(contraction_plan const &plan,
+                                 std::size_t dim) {
+    std::vector<operand_ref> slots;
+    slots.reserve(plan.operands.size());
+    for (auto const &expr : plan.operands)
+      slots.push_back(operand(expr));
+    for (auto const &step : plan.steps) {
+      auto &lhs = slots[step.lhs];
+      auto const &rhs = slots[step.rhs];
+      auto result = make_tensor_data<ValueType>(dim, step.result_rank);
+      tensor_data_inner_product<ValueType> ip(*result, *lhs, *rhs,
+                                              step.lhs_indices,
+                                              step.rhs_indices);
+      ip.evaluate(dim, rhs->rank(), lhs->rank());
+      lhs = operand_ref(std::move(result));
+    }
+    auto const &result = slots[plan.result_slot];
+    if (!plan.permutation.empty()) {
+      auto permuted = make_tensor_data<ValueType>(dim, result->rank());
+      tensor_data_permute_indices<ValueType> bc(*permuted, *result,
+                                                plan.permutation);
+      bc.evaluate(dim, result->rank());
+      return permuted;
+    }
+    return take(std::move(slots[plan.result_slot]));
+  }
+
+  // ─── tensor_pow strategies ──────────────────────────────────
+
+  // Single contraction of the last index of lhs with the first of rhs.
+  data_ptr contract_adjacent(tensor_data_base<ValueType> const &lhs,
+                             tensor_data_base<ValueType> const &rhs,
+                             std::size_t d, std::size_t r) {
+    auto result = make_tensor_data<ValueType>(d, r);
+    index_list const lhs_idx{static_cast<std::uint8_t>(r - 1)};
+    index_list const rhs_idx{0};
+    tensor_data_inner_product<ValueType> ip(*result, lhs, rhs, lhs_idx,
+                                            rhs_idx);
+    ip.evaluate(d, r, r);
+    return result;
+  }
+
+  // A^m with floor(log2 m) squarings plus one contraction per set bit.
+  data_ptr pow_by_squaring(operand_ref base, std::size_t m, std::size_t d,
+                           std::size_t r) {
+    data_ptr result;
+    while (true) {
+      if (m & 1u)
+        result = result ? contract_adjacent(*result, *base, d, r)
+                        : copy_data(*base, d, r);
+      m >>= 1u;
+      if (m == 0)
+        return result;
+      base = operand_ref(contract_adjacent(*base, *base, d, r));
+    }
+  }
+
+  // A^m = a I + b A + c A^2 for rank-2 A in 2D (c = 0) or 3D, with the
+  // coefficients advanced by the characteristic polynomial
+  //   2D: A^2 = I1 A - I2 I,   3D: A^3 = I1 A^2 - I2 A + I3 I.
+  data_ptr pow_cayley_hamilton(tensor_data_base<ValueType> const &A,
+                               std::size_t m, std::size_t d) {
+    auto const *a = A.raw_data();
+    ValueType I1{0}, trA2{0};
+    for (std::size_t i = 0; i < d; ++i) {
+      I1 += a[i * d + i];
+      for (std::size_t j = 0; j < d; ++j)
+        trA2 += a[i * d + j] * a[j * d + i];
+    }
+    const ValueType I2 = (I1 * I1 - trA2) / ValueType{2};
+
+    const auto size = d * d;
+    auto result = make_tensor_data<ValueType>(d, 2);
+    auto *dst = result->raw_data();
+    if (d == 2) {
+      // A^1 = 0 I + 1 A
+      ValueType c0{0}, c1{1};
+      for (std::size_t k = 1; k < m; ++k) {
+        const ValueType next0 = -c1 * I2;
+        c1 = c0 + c1 * I1;
+        c0 = next0;
+      }
+      for (std::size_t i = 0; i < size; ++i)
+        dst[i] = c1 * a[i];
+      for (std::size_t i = 0; i < d; ++i)
+        dst[i * d + i] += c0;
+      return result;
+    }
+
+    const ValueType I3 = a[0] * (a[4] * a[8] - a[5] * a[7]) -
+                         a[1] * (a[3] * a[8] - a[5] * a[6]) +
+                         a[2] * (a[3] * a[7] - a[4] * a[6]);
+    // A^2 = 0 I + 0 A + 1 A^2
+    ValueType c0{0}, c1{0}, c2{1};
+    for (std::size_t k = 2; k < m; ++k) {
+      const ValueType next0 = c2 * I3;
+      const ValueType next1 = c0 - c2 * I2;
+      c2 = c1 + c2 * I1;
+      c0 = next0;
+      c1 = next1;
+    }
+    auto A2 = contract_adjacent(A, A, d, 2);
+    auto const *a2 = A2->raw_data();
+    for (std::size_t i = 0; i < size; ++i)
+      dst[i] = c1 * a[i] + c2 * a2[i];
+    for (std::size_t i = 0; i < d; ++i)
+      dst[i * d + i] += c0;
+    return result;
+  }
+
+  data_ptr copy_data(tensor_data_base<ValueType> const &src, std::size_t d,
+                     std::size_t r) {
+    auto result = make_tensor_data<ValueType>(d, r);
+    std::memcpy(result->raw_data(), src.raw_data(),
+                compute_size(d, r) * sizeof(ValueType));
+    return result;
+  }
+
+  // The operand's tensor, copied if it is a bound symbol.
+  data_ptr take(operand_ref &&op) {
+    if (op.m_owned)
+      return std::move(op.m_owned);
+    return copy_data(*op, op->dim(), op->rank());
+  }
+
   // ─── Projector short-circuit: apply tmech op to RHS of inner_product ───
 
   template <typename Op>
   void eval_projector_unary(inner_product_wrapper const &visitable) {
-    auto rhs_data = apply(visitable.expr_rhs());
+    auto rhs_data = operand(visitable.expr_rhs());
     m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
     tensor_data_unary_wrapper<Op, ValueType> op(*m_result, *rhs_data);
     op.evaluate(visitable.dim(), visitable.rank());
@@ -394,12 +603,27 @@ private:
 
   template <typename Op, typename Visitable>
   void eval_unary_tmech(Visitable const &visitable) {
-    auto temp = apply(visitable.expr());
+    auto temp = operand(visitable.expr());
     m_result = make_tensor_data<ValueType>(visitable.dim(), visitable.rank());
     tensor_data_unary_wrapper<Op, ValueType> op(*m_result, *temp);
     op.evaluate(visitable.dim(), visitable.rank());
   }
 
+  // Same, in promoted_value_t<ValueType> (mixed precision).
+  template <typename Op, typename Visitable>
+  void eval_unary_tmech_promoted(Visitable const &visitable) {
+    auto temp = operand(visitable.expr());
+    const auto dim = visitable.dim();
+    const auto rank = visitable.rank();
+    m_result = evaluate_promoted(
+        *temp, dim, rank,
+        [&]<typename W>(tensor_data_base<W> &out,
+                        tensor_data_base<W> const &in) {
+          tensor_data_unary_wrapper<Op, W> op(out, in);
+          op.evaluate(dim, rank);
+        });
+  }
+
   // ─── Identity dispatch via tmech::eye ───────────────────────
 
   template <typename Visitable> void eval_identity(Visitable const &visitable) {
@@ -411,6 +635,13 @@ private:
   // ─── Symbol dispatch ─────────────────────────────────────────
 
   void dispatch_tensor() {
+    if (auto view = m_tensor_views.find(m_current_expr);
+        view != m_tensor_views.end()) {
+      auto const &[data, dim, rank, layout] = view->second.view;
+      m_result = make_tensor_data<ValueType>(dim, rank);
+      tensor_layout_unpack(m_result->raw_data(), data, dim, rank, layout);
+      return;
+    }
     auto it = m_tensor_values.find(m_current_expr);
     if (it == m_tensor_values.end()) {
       throw evaluation_error("tensor_evaluator: symbol not found");
@@ -421,6 +652,23 @@ private:
     add.evaluate(src->dim(), src->rank());
   }
 
+  // Tensor bound to `symbol`, or null. A view is unpacked into the working
+  // tensor of its binding, allocated on first use.
+  tensor_data_base<ValueType> const *
+  find_bound(expression_holder<expression> const &symbol) {
+    if (auto it = m_tensor_views.find(symbol); it != m_tensor_views.end()) {
+      auto &[view, work] = it->second;
+      if (!work)
+        work = make_tensor_data<ValueType>(view.dim, view.rank);
+      tensor_layout_unpack(work->raw_data(), view.data, view.dim, view.rank,
+                           view.layout);
+      return work.get();
+    }
+    if (auto it = m_tensor_values.find(symbol); it != m_tensor_values.end())
+      return it->second.get();
+    return nullptr;
+  }
+
   template <typename ExprBase>
   static expression_holder<expression>
   to_base_holder(expression_holder<ExprBase> const &h) {
@@ -438,12 +686,19 @@ private:
 
   // ─── State ───────────────────────────────────────────────────
 
+  struct bound_view {
+    tensor_data_view<ValueType> view;
+    data_ptr work;
+  };
+
   std::map<expression_holder<expression>,
            std::shared_ptr<tensor_data_base<ValueType>>>
       m_tensor_values;
+  std::map<expression_holder<expression>, bound_view> m_tensor_views;
   scalar_evaluator<ValueType> m_scalar_eval;
   data_ptr m_result;
   expression_holder<expression> m_current_expr;
+  evaluator_dispatch m_dispatch{evaluator_dispatch::virtual_call};
 };
 
 } // namespace numsim::cas
@@ -456,12 +711,16 @@ template <typename ValueType>
 void tensor_evaluator<ValueType>::operator()(
     tensor_to_scalar_with_tensor_mul const &visitable) {
   tensor_to_scalar_evaluator<ValueType> t2s_eval;
+  t2s_eval.set_dispatch(m_dispatch);
   for (auto const &[key, val] : m_tensor_values) {
     t2s_eval.set(key, val);
   }
+  for (auto const &[key, bound] : m_tensor_views) {
+    t2s_eval.set_view(key, bound.view);
+  }
   m_scalar_eval.forward_values_to(t2s_eval);
   const auto scalar_val = t2s_eval.apply(visitable.expr_rhs());
-  auto src = apply(visitable.expr_lhs());
+  auto src = operand(visitable.expr_lhs());
   const auto dim = src->dim();
   const auto rank = src->rank();
   m_result = make_tensor_data<ValueType>(dim, rank);
@@ -477,9 +736,13 @@ void tensor_evaluator<ValueType>::operator()(
 template <typename ValueType>
 void tensor_evaluator<ValueType>::operator()(tensor_if_then_else_t2s const &v) {
   tensor_to_scalar_evaluator<ValueType> t2s_eval;
+  t2s_eval.set_dispatch(m_dispatch);
   for (auto const &[key, val] : m_tensor_values) {
     t2s_eval.set(key, val);
   }
+  for (auto const &[key, bound] : m_tensor_views) {
+    t2s_eval.set_view(key, bound.view);
+  }
   m_scalar_eval.forward_values_to(t2s_eval);
   if (t2s_eval.apply(v.expr_cond()) != ValueType{0})
     m_result = apply(v.expr_then());
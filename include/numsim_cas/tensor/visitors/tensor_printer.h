@@ -53,7 +53,7 @@ public:
    */
   auto apply(expression_holder<tensor_expression> const &expr,
              [[maybe_unused]] Precedence parent_precedence = Precedence::None) {
-    if (expr.is_valid()) {
+    if (expr.is_valid() && !this->print_let_name(expr)) {
       m_parent_precedence = parent_precedence;
       static_cast<const tensor_visitable_t &>(expr.get())
           .accept(static_cast<base_visitor &>(*this));
@@ -123,7 +123,7 @@ public:
     const auto parent_precedence{m_parent_precedence};
 
     begin(precedence, parent_precedence);
-    const auto values{visitable.symbol_map() | std::views::values};
+    auto const &values{visitable.symbol_map()};
     std::map<expr_t, expr_t> sorted_map;
     std::for_each(std::begin(values), std::end(values),
                   [&](auto &expr) { sorted_map[expr] = expr; });
@@ -126,7 +126,7 @@ public:
     tensor_holder_t result;
     if (v.coeff().is_valid())
       result += apply(v.coeff());
-    for (auto &child : v.symbol_map() | std::views::values)
+    for (auto &child : v.symbol_map())
       result += apply(child);
     m_result = std::move(result);
   }
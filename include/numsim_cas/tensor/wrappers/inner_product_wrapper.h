@@ -2,6 +2,7 @@
 #define INNER_PRODUCT_WRAPPER_H
 
 #include <algorithm>
+#include <memory>
 #include <numsim_cas/core/binary_op.h>
 #include <numsim_cas/tensor/tensor_expression.h>
 #include <stdexcept>
@@ -9,6 +10,8 @@
 
 namespace numsim::cas {
 
+struct contraction_plan;
+
 class inner_product_wrapper final
     : public binary_op<tensor_node_base_t<inner_product_wrapper>,
                        tensor_expression> {
@@ -52,6 +55,12 @@ public:
     return m_rhs_indices;
   }
 
+  // Evaluation order of the contraction network rooted here, filled in by
+  // plan_contractions() (tensor/contraction_plan.h) on first evaluation.
+  [[nodiscard]] auto &contraction_plan_cache() const noexcept {
+    return m_contraction_plan;
+  }
+
   // #266 — fold the contraction indices into the hash (mirrors
   // outer_product_wrapper). Without this, the default binary_op hash
   // ignores them, so two inner_products differing only in their
@@ -69,6 +78,7 @@ public:
 protected:
   sequence m_lhs_indices;
   sequence m_rhs_indices;
+  mutable std::shared_ptr<contraction_plan const> m_contraction_plan;
 };
 
 } // namespace numsim::cas
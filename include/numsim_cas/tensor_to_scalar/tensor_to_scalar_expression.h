@@ -12,6 +12,8 @@ public:
   using expr_t = tensor_to_scalar_expression;
   using visitor_t = tensor_to_scalar_visitor_t;
   using visitor_const_t = tensor_to_scalar_visitor_const_t;
+  static constexpr expression_domain node_domain{
+      expression_domain::tensor_to_scalar};
 
   tensor_to_scalar_expression() = default;
   tensor_to_scalar_expression(tensor_to_scalar_expression const &data)
@@ -28,6 +28,7 @@ requires std::same_as<std::remove_cvref_t<L>,
 inline expression_holder<tensor_to_scalar_expression>
 tag_invoke(add_fn, [[maybe_unused]] L &&lhs, [[maybe_unused]] R &&rhs) {
   auto &_lhs{lhs.template get<tensor_to_scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_to_scalar::add_base");
   tensor_to_scalar_detail::simplifier::add_base visitor(std::forward<L>(lhs),
                                                         std::forward<R>(rhs));
   return _lhs.accept(visitor);
@@ -64,6 +65,7 @@ requires std::same_as<std::remove_cvref_t<L>,
 inline expression_holder<tensor_to_scalar_expression>
 tag_invoke(sub_fn, [[maybe_unused]] L &&lhs, [[maybe_unused]] R &&rhs) {
   auto &_lhs{lhs.template get<tensor_to_scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_to_scalar::sub_base");
   tensor_to_scalar_detail::simplifier::sub_base visitor(std::forward<L>(lhs),
                                                         std::forward<R>(rhs));
   return _lhs.accept(visitor);
@@ -103,6 +105,7 @@ tag_invoke(mul_fn, [[maybe_unused]] L &&lhs, [[maybe_unused]] R &&rhs) {
   const auto lhs_tags = positivity::read(lhs);
   const auto rhs_tags = positivity::read(rhs);
   auto &_lhs{lhs.template get<tensor_to_scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_to_scalar::mul_base");
   tensor_to_scalar_detail::simplifier::mul_base visitor(std::forward<L>(lhs),
                                                         std::forward<R>(rhs));
   auto result = _lhs.accept(visitor);
@@ -31,8 +31,7 @@ read(expression_holder<tensor_to_scalar_expression> const &e) {
     // own, so it keeps eager propagation and just needs the scalar
     // facts materialized here).
     infer_assumptions(inner);
-    for (auto const &t : inner.data()->assumptions().data())
-      m.insert(t);
+    m.merge(inner.data()->assumptions());
   }
   if (m.contains(numsim::cas::integer{}) ||
       m.contains(numsim::cas::rational{}) ||
@@ -16,7 +16,13 @@ public:
   using base =
       unary_op<tensor_to_scalar_node_base_t<tensor_to_scalar_scalar_wrapper>,
                scalar_expression>;
-  using base::base;
+
+  template <typename Expr>
+  requires std::is_constructible_v<typename base::expr_holder_t, Expr &&>
+  explicit tensor_to_scalar_scalar_wrapper(Expr &&expr)
+      : base(std::forward<Expr>(expr)) {
+    forward_payload_flags();
+  }
 
   tensor_to_scalar_scalar_wrapper(
       tensor_to_scalar_scalar_wrapper &&data) noexcept
@@ -28,17 +34,6 @@ public:
   const tensor_to_scalar_scalar_wrapper &
   operator=(tensor_to_scalar_scalar_wrapper &&) = delete;
 
-  // Transparent forwarding of Symbol classification: this wrapper is the
-  // bridge that lets a named scalar (e.g. scalar("x")) appear in a t2s
-  // expression. A user who has only a `holder<t2s_expression>` referring
-  // to such a wrapped scalar should still be able to call
-  // `.assumption(...)` — the wrapped child IS a Symbol. Forward through.
-  // For non-Symbol payloads (constants, compound scalar expressions),
-  // this returns the payload's own answer (typically false).
-  [[nodiscard]] bool is_symbol() const noexcept override {
-    return this->expr().is_valid() && this->expr().get().is_symbol();
-  }
-
   friend bool operator<(tensor_to_scalar_scalar_wrapper const &lhs,
                         tensor_to_scalar_scalar_wrapper const &rhs) {
     return lhs.hash_value() < rhs.hash_value();
@@ -66,6 +61,22 @@ public:
       hash_combine(base::m_hash_value, this->expr().get().hash_value());
     }
   }
+
+private:
+  // Transparent forwarding of Symbol classification: this wrapper is the
+  // bridge that lets a named scalar (e.g. scalar("x")) appear in a t2s
+  // expression. A user who has only a `holder<t2s_expression>` referring
+  // to such a wrapped scalar should still be able to call
+  // `.assumption(...)` — the wrapped child IS a Symbol. The payload is
+  // fixed at construction, so its symbol and number flags are copied into
+  // the header once.
+  void forward_payload_flags() noexcept {
+    if (!this->expr().is_valid())
+      return;
+    auto const &payload{this->expr().get()};
+    this->set_node_flag(node_flags::symbol, payload.is_symbol());
+    this->set_node_flag(node_flags::number, payload.is_number());
+  }
 };
 
 // Transparent apply_assumption forwarding for the t2s scalar wrapper.
@@ -63,6 +63,7 @@ template <tensor_to_scalar_expr_holder ExprLHS,
   const auto exp_tags = positivity::read(expr_rhs);
   // Full simplification via visitor dispatch
   auto &_lhs{expr_lhs.template get<tensor_to_scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("tensor_to_scalar::pow_base");
   tensor_to_scalar_detail::simplifier::pow_base visitor(
       std::forward<ExprLHS>(expr_lhs), std::forward<ExprRHS>(expr_rhs));
   auto result = _lhs.accept(visitor);
@@ -0,0 +1,16 @@
+#ifndef TENSOR_TO_SCALAR_VISIT_BY_TAG_H
+#define TENSOR_TO_SCALAR_VISIT_BY_TAG_H
+
+#include <numsim_cas/core/visit_by_tag.h>
+#include <numsim_cas/tensor_to_scalar/operators/tensor_to_scalar_add.h>
+#include <numsim_cas/tensor_to_scalar/operators/tensor_to_scalar_mul.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_definitions.h>
+
+namespace numsim::cas {
+
+NUMSIM_CAS_DEFINE_VISIT_BY_TAG(tensor_to_scalar_expression,
+                               NUMSIM_CAS_TENSOR_TO_SCALAR_NODE_LIST)
+
+} // namespace numsim::cas
+
+#endif // TENSOR_TO_SCALAR_VISIT_BY_TAG_H
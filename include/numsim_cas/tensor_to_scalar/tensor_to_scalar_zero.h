@@ -10,6 +10,7 @@ class tensor_to_scalar_zero final
     : public tensor_to_scalar_node_base_t<tensor_to_scalar_zero> {
 public:
   using base = tensor_to_scalar_node_base_t<tensor_to_scalar_zero>;
+  static constexpr std::uint8_t static_node_flags{node_flags::number};
 
   // The constant 0 is mathematically: nonnegative, nonpositive, real,
   // integer, rational. nonzero is INTENTIONALLY absent — 0 is the
@@ -57,6 +58,10 @@ public:
   void update_hash_value() const override {
     hash_combine(base::m_hash_value, base::get_id());
   }
+
+  [[nodiscard]] symbol_set compute_free_symbols() const override {
+    return {};
+  }
 };
 
 } // namespace numsim::cas
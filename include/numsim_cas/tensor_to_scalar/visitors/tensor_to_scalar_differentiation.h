@@ -49,7 +49,7 @@ public:
 
   [[nodiscard]] tensor_holder_t apply(t2s_holder_t const &expr) {
     m_result = tensor_holder_t{};
-    if (expr.is_valid()) {
+    if (expr.is_valid() && may_depend_on(expr.get(), m_arg.get())) {
       m_expr = expr;
       expr.get<tensor_to_scalar_visitable_t>().accept(*this);
     }
@@ -2,11 +2,16 @@
 #define TENSOR_TO_SCALAR_EVALUATOR_H
 
 #include <cmath>
+#include <map>
 #include <ranges>
+#include <type_traits>
+#include <unordered_map>
+#include <variant>
 
 #include <numsim_cas/core/cas_error.h>
 #include <numsim_cas/core/expression.h>
 #include <numsim_cas/core/expression_holder.h>
+#include <numsim_cas/core/interval.h>
 #include <numsim_cas/scalar/visitors/scalar_evaluator.h>
 #include <numsim_cas/tensor/data/tensor_data.h>
 #include <numsim_cas/tensor/data/tensor_data_isotropic.h>
@@ -15,9 +20,13 @@
 #include <numsim_cas/tensor_to_scalar/operators/tensor_to_scalar_add.h>
 #include <numsim_cas/tensor_to_scalar/operators/tensor_to_scalar_mul.h>
 #include <numsim_cas/tensor_to_scalar/tensor_to_scalar_definitions.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_visit_by_tag.h>
 
 namespace numsim::cas {
 
+// With ValueType = interval<T> there is no tensor arithmetic: the
+// tensor-valued leaves (invariants, norms, ...) are bound to ranges with
+// set_t2s(), everything above them is bounded by interval arithmetic.
 template <typename ValueType>
 class tensor_to_scalar_evaluator final
     : public tensor_to_scalar_visitor_const_t {
@@ -34,23 +43,78 @@ public:
   template <typename ExprBase>
   void set(expression_holder<ExprBase> const &symbol,
            std::shared_ptr<tensor_data_base<ValueType>> val) {
+    static_assert(!is_interval_v<ValueType>, "interval: use set_t2s()");
     m_tensor_eval.set(symbol, std::move(val));
   }
 
+  // Non-owning binding, see tensor_evaluator::set_view.
+  void set_view(tensor_holder_t const &symbol, ValueType const *data,
+                tensor_layout layout = tensor_layout::full) {
+    static_assert(!is_interval_v<ValueType>, "interval: use set_t2s()");
+    m_tensor_eval.set_view(symbol, data, layout);
+  }
+
+  template <typename ExprBase>
+  void set_view(expression_holder<ExprBase> const &symbol,
+                tensor_data_view<ValueType> view) {
+    static_assert(!is_interval_v<ValueType>, "interval: use set_t2s()");
+    m_tensor_eval.set_view(symbol, view);
+  }
+
   template <typename ExprBase>
   void set_scalar(expression_holder<ExprBase> const &symbol, ValueType val) {
     m_scalar_eval.set(symbol, val);
-    m_tensor_eval.set_scalar(symbol, val);
+    if constexpr (!is_interval_v<ValueType>)
+      m_tensor_eval.set_scalar(symbol, val);
   }
 
+  // Binds a whole subexpression (typically an invariant such as trace(E)
+  // or norm(dev(E))) to a value; it is not evaluated below that node.
+  void set_t2s(t2s_holder_t const &expr, ValueType val) {
+    m_t2s_values[expr] = val;
+  }
+
+  // A node with more than one owner (diff() output, the Cayley-Hamilton
+  // coefficients of d(A^n)/dA) is evaluated once per outermost apply();
+  // nodes with a single owner are only reached through a shared ancestor,
+  // which is already memoized.
   ValueType apply(t2s_holder_t const &expr) {
     if (expr.is_valid()) {
-      expr.template get<tensor_to_scalar_visitable_t>().accept(*this);
+      if (!m_t2s_values.empty())
+        if (auto it = m_t2s_values.find(expr); it != m_t2s_values.end())
+          return m_result = it->second;
+      if (m_depth == 0)
+        m_shared_values.clear();
+      auto const *node = expr.data().get();
+      bool const shared = m_depth > 0 && expr.data().use_count() > 1;
+      if (shared)
+        if (auto it = m_shared_values.find(node);
+            it != m_shared_values.end())
+          return m_result = it->second;
+      {
+        depth_guard guard{m_depth};
+        if (m_dispatch == evaluator_dispatch::type_tag)
+          visit_by_tag(expr.get(), *this);
+        else
+          expr.template get<tensor_to_scalar_visitable_t>().accept(*this);
+      }
+      if (shared)
+        m_shared_values.emplace(node, m_result);
       return m_result;
     }
     return ValueType{0};
   }
 
+  // How apply() reaches the operator() of a node, see evaluator_dispatch;
+  // the scalar and tensor evaluators used below it follow along.
+  void set_dispatch(evaluator_dispatch mode) noexcept {
+    m_dispatch = mode;
+    m_scalar_eval.set_dispatch(mode);
+    if constexpr (!is_interval_v<ValueType>)
+      m_tensor_eval.set_dispatch(mode);
+  }
+  evaluator_dispatch dispatch_mode() const noexcept { return m_dispatch; }
+
   // ─── Constants ───────────────────────────────────────────────
 
   void operator()([[maybe_unused]] tensor_to_scalar_zero const &) override {
@@ -69,8 +133,18 @@ public:
   // Lazy on the unselected branch — load-bearing for damage models
   // where the unselected arm may contain expressions that would error
   // at evaluation (e.g. log(x) for x ≤ 0).
+  // For intervals a condition that may go either way evaluates both arms
+  // and returns their hull.
   void operator()(tensor_to_scalar_if_then_else const &v) override {
-    if (apply(v.expr_cond()) != ValueType{0})
+    const ValueType cond{apply(v.expr_cond())};
+    if constexpr (is_interval_v<ValueType>) {
+      if (cond.contains(0) && !cond.is_point()) {
+        const ValueType then_value{apply(v.expr_then())};
+        m_result = hull(then_value, apply(v.expr_else()));
+        return;
+      }
+    }
+    if (cond != ValueType{0})
       m_result = apply(v.expr_then());
     else
       m_result = apply(v.expr_else());
@@ -83,15 +157,18 @@ public:
   }
 
   void operator()(tensor_to_scalar_log const &v) override {
-    m_result = std::log(apply(v.expr()));
+    using std::log;
+    m_result = log(apply(v.expr()));
   }
 
   void operator()(tensor_to_scalar_exp const &v) override {
-    m_result = std::exp(apply(v.expr()));
+    using std::exp;
+    m_result = exp(apply(v.expr()));
   }
 
   void operator()(tensor_to_scalar_sqrt const &v) override {
-    m_result = std::sqrt(apply(v.expr()));
+    using std::sqrt;
+    m_result = sqrt(apply(v.expr()));
   }
 
   void operator()(tensor_to_scalar_add const &v) override {
@@ -99,7 +176,7 @@ public:
     if (v.coeff().is_valid()) {
       result += apply(v.coeff());
     }
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       result += apply(child);
     }
     m_result = result;
@@ -110,14 +187,15 @@ public:
     if (v.coeff().is_valid()) {
       result = apply(v.coeff());
     }
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       result *= apply(child);
     }
     m_result = result;
   }
 
   void operator()(tensor_to_scalar_pow const &v) override {
-    m_result = std::pow(apply(v.expr_lhs()), apply(v.expr_rhs()));
+    using std::pow;
+    m_result = pow(apply(v.expr_lhs()), apply(v.expr_rhs()));
   }
 
   // ─── Tensor → scalar operations ─────────────────────────────
@@ -127,7 +205,7 @@ public:
   }
 
   void operator()(tensor_det const &v) override {
-    m_result = eval_tensor_to_scalar<tmech_ops::det_op>(v.expr());
+    m_result = eval_tensor_to_scalar_promoted<tmech_ops::det_op>(v.expr());
   }
 
   void operator()(tensor_norm const &v) override {
@@ -138,30 +216,50 @@ public:
     m_result = eval_tensor_to_scalar<tmech_ops::dcontract_self_op>(v.expr());
   }
 
+  // Spectral quantities and divided differences run in
+  // promoted_value_t<ValueType> (see tensor_data_precision.h).
   void operator()(tensor_to_scalar_eigenvalue const &v) override {
-    auto data = m_tensor_eval.apply(v.expr());
-    const auto dim = data->dim();
-    const auto rank = data->rank();
-    tensor_data_eigenvalue_wrapper<ValueType> op(*data, v.index());
-    m_result = op.evaluate(dim, rank);
+    if constexpr (is_interval_v<ValueType>) {
+      unbound_tensor_node();
+    } else {
+      auto data = m_tensor_eval.operand(v.expr());
+      const auto dim = data->dim();
+      const auto rank = data->rank();
+      m_result = evaluate_promoted_scalar(
+          *data, [&]<typename W>(tensor_data_base<W> const &in) {
+            tensor_data_eigenvalue_wrapper<W> op(in, v.index());
+            return op.evaluate(dim, rank);
+          });
+    }
   }
 
   void operator()(tensor_to_scalar_divided_difference const &v) override {
-    auto data = m_tensor_eval.apply(v.expr());
-    const auto dim = data->dim();
-    const auto rank = data->rank();
-    tensor_data_divided_difference_wrapper<ValueType> op(*data, v.kind(),
+    if constexpr (is_interval_v<ValueType>) {
+      unbound_tensor_node();
+    } else {
+      auto data = m_tensor_eval.operand(v.expr());
+      const auto dim = data->dim();
+      const auto rank = data->rank();
+      m_result = evaluate_promoted_scalar(
+          *data, [&]<typename W>(tensor_data_base<W> const &in) {
+            tensor_data_divided_difference_wrapper<W> op(in, v.kind(),
                                                          v.indices());
-    m_result = op.evaluate(dim, rank);
+            return op.evaluate(dim, rank);
+          });
+    }
   }
 
   void operator()(tensor_inner_product_to_scalar const &v) override {
-    auto lhs_data = m_tensor_eval.apply(v.expr_lhs());
-    auto rhs_data = m_tensor_eval.apply(v.expr_rhs());
-    const auto dim = lhs_data->dim();
-    const auto rank = lhs_data->rank();
-    tensor_data_dcontract_wrapper<ValueType> op(*lhs_data, *rhs_data);
-    m_result = op.evaluate(dim, rank);
+    if constexpr (is_interval_v<ValueType>) {
+      unbound_tensor_node();
+    } else {
+      auto lhs_data = m_tensor_eval.operand(v.expr_lhs());
+      auto rhs_data = m_tensor_eval.operand(v.expr_rhs());
+      const auto dim = lhs_data->dim();
+      const auto rank = lhs_data->rank();
+      tensor_data_dcontract_wrapper<ValueType> op(*lhs_data, *rhs_data);
+      m_result = op.evaluate(dim, rank);
+    }
   }
 
   template <class T> void operator()([[maybe_unused]] T const &) noexcept {
@@ -171,18 +269,62 @@ public:
   }
 
 private:
+  struct depth_guard {
+    explicit depth_guard(std::size_t &depth) noexcept : m_depth(depth) {
+      ++m_depth;
+    }
+    ~depth_guard() { --m_depth; }
+    depth_guard(depth_guard const &) = delete;
+    depth_guard &operator=(depth_guard const &) = delete;
+    std::size_t &m_depth;
+  };
+
+  [[noreturn]] static void unbound_tensor_node() {
+    throw evaluation_error("tensor_to_scalar_evaluator: interval evaluation "
+                           "has no tensor arithmetic, bind the tensor-valued "
+                           "subexpression with set_t2s()");
+  }
+
   template <typename Op>
   ValueType eval_tensor_to_scalar(tensor_holder_t const &tensor_expr) {
-    auto data = m_tensor_eval.apply(tensor_expr);
-    const auto dim = data->dim();
-    const auto rank = data->rank();
-    tensor_data_to_scalar_wrapper<Op, ValueType> op(*data);
-    return op.evaluate(dim, rank);
+    if constexpr (is_interval_v<ValueType>) {
+      unbound_tensor_node();
+    } else {
+      auto data = m_tensor_eval.operand(tensor_expr);
+      const auto dim = data->dim();
+      const auto rank = data->rank();
+      tensor_data_to_scalar_wrapper<Op, ValueType> op(*data);
+      return op.evaluate(dim, rank);
+    }
+  }
+
+  template <typename Op>
+  ValueType eval_tensor_to_scalar_promoted(tensor_holder_t const &tensor_expr) {
+    if constexpr (is_interval_v<ValueType>) {
+      unbound_tensor_node();
+    } else {
+      auto data = m_tensor_eval.operand(tensor_expr);
+      const auto dim = data->dim();
+      const auto rank = data->rank();
+      return evaluate_promoted_scalar(
+          *data, [&]<typename W>(tensor_data_base<W> const &in) {
+            tensor_data_to_scalar_wrapper<Op, W> op(in);
+            return op.evaluate(dim, rank);
+          });
+    }
   }
 
-  tensor_evaluator<ValueType> m_tensor_eval;
+  // No tensor evaluator for intervals (tmech kernels need a field type).
+  std::conditional_t<is_interval_v<ValueType>, std::monostate,
+                     tensor_evaluator<ValueType>>
+      m_tensor_eval;
   scalar_evaluator<ValueType> m_scalar_eval;
+  std::map<t2s_holder_t, ValueType> m_t2s_values;
+  std::unordered_map<tensor_to_scalar_expression const *, ValueType>
+      m_shared_values;
+  std::size_t m_depth{0};
   ValueType m_result{};
+  evaluator_dispatch m_dispatch{evaluator_dispatch::virtual_call};
 };
 
 } // namespace numsim::cas
@@ -42,7 +42,7 @@ public:
 
   auto apply(expression_holder<tensor_to_scalar_expression> const &expr,
              Precedence parent_precedence = Precedence::None) {
-    if (expr.is_valid()) {
+    if (expr.is_valid() && !this->print_let_name(expr)) {
       m_parent_precedence = parent_precedence;
       static_cast<const tensor_to_scalar_visitable_t &>(expr.get())
           .accept(static_cast<tensor_to_scalar_visitor_const_t &>(*this));
@@ -202,7 +202,7 @@ public:
     using expr_t = expression_holder<tensor_to_scalar_expression>;
     std::vector<expr_t> children;
     children.reserve(visitable.symbol_map().size());
-    for (auto &child : visitable.symbol_map() | std::views::values) {
+    for (auto &child : visitable.symbol_map()) {
       children.push_back(child);
     }
     std::stable_partition(children.begin(), children.end(), [](auto const &c) {
@@ -2,6 +2,7 @@
 #define TENSOR_TO_SCALAR_LIMIT_VISITOR_H
 
 #include <numsim_cas/core/limit_algebra.h>
+#include <numsim_cas/core/limit_cache.h>
 #include <numsim_cas/core/limit_result.h>
 #include <numsim_cas/tensor_to_scalar/operators/tensor_to_scalar_add.h>
 #include <numsim_cas/tensor_to_scalar/operators/tensor_to_scalar_mul.h>
@@ -18,13 +19,18 @@ public:
   using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
   using tensor_holder_t = expression_holder<tensor_expression>;
 
+  // Results are memoized per node; `cache` shares them across visitors
+  // (see limit_cache).
+
   // Mode 1: exact sub-expression match (e.g., det(F) is the limit var)
   tensor_to_scalar_limit_visitor(t2s_holder_t const &limit_var,
-                                 limit_target target);
+                                 limit_target target,
+                                 limit_cache *cache = nullptr);
 
   // Mode 2: any T2S expression depending on tensor F
   tensor_to_scalar_limit_visitor(tensor_holder_t const &tensor_var,
-                                 limit_target target);
+                                 limit_target target,
+                                 limit_cache *cache = nullptr);
 
   limit_result apply(t2s_holder_t const &expr);
 
@@ -57,11 +63,17 @@ public:
 private:
   bool depends_on_limit_var(t2s_holder_t const &expr) const;
 
+  limit_cache &cache() noexcept { return m_cache ? *m_cache : m_own_cache; }
+  limit_result const *find_cached(t2s_holder_t const &expr);
+  void store_cached(t2s_holder_t const &expr);
+
   dependency_mode m_mode;
   t2s_holder_t m_limit_var_t2s;
   tensor_holder_t m_tensor_var;
   limit_target m_target;
   limit_result m_result;
+  limit_cache *m_cache;
+  limit_cache m_own_cache;
 };
 
 } // namespace numsim::cas
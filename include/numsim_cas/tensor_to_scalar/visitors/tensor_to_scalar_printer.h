@@ -27,8 +27,8 @@ is_scalar_like(expression_holder<tensor_to_scalar_expression> const &expr) {
     return true;
   if (is_same<tensor_to_scalar_mul>(expr)) {
     auto const &mul = expr.template get<tensor_to_scalar_mul>();
-    for (auto const &[k, v] : mul.symbol_map()) {
-      if (!is_scalar_like(v))
+    for (auto const &child : mul.symbol_map()) {
+      if (!is_scalar_like(child))
         return false;
     }
     return true;
@@ -62,7 +62,7 @@ public:
 
   auto apply(expression_holder<tensor_to_scalar_expression> const &expr,
              [[maybe_unused]] Precedence parent_precedence = Precedence::None) {
-    if (expr.is_valid()) {
+    if (expr.is_valid() && !this->print_let_name(expr)) {
       m_parent_precedence = parent_precedence;
       static_cast<const tensor_to_scalar_visitable_t &>(expr.get())
           .accept(static_cast<tensor_to_scalar_visitor_const_t &>(*this));
@@ -204,7 +204,7 @@ public:
     using expr_t = expression_holder<tensor_to_scalar_expression>;
     std::vector<expr_t> children;
     children.reserve(visitable.symbol_map().size());
-    for (auto &child : visitable.symbol_map() | std::views::values) {
+    for (auto &child : visitable.symbol_map()) {
       children.push_back(child);
     }
     std::stable_partition(children.begin(), children.end(), [](auto const &c) {
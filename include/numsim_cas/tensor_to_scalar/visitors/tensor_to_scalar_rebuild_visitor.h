@@ -119,7 +119,7 @@ public:
     t2s_holder_t result;
     if (v.coeff().is_valid())
       result += apply(v.coeff());
-    for (auto &child : v.symbol_map() | std::views::values)
+    for (auto &child : v.symbol_map())
       result += apply(child);
     m_result = std::move(result);
   }
@@ -128,7 +128,7 @@ public:
     t2s_holder_t result;
     if (v.coeff().is_valid())
       result *= apply(v.coeff());
-    for (auto &child : v.symbol_map() | std::views::values)
+    for (auto &child : v.symbol_map())
       result *= apply(child);
     m_result = std::move(result);
   }
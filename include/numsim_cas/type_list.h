@@ -23,6 +23,15 @@ struct index_of<T, type_list<U, Ts...>>
 template <class T, class List>
 inline constexpr std::uint16_t index_of_v = index_of<T, List>::value;
 
+template <class List> struct type_list_size;
+
+template <class... Ts>
+struct type_list_size<type_list<Ts...>>
+    : std::integral_constant<std::uint16_t, sizeof...(Ts)> {};
+
+template <class List>
+inline constexpr std::uint16_t type_list_size_v = type_list_size<List>::value;
+
 // Unique ID mapping
 template <typename T, typename Base> struct get_index; // primary template
 
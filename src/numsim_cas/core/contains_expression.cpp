@@ -20,11 +20,17 @@ class scalar_contains_visitor final : public scalar_visitor_const_t {
 public:
   using expr_holder_t = expression_holder<scalar_expression>;
 
-  scalar_contains_visitor(expr_holder_t const &needle) : m_needle(needle) {}
+  scalar_contains_visitor(expr_holder_t const &needle)
+      : m_needle(needle),
+        m_needle_symbols(needle.is_valid() ? needle.get().free_symbols()
+                                           : symbol_set{}) {}
 
   bool apply(expr_holder_t const &expr) {
     if (!expr.is_valid())
       return false;
+    // Every symbol of the needle must occur in a subtree containing it.
+    if (!expr.get().free_symbols().may_contain(m_needle_symbols))
+      return false;
     if (expr == m_needle)
       return true;
     m_found = false;
@@ -40,7 +46,7 @@ public:
   void operator()(scalar_add const &v) override {
     if (v.coeff().is_valid())
       check(v.coeff());
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       if (m_found)
         return;
       check(child);
@@ -50,7 +56,7 @@ public:
   void operator()(scalar_mul const &v) override {
     if (v.coeff().is_valid())
       check(v.coeff());
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       if (m_found)
         return;
       check(child);
@@ -111,6 +117,7 @@ private:
   }
 
   expr_holder_t m_needle;
+  symbol_set m_needle_symbols;
   bool m_found = false;
 };
 
@@ -120,11 +127,17 @@ class tensor_contains_visitor final : public tensor_visitor_const_t {
 public:
   using expr_holder_t = expression_holder<tensor_expression>;
 
-  tensor_contains_visitor(expr_holder_t const &needle) : m_needle(needle) {}
+  tensor_contains_visitor(expr_holder_t const &needle)
+      : m_needle(needle),
+        m_needle_symbols(needle.is_valid() ? needle.get().free_symbols()
+                                           : symbol_set{}) {}
 
   bool apply(expr_holder_t const &expr) {
     if (!expr.is_valid())
       return false;
+    // Every symbol of the needle must occur in a subtree containing it.
+    if (!expr.get().free_symbols().may_contain(m_needle_symbols))
+      return false;
     if (expr == m_needle)
       return true;
     m_found = false;
@@ -141,7 +154,7 @@ public:
   void operator()(tensor_add const &v) override {
     if (v.coeff().is_valid())
       check(v.coeff());
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       if (m_found)
         return;
       check(child);
@@ -223,6 +236,7 @@ private:
   }
 
   expr_holder_t m_needle;
+  symbol_set m_needle_symbols;
   bool m_found = false;
 };
 
@@ -238,7 +252,7 @@ public:
       : m_tensor_var(tensor_var) {}
 
   bool apply(t2s_holder_t const &expr) {
-    if (!expr.is_valid())
+    if (!expr.is_valid() || !may_depend_on(expr.get(), m_tensor_var.get()))
       return false;
     m_found = false;
     expr.template get<tensor_to_scalar_visitable_t>().accept(*this);
@@ -266,7 +280,7 @@ public:
   void operator()(tensor_to_scalar_add const &v) override {
     if (v.coeff().is_valid())
       check_t2s(v.coeff());
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       if (m_found)
         return;
       check_t2s(child);
@@ -275,7 +289,7 @@ public:
   void operator()(tensor_to_scalar_mul const &v) override {
     if (v.coeff().is_valid())
       check_t2s(v.coeff());
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       if (m_found)
         return;
       check_t2s(child);
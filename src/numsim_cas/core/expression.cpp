@@ -9,6 +9,14 @@ expression::hash_type const &expression::hash_value() const {
   return m_hash_value;
 }
 
+symbol_set const &expression::free_symbols() const {
+  if (!m_free_symbols_valid) {
+    m_free_symbols = compute_free_symbols();
+    m_free_symbols_valid = true;
+  }
+  return m_free_symbols;
+}
+
 bool expression::operator==(expression const &rhs) const noexcept {
   if (this == &rhs)
     return true;
@@ -30,6 +38,10 @@ bool expression::operator!=(expression const &rhs) const noexcept {
 }
 
 bool expression::operator<(expression const &rhs) const noexcept {
+  // Same node: without this a shared subexpression is compared with itself
+  // all the way down, once per path through the DAG.
+  if (this == &rhs)
+    return false;
   if (hash_value() != rhs.hash_value())
     return hash_value() < rhs.hash_value();
   if (id() != rhs.id())
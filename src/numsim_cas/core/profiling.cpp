@@ -0,0 +1,226 @@
+#include <numsim_cas/core/profiling.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace numsim::cas::profiling {
+
+namespace {
+
+// std::map nodes never move, so the unique_ptr indirection is only there to
+// keep the atomics out of the map's value_type requirements.
+template <typename Counter> struct registry {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<Counter>, std::less<>> entries;
+
+  Counter &get(std::string_view name) {
+    std::scoped_lock lock(mutex);
+    auto it = entries.find(name);
+    if (it == entries.end())
+      it = entries.emplace(std::string(name), std::make_unique<Counter>())
+               .first;
+    return *it->second;
+  }
+};
+
+registry<rule_counter> &rule_registry() {
+  static registry<rule_counter> instance;
+  return instance;
+}
+
+registry<dispatch_counter> &dispatch_registry() {
+  static registry<dispatch_counter> instance;
+  return instance;
+}
+
+registry<allocation_counter> &allocation_registry() {
+  static registry<allocation_counter> instance;
+  return instance;
+}
+
+std::string json_escape(std::string_view s) {
+  std::string out;
+  out.reserve(s.size());
+  for (char c : s) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char buf[8];
+        std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+        out += buf;
+      } else {
+        out += c;
+      }
+    }
+  }
+  return out;
+}
+
+std::string format_table(snapshot_t snap) {
+  std::ranges::sort(snap.rules, [](auto const &a, auto const &b) {
+    return a.attempts != b.attempts ? a.attempts > b.attempts
+                                    : a.name < b.name;
+  });
+  std::ranges::sort(snap.dispatches, [](auto const &a, auto const &b) {
+    return a.nanoseconds != b.nanoseconds ? a.nanoseconds > b.nanoseconds
+                                          : a.name < b.name;
+  });
+  std::ranges::sort(snap.allocations, [](auto const &a, auto const &b) {
+    return a.count != b.count ? a.count > b.count : a.type_name < b.type_name;
+  });
+
+  std::string out;
+  char line[256];
+  out += "rule                                          attempts        hits"
+         "   hit%\n";
+  for (auto const &r : snap.rules) {
+    double const pct =
+        r.attempts ? 100.0 * static_cast<double>(r.hits) /
+                         static_cast<double>(r.attempts)
+                   : 0.0;
+    std::snprintf(line, sizeof(line), "%-44s %10llu %11llu %6.1f\n",
+                  r.name.c_str(), static_cast<unsigned long long>(r.attempts),
+                  static_cast<unsigned long long>(r.hits), pct);
+    out += line;
+  }
+  out += "\ndispatch                                         calls    "
+         "total[ms]  avg[us]\n";
+  for (auto const &d : snap.dispatches) {
+    double const ms = static_cast<double>(d.nanoseconds) * 1e-6;
+    double const avg_us = d.calls ? static_cast<double>(d.nanoseconds) *
+                                        1e-3 / static_cast<double>(d.calls)
+                                  : 0.0;
+    std::snprintf(line, sizeof(line), "%-44s %10llu %12.3f %8.3f\n",
+                  d.name.c_str(), static_cast<unsigned long long>(d.calls),
+                  ms, avg_us);
+    out += line;
+  }
+  out += "\nallocations                                      count\n";
+  for (auto const &a : snap.allocations) {
+    std::snprintf(line, sizeof(line), "%-44s %10llu\n", a.type_name.c_str(),
+                  static_cast<unsigned long long>(a.count));
+    out += line;
+  }
+  return out;
+}
+
+std::string format_json(snapshot_t const &snap) {
+  std::string out{"{\n  \"enabled\": "};
+  out += enabled() ? "true" : "false";
+  out += ",\n  \"rules\": [";
+  bool first = true;
+  for (auto const &r : snap.rules) {
+    out += first ? "\n    " : ",\n    ";
+    first = false;
+    out += "{\"name\": \"" + json_escape(r.name) +
+           "\", \"attempts\": " + std::to_string(r.attempts) +
+           ", \"hits\": " + std::to_string(r.hits) + "}";
+  }
+  out += first ? "],\n" : "\n  ],\n";
+  out += "  \"dispatch\": [";
+  first = true;
+  for (auto const &d : snap.dispatches) {
+    out += first ? "\n    " : ",\n    ";
+    first = false;
+    out += "{\"name\": \"" + json_escape(d.name) +
+           "\", \"calls\": " + std::to_string(d.calls) +
+           ", \"nanoseconds\": " + std::to_string(d.nanoseconds) + "}";
+  }
+  out += first ? "],\n" : "\n  ],\n";
+  out += "  \"allocations\": [";
+  first = true;
+  for (auto const &a : snap.allocations) {
+    out += first ? "\n    " : ",\n    ";
+    first = false;
+    out += "{\"type\": \"" + json_escape(a.type_name) +
+           "\", \"count\": " + std::to_string(a.count) + "}";
+  }
+  out += first ? "]\n}\n" : "\n  ]\n}\n";
+  return out;
+}
+
+} // namespace
+
+rule_counter &rule(std::string_view name) {
+  return rule_registry().get(name);
+}
+
+dispatch_counter &dispatch(std::string_view name) {
+  return dispatch_registry().get(name);
+}
+
+allocation_counter &allocation(std::string_view type_name) {
+  return allocation_registry().get(type_name);
+}
+
+snapshot_t snapshot() {
+  snapshot_t snap;
+  {
+    auto &reg = rule_registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto const &[name, c] : reg.entries)
+      snap.rules.push_back({name, c->attempts.load(std::memory_order_relaxed),
+                            c->hits.load(std::memory_order_relaxed)});
+  }
+  {
+    auto &reg = dispatch_registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto const &[name, c] : reg.entries)
+      snap.dispatches.push_back(
+          {name, c->calls.load(std::memory_order_relaxed),
+           c->nanoseconds.load(std::memory_order_relaxed)});
+  }
+  {
+    auto &reg = allocation_registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto const &[name, c] : reg.entries)
+      snap.allocations.push_back(
+          {name, c->count.load(std::memory_order_relaxed)});
+  }
+  return snap;
+}
+
+void reset() {
+  {
+    auto &reg = rule_registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto &[name, c] : reg.entries) {
+      c->attempts.store(0, std::memory_order_relaxed);
+      c->hits.store(0, std::memory_order_relaxed);
+    }
+  }
+  {
+    auto &reg = dispatch_registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto &[name, c] : reg.entries) {
+      c->calls.store(0, std::memory_order_relaxed);
+      c->nanoseconds.store(0, std::memory_order_relaxed);
+    }
+  }
+  {
+    auto &reg = allocation_registry();
+    std::scoped_lock lock(reg.mutex);
+    for (auto &[name, c] : reg.entries)
+      c->count.store(0, std::memory_order_relaxed);
+  }
+}
+
+std::string report(report_format format) {
+  if (format == report_format::json)
+    return format_json(snapshot());
+  return format_table(snapshot());
+}
+
+} // namespace numsim::cas::profiling
@@ -0,0 +1,214 @@
+#include <numsim_cas/core/substitution_map.h>
+
+#include <numsim_cas/scalar/visitors/scalar_rebuild_visitor.h>
+#include <numsim_cas/tensor/visitors/tensor_rebuild_visitor.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_rebuild_visitor.h>
+#include <unordered_map>
+
+namespace numsim::cas {
+
+substitution_map::substitution_map(
+    std::initializer_list<std::pair<scalar_holder_t, scalar_holder_t>> subs) {
+  for (auto const &[old_val, new_val] : subs)
+    add(old_val, new_val);
+}
+
+substitution_map::substitution_map(
+    std::initializer_list<std::pair<tensor_holder_t, tensor_holder_t>> subs) {
+  for (auto const &[old_val, new_val] : subs)
+    add(old_val, new_val);
+}
+
+substitution_map::substitution_map(
+    std::initializer_list<std::pair<t2s_holder_t, t2s_holder_t>> subs) {
+  for (auto const &[old_val, new_val] : subs)
+    add(old_val, new_val);
+}
+
+namespace {
+
+// ─── Shared traversal state ───────────────────────────────────────
+
+// Results per source node, keyed by node address. The source tree owns
+// every key for the whole traversal, so the addresses stay unique.
+template <typename ExprBase>
+using memo_t =
+    std::unordered_map<expression const *, expression_holder<ExprBase>>;
+
+class multi_substitution;
+
+// One rebuild visitor per domain, all sharing the map and the memo tables
+// of a multi_substitution so that cross-domain children (the scalar
+// coefficient of a tensor_scalar_mul, the tensor inside tr(.)) are routed
+// through the same cache.
+class scalar_multi_substitution final : public scalar_rebuild_visitor {
+public:
+  explicit scalar_multi_substitution(multi_substitution &owner)
+      : m_owner(owner) {}
+
+  expr_holder_t apply(expr_holder_t const &expr) override;
+
+  expr_holder_t rebuild(expr_holder_t const &expr) {
+    return scalar_rebuild_visitor::apply(expr);
+  }
+
+private:
+  multi_substitution &m_owner;
+};
+
+class tensor_multi_substitution final : public tensor_rebuild_visitor {
+public:
+  explicit tensor_multi_substitution(multi_substitution &owner)
+      : m_owner(owner) {}
+
+  tensor_holder_t apply(tensor_holder_t const &expr) override;
+  scalar_holder_t apply_scalar(scalar_holder_t const &expr) override;
+  t2s_holder_t apply_t2s(t2s_holder_t const &expr) override;
+
+  tensor_holder_t rebuild(tensor_holder_t const &expr) {
+    return tensor_rebuild_visitor::apply(expr);
+  }
+
+private:
+  multi_substitution &m_owner;
+};
+
+class t2s_multi_substitution final : public tensor_to_scalar_rebuild_visitor {
+public:
+  explicit t2s_multi_substitution(multi_substitution &owner)
+      : m_owner(owner) {}
+
+  t2s_holder_t apply(t2s_holder_t const &expr) override;
+  scalar_holder_t apply_scalar(scalar_holder_t const &expr) override;
+  tensor_holder_t apply_tensor(tensor_holder_t const &expr) override;
+
+  t2s_holder_t rebuild(t2s_holder_t const &expr) {
+    return tensor_to_scalar_rebuild_visitor::apply(expr);
+  }
+
+private:
+  multi_substitution &m_owner;
+};
+
+class multi_substitution {
+public:
+  explicit multi_substitution(substitution_map const &subs)
+      : m_subs(subs), m_scalar(*this), m_tensor(*this), m_t2s(*this) {}
+
+  template <typename ExprBase>
+  expression_holder<ExprBase> apply(expression_holder<ExprBase> const &expr) {
+    if (!expr.is_valid())
+      return expr;
+
+    auto const &targets = m_subs.entries<ExprBase>();
+    if (auto it = targets.find(expr); it != targets.end())
+      return it->second;
+    if (!m_subs.may_occur_in(expr.get()))
+      return expr;
+
+    auto &memo = memo_for<ExprBase>();
+    if (auto it = memo.find(&expr.get()); it != memo.end())
+      return it->second;
+
+    auto result = visitor_for<ExprBase>().rebuild(expr);
+    // Nothing matched below after all (free-symbol false positive): keep
+    // the source node instead of the structurally equal rebuild.
+    if (result == expr)
+      result = expr;
+    memo.emplace(&expr.get(), result);
+    return result;
+  }
+
+private:
+  template <typename ExprBase> memo_t<ExprBase> &memo_for() {
+    if constexpr (std::is_same_v<ExprBase, scalar_expression>)
+      return m_scalar_memo;
+    else if constexpr (std::is_same_v<ExprBase, tensor_expression>)
+      return m_tensor_memo;
+    else
+      return m_t2s_memo;
+  }
+
+  template <typename ExprBase> auto &visitor_for() {
+    if constexpr (std::is_same_v<ExprBase, scalar_expression>)
+      return m_scalar;
+    else if constexpr (std::is_same_v<ExprBase, tensor_expression>)
+      return m_tensor;
+    else
+      return m_t2s;
+  }
+
+  substitution_map const &m_subs;
+  scalar_multi_substitution m_scalar;
+  tensor_multi_substitution m_tensor;
+  t2s_multi_substitution m_t2s;
+  memo_t<scalar_expression> m_scalar_memo;
+  memo_t<tensor_expression> m_tensor_memo;
+  memo_t<tensor_to_scalar_expression> m_t2s_memo;
+};
+
+scalar_multi_substitution::expr_holder_t
+scalar_multi_substitution::apply(expr_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+tensor_multi_substitution::tensor_holder_t
+tensor_multi_substitution::apply(tensor_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+tensor_multi_substitution::scalar_holder_t
+tensor_multi_substitution::apply_scalar(scalar_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+tensor_multi_substitution::t2s_holder_t
+tensor_multi_substitution::apply_t2s(t2s_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+t2s_multi_substitution::t2s_holder_t
+t2s_multi_substitution::apply(t2s_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+t2s_multi_substitution::scalar_holder_t
+t2s_multi_substitution::apply_scalar(scalar_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+t2s_multi_substitution::tensor_holder_t
+t2s_multi_substitution::apply_tensor(tensor_holder_t const &expr) {
+  return m_owner.apply(expr);
+}
+
+} // namespace
+
+// ─── Public API ───────────────────────────────────────────────────
+
+expression_holder<scalar_expression>
+tag_invoke(detail::substitute_fn, std::type_identity<scalar_expression>,
+           expression_holder<scalar_expression> const &expr,
+           substitution_map const &subs) {
+  multi_substitution visitor(subs);
+  return visitor.apply(expr);
+}
+
+expression_holder<tensor_expression>
+tag_invoke(detail::substitute_fn, std::type_identity<tensor_expression>,
+           expression_holder<tensor_expression> const &expr,
+           substitution_map const &subs) {
+  multi_substitution visitor(subs);
+  return visitor.apply(expr);
+}
+
+expression_holder<tensor_to_scalar_expression>
+tag_invoke(detail::substitute_fn,
+           std::type_identity<tensor_to_scalar_expression>,
+           expression_holder<tensor_to_scalar_expression> const &expr,
+           substitution_map const &subs) {
+  multi_substitution visitor(subs);
+  return visitor.apply(expr);
+}
+
+} // namespace numsim::cas
@@ -0,0 +1,239 @@
+#include <numsim_cas/dag_printer.h>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/scalar/visitors/scalar_latex_printer.h>
+#include <numsim_cas/scalar/visitors/scalar_printer.h>
+#include <numsim_cas/tensor/visitors/tensor_latex_printer.h>
+#include <numsim_cas/tensor/visitors/tensor_printer.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_latex_printer.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_printer.h>
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace numsim::cas {
+namespace {
+
+using scalar_holder_t = expression_holder<scalar_expression>;
+using tensor_holder_t = expression_holder<tensor_expression>;
+using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+
+// The plain printers when `latex` is null, the LaTeX printers otherwise.
+void render(std::ostream &out, scalar_holder_t const &expr,
+            latex_config const *latex) {
+  if (latex != nullptr) {
+    scalar_latex_printer<std::ostream> printer(out, *latex);
+    printer.apply(expr);
+  } else {
+    scalar_printer<std::ostream> printer(out);
+    printer.apply(expr);
+  }
+}
+
+void render(std::ostream &out, tensor_holder_t const &expr,
+            latex_config const *latex) {
+  if (latex != nullptr) {
+    tensor_latex_printer<std::ostream> printer(out, *latex);
+    printer.apply(expr);
+  } else {
+    tensor_printer<std::ostream> printer(out);
+    printer.apply(expr);
+  }
+}
+
+void render(std::ostream &out, t2s_holder_t const &expr,
+            latex_config const *latex) {
+  if (latex != nullptr) {
+    tensor_to_scalar_latex_printer<std::ostream> printer(out, *latex);
+    printer.apply(expr);
+  } else {
+    tensor_to_scalar_printer<std::ostream> printer(out);
+    printer.apply(expr);
+  }
+}
+
+// Two passes over the printers with itself installed as the active
+// let_binding_hook:
+//  1. counting: print into a null stream and answer every repeated node
+//     with an empty name, so each node is descended into once and the pass
+//     costs O(DAG). Counting through the printers themselves means exactly
+//     the nodes they print are counted, in every domain.
+//  2. printing: a node used twice or more is rendered on first use into its
+//     binding (binding its own shared children on the way, so they come
+//     first) and printed by name from then on.
+// Counted nodes stay alive until the end, so a temporary the printers
+// build cannot reuse the address of a counted node.
+class let_binder final : public let_binding_hook {
+public:
+  let_binder(dag_print_options const &options, latex_config const *latex)
+      : m_prefix(options.prefix), m_latex(latex) {}
+
+  template <typename Holder> std::string print(Holder const &expr) {
+    struct activation {
+      let_binding_hook *previous;
+      explicit activation(let_binding_hook *hook)
+          : previous(std::exchange(let_binding_hook::active(), hook)) {}
+      ~activation() { let_binding_hook::active() = previous; }
+    } const scope(this);
+
+    std::ostream sink(nullptr);
+    render(sink, expr, m_latex);
+    m_counting = false;
+
+    std::ostringstream body;
+    render(body, expr, m_latex);
+
+    std::string result;
+    for (auto const &[name, definition] : m_bindings) {
+      if (m_latex != nullptr)
+        result.append(name).append(" = ").append(definition).append(
+            " \\\\\n");
+      else
+        result.append("let ")
+            .append(name)
+            .append(" = ")
+            .append(definition)
+            .append(";\n");
+    }
+    result += body.view();
+    return result;
+  }
+
+private:
+  std::string const *scalar_name(scalar_holder_t const &expr) override {
+    // A named expression already is a name.
+    if (is_same<scalar_named_expression>(expr))
+      return nullptr;
+    return lookup(expr);
+  }
+
+  std::string const *tensor_name(tensor_holder_t const &expr) override {
+    return lookup(expr);
+  }
+
+  std::string const *tensor_to_scalar_name(t2s_holder_t const &expr) override {
+    return lookup(expr);
+  }
+
+  enum class binding : std::uint8_t { pending, inlined, bound };
+
+  struct entry {
+    std::variant<scalar_holder_t, tensor_holder_t, t2s_holder_t> node;
+    std::size_t uses{1};
+    binding state{binding::pending};
+    std::string name;
+  };
+
+  template <typename Holder> std::string const *lookup(Holder const &expr) {
+    ++m_lookups;
+    void const *key{&expr.get()};
+    if (m_counting) {
+      auto [it, inserted] = m_entries.try_emplace(key);
+      if (!inserted) {
+        ++it->second.uses;
+        return &m_skip;
+      }
+      it->second.node = expr;
+      return nullptr;
+    }
+
+    if (key == m_defining) {
+      m_defining = nullptr;
+      return nullptr;
+    }
+    auto it = m_entries.find(key);
+    if (it == m_entries.end() || it->second.uses < 2)
+      return nullptr;
+    auto &node{it->second};
+    if (node.state == binding::bound)
+      return &node.name;
+    if (node.state == binding::inlined)
+      return nullptr;
+
+    auto const lookups{m_lookups};
+    auto const defining{std::exchange(m_defining, key)};
+    std::ostringstream definition;
+    render(definition, expr, m_latex);
+    m_defining = defining;
+
+    // Leaves (only the node itself was looked up) and definitions no
+    // longer than their name are cheaper printed in place.
+    auto name{next_name()};
+    if (m_lookups == lookups + 1 || definition.view().size() <= name.size()) {
+      node.state = binding::inlined;
+      return nullptr;
+    }
+    ++m_count;
+    node.state = binding::bound;
+    node.name = std::move(name);
+    m_bindings.emplace_back(node.name, std::move(definition).str());
+    return &node.name;
+  }
+
+  [[nodiscard]] std::string next_name() const {
+    auto const number{std::to_string(m_count + 1)};
+    std::string name{m_prefix};
+    if (m_latex != nullptr)
+      name.append("_{").append(number).append("}");
+    else
+      name += number;
+    return name;
+  }
+
+  std::string_view m_prefix;
+  latex_config const *m_latex;
+  std::unordered_map<void const *, entry> m_entries;
+  std::vector<std::pair<std::string, std::string>> m_bindings;
+  std::string const m_skip;
+  void const *m_defining{nullptr};
+  std::size_t m_lookups{0};
+  std::size_t m_count{0};
+  bool m_counting{true};
+};
+
+template <typename Holder>
+std::string print_dag(Holder const &expr, dag_print_options const &options,
+                      latex_config const *latex) {
+  if (!expr.is_valid())
+    return {};
+  return let_binder(options, latex).print(expr);
+}
+
+} // namespace
+
+std::string to_string_dag(scalar_holder_t const &expr,
+                          dag_print_options const &options) {
+  return print_dag(expr, options, nullptr);
+}
+
+std::string to_string_dag(tensor_holder_t const &expr,
+                          dag_print_options const &options) {
+  return print_dag(expr, options, nullptr);
+}
+
+std::string to_string_dag(t2s_holder_t const &expr,
+                          dag_print_options const &options) {
+  return print_dag(expr, options, nullptr);
+}
+
+std::string to_latex_dag(scalar_holder_t const &expr, latex_config const &cfg,
+                         dag_print_options const &options) {
+  return print_dag(expr, options, &cfg);
+}
+
+std::string to_latex_dag(tensor_holder_t const &expr, latex_config const &cfg,
+                         dag_print_options const &options) {
+  return print_dag(expr, options, &cfg);
+}
+
+std::string to_latex_dag(t2s_holder_t const &expr, latex_config const &cfg,
+                         dag_print_options const &options) {
+  return print_dag(expr, options, &cfg);
+}
+
+} // namespace numsim::cas
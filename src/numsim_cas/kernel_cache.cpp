@@ -0,0 +1,120 @@
+#include <numsim_cas/kernel_cache.h>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/operators.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_program.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+#include <numsim_cas/tensor/tensor_definitions.h>
+#include <numsim_cas/tensor/tensor_functions.h>
+#include <numsim_cas/tensor/tensor_operators.h>
+#include <numsim_cas/tensor/visitors/tensor_evaluator.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_definitions.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_operators.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
+
+#include "scalar/scalar_kernel_state.h"
+
+#include <memory>
+#include <utility>
+
+namespace numsim::cas {
+namespace {
+
+using scalar_holder_t = expression_holder<scalar_expression>;
+using tensor_holder_t = expression_holder<tensor_expression>;
+using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+
+std::string describe(std::vector<kernel_expression> const &exprs) {
+  std::string text;
+  for (auto const &expr : exprs) {
+    if (!text.empty())
+      text += ", ";
+    if (auto const *t = std::get_if<tensor_holder_t>(&expr))
+      text += "tensor " + std::to_string(t->get().dim()) + "^" +
+              std::to_string(t->get().rank());
+    else if (std::holds_alternative<t2s_holder_t>(expr))
+      text += "tensor_to_scalar";
+    else
+      text += "scalar";
+  }
+  return text;
+}
+
+std::string signature(std::vector<kernel_expression> const &outputs,
+                      std::vector<kernel_expression> const &inputs) {
+  return "model kernel v1: double; inputs: " + describe(inputs) +
+         "; outputs: " + describe(outputs);
+}
+
+std::size_t total_size(std::vector<kernel_expression> const &exprs) {
+  std::size_t size{0};
+  for (auto const &expr : exprs)
+    size += kernel_size(expr);
+  return size;
+}
+
+// The evaluators with every input bound to its place in `in`.
+void evaluate(std::vector<kernel_expression> const &outputs,
+              std::vector<kernel_expression> const &inputs, double const *in,
+              double *out) {
+  scalar_evaluator<double> scalars;
+  tensor_evaluator<double> tensors;
+  tensor_to_scalar_evaluator<double> t2s;
+  for (auto const &input : inputs) {
+    if (auto const *s = std::get_if<scalar_holder_t>(&input)) {
+      scalars.set(*s, *in);
+      tensors.set_scalar(*s, *in);
+      t2s.set_scalar(*s, *in);
+    } else {
+      auto const &t = std::get<tensor_holder_t>(input);
+      tensors.set_view(t, in);
+      t2s.set_view(t, in);
+    }
+    in += kernel_size(input);
+  }
+  for (auto const &output : outputs) {
+    if (auto const *s = std::get_if<scalar_holder_t>(&output))
+      *out = scalars.apply(*s);
+    else if (auto const *f = std::get_if<t2s_holder_t>(&output))
+      *out = t2s.apply(*f);
+    else
+      tensors.apply_into(std::get<tensor_holder_t>(output), out);
+    out += kernel_size(output);
+  }
+}
+
+} // namespace
+
+kernel_cache::kernel_cache(scalar_kernel_cache_options options)
+    : m_cache(std::move(options)) {}
+
+scalar_kernel kernel_cache::load(std::vector<kernel_expression> const &outputs,
+                                 std::vector<kernel_expression> const &inputs) {
+  auto const program = make_kernel_program(outputs, inputs);
+  auto state = std::make_shared<detail::scalar_kernel_state>();
+  state->evaluate = [outputs, inputs](double const *in, double *out) {
+    evaluate(outputs, inputs, in, out);
+  };
+  return m_cache.load_source(
+      m_cache.kernel_source(signature(outputs, inputs), program),
+      std::move(state), total_size(inputs), total_size(outputs));
+}
+
+std::string
+kernel_cache::key(std::vector<kernel_expression> const &outputs,
+                  std::vector<kernel_expression> const &inputs) const {
+  return m_cache.key_of(m_cache.kernel_source(
+      signature(outputs, inputs), make_kernel_program(outputs, inputs)));
+}
+
+scalar_kernel_cache::statistics kernel_cache::stats() const {
+  return m_cache.stats();
+}
+
+std::filesystem::path const &kernel_cache::directory() const noexcept {
+  return m_cache.directory();
+}
+
+} // namespace numsim::cas
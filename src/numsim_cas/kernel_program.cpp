@@ -0,0 +1,650 @@
+#include <numsim_cas/kernel_program.h>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/core/operators.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+#include <numsim_cas/tensor/contraction_plan.h>
+#include <numsim_cas/tensor/tensor_definitions.h>
+#include <numsim_cas/tensor/tensor_functions.h>
+#include <numsim_cas/tensor/tensor_operators.h>
+#include <numsim_cas/tensor/visitors/tensor_evaluator.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_definitions.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_operators.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
+
+#include "scalar/scalar_program_builder.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+
+namespace numsim::cas {
+namespace {
+
+using scalar_holder_t = expression_holder<scalar_expression>;
+using tensor_holder_t = expression_holder<tensor_expression>;
+using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+using opcode = scalar_program::opcode;
+// The instructions holding the components of a tensor, row-major.
+using components = std::vector<std::uint32_t>;
+
+std::size_t component_count(std::size_t dim, std::size_t rank) {
+  std::size_t size{1};
+  for (std::size_t i{0}; i < rank; ++i)
+    size *= dim;
+  return size;
+}
+
+// Multi-index of the row-major position `flat`.
+index_list unflatten(std::size_t flat, std::size_t dim, std::size_t rank) {
+  index_list index(rank);
+  for (std::size_t k = rank; k-- > 0; flat /= dim)
+    index[k] = static_cast<std::uint8_t>(flat % dim);
+  return index;
+}
+
+std::size_t flatten(index_list const &index, std::size_t dim) {
+  std::size_t flat{0};
+  for (auto i : index)
+    flat = flat * dim + i;
+  return flat;
+}
+
+[[noreturn]] void unsupported(std::string const &what) {
+  throw invalid_expression_error("make_kernel_program: " + what +
+                                 " has no closed form in the components");
+}
+
+class kernel_program_builder final
+    : public tensor_visitor_const_t,
+      public tensor_to_scalar_visitor_const_t {
+public:
+  explicit kernel_program_builder(
+      std::vector<kernel_expression> const &inputs) {
+    std::size_t position{0};
+    for (auto const &in : inputs) {
+      if (auto const *s = std::get_if<scalar_holder_t>(&in)) {
+        m_scalar.add_input(*s, position++);
+        continue;
+      }
+      auto const *t = std::get_if<tensor_holder_t>(&in);
+      if (!t || !t->is_valid() || !is_same<tensor>(*t))
+        throw invalid_expression_error(
+            "make_kernel_program: inputs have to be scalar or tensor symbols");
+      components values(kernel_size(in));
+      for (auto &value : values)
+        value = emit(
+            {opcode::input, 0, 0, 0, static_cast<double>(position++)});
+      if (!m_tensor_inputs.emplace(*t, std::move(values)).second)
+        throw invalid_expression_error("make_kernel_program: input '" +
+                                       t->get<tensor>().name() +
+                                       "' is given twice");
+    }
+    m_scalar.program().inputs = position;
+  }
+
+  void add_output(kernel_expression const &expr) {
+    auto &outputs = m_scalar.program().outputs;
+    if (auto const *s = std::get_if<scalar_holder_t>(&expr))
+      outputs.push_back(m_scalar.apply(*s));
+    else if (auto const *f = std::get_if<t2s_holder_t>(&expr))
+      outputs.push_back(apply(*f));
+    else {
+      auto const values = apply(std::get<tensor_holder_t>(expr));
+      outputs.insert(outputs.end(), values.begin(), values.end());
+    }
+  }
+
+  scalar_program take() && { return std::move(m_scalar).take(); }
+
+  components apply(tensor_holder_t const &expr) {
+    if (!expr.is_valid())
+      throw invalid_expression_error(
+          "make_kernel_program: invalid expression");
+    auto const *node = &expr.get();
+    if (auto it = m_tensors.find(node); it != m_tensors.end())
+      return it->second;
+    m_current_tensor = &expr;
+    expr.template get<tensor_visitable_t>().accept(*this);
+    return m_tensors.emplace(node, std::move(m_components)).first->second;
+  }
+
+  std::uint32_t apply(t2s_holder_t const &expr) {
+    if (!expr.is_valid())
+      throw invalid_expression_error(
+          "make_kernel_program: invalid expression");
+    auto const *node = &expr.get();
+    if (auto it = m_t2s.find(node); it != m_t2s.end())
+      return it->second;
+    expr.template get<tensor_to_scalar_visitable_t>().accept(*this);
+    m_t2s.emplace(node, m_value);
+    return m_value;
+  }
+
+  // ─── Tensor nodes ────────────────────────────────────────────
+
+  void operator()(tensor const &v) override {
+    auto it = m_tensor_inputs.find(*m_current_tensor);
+    if (it == m_tensor_inputs.end())
+      throw invalid_expression_error("make_kernel_program: symbol '" +
+                                     v.name() + "' is not an input");
+    m_components = it->second;
+  }
+
+  void operator()(tensor_zero const &v) override {
+    m_components.assign(component_count(v.dim(), v.rank()), constant(0.0));
+  }
+  void operator()(identity_tensor const &) override { constant_tensor(); }
+  void operator()(levi_civita_tensor const &) override { constant_tensor(); }
+  void operator()(tensor_projector const &) override { constant_tensor(); }
+
+  void operator()(tensor_add const &v) override {
+    components result(component_count(v.dim(), v.rank()), constant(0.0));
+    auto accumulate = [&](tensor_holder_t const &child) {
+      auto const values = apply(child);
+      for (std::size_t i{0}; i < result.size(); ++i)
+        result[i] = add(result[i], values[i]);
+    };
+    if (v.coeff().is_valid())
+      accumulate(v.coeff());
+    for (auto const &child : v.symbol_map())
+      accumulate(child);
+    m_components = std::move(result);
+  }
+
+  void operator()(tensor_negative const &v) override {
+    m_components = apply(v.expr());
+    for (auto &value : m_components)
+      value = negate(value);
+  }
+
+  void operator()(tensor_scalar_mul const &v) override {
+    scale(m_scalar.apply(v.expr_lhs()), v.expr_rhs());
+  }
+
+  void operator()(tensor_to_scalar_with_tensor_mul const &v) override {
+    scale(apply(v.expr_rhs()), v.expr_lhs());
+  }
+
+  void operator()(tensor_if_then_else_scalar const &v) override {
+    select(m_scalar.apply(v.expr_cond()), v.expr_then(), v.expr_else());
+  }
+
+  void operator()(tensor_if_then_else_t2s const &v) override {
+    select(apply(v.expr_cond()), v.expr_then(), v.expr_else());
+  }
+
+  // A projector on the left is contracted directly; the evaluator has a
+  // shortcut for it and plan_contractions keeps it as an operand.
+  void operator()(inner_product_wrapper const &v) override {
+    if (is_same<tensor_projector>(v.expr_lhs())) {
+      auto const &lhs = v.expr_lhs();
+      auto const &rhs = v.expr_rhs();
+      m_components =
+          contract(apply(lhs), lhs.get().rank(), apply(rhs), rhs.get().rank(),
+                   v.indices_lhs().indices(), v.indices_rhs().indices(),
+                   v.dim());
+      return;
+    }
+    m_components = contraction_network(plan_contractions(v), v.dim());
+  }
+
+  void operator()(tensor_mul const &v) override {
+    if (v.data().empty()) {
+      m_components.assign(component_count(v.dim(), v.rank()), constant(0.0));
+      return;
+    }
+    auto result = contraction_network(plan_contractions(v), v.dim());
+    // Componentwise, as in tensor_evaluator.
+    if (v.coeff().is_valid()) {
+      auto const coeff = apply(v.coeff());
+      for (std::size_t i{0}; i < result.size(); ++i)
+        result[i] = mul(result[i], coeff[i]);
+    }
+    m_components = std::move(result);
+  }
+
+  void operator()(outer_product_wrapper const &v) override {
+    auto const &lhs = v.expr_lhs();
+    auto const &rhs = v.expr_rhs();
+    m_components = outer(apply(lhs), apply(rhs), v.indices_lhs().indices(),
+                         v.indices_rhs().indices(), v.dim(), v.rank());
+  }
+
+  void operator()(permute_indices_wrapper const &v) override {
+    m_components =
+        permute(apply(v.expr()), v.indices().indices(), v.dim(), v.rank());
+  }
+
+  void operator()(simple_outer_product const &v) override {
+    auto const &children = v.data();
+    if (children.empty()) {
+      m_components.assign(component_count(v.dim(), v.rank()), constant(0.0));
+      return;
+    }
+    auto result = apply(children.front());
+    std::size_t rank = children.front().get().rank();
+    for (std::size_t i = 1; i < children.size(); ++i) {
+      std::size_t const rhs_rank = children[i].get().rank();
+      index_list lhs_seq(rank), rhs_seq(rhs_rank);
+      std::iota(lhs_seq.begin(), lhs_seq.end(), std::uint8_t{0});
+      std::iota(rhs_seq.begin(), rhs_seq.end(),
+                static_cast<std::uint8_t>(rank));
+      result = outer(result, apply(children[i]), lhs_seq, rhs_seq, v.dim(),
+                     rank + rhs_rank);
+      rank += rhs_rank;
+    }
+    m_components = std::move(result);
+  }
+
+  // A^n by squaring; the exponent has to be a constant.
+  void operator()(tensor_pow const &v) override {
+    double exponent{0};
+    try {
+      exponent = scalar_evaluator<double>{}.apply(v.expr_rhs());
+    } catch (evaluation_error const &) {
+      unsupported("tensor_pow with a non-constant exponent");
+    }
+    auto const n = static_cast<int>(exponent);
+    auto const d = v.dim();
+    auto const r = v.rank();
+    if (n == 0) {
+      constant_tensor(make_expression<identity_tensor>(d, r));
+      return;
+    }
+    auto base = apply(v.expr_lhs());
+    auto m = static_cast<std::size_t>(std::abs(n));
+    index_list const last{static_cast<std::uint8_t>(r - 1)};
+    index_list const first{0};
+    components result;
+    while (true) {
+      if (m & 1u)
+        result = result.empty() ? base
+                                : contract(result, r, base, r, last, first, d);
+      m >>= 1u;
+      if (m == 0)
+        break;
+      base = contract(base, r, base, r, last, first, d);
+    }
+    m_components = std::move(result);
+  }
+
+  // Adjugate over the determinant for rank 2.
+  void operator()(tensor_inv const &v) override {
+    auto const d = v.dim();
+    if (v.rank() != 2 || d > 3)
+      unsupported("inv of a rank-" + std::to_string(v.rank()) + " tensor in " +
+                  std::to_string(d) + "D");
+    auto const a = apply(v.expr());
+    if (d == 1) {
+      m_components = {reciprocal(a[0])};
+      return;
+    }
+    components adj;
+    if (d == 2) {
+      adj = {a[3], negate(a[1]), negate(a[2]), a[0]};
+    } else {
+      auto minor = [&](std::size_t i, std::size_t j, std::size_t k,
+                       std::size_t l) {
+        return sub(mul(a[i], a[j]), mul(a[k], a[l]));
+      };
+      // adj(A)_ij = cofactor(A)_ji
+      adj = {minor(4, 8, 5, 7), minor(2, 7, 1, 8), minor(1, 5, 2, 4),
+             minor(5, 6, 3, 8), minor(0, 8, 2, 6), minor(2, 3, 0, 5),
+             minor(3, 7, 4, 6), minor(1, 6, 0, 7), minor(0, 4, 1, 3)};
+    }
+    std::uint32_t det{constant(0.0)};
+    for (std::size_t j{0}; j < d; ++j)
+      det = add(det, mul(a[j], adj[j * d]));
+    auto const inv_det = reciprocal(det);
+    for (auto &value : adj)
+      value = mul(value, inv_det);
+    m_components = std::move(adj);
+  }
+
+  void operator()(tensor_eigenprojection const &) override {
+    unsupported("eigenprojection");
+  }
+  void operator()(tensor_eigenvector const &) override {
+    unsupported("eigenvector");
+  }
+  void operator()(tensor_isotropic_function const &) override {
+    unsupported("isotropic tensor function");
+  }
+
+  // ─── Tensor-to-scalar nodes ──────────────────────────────────
+
+  void operator()(tensor_to_scalar_zero const &) override {
+    m_value = constant(0.0);
+  }
+  void operator()(tensor_to_scalar_one const &) override {
+    m_value = constant(1.0);
+  }
+  void operator()(tensor_to_scalar_scalar_wrapper const &v) override {
+    m_value = m_scalar.apply(v.expr());
+  }
+
+  void operator()(tensor_to_scalar_if_then_else const &v) override {
+    auto const cond = apply(v.expr_cond());
+    auto const then_arm = apply(v.expr_then());
+    auto const else_arm = apply(v.expr_else());
+    m_value = emit({opcode::select, cond, then_arm, else_arm, 0});
+  }
+
+  void operator()(tensor_to_scalar_negative const &v) override {
+    m_value = negate(apply(v.expr()));
+  }
+  void operator()(tensor_to_scalar_log const &v) override {
+    m_value = emit({opcode::log, apply(v.expr()), 0, 0, 0});
+  }
+  void operator()(tensor_to_scalar_exp const &v) override {
+    m_value = emit({opcode::exp, apply(v.expr()), 0, 0, 0});
+  }
+  void operator()(tensor_to_scalar_sqrt const &v) override {
+    m_value = emit({opcode::sqrt, apply(v.expr()), 0, 0, 0});
+  }
+  void operator()(tensor_to_scalar_pow const &v) override {
+    auto const base = apply(v.expr_lhs());
+    auto const exponent = apply(v.expr_rhs());
+    m_value = emit({opcode::pow, base, exponent, 0, 0});
+  }
+
+  void operator()(tensor_to_scalar_add const &v) override {
+    std::uint32_t result{constant(0.0)};
+    if (v.coeff().is_valid())
+      result = add(result, apply(v.coeff()));
+    for (auto const &child : v.symbol_map())
+      result = add(result, apply(child));
+    m_value = result;
+  }
+
+  void operator()(tensor_to_scalar_mul const &v) override {
+    std::uint32_t result{constant(1.0)};
+    if (v.coeff().is_valid())
+      result = mul(result, apply(v.coeff()));
+    for (auto const &child : v.symbol_map())
+      result = mul(result, apply(child));
+    m_value = result;
+  }
+
+  void operator()(tensor_trace const &v) override {
+    auto const a = rank2_operand(v.expr(), "trace");
+    auto const d = v.expr().get().dim();
+    std::uint32_t result{constant(0.0)};
+    for (std::size_t i{0}; i < d; ++i)
+      result = add(result, a[i * d + i]);
+    m_value = result;
+  }
+
+  void operator()(tensor_det const &v) override {
+    auto const a = rank2_operand(v.expr(), "det");
+    auto const d = v.expr().get().dim();
+    if (d == 2) {
+      m_value = sub(mul(a[0], a[3]), mul(a[1], a[2]));
+    } else if (d == 3) {
+      auto minor = [&](std::size_t i, std::size_t j, std::size_t k,
+                       std::size_t l) {
+        return sub(mul(a[i], a[j]), mul(a[k], a[l]));
+      };
+      m_value = add(sub(mul(a[0], minor(4, 8, 5, 7)),
+                        mul(a[1], minor(3, 8, 5, 6))),
+                    mul(a[2], minor(3, 7, 4, 6)));
+    } else {
+      unsupported("det in " + std::to_string(d) + "D");
+    }
+  }
+
+  void operator()(tensor_norm const &v) override {
+    auto const a = rank2_operand(v.expr(), "norm");
+    m_value = emit({opcode::sqrt, dot(a, a), 0, 0, 0});
+  }
+
+  void operator()(tensor_dot const &v) override {
+    auto const a = rank2_operand(v.expr(), "dot");
+    m_value = dot(a, a);
+  }
+
+  // Full contraction over the given index pairs.
+  void operator()(tensor_inner_product_to_scalar const &v) override {
+    auto const &lhs = v.expr_lhs();
+    auto const &rhs = v.expr_rhs();
+    auto const result =
+        contract(apply(lhs), lhs.get().rank(), apply(rhs), rhs.get().rank(),
+                 v.indices_lhs().indices(), v.indices_rhs().indices(),
+                 lhs.get().dim());
+    m_value = result.front();
+  }
+
+  void operator()(tensor_to_scalar_eigenvalue const &) override {
+    unsupported("eigenvalue");
+  }
+  void operator()(tensor_to_scalar_divided_difference const &) override {
+    unsupported("divided difference");
+  }
+
+private:
+  std::uint32_t emit(scalar_program::instruction const &inst) {
+    return m_scalar.emit(inst);
+  }
+
+  std::uint32_t constant(double value) {
+    auto [it, inserted] =
+        m_constants.try_emplace(std::bit_cast<std::uint64_t>(value), 0);
+    if (inserted)
+      it->second = emit({opcode::constant, 0, 0, 0, value});
+    return it->second;
+  }
+
+  bool is_constant(std::uint32_t value, double c) const {
+    auto const &inst = m_scalar.program().code[value];
+    return inst.op == opcode::constant && inst.value == c;
+  }
+
+  std::uint32_t add(std::uint32_t a, std::uint32_t b) {
+    if (is_constant(a, 0.0))
+      return b;
+    if (is_constant(b, 0.0))
+      return a;
+    return emit({opcode::add, a, b, 0, 0});
+  }
+
+  std::uint32_t mul(std::uint32_t a, std::uint32_t b) {
+    if (is_constant(a, 0.0) || is_constant(b, 0.0))
+      return constant(0.0);
+    if (is_constant(a, 1.0))
+      return b;
+    if (is_constant(b, 1.0))
+      return a;
+    return emit({opcode::mul, a, b, 0, 0});
+  }
+
+  std::uint32_t negate(std::uint32_t a) {
+    if (is_constant(a, 0.0))
+      return a;
+    return emit({opcode::neg, a, 0, 0, 0});
+  }
+
+  std::uint32_t sub(std::uint32_t a, std::uint32_t b) {
+    return add(a, negate(b));
+  }
+
+  std::uint32_t reciprocal(std::uint32_t a) {
+    return emit({opcode::pow, a, constant(-1.0), 0, 0});
+  }
+
+  std::uint32_t dot(components const &a, components const &b) {
+    std::uint32_t result{constant(0.0)};
+    for (std::size_t i{0}; i < a.size(); ++i)
+      result = add(result, mul(a[i], b[i]));
+    return result;
+  }
+
+  components rank2_operand(tensor_holder_t const &expr, char const *what) {
+    if (expr.get().rank() != 2)
+      unsupported(std::string(what) + " of a rank-" +
+                  std::to_string(expr.get().rank()) + " tensor");
+    return apply(expr);
+  }
+
+  // Tensors without symbols, evaluated once and stored as constants.
+  void constant_tensor() { constant_tensor(*m_current_tensor); }
+  void constant_tensor(tensor_holder_t const &expr) {
+    tensor_evaluator<double> ev;
+    auto const data = ev.apply(expr);
+    auto const *values = data->raw_data();
+    m_components.resize(component_count(data->dim(), data->rank()));
+    for (std::size_t i{0}; i < m_components.size(); ++i)
+      m_components[i] = constant(values[i]);
+  }
+
+  void scale(std::uint32_t factor, tensor_holder_t const &expr) {
+    m_components = apply(expr);
+    for (auto &value : m_components)
+      value = mul(factor, value);
+  }
+
+  void select(std::uint32_t cond, tensor_holder_t const &then_expr,
+              tensor_holder_t const &else_expr) {
+    auto const then_arm = apply(then_expr);
+    auto const else_arm = apply(else_expr);
+    m_components.resize(then_arm.size());
+    for (std::size_t i{0}; i < then_arm.size(); ++i)
+      m_components[i] =
+          emit({opcode::select, cond, then_arm[i], else_arm[i], 0});
+  }
+
+  // lhs_indices[k] of lhs is summed against rhs_indices[k] of rhs. The
+  // result has the free lhs indices followed by the free rhs indices, each
+  // in their original order (tensor_data_inner_product).
+  components contract(components const &lhs, std::size_t lhs_rank,
+                      components const &rhs, std::size_t rhs_rank,
+                      index_list const &lhs_indices,
+                      index_list const &rhs_indices, std::size_t dim) {
+    auto free_positions = [](std::size_t rank, index_list const &summed) {
+      index_list free;
+      for (std::size_t k{0}; k < rank; ++k)
+        if (std::find(summed.begin(), summed.end(), k) == summed.end())
+          free.push_back(static_cast<std::uint8_t>(k));
+      return free;
+    };
+    auto const free_lhs = free_positions(lhs_rank, lhs_indices);
+    auto const free_rhs = free_positions(rhs_rank, rhs_indices);
+    auto const summed = lhs_indices.size();
+    auto const terms = component_count(dim, summed);
+    auto const result_rank = free_lhs.size() + free_rhs.size();
+
+    components result(component_count(dim, result_rank));
+    index_list lhs_index(lhs_rank), rhs_index(rhs_rank);
+    for (std::size_t i{0}; i < result.size(); ++i) {
+      auto const out = unflatten(i, dim, result_rank);
+      for (std::size_t k{0}; k < free_lhs.size(); ++k)
+        lhs_index[free_lhs[k]] = out[k];
+      for (std::size_t k{0}; k < free_rhs.size(); ++k)
+        rhs_index[free_rhs[k]] = out[free_lhs.size() + k];
+      std::uint32_t sum{constant(0.0)};
+      for (std::size_t c{0}; c < terms; ++c) {
+        auto const inner = unflatten(c, dim, summed);
+        for (std::size_t k{0}; k < summed; ++k) {
+          lhs_index[lhs_indices[k]] = inner[k];
+          rhs_index[rhs_indices[k]] = inner[k];
+        }
+        sum = add(sum, mul(lhs[flatten(lhs_index, dim)],
+                           rhs[flatten(rhs_index, dim)]));
+      }
+      result[i] = sum;
+    }
+    return result;
+  }
+
+  // result(i...) = lhs(i[lhs_indices]...) * rhs(i[rhs_indices]...)
+  components outer(components const &lhs, components const &rhs,
+                   index_list const &lhs_indices,
+                   index_list const &rhs_indices, std::size_t dim,
+                   std::size_t rank) {
+    components result(component_count(dim, rank));
+    index_list lhs_index(lhs_indices.size()), rhs_index(rhs_indices.size());
+    for (std::size_t i{0}; i < result.size(); ++i) {
+      auto const out = unflatten(i, dim, rank);
+      for (std::size_t k{0}; k < lhs_indices.size(); ++k)
+        lhs_index[k] = out[lhs_indices[k]];
+      for (std::size_t k{0}; k < rhs_indices.size(); ++k)
+        rhs_index[k] = out[rhs_indices[k]];
+      result[i] =
+          mul(lhs[flatten(lhs_index, dim)], rhs[flatten(rhs_index, dim)]);
+    }
+    return result;
+  }
+
+  // result(i...) = in(i[indices]...), see tensor_data_permute_indices.
+  components permute(components const &in, index_list const &indices,
+                     std::size_t dim, std::size_t rank) {
+    components result(in.size());
+    index_list in_index(rank);
+    for (std::size_t i{0}; i < result.size(); ++i) {
+      auto const out = unflatten(i, dim, rank);
+      for (std::size_t k{0}; k < rank; ++k)
+        in_index[k] = out[indices[k]];
+      result[i] = in[flatten(in_index, dim)];
+    }
+    return result;
+  }
+
+  // Same steps as tensor_evaluator::eval_contraction_plan.
+  components contraction_network(contraction_plan const &plan,
+                                 std::size_t dim) {
+    std::vector<components> slots;
+    std::vector<std::size_t> ranks;
+    for (auto const &expr : plan.operands) {
+      slots.push_back(apply(expr));
+      ranks.push_back(expr.get().rank());
+    }
+    for (auto const &step : plan.steps) {
+      slots[step.lhs] =
+          contract(slots[step.lhs], ranks[step.lhs], slots[step.rhs],
+                   ranks[step.rhs], step.lhs_indices, step.rhs_indices, dim);
+      ranks[step.lhs] = step.result_rank;
+    }
+    auto &result = slots[plan.result_slot];
+    if (!plan.permutation.empty())
+      return permute(result, plan.permutation, dim, ranks[plan.result_slot]);
+    return std::move(result);
+  }
+
+  detail::scalar_program_builder m_scalar;
+  std::map<tensor_holder_t, components> m_tensor_inputs;
+  std::unordered_map<tensor_expression const *, components> m_tensors;
+  std::unordered_map<tensor_to_scalar_expression const *, std::uint32_t>
+      m_t2s;
+  std::unordered_map<std::uint64_t, std::uint32_t> m_constants;
+  tensor_holder_t const *m_current_tensor{nullptr};
+  components m_components;
+  std::uint32_t m_value{0};
+};
+
+} // namespace
+
+std::size_t kernel_size(kernel_expression const &expr) {
+  if (auto const *t = std::get_if<tensor_holder_t>(&expr))
+    return t->is_valid() ? component_count(t->get().dim(), t->get().rank())
+                         : 0;
+  return 1;
+}
+
+scalar_program
+make_kernel_program(std::vector<kernel_expression> const &outputs,
+                    std::vector<kernel_expression> const &inputs) {
+  kernel_program_builder builder(inputs);
+  for (auto const &out : outputs)
+    builder.add_output(out);
+  return std::move(builder).take();
+}
+
+} // namespace numsim::cas
@@ -84,6 +84,9 @@ struct parser_state {
   std::optional<std::size_t> pending_rank;
   std::optional<std::size_t> pending_dim;
 
+  // Finished statements of a `statement_list` parse, in source order.
+  std::vector<parsed_expression> statements;
+
   symbol_table &syms;
   std::string_view source;
 
@@ -104,6 +107,33 @@ require_scalar(registry::parser_value &v, std::size_t pos,
                             pos, source);
 }
 
+// Pops the single finished value off the stack as a public
+// `parsed_expression`. An index_list_value at the top is a syntax error —
+// bracket-list literals are only valid inside contraction function arg
+// lists, never as a top-level expression.
+inline parsed_expression take_result(parser_state &state, std::size_t pos) {
+  if (state.values.size() != 1) {
+    throw syntax_error("parser ended with " +
+                           std::to_string(state.values.size()) +
+                           " expressions on the stack (expected exactly 1)",
+                       pos, state.source);
+  }
+  auto value = std::move(state.values.back());
+  state.values.pop_back();
+  return std::visit(
+      [&](auto &&v) -> parsed_expression {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, registry::index_list_value>) {
+          throw syntax_error(
+              "bracket-list literal '[...]' cannot be a top-level expression",
+              pos, state.source);
+        } else {
+          return std::move(v);
+        }
+      },
+      std::move(value));
+}
+
 // Same-domain combinator: lhs OP rhs only when both values are in
 // the SAME alternative AND that alternative is an expression
 // (not index_list_value). Used by +, -, and the comparison
@@ -439,6 +469,17 @@ template <> struct action<grammar::eq_tail_ne> {
   }
 };
 
+// ─── Statements (parse_all) ───────────────────────────────────────
+// Each finished statement leaves exactly one value on the stack; move
+// it to the result list so the stack is empty for the next one.
+template <> struct action<grammar::statement> {
+  template <typename Input>
+  static void apply(Input const &in, parser_state &state) {
+    state.statements.push_back(
+        take_result(state, in.position().byte + in.size()));
+  }
+};
+
 // ─── Function calls ───────────────────────────────────────────────
 // The opening '(' of a function call records the current value-stack
 // depth. By the time the matching ')' fires the function_call action,
@@ -232,6 +232,18 @@ struct expression : eq_term {};
 // to end of input.
 struct grammar : pegtl::must<ws, expression, ws, pegtl::eof> {};
 
+// ─── Statement lists (parse_all) ──────────────────────────────────
+// `expr; expr; …` with an optional trailing `;`; empty statements are
+// skipped. `statement` is a distinct rule so its action can move each
+// finished expression off the value stack as soon as it is reduced.
+struct statement : expression {};
+struct statement_separator : pegtl::one<';'> {};
+struct statement_list
+    : pegtl::must<ws, pegtl::opt<statement>,
+                  pegtl::star<ws, statement_separator, ws,
+                              pegtl::opt<statement>>,
+                  ws, pegtl::eof> {};
+
 } // namespace numsim::cas::parser::grammar
 
 #endif // NUMSIM_CAS_PARSER_GRAMMAR_H
@@ -8,6 +8,8 @@
 #include <tao/pegtl.hpp>
 #include <tao/pegtl/contrib/parse_tree.hpp>
 
+#include <fstream>
+#include <iterator>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -43,12 +45,9 @@ syntax_error translate_pegtl_error(pegtl::parse_error const &e,
 } // namespace
 
 parsed_expression parse(std::string_view source, symbol_table &syms) {
-  // Make a copy into a std::string-backed input — PEGTL's
-  // memory_input takes ownership of the source view (it doesn't
-  // copy) so callers must keep the string alive across the parse.
-  // string_input copies the data internally, which is safer for our
-  // public API where we accept a string_view by value.
-  pegtl::string_input input{std::string(source), "<source>"};
+  // memory_input reads `source` in place; the view only has to outlive
+  // this call, which it does.
+  pegtl::memory_input<> input(source.data(), source.size(), "<source>");
 
   // #222 — roll back any declarations if the parse throws, so a failed
   // parse leaves the symbol_table unchanged (committed only on success).
@@ -67,33 +66,51 @@ parsed_expression parse(std::string_view source, symbol_table &syms) {
     throw translate_pegtl_error(e, source);
   }
 
-  if (state.values.size() != 1) {
-    throw syntax_error("parser ended with " +
-                           std::to_string(state.values.size()) +
-                           " expressions on the stack (expected exactly 1)",
-                       source.size(), source);
-  }
-  // Convert from the parser-internal `parser_value` (which can hold an
-  // index_list_value as a 4th alternative) to the public
-  // `parsed_expression`. An index_list_value at the top is a syntax
-  // error — bracket-list literals are only valid inside contraction
-  // function arg lists, never as a top-level expression.
-  auto result = std::visit(
-      [&](auto &&v) -> parsed_expression {
-        using V = std::decay_t<decltype(v)>;
-        if constexpr (std::is_same_v<V, registry::index_list_value>) {
-          throw syntax_error(
-              "bracket-list literal '[...]' cannot be a top-level expression",
-              source.size(), source);
-        } else {
-          return std::move(v);
-        }
-      },
-      std::move(state.values.front()));
+  auto result = actions::take_result(state, source.size());
   tx.commit();
   return result;
 }
 
+parse_batch parse_all(std::string_view source, symbol_table &syms) {
+  auto const start = std::chrono::steady_clock::now();
+  pegtl::memory_input<> input(source.data(), source.size(), "<source>");
+
+  // One transaction for the whole batch: all-or-nothing, and the
+  // journal-based rollback costs nothing per statement.
+  symbol_table::transaction tx(syms);
+
+  actions::parser_state state(syms, source);
+
+  try {
+    pegtl::parse<grammar::statement_list, actions::action>(input, state);
+  } catch (parse_error const &) {
+    throw;
+  } catch (pegtl::parse_error const &e) {
+    throw translate_pegtl_error(e, source);
+  }
+  tx.commit();
+
+  parse_batch batch;
+  batch.expressions = std::move(state.statements);
+  batch.statistics.statements = batch.expressions.size();
+  batch.statistics.bytes = source.size();
+  batch.statistics.elapsed =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start);
+  return batch;
+}
+
+parse_batch parse_file(std::filesystem::path const &path, symbol_table &syms) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw parse_error("cannot open '" + path.string() + "' for reading", 0,
+                      std::string_view{});
+  }
+  std::string const source{std::istreambuf_iterator<char>(in),
+                           std::istreambuf_iterator<char>()};
+  return parse_all(source, syms);
+}
+
 expression_holder<scalar_expression> parse_scalar(std::string_view source,
                                                   symbol_table &syms) {
   // #222/#314 — outer transaction so a domain mismatch rolls back the
@@ -11,36 +11,39 @@ namespace numsim::cas::parser {
 
 expression_holder<scalar_expression>
 symbol_table::get_or_declare_scalar(std::string_view name) {
-  std::string key(name);
-  auto it = m_entries.find(key);
+  auto it = m_entries.find(name);
   if (it == m_entries.end()) {
+    std::string key(name);
     auto expr = make_expression<scalar>(key);
     m_entries.emplace(std::move(key), scalar_entry{expr});
+    journal(name);
     return expr;
   }
   if (auto *s = std::get_if<scalar_entry>(&it->second)) {
     return s->expr;
   }
   // Existing entry is a tensor — cross-type collision.
-  throw type_collision_error(
-      "'" + key + "' is already declared as a tensor; cannot reuse as a scalar",
-      0, std::string_view{});
+  throw type_collision_error("'" + std::string(name) +
+                                 "' is already declared as a tensor; cannot "
+                                 "reuse as a scalar",
+                             0, std::string_view{});
 }
 
 expression_holder<tensor_expression>
 symbol_table::get_or_declare_tensor(std::string_view name, std::size_t rank,
                                     std::size_t dim) {
-  std::string key(name);
-  auto it = m_entries.find(key);
+  auto it = m_entries.find(name);
   if (it == m_entries.end()) {
+    std::string key(name);
     auto expr = make_expression<tensor>(key, dim, rank);
     m_entries.emplace(std::move(key), tensor_entry{expr, rank, dim});
+    journal(name);
     return expr;
   }
   if (auto *t = std::get_if<tensor_entry>(&it->second)) {
     if (t->rank != rank || t->dim != dim) {
       std::ostringstream oss;
-      oss << "'" << key
+      oss << "'" << name
           << "' is already declared as a tensor with rank=" << t->rank
           << ", dim=" << t->dim << "; cannot redeclare with rank=" << rank
           << ", dim=" << dim;
@@ -49,21 +52,19 @@ symbol_table::get_or_declare_tensor(std::string_view name, std::size_t rank,
     return t->expr;
   }
   // Existing entry is a scalar — cross-type collision.
-  throw type_collision_error(
-      "'" + key + "' is already declared as a scalar; cannot reuse as a tensor",
-      0, std::string_view{});
+  throw type_collision_error("'" + std::string(name) +
+                                 "' is already declared as a scalar; cannot "
+                                 "reuse as a tensor",
+                             0, std::string_view{});
 }
 
 bool symbol_table::has(std::string_view name) const noexcept {
-  // unordered_map::find takes string; we materialise a key.
-  // C++20 heterogeneous lookup would avoid the allocation but requires
-  // a custom hash/equal — not worth the complexity for occasional lookup.
-  return m_entries.find(std::string(name)) != m_entries.end();
+  return m_entries.contains(name);
 }
 
 std::optional<std::pair<std::size_t, std::size_t>>
 symbol_table::tensor_shape(std::string_view name) const {
-  auto it = m_entries.find(std::string(name));
+  auto it = m_entries.find(name);
   if (it == m_entries.end())
     return std::nullopt;
   if (auto const *t = std::get_if<tensor_entry>(&it->second)) {
@@ -74,7 +75,7 @@ symbol_table::tensor_shape(std::string_view name) const {
 
 std::optional<symbol_table::lookup_result>
 symbol_table::get(std::string_view name) const {
-  auto it = m_entries.find(std::string(name));
+  auto it = m_entries.find(name);
   if (it == m_entries.end())
     return std::nullopt;
   if (auto const *s = std::get_if<scalar_entry>(&it->second))
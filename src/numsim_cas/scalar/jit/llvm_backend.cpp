@@ -0,0 +1,290 @@
+#include "llvm_backend.h"
+
+#include <numsim_cas/core/cas_error.h>
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/Verifier.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// CMakeLists.txt only adds this file for these versions.
+#if LLVM_VERSION_MAJOR < 14 || LLVM_VERSION_MAJOR > 18
+#error "scalar_jit: the LLVM backend supports LLVM 14 to 18"
+#endif
+
+namespace numsim::cas::detail {
+namespace {
+
+#if LLVM_VERSION_MAJOR >= 18
+using codegen_level_t = llvm::CodeGenOptLevel;
+#else
+using codegen_level_t = llvm::CodeGenOpt::Level;
+#endif
+
+bool initialize_native_target() {
+  static bool const ok = [] {
+    return !llvm::InitializeNativeTarget() &&
+           !llvm::InitializeNativeTargetAsmPrinter();
+  }();
+  return ok;
+}
+
+[[noreturn]] void fail(llvm::Error err) {
+  throw internal_error("scalar_jit: " + llvm::toString(std::move(err)));
+}
+
+template <typename T> T unwrap(llvm::Expected<T> value) {
+  if (!value)
+    fail(value.takeError());
+  return std::move(*value);
+}
+
+llvm::OptimizationLevel optimization_level(unsigned level) {
+  switch (level) {
+  case 0:
+    return llvm::OptimizationLevel::O0;
+  case 1:
+    return llvm::OptimizationLevel::O1;
+  case 2:
+    return llvm::OptimizationLevel::O2;
+  default:
+    return llvm::OptimizationLevel::O3;
+  }
+}
+
+codegen_level_t codegen_level(unsigned level) {
+  switch (level) {
+  case 0:
+    return codegen_level_t::None;
+  case 1:
+    return codegen_level_t::Less;
+  case 2:
+    return codegen_level_t::Default;
+  default:
+    return codegen_level_t::Aggressive;
+  }
+}
+
+// Emits `void name(double const *in, double *out)` for `program`.
+void emit_kernel(scalar_program const &program, std::string const &name,
+                 llvm::Module &module) {
+  using opcode = scalar_program::opcode;
+  auto &ctx = module.getContext();
+  llvm::IRBuilder<> b(ctx);
+  auto *f64 = b.getDoubleTy();
+  auto *ptr = llvm::PointerType::getUnqual(f64);
+  auto *fn = llvm::Function::Create(
+      llvm::FunctionType::get(b.getVoidTy(), {ptr, ptr}, false),
+      llvm::Function::ExternalLinkage, name, module);
+  fn->addFnAttr(llvm::Attribute::NoUnwind);
+  for (unsigned i : {0u, 1u})
+    fn->addParamAttr(i, llvm::Attribute::NoAlias);
+  fn->addParamAttr(0, llvm::Attribute::ReadOnly);
+  auto *in = fn->getArg(0);
+  auto *out = fn->getArg(1);
+  b.SetInsertPoint(llvm::BasicBlock::Create(ctx, "entry", fn));
+
+  auto *zero = llvm::ConstantFP::get(f64, 0.0);
+  auto *one = llvm::ConstantFP::get(f64, 1.0);
+  auto libm = [&](char const *fname) {
+    return module.getOrInsertFunction(
+        fname, llvm::FunctionType::get(f64, {f64}, false));
+  };
+  auto indicator = [&](llvm::Value *cond) {
+    return b.CreateSelect(cond, one, zero);
+  };
+
+  std::vector<llvm::Value *> values;
+  values.reserve(program.code.size());
+  for (auto const &inst : program.code) {
+    auto arg = [&](std::uint32_t i) { return values[i]; };
+    llvm::Value *v{nullptr};
+    switch (inst.op) {
+    case opcode::input:
+      v = b.CreateLoad(
+          f64, b.CreateConstInBoundsGEP1_64(
+                   f64, in, static_cast<std::uint64_t>(inst.value)));
+      break;
+    case opcode::constant:
+      v = llvm::ConstantFP::get(f64, inst.value);
+      break;
+    case opcode::add:
+      v = b.CreateFAdd(arg(inst.a), arg(inst.b));
+      break;
+    case opcode::mul:
+      v = b.CreateFMul(arg(inst.a), arg(inst.b));
+      break;
+    case opcode::neg:
+      v = b.CreateFNeg(arg(inst.a));
+      break;
+    case opcode::pow:
+      v = b.CreateBinaryIntrinsic(llvm::Intrinsic::pow, arg(inst.a),
+                                  arg(inst.b));
+      break;
+    case opcode::sin:
+      v = b.CreateUnaryIntrinsic(llvm::Intrinsic::sin, arg(inst.a));
+      break;
+    case opcode::cos:
+      v = b.CreateUnaryIntrinsic(llvm::Intrinsic::cos, arg(inst.a));
+      break;
+    case opcode::tan:
+      v = b.CreateCall(libm("tan"), {arg(inst.a)});
+      break;
+    case opcode::asin:
+      v = b.CreateCall(libm("asin"), {arg(inst.a)});
+      break;
+    case opcode::acos:
+      v = b.CreateCall(libm("acos"), {arg(inst.a)});
+      break;
+    case opcode::atan:
+      v = b.CreateCall(libm("atan"), {arg(inst.a)});
+      break;
+    case opcode::sqrt:
+      v = b.CreateUnaryIntrinsic(llvm::Intrinsic::sqrt, arg(inst.a));
+      break;
+    case opcode::log:
+      v = b.CreateUnaryIntrinsic(llvm::Intrinsic::log, arg(inst.a));
+      break;
+    case opcode::exp:
+      v = b.CreateUnaryIntrinsic(llvm::Intrinsic::exp, arg(inst.a));
+      break;
+    case opcode::abs:
+      v = b.CreateUnaryIntrinsic(llvm::Intrinsic::fabs, arg(inst.a));
+      break;
+    case opcode::sign: {
+      auto *u = arg(inst.a);
+      v = b.CreateSelect(
+          b.CreateFCmpOGT(u, zero), one,
+          b.CreateSelect(b.CreateFCmpOLT(u, zero),
+                         llvm::ConstantFP::get(f64, -1.0), zero));
+      break;
+    }
+    case opcode::lt:
+      v = indicator(b.CreateFCmpOLT(arg(inst.a), arg(inst.b)));
+      break;
+    case opcode::le:
+      v = indicator(b.CreateFCmpOLE(arg(inst.a), arg(inst.b)));
+      break;
+    case opcode::eq:
+      v = indicator(b.CreateFCmpOEQ(arg(inst.a), arg(inst.b)));
+      break;
+    case opcode::ne:
+      v = indicator(b.CreateFCmpUNE(arg(inst.a), arg(inst.b)));
+      break;
+    case opcode::max:
+      v = b.CreateSelect(b.CreateFCmpOLT(arg(inst.a), arg(inst.b)),
+                         arg(inst.b), arg(inst.a));
+      break;
+    case opcode::min:
+      v = b.CreateSelect(b.CreateFCmpOLT(arg(inst.b), arg(inst.a)),
+                         arg(inst.b), arg(inst.a));
+      break;
+    case opcode::select:
+      v = b.CreateSelect(b.CreateFCmpUNE(arg(inst.a), zero), arg(inst.b),
+                         arg(inst.c));
+      break;
+    }
+    values.push_back(v);
+  }
+  for (std::size_t j{0}; j < program.outputs.size(); ++j)
+    b.CreateStore(values[program.outputs[j]],
+                  b.CreateConstInBoundsGEP1_64(f64, out, j));
+  b.CreateRetVoid();
+}
+
+} // namespace
+
+struct llvm_backend::session {
+  std::unique_ptr<llvm::TargetMachine> target;
+  std::unique_ptr<llvm::orc::LLJIT> jit;
+  unsigned opt_level{2};
+  std::atomic<std::size_t> next_id{0};
+
+  void optimize(llvm::Module &module) const {
+    if (opt_level == 0)
+      return;
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+    llvm::PassBuilder pb(target.get());
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+    pb.buildPerModuleDefaultPipeline(optimization_level(opt_level))
+        .run(module, mam);
+  }
+};
+
+llvm_backend::llvm_backend(std::unique_ptr<session> s)
+    : m_session(std::move(s)) {}
+
+llvm_backend::~llvm_backend() = default;
+
+bool llvm_backend::available() noexcept { return initialize_native_target(); }
+
+std::shared_ptr<llvm_backend> llvm_backend::create(unsigned opt_level) {
+  if (!initialize_native_target())
+    return nullptr;
+  auto s = std::make_unique<session>();
+  s->opt_level = opt_level;
+  auto jtmb = unwrap(llvm::orc::JITTargetMachineBuilder::detectHost());
+  jtmb.setCodeGenOptLevel(codegen_level(opt_level));
+  s->target = unwrap(jtmb.createTargetMachine());
+  s->jit = unwrap(
+      llvm::orc::LLJITBuilder().setJITTargetMachineBuilder(jtmb).create());
+  // tan, asin, ... and whatever the intrinsics lower to come from the
+  // libm already loaded into the process.
+  s->jit->getMainJITDylib().addGenerator(
+      unwrap(llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+          s->jit->getDataLayout().getGlobalPrefix())));
+  return std::shared_ptr<llvm_backend>(new llvm_backend(std::move(s)));
+}
+
+native_code llvm_backend::compile(scalar_program const &program) {
+  auto const name = "numsim_cas_kernel_" + std::to_string(m_session->next_id++);
+  auto ctx = std::make_unique<llvm::LLVMContext>();
+  auto module = std::make_unique<llvm::Module>(name, *ctx);
+  module->setDataLayout(m_session->jit->getDataLayout());
+  module->setTargetTriple(m_session->jit->getTargetTriple().str());
+  emit_kernel(program, name, *module);
+  if (llvm::verifyModule(*module, &llvm::errs()))
+    throw internal_error("scalar_jit: generated invalid code");
+  m_session->optimize(*module);
+
+  auto tracker = m_session->jit->getMainJITDylib().createResourceTracker();
+  llvm::orc::ThreadSafeModule tsm(std::move(module), std::move(ctx));
+  if (auto err = m_session->jit->addIRModule(tracker, std::move(tsm)))
+    fail(std::move(err));
+  // lookup() returns an ExecutorAddr from LLVM 15 on.
+#if LLVM_VERSION_MAJOR >= 15
+  auto const address = unwrap(m_session->jit->lookup(name)).getValue();
+#else
+  auto const address = unwrap(m_session->jit->lookup(name)).getAddress();
+#endif
+
+  native_code code;
+  code.function = reinterpret_cast<scalar_kernel::function_t>(address);
+  code.owner = std::shared_ptr<void const>(
+      reinterpret_cast<void const *>(address),
+      [self = shared_from_this(), tracker](void const *) {
+        llvm::consumeError(tracker->remove());
+      });
+  return code;
+}
+
+} // namespace numsim::cas::detail
@@ -0,0 +1,39 @@
+#ifndef LLVM_BACKEND_H
+#define LLVM_BACKEND_H
+
+// JIT backend of scalar_jit on LLVM ORC. Only compiled with
+// NUMSIM_CAS_ENABLE_JIT when CMake finds LLVM; no LLVM type appears here.
+
+#include <memory>
+
+#include <numsim_cas/scalar/scalar_jit.h>
+#include <numsim_cas/scalar/scalar_program.h>
+
+namespace numsim::cas::detail {
+
+struct native_code {
+  scalar_kernel::function_t function{nullptr};
+  // Removes the code from the JIT session when the last copy goes away.
+  std::shared_ptr<void const> owner;
+};
+
+class llvm_backend : public std::enable_shared_from_this<llvm_backend> {
+public:
+  // Null if the native target cannot be initialized.
+  static std::shared_ptr<llvm_backend> create(unsigned opt_level);
+  static bool available() noexcept;
+
+  ~llvm_backend();
+
+  native_code compile(scalar_program const &program);
+
+private:
+  struct session;
+  explicit llvm_backend(std::unique_ptr<session> s);
+
+  std::unique_ptr<session> m_session;
+};
+
+} // namespace numsim::cas::detail
+
+#endif // LLVM_BACKEND_H
@@ -7,6 +7,7 @@ expression_holder<scalar_expression>
 binary_scalar_pow_simplify(expression_holder<scalar_expression> lhs,
                            expression_holder<scalar_expression> rhs) {
   auto &_lhs{lhs.template get<scalar_visitable_t>()};
+  NUMSIM_CAS_PROFILE_SCOPE("scalar::pow_base");
   simplifier::pow_base visitor(std::move(lhs), std::move(rhs));
   return _lhs.accept(visitor);
 }
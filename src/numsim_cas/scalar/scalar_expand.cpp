@@ -0,0 +1,482 @@
+#include <numsim_cas/scalar/scalar_expand.h>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_domain_traits.h>
+#include <numsim_cas/scalar/scalar_functions.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/scalar/visitors/scalar_rebuild_visitor.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace numsim::cas {
+namespace {
+
+using expr_holder_t = expression_holder<scalar_expression>;
+using scalar_traits = domain_traits<scalar_expression>;
+
+// Degree bounds saturate here; anything this large is not expanded.
+constexpr std::uint64_t degree_limit{std::uint64_t{1} << 32};
+
+struct holder_hash {
+  std::size_t operator()(expr_holder_t const &expr) const noexcept {
+    return expr.get().hash_value();
+  }
+};
+
+// Exponent of a pow node that expand multiplies out, if any.
+std::optional<std::uint64_t> expansion_exponent(scalar_pow const &pow_node) {
+  auto const n{try_int_constant(pow_node.expr_rhs())};
+  if (!n || *n < 0)
+    return std::nullopt;
+  return static_cast<std::uint64_t>(*n);
+}
+
+bool is_polynomial_node(expr_holder_t const &expr) {
+  if (is_same<scalar_add>(expr) || is_same<scalar_mul>(expr) ||
+      is_same<scalar_negative>(expr))
+    return true;
+  return is_same<scalar_pow>(expr) &&
+         expansion_exponent(expr.get<scalar_pow>()).has_value();
+}
+
+// Atoms of one polynomial subtree and a bound on the exponents that can
+// occur while expanding it. Atoms are keyed by node, generators by value,
+// so equal atoms built separately share a generator.
+struct polynomial_context {
+  std::vector<expr_holder_t> generators;
+  std::unordered_map<expr_holder_t, std::size_t, holder_hash> generator_index;
+  std::unordered_map<void const *, std::size_t> atom_generator;
+  std::unordered_map<void const *, std::uint64_t> degree;
+  std::uint64_t max_degree{0};
+};
+
+// Exponents of all generators packed into Words machine words, `bits` per
+// generator. Fields are sized from the degree bound, so adding two packed
+// monomials of a product never carries from one field into the next.
+template <std::size_t Words> struct packed_monomial {
+  std::array<std::uint64_t, Words> words{};
+
+  friend packed_monomial operator+(packed_monomial lhs,
+                                   packed_monomial const &rhs) noexcept {
+    for (std::size_t i = 0; i < Words; ++i)
+      lhs.words[i] += rhs.words[i];
+    return lhs;
+  }
+  friend bool operator==(packed_monomial const &,
+                         packed_monomial const &) = default;
+};
+
+template <std::size_t Words> struct packed_monomial_hash {
+  std::size_t operator()(packed_monomial<Words> const &m) const noexcept {
+    std::size_t seed{0};
+    for (auto const word : m.words)
+      hash_combine(seed, word);
+    return seed;
+  }
+};
+
+// Hash-map polynomial over packed monomials for one polynomial subtree.
+template <std::size_t Words> class packed_expansion {
+public:
+  using monomial_t = packed_monomial<Words>;
+  using polynomial_t = std::unordered_map<monomial_t, scalar_number,
+                                          packed_monomial_hash<Words>>;
+
+  packed_expansion(polynomial_context const &context, unsigned bits,
+                   expand_options const &options)
+      : m_context(context), m_bits(bits), m_fields_per_word(64 / bits),
+        m_options(options) {}
+
+  polynomial_t const &convert(expr_holder_t const &expr) {
+    void const *key{&expr.get()};
+    if (auto it = m_memo.find(key); it != m_memo.end())
+      return it->second;
+    return m_memo.emplace(key, convert_node(expr)).first->second;
+  }
+
+  [[nodiscard]] expr_holder_t rebuild(polynomial_t const &poly) const {
+    scalar_number constant{0};
+    std::vector<expr_holder_t> terms;
+    std::vector<expr_holder_t> colliding;
+    std::unordered_set<std::size_t> seen;
+    terms.reserve(poly.size());
+    for (auto const &[exponents, coefficient] : poly) {
+      if (exponents == monomial_t{}) {
+        constant = coefficient;
+        continue;
+      }
+      auto const product{monomial_expression(exponents)};
+      auto term{scaled(product, coefficient)};
+      // Products of atoms may simplify (sqrt(x)^2 -> x, exp(a)*exp(b) ->
+      // exp(a+b)) and meet another term. Like terms share their hash, so
+      // only terms with a fresh product hash go into the flat sum; the
+      // rest are added through the simplifier.
+      if (scalar_traits::try_numeric(product) ||
+          is_same<scalar_add>(product) ||
+          !seen.insert(product.get().hash_value()).second)
+        colliding.push_back(std::move(term));
+      else
+        terms.push_back(std::move(term));
+    }
+
+    expr_holder_t result;
+    if (terms.empty() ||
+        (terms.size() == 1 && constant == scalar_number{0})) {
+      result = terms.empty() ? scalar_traits::make_constant(constant)
+                             : std::move(terms.front());
+    } else {
+      result = make_expression<scalar_add>();
+      auto &add{result.get<scalar_add>()};
+      add.append(terms);
+      if (constant != scalar_number{0})
+        add.set_coeff(scalar_traits::make_constant(constant));
+    }
+    for (auto &term : colliding)
+      result = std::move(result) + std::move(term);
+    return result;
+  }
+
+private:
+  polynomial_t convert_node(expr_holder_t const &expr) {
+    if (auto value = scalar_traits::try_numeric(expr)) {
+      polynomial_t result;
+      if (*value != scalar_number{0})
+        result.emplace(monomial_t{}, *value);
+      return result;
+    }
+    if (auto it = m_context.atom_generator.find(&expr.get());
+        it != m_context.atom_generator.end())
+      return {{variable(it->second, 1), scalar_number{1}}};
+
+    if (is_same<scalar_negative>(expr)) {
+      auto result{convert(expr.get<scalar_negative>().expr())};
+      for (auto &coefficient : result | std::views::values)
+        coefficient = -coefficient;
+      return result;
+    }
+    if (is_same<scalar_add>(expr)) {
+      auto const &add{expr.get<scalar_add>()};
+      polynomial_t result;
+      if (add.coeff().is_valid())
+        result = convert(add.coeff());
+      for (auto const &child : add.symbol_map())
+        accumulate(result, convert(child));
+      drop_zeros(result);
+      return result;
+    }
+    if (is_same<scalar_mul>(expr)) {
+      auto const &mul{expr.get<scalar_mul>()};
+      polynomial_t result{{monomial_t{}, scalar_number{1}}};
+      if (mul.coeff().is_valid())
+        result = convert(mul.coeff());
+      for (auto const &child : mul.symbol_map())
+        result = multiply(result, convert(child));
+      return result;
+    }
+    auto const &pow_node{expr.get<scalar_pow>()};
+    return power(convert(pow_node.expr_lhs()),
+                 *expansion_exponent(pow_node));
+  }
+
+  [[nodiscard]] monomial_t variable(std::size_t generator,
+                                    std::uint64_t exponent) const noexcept {
+    monomial_t result;
+    result.words[generator / m_fields_per_word] =
+        exponent << (m_bits * (generator % m_fields_per_word));
+    return result;
+  }
+
+  [[nodiscard]] std::uint64_t exponent(monomial_t const &m,
+                                       std::size_t generator) const noexcept {
+    auto const mask{(std::uint64_t{1} << m_bits) - 1};
+    return (m.words[generator / m_fields_per_word] >>
+            (m_bits * (generator % m_fields_per_word))) &
+           mask;
+  }
+
+  [[nodiscard]] expr_holder_t
+  monomial_expression(monomial_t const &m) const {
+    expr_holder_t product;
+    for (std::size_t g = 0; g < m_context.generators.size(); ++g) {
+      auto const e{exponent(m, g)};
+      if (e == 0)
+        continue;
+      auto const &generator{m_context.generators[g]};
+      product *= e == 1 ? generator
+                        : pow(generator, static_cast<long long>(e));
+    }
+    return product;
+  }
+
+  static expr_holder_t scaled(expr_holder_t const &product,
+                              scalar_number const &coefficient) {
+    if (coefficient == scalar_number{1})
+      return product;
+    if (coefficient == scalar_number{-1})
+      return -product;
+    return scalar_traits::make_constant(coefficient) * product;
+  }
+
+  static void add_term(polynomial_t &poly, monomial_t const &m,
+                       scalar_number const &coefficient) {
+    auto [it, inserted] = poly.try_emplace(m, coefficient);
+    if (!inserted)
+      it->second = it->second + coefficient;
+  }
+
+  static void accumulate(polynomial_t &into, polynomial_t const &from) {
+    for (auto const &[m, coefficient] : from)
+      add_term(into, m, coefficient);
+  }
+
+  static void drop_zeros(polynomial_t &poly) {
+    std::erase_if(poly, [](auto const &entry) {
+      return entry.second == scalar_number{0};
+    });
+  }
+
+  [[nodiscard]] polynomial_t multiply(polynomial_t const &lhs,
+                                      polynomial_t const &rhs) const {
+    auto const &outer{lhs.size() >= rhs.size() ? lhs : rhs};
+    auto const &inner{lhs.size() >= rhs.size() ? rhs : lhs};
+    std::vector<std::pair<monomial_t, scalar_number>> const terms(
+        outer.begin(), outer.end());
+    auto const product_of = [&](std::size_t first, std::size_t last) {
+      polynomial_t result;
+      result.reserve((last - first) * inner.size());
+      for (std::size_t i = first; i < last; ++i)
+        for (auto const &[m, coefficient] : inner)
+          add_term(result, terms[i].first + m, terms[i].second * coefficient);
+      return result;
+    };
+
+    std::size_t threads{m_options.max_threads != 0
+                            ? m_options.max_threads
+                            : std::thread::hardware_concurrency()};
+    threads = std::min(threads, terms.size());
+    if (threads < 2 ||
+        terms.size() * inner.size() < m_options.parallel_threshold) {
+      auto result{product_of(0, terms.size())};
+      drop_zeros(result);
+      return result;
+    }
+
+    // Rows of the outer operand are split across threads, each with its
+    // own map; the partial products are summed afterwards. Only numbers
+    // and packed words are touched off the calling thread.
+    std::vector<std::future<polynomial_t>> parts;
+    auto const chunk{(terms.size() + threads - 1) / threads};
+    for (std::size_t first = chunk; first < terms.size(); first += chunk)
+      parts.push_back(std::async(std::launch::async, product_of, first,
+                                 std::min(first + chunk, terms.size())));
+    auto result{product_of(0, std::min(chunk, terms.size()))};
+    for (auto &part : parts)
+      accumulate(result, part.get());
+    drop_zeros(result);
+    return result;
+  }
+
+  [[nodiscard]] polynomial_t power(polynomial_t const &base,
+                                   std::uint64_t n) const {
+    polynomial_t result{{monomial_t{}, scalar_number{1}}};
+    polynomial_t square{base};
+    while (n != 0) {
+      if ((n & 1u) != 0)
+        result = multiply(result, square);
+      n >>= 1u;
+      if (n != 0)
+        square = multiply(square, square);
+    }
+    return result;
+  }
+
+  polynomial_context const &m_context;
+  unsigned m_bits;
+  std::size_t m_fields_per_word;
+  expand_options const &m_options;
+  std::unordered_map<void const *, polynomial_t> m_memo;
+};
+
+class scalar_expander final : public scalar_rebuild_visitor {
+public:
+  explicit scalar_expander(expand_options const &options)
+      : m_options(options) {}
+
+  expr_holder_t apply(expr_holder_t const &expr) override {
+    if (!expr.is_valid())
+      return expr;
+    void const *key{&expr.get()};
+    if (auto it = m_done.find(key); it != m_done.end())
+      return it->second;
+    auto result{is_polynomial_node(expr) ? expand_polynomial(expr)
+                                         : scalar_rebuild_visitor::apply(expr)};
+    m_done.emplace(key, result);
+    return result;
+  }
+
+private:
+  expr_holder_t expand_polynomial(expr_holder_t const &expr) {
+    polynomial_context context;
+    analyse(expr, context);
+    if (context.max_degree < degree_limit) {
+      auto const bits{std::max(1u, static_cast<unsigned>(
+                                       std::bit_width(context.max_degree)))};
+      auto const fields_per_word{64 / bits};
+      auto const words{(context.generators.size() + fields_per_word - 1) /
+                       fields_per_word};
+      if (words <= 1)
+        return expand_packed<1>(expr, context, bits);
+      if (words <= 2)
+        return expand_packed<2>(expr, context, bits);
+      if (words <= 4)
+        return expand_packed<4>(expr, context, bits);
+      if (words <= 8)
+        return expand_packed<8>(expr, context, bits);
+    }
+    return distribute(expr, context);
+  }
+
+  template <std::size_t Words>
+  expr_holder_t expand_packed(expr_holder_t const &expr,
+                              polynomial_context const &context,
+                              unsigned bits) {
+    packed_expansion<Words> expansion(context, bits, m_options);
+    return expansion.rebuild(expansion.convert(expr));
+  }
+
+  // Numbers the atoms (expanded inside first) and bounds the degree of
+  // every node. Must classify nodes exactly like packed_expansion does.
+  std::uint64_t analyse(expr_holder_t const &expr,
+                        polynomial_context &context) {
+    void const *key{&expr.get()};
+    if (auto it = context.degree.find(key); it != context.degree.end())
+      return it->second;
+
+    auto const saturate = [](std::uint64_t value) {
+      return std::min(value, degree_limit);
+    };
+    std::uint64_t degree{0};
+    if (scalar_traits::try_numeric(expr)) {
+      degree = 0;
+    } else if (is_same<scalar_add>(expr)) {
+      auto const &add{expr.get<scalar_add>()};
+      if (add.coeff().is_valid())
+        degree = analyse(add.coeff(), context);
+      for (auto const &child : add.symbol_map())
+        degree = std::max(degree, analyse(child, context));
+    } else if (is_same<scalar_mul>(expr)) {
+      auto const &mul{expr.get<scalar_mul>()};
+      if (mul.coeff().is_valid())
+        degree = analyse(mul.coeff(), context);
+      for (auto const &child : mul.symbol_map())
+        degree = saturate(degree + analyse(child, context));
+    } else if (is_same<scalar_negative>(expr)) {
+      degree = analyse(expr.get<scalar_negative>().expr(), context);
+    } else if (is_polynomial_node(expr)) {
+      auto const &pow_node{expr.get<scalar_pow>()};
+      auto const n{*expansion_exponent(pow_node)};
+      auto const base{analyse(pow_node.expr_lhs(), context)};
+      degree = base != 0 && n >= degree_limit / base ? degree_limit
+                                                     : saturate(n * base);
+    } else {
+      auto atom{scalar_rebuild_visitor::apply(expr)};
+      auto const [it, inserted] = context.generator_index.try_emplace(
+          atom, context.generators.size());
+      if (inserted)
+        context.generators.push_back(std::move(atom));
+      context.atom_generator.emplace(key, it->second);
+      degree = 1;
+    }
+    context.max_degree = std::max(context.max_degree, degree);
+    context.degree.emplace(key, degree);
+    return degree;
+  }
+
+  // Fallback for subtrees whose exponents do not fit eight words:
+  // distributes through the simplifying operators instead.
+  expr_holder_t distribute(expr_holder_t const &expr,
+                           polynomial_context const &context) {
+    if (scalar_traits::try_numeric(expr))
+      return expr;
+    if (auto it = context.atom_generator.find(&expr.get());
+        it != context.atom_generator.end())
+      return context.generators[it->second];
+    if (is_same<scalar_negative>(expr))
+      return -distribute(expr.get<scalar_negative>().expr(), context);
+    if (is_same<scalar_add>(expr)) {
+      auto const &add{expr.get<scalar_add>()};
+      expr_holder_t result;
+      if (add.coeff().is_valid())
+        result += distribute(add.coeff(), context);
+      for (auto const &child : add.symbol_map())
+        result += distribute(child, context);
+      return result;
+    }
+    if (is_same<scalar_mul>(expr)) {
+      auto const &mul{expr.get<scalar_mul>()};
+      expr_holder_t result;
+      if (mul.coeff().is_valid())
+        result = distribute(mul.coeff(), context);
+      for (auto const &child : mul.symbol_map()) {
+        auto factor{distribute(child, context)};
+        result = result.is_valid() ? multiply_out(result, factor) : factor;
+      }
+      return result;
+    }
+    auto const &pow_node{expr.get<scalar_pow>()};
+    auto const base{distribute(pow_node.expr_lhs(), context)};
+    expr_holder_t result{get_scalar_one()};
+    for (auto n = *expansion_exponent(pow_node); n != 0; --n)
+      result = multiply_out(result, base);
+    return result;
+  }
+
+  static std::vector<expr_holder_t> summands(expr_holder_t const &expr) {
+    if (!is_same<scalar_add>(expr))
+      return {expr};
+    auto const &add{expr.get<scalar_add>()};
+    std::vector<expr_holder_t> result;
+    if (add.coeff().is_valid())
+      result.push_back(add.coeff());
+    for (auto const &child : add.symbol_map())
+      result.push_back(child);
+    return result;
+  }
+
+  static expr_holder_t multiply_out(expr_holder_t const &lhs,
+                                    expr_holder_t const &rhs) {
+    expr_holder_t result;
+    for (auto const &a : summands(lhs))
+      for (auto const &b : summands(rhs))
+        result += a * b;
+    return result;
+  }
+
+  expand_options const &m_options;
+  // Results per input node; the input keeps every key alive.
+  std::unordered_map<void const *, expr_holder_t> m_done;
+};
+
+} // namespace
+
+expression_holder<scalar_expression>
+expand(expression_holder<scalar_expression> const &expr,
+       expand_options const &options) {
+  scalar_expander expander(options);
+  return expander.apply(expr);
+}
+
+} // namespace numsim::cas
@@ -0,0 +1,142 @@
+#include <numsim_cas/scalar/scalar_jit.h>
+
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/core/hash_functions.h>
+#include <numsim_cas/scalar/scalar_program.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+
+#include "scalar_kernel_state.h"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#ifdef NUMSIM_CAS_HAS_LLVM_JIT
+#include "jit/llvm_backend.h"
+#endif
+
+namespace numsim::cas {
+
+double scalar_kernel::operator()(std::span<double const> in) const {
+  if (!m_state)
+    throw evaluation_error("scalar_kernel: empty kernel");
+  if (m_outputs != 1)
+    throw evaluation_error("scalar_kernel: " + std::to_string(m_outputs) +
+                           " outputs, pass an output array");
+  if (in.size() != m_inputs)
+    throw evaluation_error("scalar_kernel: expected " +
+                           std::to_string(m_inputs) + " inputs, got " +
+                           std::to_string(in.size()));
+  double out{0};
+  (*this)(in.data(), &out);
+  return out;
+}
+
+void scalar_kernel::evaluate(double const *in, double *out) const {
+  if (!m_state)
+    throw evaluation_error("scalar_kernel: empty kernel");
+  if (m_state->evaluate) {
+    m_state->evaluate(in, out);
+    return;
+  }
+  scalar_evaluator<double> ev;
+  for (std::size_t i{0}; i < m_inputs; ++i)
+    ev.set(m_state->inputs[i], in[i]);
+  for (std::size_t j{0}; j < m_outputs; ++j)
+    out[j] = ev.apply(m_state->outputs[j]);
+}
+
+struct scalar_jit::impl {
+  scalar_jit_options options;
+#ifdef NUMSIM_CAS_HAS_LLVM_JIT
+  std::shared_ptr<detail::llvm_backend> backend;
+#endif
+  mutable std::mutex mutex;
+  std::unordered_map<std::size_t, std::vector<scalar_kernel>> cache;
+  std::size_t size{0};
+};
+
+namespace {
+
+using expr_holder_t = expression_holder<scalar_expression>;
+
+std::size_t kernel_hash(std::vector<expr_holder_t> const &outputs,
+                        std::vector<expr_holder_t> const &inputs) {
+  std::size_t seed{outputs.size()};
+  hash_combine(seed, inputs.size());
+  for (auto const &e : outputs)
+    hash_combine(seed, e.is_valid() ? e.get().hash_value() : 0);
+  for (auto const &e : inputs)
+    hash_combine(seed, e.is_valid() ? e.get().hash_value() : 0);
+  return seed;
+}
+
+} // namespace
+
+scalar_jit::scalar_jit(scalar_jit_options options)
+    : m_impl(std::make_unique<impl>()) {
+  m_impl->options = options;
+#ifdef NUMSIM_CAS_HAS_LLVM_JIT
+  if (options.native)
+    m_impl->backend = detail::llvm_backend::create(options.opt_level);
+#endif
+}
+
+scalar_jit::~scalar_jit() = default;
+
+scalar_kernel scalar_jit::compile(std::vector<expr_holder_t> const &outputs,
+                                  std::vector<expr_holder_t> const &inputs) {
+  auto const hash = kernel_hash(outputs, inputs);
+  std::scoped_lock lock(m_impl->mutex);
+  auto &bucket = m_impl->cache[hash];
+  for (auto const &kernel : bucket)
+    if (kernel.m_state->outputs == outputs && kernel.m_state->inputs == inputs)
+      return kernel;
+
+  // Lowering also checks the inputs, so both paths reject the same input.
+  auto const program = make_scalar_program(outputs, inputs);
+
+  auto state = std::make_shared<detail::scalar_kernel_state>();
+  state->outputs = outputs;
+  state->inputs = inputs;
+  scalar_kernel kernel;
+#ifdef NUMSIM_CAS_HAS_LLVM_JIT
+  if (m_impl->backend) {
+    auto native = m_impl->backend->compile(program);
+    kernel.m_function = native.function;
+    state->code = std::move(native.owner);
+  }
+#endif
+  kernel.m_state = std::move(state);
+  kernel.m_inputs = inputs.size();
+  kernel.m_outputs = outputs.size();
+  bucket.push_back(kernel);
+  ++m_impl->size;
+  return kernel;
+}
+
+scalar_kernel scalar_jit::compile(expr_holder_t const &output,
+                                  std::vector<expr_holder_t> const &inputs) {
+  return compile(std::vector<expr_holder_t>{output}, inputs);
+}
+
+std::size_t scalar_jit::cache_size() const {
+  std::scoped_lock lock(m_impl->mutex);
+  return m_impl->size;
+}
+
+void scalar_jit::clear_cache() {
+  std::scoped_lock lock(m_impl->mutex);
+  m_impl->cache.clear();
+  m_impl->size = 0;
+}
+
+bool scalar_jit::native_available() noexcept {
+#ifdef NUMSIM_CAS_HAS_LLVM_JIT
+  return detail::llvm_backend::available();
+#else
+  return false;
+#endif
+}
+
+} // namespace numsim::cas
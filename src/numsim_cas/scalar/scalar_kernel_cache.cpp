@@ -0,0 +1,322 @@
+#include <numsim_cas/scalar/scalar_kernel_cache.h>
+
+#include <numsim_cas/scalar/scalar_program.h>
+
+#include "scalar_kernel_state.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#if __has_include(<dlfcn.h>) && __has_include(<unistd.h>)
+#include <dlfcn.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NUMSIM_CAS_HAS_DLOPEN
+#endif
+
+namespace numsim::cas {
+namespace {
+
+constexpr char const *kernel_symbol = "numsim_cas_kernel";
+
+std::uint64_t fnv1a(std::string const &text) {
+  std::uint64_t h = 1469598103934665603ULL;
+  for (unsigned char c : text) {
+    h ^= c;
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+std::string hex(std::uint64_t value) {
+  char buffer[17];
+  std::snprintf(buffer, sizeof(buffer), "%016llx",
+                static_cast<unsigned long long>(value));
+  return buffer;
+}
+
+std::filesystem::path default_directory() {
+  auto const *xdg = std::getenv("XDG_CACHE_HOME");
+  if (xdg && *xdg)
+    return std::filesystem::path(xdg) / "numsim_cas" / "kernels";
+  auto const *home = std::getenv("HOME");
+  if (home && *home)
+    return std::filesystem::path(home) / ".cache" / "numsim_cas" / "kernels";
+  // No shared fallback such as the temporary directory: its name would be
+  // predictable and writable by every local user.
+  return {};
+}
+
+std::optional<std::string> read_file(std::filesystem::path const &file) {
+  std::ifstream in(file, std::ios::binary);
+  if (!in)
+    return std::nullopt;
+  return std::string(std::istreambuf_iterator<char>(in), {});
+}
+
+#ifdef NUMSIM_CAS_HAS_DLOPEN
+
+// True if `path` is a directory (or a regular file) of the effective user
+// that nobody else can write to. Everything loaded from the cache has to
+// pass this, otherwise another local user could plant code in it.
+bool is_private(std::filesystem::path const &path, bool directory) {
+  struct ::stat st;
+  if (::lstat(path.c_str(), &st) != 0)
+    return false;
+  if (directory ? !S_ISDIR(st.st_mode) : !S_ISREG(st.st_mode))
+    return false;
+  return st.st_uid == ::geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+// Creates `dir` with mode 0700 (its parents with the default mode) unless
+// it exists; true if it is private afterwards.
+bool make_private_directory(std::filesystem::path const &dir) {
+  std::error_code ec;
+  std::filesystem::create_directories(dir.parent_path(), ec);
+  if (::mkdir(dir.c_str(), S_IRWXU) != 0 && errno != EEXIST)
+    return false;
+  return is_private(dir, true);
+}
+
+// Single quotes for /bin/sh.
+std::string shell_quote(std::string const &arg) {
+  std::string out = "'";
+  for (char c : arg)
+    out += c == '\'' ? std::string("'\\''") : std::string(1, c);
+  return out + "'";
+}
+
+// Loads `file` and looks up the kernel; null on failure. The returned owner
+// closes the library.
+std::shared_ptr<void const> open_kernel(std::filesystem::path const &file,
+                                        scalar_kernel::function_t &function) {
+  void *handle = ::dlopen(file.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!handle)
+    return nullptr;
+  void *symbol = ::dlsym(handle, kernel_symbol);
+  if (!symbol) {
+    ::dlclose(handle);
+    return nullptr;
+  }
+  function = reinterpret_cast<scalar_kernel::function_t>(symbol);
+  return std::shared_ptr<void const>(handle, [](void const *h) {
+    ::dlclose(const_cast<void *>(h));
+  });
+}
+
+#endif
+
+} // namespace
+
+struct scalar_kernel_cache::impl {
+  scalar_kernel_cache_options options;
+  mutable std::mutex mutex;
+  // key -> (source, kernel); the source rules out hash collisions.
+  std::unordered_map<std::string, std::pair<std::string, scalar_kernel>>
+      kernels;
+  statistics stats;
+  std::atomic<std::size_t> next_temporary{0};
+
+#ifdef NUMSIM_CAS_HAS_DLOPEN
+  // <key>.so if <key>.c in the private cache directory equals `source` and
+  // both files are private too; null otherwise.
+  std::shared_ptr<void const> open_stored(std::string const &source,
+                                          std::string const &key,
+                                          scalar_kernel::function_t &function) {
+    auto const &dir = options.directory;
+    auto const c_file = dir / (key + ".c");
+    auto const so_file = dir / (key + ".so");
+    if (!is_private(c_file, false) || read_file(c_file) != source ||
+        !is_private(so_file, false))
+      return nullptr;
+    return open_kernel(so_file, function);
+  }
+
+  // Compiles `source` into <key>.so next to <key>.c. Both are written
+  // under a unique temporary stem first and renamed, the object first, so
+  // a stored pair is always complete. The compiler output goes to
+  // <stem>.log and is kept as <key>.log if compiling fails.
+  bool compile(std::string const &source, std::string const &key) {
+    auto const &dir = options.directory;
+    std::error_code ec;
+    auto const stem = key + ".tmp" + std::to_string(::getpid()) + "_" +
+                      std::to_string(next_temporary++);
+    auto const c_file = dir / (stem + ".c");
+    auto const so_file = dir / (stem + ".so");
+    auto const log_file = dir / (stem + ".log");
+    {
+      std::ofstream out(c_file, std::ios::binary);
+      out << source;
+      if (!out.flush())
+        return false;
+    }
+    auto const command = options.compiler + " " + options.flags + " -o " +
+                         shell_quote(so_file.string()) + " " +
+                         shell_quote(c_file.string()) + " -lm > " +
+                         shell_quote(log_file.string()) + " 2>&1";
+    bool ok = std::system(command.c_str()) == 0 &&
+              std::filesystem::exists(so_file, ec);
+    // Strip the group and other write bits a umask may have left, or the
+    // entry would not pass is_private() later.
+    using perms = std::filesystem::perms;
+    if (ok) {
+      std::filesystem::permissions(so_file, perms::owner_all, ec);
+      ok = !ec;
+    }
+    if (ok) {
+      std::filesystem::permissions(
+          c_file, perms::owner_read | perms::owner_write, ec);
+      ok = !ec;
+    }
+    if (ok) {
+      std::filesystem::rename(so_file, dir / (key + ".so"), ec);
+      ok = !ec;
+    }
+    if (ok) {
+      std::filesystem::rename(c_file, dir / (key + ".c"), ec);
+      std::filesystem::remove(log_file, ec);
+    } else {
+      std::filesystem::rename(log_file, dir / (key + ".log"), ec);
+    }
+    std::filesystem::remove(c_file, ec);
+    std::filesystem::remove(so_file, ec);
+    std::filesystem::remove(log_file, ec);
+    return ok;
+  }
+#endif
+};
+
+scalar_kernel_cache::scalar_kernel_cache(scalar_kernel_cache_options options)
+    : m_impl(std::make_unique<impl>()) {
+  if (options.compiler.empty()) {
+    auto const *cc = std::getenv("NUMSIM_CAS_KERNEL_CC");
+    options.compiler = cc && *cc ? cc : "cc";
+  }
+  if (options.directory.empty())
+    options.directory = default_directory();
+  // dlopen() searches the library path for names without a slash.
+  options.directory = std::filesystem::absolute(options.directory);
+  m_impl->options = std::move(options);
+}
+
+scalar_kernel_cache::~scalar_kernel_cache() = default;
+
+scalar_kernel
+scalar_kernel_cache::load(std::vector<expr_holder_t> const &outputs,
+                          std::vector<expr_holder_t> const &inputs) {
+  auto state = std::make_shared<detail::scalar_kernel_state>();
+  state->outputs = outputs;
+  state->inputs = inputs;
+  return load_source(kernel_source(signature(outputs, inputs),
+                                   make_scalar_program(outputs, inputs)),
+                     std::move(state), inputs.size(), outputs.size());
+}
+
+scalar_kernel
+scalar_kernel_cache::load(expr_holder_t const &output,
+                          std::vector<expr_holder_t> const &inputs) {
+  return load(std::vector<expr_holder_t>{output}, inputs);
+}
+
+std::string
+scalar_kernel_cache::key(std::vector<expr_holder_t> const &outputs,
+                         std::vector<expr_holder_t> const &inputs) const {
+  return key_of(kernel_source(signature(outputs, inputs),
+                              make_scalar_program(outputs, inputs)));
+}
+
+std::string
+scalar_kernel_cache::signature(std::vector<expr_holder_t> const &outputs,
+                               std::vector<expr_holder_t> const &inputs) {
+  return "scalar kernel v1: double, " + std::to_string(inputs.size()) +
+         " inputs, " + std::to_string(outputs.size()) + " outputs";
+}
+
+std::string
+scalar_kernel_cache::kernel_source(std::string const &header,
+                                   scalar_program const &program) const {
+  auto command = m_impl->options.compiler + " " + m_impl->options.flags;
+  for (std::size_t pos; (pos = command.find("*/")) != std::string::npos;)
+    command.replace(pos, 2, "* /");
+  return "/* numsim_cas " + header + "\n   " + command + " */\n" +
+         to_c_source(program, kernel_symbol);
+}
+
+std::string scalar_kernel_cache::key_of(std::string const &source) {
+  return hex(fnv1a(source));
+}
+
+scalar_kernel scalar_kernel_cache::load_source(
+    std::string source, std::shared_ptr<detail::scalar_kernel_state> state,
+    std::size_t inputs, std::size_t outputs) {
+  auto const key = key_of(source);
+
+  {
+    std::scoped_lock lock(m_impl->mutex);
+    if (auto it = m_impl->kernels.find(key);
+        it != m_impl->kernels.end() && it->second.first == source) {
+      ++m_impl->stats.memory_hits;
+      return it->second.second;
+    }
+  }
+
+  // The disk and the compiler are used without the lock, so one compile
+  // does not hold up other lookups. Two threads missing on the same key
+  // both compile; their temporary files do not clash and the first
+  // kernel to be stored wins.
+  scalar_kernel kernel;
+  std::size_t statistics::*outcome = &statistics::failed;
+#ifdef NUMSIM_CAS_HAS_DLOPEN
+  auto const &dir = m_impl->options.directory;
+  if (!dir.empty() && make_private_directory(dir)) {
+    if ((state->code = m_impl->open_stored(source, key, kernel.m_function)))
+      outcome = &statistics::disk_hits;
+    else if (m_impl->compile(source, key) &&
+             (state->code =
+                  m_impl->open_stored(source, key, kernel.m_function)))
+      outcome = &statistics::compiled;
+  }
+  if (!state->code)
+    kernel.m_function = nullptr;
+#endif
+  kernel.m_state = std::move(state);
+  kernel.m_inputs = inputs;
+  kernel.m_outputs = outputs;
+
+  std::scoped_lock lock(m_impl->mutex);
+  ++(m_impl->stats.*outcome);
+  auto [it, inserted] =
+      m_impl->kernels.try_emplace(key, std::move(source), kernel);
+  if (!inserted && it->second.first != source)
+    it->second = {std::move(source), kernel};
+  return it->second.second;
+}
+
+scalar_kernel_cache::statistics scalar_kernel_cache::stats() const {
+  std::scoped_lock lock(m_impl->mutex);
+  return m_impl->stats;
+}
+
+std::filesystem::path const &scalar_kernel_cache::directory() const noexcept {
+  return m_impl->options.directory;
+}
+
+bool scalar_kernel_cache::native_available() noexcept {
+#ifdef NUMSIM_CAS_HAS_DLOPEN
+  return true;
+#else
+  return false;
+#endif
+}
+
+} // namespace numsim::cas
@@ -0,0 +1,27 @@
+#ifndef SCALAR_KERNEL_STATE_H
+#define SCALAR_KERNEL_STATE_H
+
+// Shared state of a scalar_kernel, used by the places that create kernels
+// (scalar_jit, scalar_kernel_cache and kernel_cache).
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <numsim_cas/scalar/scalar_jit.h>
+
+namespace numsim::cas::detail {
+
+struct scalar_kernel_state {
+  std::vector<expression_holder<scalar_expression>> outputs;
+  std::vector<expression_holder<scalar_expression>> inputs;
+  // Replaces scalar_evaluator over outputs/inputs when set (kernels of
+  // tensor models, which run on the tensor evaluators instead).
+  std::function<void(double const *, double *)> evaluate;
+  // Keeps the native code alive; null for the evaluator fallback.
+  std::shared_ptr<void const> code;
+};
+
+} // namespace numsim::cas::detail
+
+#endif // SCALAR_KERNEL_STATE_H
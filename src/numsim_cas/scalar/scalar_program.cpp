@@ -0,0 +1,143 @@
+#include <numsim_cas/scalar/scalar_program.h>
+
+#include "scalar_program_builder.h"
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+namespace numsim::cas {
+namespace {
+
+using expr_holder_t = expression_holder<scalar_expression>;
+using opcode = scalar_program::opcode;
+using detail::scalar_program_builder;
+
+// Hex float literal, exact for every finite double.
+std::string c_literal(double value) {
+  if (std::isnan(value))
+    return "NAN";
+  if (std::isinf(value))
+    return value < 0 ? "(-INFINITY)" : "INFINITY";
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%a", value);
+  return value < 0 ? "(" + std::string(buffer) + ")" : std::string(buffer);
+}
+
+char const *c_function(opcode op) {
+  switch (op) {
+  case opcode::sin:
+    return "sin";
+  case opcode::cos:
+    return "cos";
+  case opcode::tan:
+    return "tan";
+  case opcode::asin:
+    return "asin";
+  case opcode::acos:
+    return "acos";
+  case opcode::atan:
+    return "atan";
+  case opcode::sqrt:
+    return "sqrt";
+  case opcode::log:
+    return "log";
+  case opcode::exp:
+    return "exp";
+  case opcode::abs:
+    return "fabs";
+  default:
+    return nullptr;
+  }
+}
+
+char const *c_comparison(opcode op) {
+  switch (op) {
+  case opcode::lt:
+    return " < ";
+  case opcode::le:
+    return " <= ";
+  case opcode::eq:
+    return " == ";
+  case opcode::ne:
+    return " != ";
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace
+
+scalar_program
+make_scalar_program(std::vector<expr_holder_t> const &outputs,
+                    std::vector<expr_holder_t> const &inputs) {
+  scalar_program_builder builder(inputs);
+  for (auto const &out : outputs)
+    builder.add_output(out);
+  return std::move(builder).take();
+}
+
+std::string to_c_source(scalar_program const &program,
+                        std::string const &name) {
+  auto v = [](std::uint32_t i) { return "v" + std::to_string(i); };
+  std::string src = "#include <math.h>\n\n"
+                    "void " +
+                    name +
+                    "(const double *restrict in, double *restrict out) {\n";
+  for (std::uint32_t i{0}; i < program.code.size(); ++i) {
+    auto const &inst = program.code[i];
+    std::string rhs;
+    switch (inst.op) {
+    case opcode::input:
+      rhs = "in[" + std::to_string(static_cast<std::size_t>(inst.value)) + "]";
+      break;
+    case opcode::constant:
+      rhs = c_literal(inst.value);
+      break;
+    case opcode::add:
+      rhs = v(inst.a) + " + " + v(inst.b);
+      break;
+    case opcode::mul:
+      rhs = v(inst.a) + " * " + v(inst.b);
+      break;
+    case opcode::neg:
+      rhs = "-" + v(inst.a);
+      break;
+    case opcode::pow:
+      rhs = "pow(" + v(inst.a) + ", " + v(inst.b) + ")";
+      break;
+    case opcode::sign:
+      rhs = v(inst.a) + " > 0 ? 1.0 : (" + v(inst.a) + " < 0 ? -1.0 : 0.0)";
+      break;
+    case opcode::lt:
+    case opcode::le:
+    case opcode::eq:
+    case opcode::ne:
+      rhs = "(" + v(inst.a) + c_comparison(inst.op) + v(inst.b) +
+            ") ? 1.0 : 0.0";
+      break;
+    case opcode::max:
+      rhs = v(inst.a) + " < " + v(inst.b) + " ? " + v(inst.b) + " : " +
+            v(inst.a);
+      break;
+    case opcode::min:
+      rhs = v(inst.b) + " < " + v(inst.a) + " ? " + v(inst.b) + " : " +
+            v(inst.a);
+      break;
+    case opcode::select:
+      rhs = v(inst.a) + " != 0.0 ? " + v(inst.b) + " : " + v(inst.c);
+      break;
+    default:
+      rhs = std::string(c_function(inst.op)) + "(" + v(inst.a) + ")";
+      break;
+    }
+    src += "  const double " + v(i) + " = " + rhs + ";\n";
+  }
+  for (std::size_t j{0}; j < program.outputs.size(); ++j)
+    src += "  out[" + std::to_string(j) + "] = " + v(program.outputs[j]) +
+           ";\n";
+  src += "}\n";
+  return src;
+}
+
+} // namespace numsim::cas
@@ -0,0 +1,234 @@
+#ifndef SCALAR_PROGRAM_BUILDER_H
+#define SCALAR_PROGRAM_BUILDER_H
+
+// The lowering behind make_scalar_program, shared with make_kernel_program.
+
+#include <complex>
+#include <cstdint>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_program.h>
+
+namespace numsim::cas::detail {
+
+struct holder_hash {
+  std::size_t
+  operator()(expression_holder<scalar_expression> const &expr) const noexcept {
+    return expr.get().hash_value();
+  }
+};
+
+// Kernels compute in double. scalar_constant already rejects complex values;
+// should one get through anyway, fail instead of dropping the imaginary part.
+inline double constant_value(scalar_constant const &c) {
+  return std::visit(
+      [](auto const &v) -> double {
+        using V = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<V, std::complex<double>>)
+          throw invalid_expression_error(
+              "make_scalar_program: complex constants are not supported");
+        else if constexpr (std::is_same_v<V, rational_t>)
+          return static_cast<double>(v.num) / static_cast<double>(v.den);
+        else
+          return static_cast<double>(v);
+      },
+      c.value().raw());
+}
+
+// Lowers scalar expressions into one scalar_program. make_scalar_program
+// uses it directly; make_kernel_program emits the tensor components around
+// it and lowers the scalar subexpressions through apply().
+class scalar_program_builder final : public scalar_visitor_const_t {
+public:
+  using expr_holder_t = expression_holder<scalar_expression>;
+  using opcode = scalar_program::opcode;
+
+  scalar_program_builder() = default;
+  explicit scalar_program_builder(std::vector<expr_holder_t> const &inputs) {
+    for (std::size_t k{0}; k < inputs.size(); ++k)
+      add_input(inputs[k], k);
+    m_program.inputs = inputs.size();
+  }
+
+  // `symbol` is read from in[position].
+  void add_input(expr_holder_t const &symbol, std::size_t position) {
+    if (!symbol.is_valid() || !is_same<scalar>(symbol))
+      throw invalid_expression_error(
+          "make_scalar_program: inputs have to be scalar symbols");
+    auto const value = static_cast<double>(position);
+    if (!m_inputs.emplace(symbol, emit({opcode::input, 0, 0, 0, value}))
+             .second)
+      throw invalid_expression_error("make_scalar_program: input '" +
+                                     symbol.get<scalar>().name() +
+                                     "' is given twice");
+  }
+
+  std::uint32_t apply(expr_holder_t const &expr) {
+    if (!expr.is_valid())
+      throw invalid_expression_error(
+          "make_scalar_program: invalid expression");
+    auto const *node = &expr.get();
+    if (auto it = m_lowered.find(node); it != m_lowered.end())
+      return it->second;
+    m_current = &expr;
+    expr.template get<scalar_visitable_t>().accept(*this);
+    m_lowered.emplace(node, m_result);
+    return m_result;
+  }
+
+  std::uint32_t emit(scalar_program::instruction const &inst) {
+    m_program.code.push_back(inst);
+    return static_cast<std::uint32_t>(m_program.code.size() - 1);
+  }
+
+  scalar_program &program() noexcept { return m_program; }
+  scalar_program const &program() const noexcept { return m_program; }
+  scalar_program take() && { return std::move(m_program); }
+  void add_output(expr_holder_t const &expr) {
+    m_program.outputs.push_back(apply(expr));
+  }
+
+  void operator()(scalar const &v) override {
+    auto it = m_inputs.find(*m_current);
+    if (it == m_inputs.end())
+      throw invalid_expression_error("make_scalar_program: symbol '" +
+                                     v.name() + "' is not an input");
+    m_result = it->second;
+  }
+
+  void operator()(scalar_zero const &) override { constant(0.0); }
+  void operator()(scalar_one const &) override { constant(1.0); }
+  void operator()(scalar_constant const &v) override {
+    constant(constant_value(v));
+  }
+
+  // Same order as scalar_evaluator: the coefficient first, then the
+  // children in map order.
+  void operator()(scalar_add const &v) override { n_ary(v, opcode::add); }
+  void operator()(scalar_mul const &v) override { n_ary(v, opcode::mul); }
+
+  void operator()(scalar_negative const &v) override {
+    unary(opcode::neg, v.expr());
+  }
+  void operator()(scalar_named_expression const &v) override {
+    m_result = apply(v.expr());
+  }
+
+  void operator()(scalar_sin const &v) override {
+    unary(opcode::sin, v.expr());
+  }
+  void operator()(scalar_cos const &v) override {
+    unary(opcode::cos, v.expr());
+  }
+  void operator()(scalar_tan const &v) override {
+    unary(opcode::tan, v.expr());
+  }
+  void operator()(scalar_asin const &v) override {
+    unary(opcode::asin, v.expr());
+  }
+  void operator()(scalar_acos const &v) override {
+    unary(opcode::acos, v.expr());
+  }
+  void operator()(scalar_atan const &v) override {
+    unary(opcode::atan, v.expr());
+  }
+  void operator()(scalar_sqrt const &v) override {
+    unary(opcode::sqrt, v.expr());
+  }
+  void operator()(scalar_log const &v) override {
+    unary(opcode::log, v.expr());
+  }
+  void operator()(scalar_exp const &v) override {
+    unary(opcode::exp, v.expr());
+  }
+  void operator()(scalar_abs const &v) override {
+    unary(opcode::abs, v.expr());
+  }
+  void operator()(scalar_sign const &v) override {
+    unary(opcode::sign, v.expr());
+  }
+
+  void operator()(scalar_pow const &v) override {
+    binary(opcode::pow, v.expr_lhs(), v.expr_rhs());
+  }
+
+  void operator()(scalar_lt const &v) override {
+    binary(opcode::lt, v.expr_lhs(), v.expr_rhs());
+  }
+  void operator()(scalar_gt const &v) override {
+    binary(opcode::lt, v.expr_rhs(), v.expr_lhs());
+  }
+  void operator()(scalar_le const &v) override {
+    binary(opcode::le, v.expr_lhs(), v.expr_rhs());
+  }
+  void operator()(scalar_ge const &v) override {
+    binary(opcode::le, v.expr_rhs(), v.expr_lhs());
+  }
+  void operator()(scalar_eq const &v) override {
+    binary(opcode::eq, v.expr_lhs(), v.expr_rhs());
+  }
+  void operator()(scalar_ne const &v) override {
+    binary(opcode::ne, v.expr_lhs(), v.expr_rhs());
+  }
+  void operator()(scalar_max const &v) override {
+    binary(opcode::max, v.expr_lhs(), v.expr_rhs());
+  }
+  void operator()(scalar_min const &v) override {
+    binary(opcode::min, v.expr_lhs(), v.expr_rhs());
+  }
+
+  void operator()(scalar_if_then_else const &v) override {
+    auto const cond = apply(v.expr_cond());
+    auto const then_arm = apply(v.expr_then());
+    auto const else_arm = apply(v.expr_else());
+    m_result = emit({opcode::select, cond, then_arm, else_arm, 0});
+  }
+
+private:
+  void constant(double value) {
+    m_result = emit({opcode::constant, 0, 0, 0, value});
+  }
+
+  void unary(opcode op, expr_holder_t const &arg) {
+    auto const a = apply(arg);
+    m_result = emit({op, a, 0, 0, 0});
+  }
+
+  void binary(opcode op, expr_holder_t const &lhs, expr_holder_t const &rhs) {
+    auto const a = apply(lhs);
+    auto const b = apply(rhs);
+    m_result = emit({op, a, b, 0, 0});
+  }
+
+  template <typename Node> void n_ary(Node const &v, opcode op) {
+    bool first{true};
+    std::uint32_t acc{0};
+    auto fold = [&](expr_holder_t const &child) {
+      auto const value = apply(child);
+      acc = first ? value : emit({op, acc, value, 0, 0});
+      first = false;
+    };
+    if (v.coeff().is_valid())
+      fold(v.coeff());
+    for (auto const &child : v.symbol_map())
+      fold(child);
+    if (first)
+      constant(op == opcode::add ? 0.0 : 1.0);
+    else
+      m_result = acc;
+  }
+
+  scalar_program m_program;
+  std::unordered_map<expr_holder_t, std::uint32_t, holder_hash> m_inputs;
+  std::unordered_map<scalar_expression const *, std::uint32_t> m_lowered;
+  expr_holder_t const *m_current{nullptr};
+  std::uint32_t m_result{0};
+};
+
+} // namespace numsim::cas::detail
+
+#endif // SCALAR_PROGRAM_BUILDER_H
@@ -1,11 +1,13 @@
 #include <numsim_cas/scalar/scalar_solve.h>
 
 #include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/cas_error.h>
 #include <numsim_cas/scalar/scalar_all.h>
 #include <numsim_cas/scalar/scalar_domain_traits.h>
 #include <numsim_cas/scalar/scalar_functions.h>
 #include <numsim_cas/scalar/scalar_operators.h>
 #include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/scalar/sparse_polynomial.h>
 
 #include <ranges>
 
@@ -65,6 +67,33 @@ bool polynomial_solver::is_numeric_zero(expr_holder_t const &expr) {
 
 std::optional<polynomial_solver::poly_map>
 polynomial_solver::classify_term(expr_holder_t const &expr) const {
+  std::optional<sparse_polynomial> poly;
+  polynomial_converter converter({m_x}, true);
+  try {
+    poly = converter.to_polynomial(expr);
+  } catch (polynomial_error const &) {
+    return classify_term_symbolic(expr);
+  }
+  if (!poly)
+    return std::nullopt;
+  if (poly->is_zero())
+    return poly_map{{0, get_scalar_zero()}};
+
+  // Generator 0 is x; group the remaining monomials by their power of x.
+  std::map<long long, sparse_polynomial> by_degree;
+  for (auto const &t : poly->terms()) {
+    auto const degree{t.exponents.degree(0)};
+    by_degree[degree] += sparse_polynomial{
+        t.exponents / monomial::variable(0, degree), t.coefficient};
+  }
+  poly_map result;
+  for (auto const &[degree, coeff] : by_degree)
+    result.emplace(degree, converter.to_expression(coeff));
+  return result;
+}
+
+std::optional<polynomial_solver::poly_map>
+polynomial_solver::classify_term_symbolic(expr_holder_t const &expr) const {
   // If expr doesn't contain x, it's a degree-0 constant.
   if (!contains_expression(expr, m_x)) {
     return poly_map{{0, expr}};
@@ -95,7 +124,7 @@ polynomial_solver::classify_term(expr_holder_t const &expr) const {
   // scalar_negative(inner)
   if (is_same<scalar_negative>(expr)) {
     auto const &neg = expr.get<scalar_negative>();
-    auto inner = classify_term(neg.expr());
+    auto inner = classify_term_symbolic(neg.expr());
     if (!inner)
       return std::nullopt;
     return negate_poly(*inner);
@@ -112,8 +141,8 @@ polynomial_solver::classify_term(expr_holder_t const &expr) const {
     }
 
     // Add each child's polynomial map
-    for (auto const &child : add.symbol_map() | std::views::values) {
-      auto child_poly = classify_term(child);
+    for (auto const &child : add.symbol_map()) {
+      auto child_poly = classify_term_symbolic(child);
       if (!child_poly)
         return std::nullopt;
       result = add_poly(result, *child_poly);
@@ -134,8 +163,8 @@ polynomial_solver::classify_term(expr_holder_t const &expr) const {
     }
 
     // Multiply by each child's polynomial map
-    for (auto const &child : mul.symbol_map() | std::views::values) {
-      auto child_poly = classify_term(child);
+    for (auto const &child : mul.symbol_map()) {
+      auto child_poly = classify_term_symbolic(child);
       if (!child_poly)
         return std::nullopt;
       result = multiply_poly(result, *child_poly);
@@ -146,7 +175,7 @@ polynomial_solver::classify_term(expr_holder_t const &expr) const {
   // scalar_named_expression: unwrap and recurse
   if (is_same<scalar_named_expression>(expr)) {
     auto const &named = expr.get<scalar_named_expression>();
-    return classify_term(named.expr());
+    return classify_term_symbolic(named.expr());
   }
 
   // Transcendental functions containing x: not polynomial
@@ -48,7 +48,7 @@ n_ary_mul::dispatch([[maybe_unused]] scalar const &rhs) {
   /// check if sub_exp == expr_rhs for sub_exp \in expr_lhs
   auto pos{m_lhs_node.symbol_map().find(m_rhs)};
   if (pos != m_lhs_node.symbol_map().end()) {
-    auto expr{pos->second * m_rhs};
+    auto expr{*pos * m_rhs};
     mul.symbol_map().erase(m_rhs);
     mul.invalidate_hash();
     mul.push_back(expr);
@@ -85,7 +85,7 @@ n_ary_mul::dispatch([[maybe_unused]] scalar_pow const &rhs) {
       return mul.coeff().is_valid() ? mul.coeff() : get_scalar_one();
     }
     if (mul.symbol_map().size() == 1 && !mul.coeff().is_valid()) {
-      return mul.symbol_map().begin()->second;
+      return *mul.symbol_map().begin();
     }
     return expr_mul;
   };
@@ -117,7 +117,7 @@ n_ary_mul::dispatch([[maybe_unused]] scalar_mul const &rhs) {
   if (rhs.coeff().is_valid())
     expr_mul *= rhs.coeff();
 
-  for (const auto &expr : rhs.symbol_map() | std::views::values) {
+  for (const auto &expr : rhs.symbol_map()) {
     expr_mul = expr_mul * expr;
   }
   return expr_mul;
@@ -262,8 +262,8 @@ symbol_mul::dispatch([[maybe_unused]] scalar_mul const &rhs) {
   /// check if sub_exp == expr_rhs for sub_exp \in expr_lhs
   auto pos{rhs.symbol_map().find(m_lhs)};
   if (pos != rhs.symbol_map().end()) {
-    // auto expr{binary_scalar_mul_simplify(pos->second, m_lhs)};
-    auto expr{pos->second * m_lhs};
+    // auto expr{binary_scalar_mul_simplify(*pos, m_lhs)};
+    auto expr{*pos * m_lhs};
     mul.symbol_map().erase(m_lhs);
     mul.invalidate_hash();
     mul.push_back(expr);
@@ -55,7 +55,7 @@ mul_pow::dispatch([[maybe_unused]] scalar_negative const &rhs) {
              result;
     }
     if (mul.symbol_map().size() == 1 && !mul.coeff().is_valid()) {
-      return pow(mul.symbol_map().begin()->second, m_rhs) * result;
+      return pow(*mul.symbol_map().begin(), m_rhs) * result;
     }
     return pow(mul_expr, m_rhs) * result;
   }
@@ -89,7 +89,7 @@ mul_pow::expr_holder_t mul_pow::dispatch([[maybe_unused]] Expr const &rhs) {
              result;
     }
     if (mul.symbol_map().size() == 1 && !mul.coeff().is_valid()) {
-      return pow(mul.symbol_map().begin()->second, m_rhs) * result;
+      return pow(*mul.symbol_map().begin(), m_rhs) * result;
     }
     return pow(mul_expr, m_rhs) * result;
   }
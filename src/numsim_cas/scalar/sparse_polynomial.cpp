@@ -0,0 +1,499 @@
+#include <numsim_cas/scalar/sparse_polynomial.h>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_domain_traits.h>
+#include <numsim_cas/scalar/scalar_functions.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_std.h>
+
+#include <algorithm>
+#include <functional>
+#include <ranges>
+#include <string>
+
+namespace numsim::cas {
+
+// Forward declare only the scalar overload to avoid pulling in tensor headers
+// from contains_expression.h.
+bool contains_expression(expression_holder<scalar_expression> const &haystack,
+                         expression_holder<scalar_expression> const &needle);
+
+namespace {
+
+constexpr std::uint64_t low_bits{0x7f7f7f7f7f7f7f7fULL};
+constexpr std::uint64_t high_bits{0x8080808080808080ULL};
+
+bool is_zero_number(scalar_number const &value) {
+  return value == scalar_number{0};
+}
+
+} // namespace
+
+// ─── monomial ───────────────────────────────────────────────────────────────
+
+monomial monomial::variable(std::size_t index, unsigned degree) {
+  if (index >= max_variables)
+    throw polynomial_error("sparse_polynomial: variable index " +
+                           std::to_string(index) + " exceeds the limit of " +
+                           std::to_string(max_variables) + " variables");
+  if (degree > max_degree)
+    throw polynomial_error("sparse_polynomial: exponent " +
+                           std::to_string(degree) + " exceeds " +
+                           std::to_string(max_degree));
+  return monomial{std::uint64_t{degree} << shift(index)};
+}
+
+unsigned monomial::total_degree() const noexcept {
+  unsigned total{0};
+  for (std::size_t i = 0; i < max_variables; ++i)
+    total += degree(i);
+  return total;
+}
+
+bool monomial::divisible_by(monomial other) const noexcept {
+  for (std::size_t i = 0; i < max_variables; ++i)
+    if (degree(i) < other.degree(i))
+      return false;
+  return true;
+}
+
+monomial operator*(monomial lhs, monomial rhs) {
+  // Byte-wise addition: add the low seven bits of every byte, then fold in
+  // the top bits. A byte overflows when at least two of (lhs, rhs, carry
+  // into bit 7) have bit 7 set.
+  auto const a{lhs.m_packed};
+  auto const b{rhs.m_packed};
+  auto const sum{(a & low_bits) + (b & low_bits)};
+  if ((((a & b) | ((a ^ b) & sum)) & high_bits) != 0)
+    throw polynomial_error("sparse_polynomial: exponent exceeds " +
+                           std::to_string(monomial::max_degree));
+  return monomial{sum ^ ((a ^ b) & high_bits)};
+}
+
+monomial operator/(monomial lhs, monomial rhs) noexcept {
+  // No byte borrows, since every exponent of rhs is at most that of lhs.
+  return monomial{lhs.m_packed - rhs.m_packed};
+}
+
+// ─── sparse_polynomial ──────────────────────────────────────────────────────
+
+sparse_polynomial::sparse_polynomial(scalar_number const &constant) {
+  if (!is_zero_number(constant))
+    m_terms.push_back({monomial{}, constant});
+}
+
+sparse_polynomial::sparse_polynomial(monomial exponents,
+                                     scalar_number const &coefficient) {
+  if (!is_zero_number(coefficient))
+    m_terms.push_back({exponents, coefficient});
+}
+
+sparse_polynomial sparse_polynomial::variable(std::size_t index,
+                                              unsigned degree) {
+  return {monomial::variable(index, degree), scalar_number{1}};
+}
+
+bool sparse_polynomial::is_constant() const noexcept {
+  return m_terms.empty() ||
+         (m_terms.size() == 1 && m_terms.front().exponents.is_constant());
+}
+
+unsigned sparse_polynomial::degree(std::size_t index) const noexcept {
+  unsigned result{0};
+  for (auto const &t : m_terms)
+    result = std::max(result, t.exponents.degree(index));
+  return result;
+}
+
+std::optional<std::size_t> sparse_polynomial::main_variable() const noexcept {
+  std::uint64_t used{0};
+  for (auto const &t : m_terms)
+    used |= t.exponents.packed();
+  for (std::size_t i = 0; i < monomial::max_variables; ++i)
+    if (((used >> (8 * (monomial::max_variables - 1 - i))) & 0xffu) != 0)
+      return i;
+  return std::nullopt;
+}
+
+sparse_polynomial sparse_polynomial::coefficient(std::size_t index,
+                                                 unsigned degree) const {
+  auto const power{monomial::variable(index, degree)};
+  sparse_polynomial result;
+  for (auto const &t : m_terms)
+    if (t.exponents.degree(index) == degree)
+      result.m_terms.push_back({t.exponents / power, t.coefficient});
+  // Removing the same power from every term keeps the order.
+  return result;
+}
+
+sparse_polynomial sparse_polynomial::monic() const {
+  if (m_terms.empty())
+    return {};
+  auto const lead{m_terms.front().coefficient};
+  sparse_polynomial result{*this};
+  for (auto &t : result.m_terms)
+    t.coefficient = t.coefficient / lead;
+  return result;
+}
+
+void sparse_polynomial::normalize() {
+  std::ranges::sort(m_terms, std::greater<>{}, &term::exponents);
+  std::size_t out{0};
+  for (std::size_t i = 0; i < m_terms.size();) {
+    auto current{m_terms[i]};
+    for (++i; i < m_terms.size() && m_terms[i].exponents == current.exponents;
+         ++i)
+      current.coefficient = current.coefficient + m_terms[i].coefficient;
+    if (!is_zero_number(current.coefficient))
+      m_terms[out++] = current;
+  }
+  m_terms.resize(out);
+}
+
+sparse_polynomial &sparse_polynomial::operator+=(sparse_polynomial const &rhs) {
+  m_terms.insert(m_terms.end(), rhs.m_terms.begin(), rhs.m_terms.end());
+  normalize();
+  return *this;
+}
+
+sparse_polynomial &sparse_polynomial::operator-=(sparse_polynomial const &rhs) {
+  return *this += -rhs;
+}
+
+sparse_polynomial &sparse_polynomial::operator*=(sparse_polynomial const &rhs) {
+  return *this = *this * rhs;
+}
+
+sparse_polynomial operator*(sparse_polynomial const &lhs,
+                            sparse_polynomial const &rhs) {
+  sparse_polynomial result;
+  result.m_terms.reserve(lhs.m_terms.size() * rhs.m_terms.size());
+  for (auto const &a : lhs.m_terms)
+    for (auto const &b : rhs.m_terms)
+      result.m_terms.push_back(
+          {a.exponents * b.exponents, a.coefficient * b.coefficient});
+  result.normalize();
+  return result;
+}
+
+sparse_polynomial operator-(sparse_polynomial const &operand) {
+  sparse_polynomial result{operand};
+  for (auto &t : result.m_terms)
+    t.coefficient = -t.coefficient;
+  return result;
+}
+
+bool operator==(sparse_polynomial const &lhs, sparse_polynomial const &rhs) {
+  return std::ranges::equal(lhs.m_terms, rhs.m_terms,
+                            [](auto const &a, auto const &b) {
+                              return a.exponents == b.exponents &&
+                                     a.coefficient == b.coefficient;
+                            });
+}
+
+sparse_polynomial pow(sparse_polynomial const &base, unsigned exponent) {
+  sparse_polynomial result{scalar_number{1}};
+  sparse_polynomial square{base};
+  while (exponent != 0) {
+    if ((exponent & 1u) != 0)
+      result *= square;
+    exponent >>= 1u;
+    if (exponent != 0)
+      square *= square;
+  }
+  return result;
+}
+
+std::optional<sparse_polynomial> divide_exact(sparse_polynomial const &lhs,
+                                              sparse_polynomial const &rhs) {
+  if (rhs.is_zero())
+    throw polynomial_error("sparse_polynomial: division by zero");
+  auto const &divisor{rhs.leading_term()};
+  sparse_polynomial quotient;
+  sparse_polynomial remainder{lhs};
+  while (!remainder.is_zero()) {
+    auto const lead{remainder.leading_term()};
+    // In lex order the leading term of an exact multiple of rhs is always
+    // a multiple of rhs's leading term.
+    if (!lead.exponents.divisible_by(divisor.exponents))
+      return std::nullopt;
+    sparse_polynomial const step{lead.exponents / divisor.exponents,
+                                 lead.coefficient / divisor.coefficient};
+    quotient.m_terms.push_back(step.m_terms.front());
+    remainder -= step * rhs;
+    // The leading term cancels exactly for exact coefficients; drop any
+    // floating-point residue so the loop always makes progress.
+    if (!remainder.is_zero() &&
+        remainder.leading_term().exponents == lead.exponents)
+      remainder.m_terms.erase(remainder.m_terms.begin());
+  }
+  // Quotient terms were produced in decreasing order.
+  return quotient;
+}
+
+namespace {
+
+// Pseudo-remainder of a by b with respect to x_var, where b has positive
+// degree in x_var.
+sparse_polynomial pseudo_remainder(sparse_polynomial remainder,
+                                   sparse_polynomial const &b,
+                                   std::size_t var) {
+  auto const db{b.degree(var)};
+  auto const lb{b.coefficient(var, db)};
+  while (!remainder.is_zero()) {
+    auto const dr{remainder.degree(var)};
+    if (dr < db)
+      break;
+    auto const lr{remainder.coefficient(var, dr)};
+    remainder = lb * remainder -
+                lr * sparse_polynomial::variable(var, dr - db) * b;
+    // Drop what should have cancelled, as in divide_exact.
+    if (!remainder.is_zero() && remainder.degree(var) == dr) {
+      auto const residue{remainder.coefficient(var, dr) *
+                         sparse_polynomial::variable(var, dr)};
+      remainder -= residue;
+    }
+  }
+  return remainder;
+}
+
+// Monic gcd of the coefficients of p with respect to x_var.
+sparse_polynomial content(sparse_polynomial const &p, std::size_t var) {
+  sparse_polynomial result;
+  for (unsigned d = p.degree(var) + 1; d-- > 0;) {
+    auto const c{p.coefficient(var, d)};
+    if (c.is_zero())
+      continue;
+    result = gcd(result, c);
+    if (result.is_constant())
+      break;
+  }
+  return result;
+}
+
+sparse_polynomial primitive_part(sparse_polynomial const &p,
+                                 std::size_t var) {
+  if (p.is_zero())
+    return p;
+  auto const c{content(p, var)};
+  if (c.is_constant())
+    return p.monic();
+  return divide_exact(p, c).value_or(p).monic();
+}
+
+} // namespace
+
+sparse_polynomial gcd(sparse_polynomial const &lhs,
+                      sparse_polynomial const &rhs) {
+  if (lhs.is_zero())
+    return rhs.monic();
+  if (rhs.is_zero())
+    return lhs.monic();
+  if (lhs.is_constant() || rhs.is_constant())
+    return sparse_polynomial{scalar_number{1}};
+
+  auto const var{std::min(*lhs.main_variable(), *rhs.main_variable())};
+  // A side free of x_var is a coefficient with respect to it.
+  if (lhs.degree(var) == 0)
+    return gcd(lhs, content(rhs, var));
+  if (rhs.degree(var) == 0)
+    return gcd(content(lhs, var), rhs);
+
+  auto const common_content{gcd(content(lhs, var), content(rhs, var))};
+  auto a{primitive_part(lhs, var)};
+  auto b{primitive_part(rhs, var)};
+  if (a.degree(var) < b.degree(var))
+    std::swap(a, b);
+  while (true) {
+    auto r{pseudo_remainder(a, b, var)};
+    if (r.is_zero())
+      break;
+    if (r.degree(var) == 0) {
+      b = sparse_polynomial{scalar_number{1}};
+      break;
+    }
+    a = std::move(b);
+    b = primitive_part(r, var);
+  }
+  return (common_content * primitive_part(b, var)).monic();
+}
+
+polynomial_fraction cancel(sparse_polynomial const &numerator,
+                           sparse_polynomial const &denominator) {
+  if (denominator.is_zero())
+    throw polynomial_error("sparse_polynomial: zero denominator");
+  if (numerator.is_zero())
+    return {{}, sparse_polynomial{scalar_number{1}}};
+  auto const common{gcd(numerator, denominator)};
+  auto num{divide_exact(numerator, common).value_or(numerator)};
+  auto den{divide_exact(denominator, common).value_or(denominator)};
+  auto const scale{sparse_polynomial{
+      scalar_number{1} / den.leading_term().coefficient}};
+  return {num * scale, den * scale};
+}
+
+// ─── polynomial_converter ───────────────────────────────────────────────────
+
+polynomial_converter::polynomial_converter(
+    std::vector<expr_holder_t> variables, bool collect_atoms)
+    : m_generators(std::move(variables)),
+      m_variable_count(m_generators.size()), m_collect_atoms(collect_atoms) {
+  if (m_variable_count > monomial::max_variables)
+    throw polynomial_error("sparse_polynomial: " +
+                           std::to_string(m_variable_count) +
+                           " variables exceed the limit of " +
+                           std::to_string(monomial::max_variables));
+}
+
+bool polynomial_converter::is_free_of_variables(
+    expr_holder_t const &expr) const {
+  return std::ranges::none_of(
+      m_generators | std::views::take(m_variable_count),
+      [&](auto const &var) { return contains_expression(expr, var); });
+}
+
+std::optional<std::size_t>
+polynomial_converter::generator_index(expr_holder_t const &expr) {
+  auto it{std::ranges::find(m_generators, expr)};
+  if (it != m_generators.end())
+    return static_cast<std::size_t>(it - m_generators.begin());
+  if (!m_collect_atoms || !is_free_of_variables(expr))
+    return std::nullopt;
+  if (m_generators.size() == monomial::max_variables)
+    throw polynomial_error("sparse_polynomial: more than " +
+                           std::to_string(monomial::max_variables) +
+                           " generators");
+  m_generators.push_back(expr);
+  return m_generators.size() - 1;
+}
+
+std::optional<sparse_polynomial>
+polynomial_converter::to_polynomial(expr_holder_t const &expr) {
+  if (auto value = domain_traits<scalar_expression>::try_numeric(expr))
+    return sparse_polynomial{*value};
+
+  auto const variables_end{m_generators.begin() +
+                           static_cast<std::ptrdiff_t>(m_variable_count)};
+  if (auto it = std::find(m_generators.begin(), variables_end, expr);
+      it != variables_end)
+    return sparse_polynomial::variable(
+        static_cast<std::size_t>(it - m_generators.begin()));
+
+  if (is_same<scalar_named_expression>(expr))
+    return to_polynomial(expr.get<scalar_named_expression>().expr());
+
+  if (is_same<scalar_negative>(expr)) {
+    auto inner{to_polynomial(expr.get<scalar_negative>().expr())};
+    if (!inner)
+      return std::nullopt;
+    return -*inner;
+  }
+
+  if (is_same<scalar_add>(expr)) {
+    auto const &add{expr.get<scalar_add>()};
+    sparse_polynomial result;
+    if (add.coeff().is_valid()) {
+      auto coeff{to_polynomial(add.coeff())};
+      if (!coeff)
+        return std::nullopt;
+      result = std::move(*coeff);
+    }
+    for (auto const &child : add.symbol_map()) {
+      auto term{to_polynomial(child)};
+      if (!term)
+        return std::nullopt;
+      result += *term;
+    }
+    return result;
+  }
+
+  if (is_same<scalar_mul>(expr)) {
+    auto const &mul{expr.get<scalar_mul>()};
+    sparse_polynomial result{scalar_number{1}};
+    if (mul.coeff().is_valid()) {
+      auto coeff{to_polynomial(mul.coeff())};
+      if (!coeff)
+        return std::nullopt;
+      result = std::move(*coeff);
+    }
+    for (auto const &child : mul.symbol_map()) {
+      auto factor{to_polynomial(child)};
+      if (!factor)
+        return std::nullopt;
+      result *= *factor;
+    }
+    return result;
+  }
+
+  if (is_same<scalar_pow>(expr)) {
+    auto const &p{expr.get<scalar_pow>()};
+    auto const n{try_int_constant(p.expr_rhs())};
+    if (n && *n >= 0) {
+      if (*n > monomial::max_degree)
+        throw polynomial_error("sparse_polynomial: exponent " +
+                               std::to_string(*n) + " exceeds " +
+                               std::to_string(monomial::max_degree));
+      auto base{to_polynomial(p.expr_lhs())};
+      if (!base)
+        return std::nullopt;
+      return pow(*base, static_cast<unsigned>(*n));
+    }
+  }
+
+  if (auto index = generator_index(expr))
+    return sparse_polynomial::variable(*index);
+  return std::nullopt;
+}
+
+polynomial_converter::expr_holder_t
+polynomial_converter::to_expression(sparse_polynomial const &poly) const {
+  expr_holder_t result{get_scalar_zero()};
+  for (auto const &t : poly.terms()) {
+    expr_holder_t product;
+    for (std::size_t i = 0; i < m_generators.size(); ++i) {
+      auto const d{t.exponents.degree(i)};
+      if (d == 0)
+        continue;
+      expr_holder_t factor{
+          d == 1 ? m_generators[i]
+                 : pow(m_generators[i], static_cast<int>(d))};
+      product = product.is_valid() ? product * factor : factor;
+    }
+    expr_holder_t term;
+    if (!product.is_valid())
+      term = domain_traits<scalar_expression>::make_constant(t.coefficient);
+    else if (t.coefficient == scalar_number{1})
+      term = product;
+    else if (t.coefficient == scalar_number{-1})
+      term = -product;
+    else
+      term = domain_traits<scalar_expression>::make_constant(t.coefficient) *
+             product;
+    result = result + term;
+  }
+  return result;
+}
+
+expression_holder<scalar_expression>
+cancel(expression_holder<scalar_expression> const &numerator,
+       expression_holder<scalar_expression> const &denominator) {
+  try {
+    polynomial_converter converter({}, true);
+    auto num{converter.to_polynomial(numerator)};
+    auto den{converter.to_polynomial(denominator)};
+    if (num && den && !den->is_zero()) {
+      auto const reduced{cancel(*num, *den)};
+      auto result{converter.to_expression(reduced.numerator)};
+      if (reduced.denominator.is_constant())
+        return result;
+      return result / converter.to_expression(reduced.denominator);
+    }
+  } catch (polynomial_error const &) {
+    // Too many generators or too high a degree; leave the fraction alone.
+  }
+  return numerator / denominator;
+}
+
+} // namespace numsim::cas
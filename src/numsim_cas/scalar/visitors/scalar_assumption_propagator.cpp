@@ -14,11 +14,22 @@ scalar_assumption_propagator::apply(expr_holder_t const &expr) {
     m_result = {};
     return m_result;
   }
-  expr.template get<scalar_visitable_t>().accept(*this);
-  // Write inferred assumptions back onto the node
-  for (auto const &a : m_result.data()) {
-    expr.data()->assumptions().insert(a);
+  // A node already analysed in this assumption generation (by this
+  // propagator or by infer_assumptions) is a cache hit, so shared
+  // subtrees are walked once per DAG instead of once per path.
+  auto &cached = expr.data()->assumptions();
+  if (cached.inferred()) {
+    m_result = {};
+    m_result.merge(cached);
+    return m_result;
   }
+  expr.template get<scalar_visitable_t>().accept(*this);
+  // Write inferred assumptions back onto the node. Replacing (not
+  // merging) drops facts derived from assumptions that have since been
+  // removed.
+  cached.clear();
+  cached.merge(m_result);
+  cached.set_inferred();
   return m_result;
 }
 
@@ -27,9 +38,7 @@ scalar_assumption_propagator::apply(expr_holder_t const &expr) {
 void scalar_assumption_propagator::operator()(scalar const &node) {
   // Symbol: keep existing user-set assumptions
   m_result = {};
-  for (auto const &a : node.assumptions().data()) {
-    m_result.insert(a);
-  }
+  m_result.merge(node.assumptions());
 }
 
 void scalar_assumption_propagator::operator()(
@@ -123,7 +132,7 @@ void scalar_assumption_propagator::operator()(scalar_add const &v) {
     all_nonpos &= ca.contains(nonpositive{});
   }
 
-  for (auto const &child : v.symbol_map() | std::views::values) {
+  for (auto const &child : v.symbol_map()) {
     auto ca = apply(child);
     all_pos &= ca.contains(positive{});
     all_neg &= ca.contains(negative{});
@@ -162,7 +171,7 @@ void scalar_assumption_propagator::operator()(scalar_mul const &v) {
     all_real &= ca.contains(real_tag{});
   }
 
-  for (auto const &child : v.symbol_map() | std::views::values) {
+  for (auto const &child : v.symbol_map()) {
     auto ca = apply(child);
     if (ca.contains(negative{}))
       ++neg_count;
@@ -518,15 +527,13 @@ public:
     // Write inferred assumptions onto the node
     auto &a = expr.data()->assumptions();
     a.clear();
-    for (auto const &x : m_result.data())
-      a.insert(x);
+    a.merge(m_result);
   }
 
   // Leaf nodes — compute intrinsic assumptions
   void operator()(scalar const &node) override {
     m_result = {};
-    for (auto const &a : node.assumptions().data())
-      m_result.insert(a);
+    m_result.merge(node.assumptions());
   }
 
   void operator()([[maybe_unused]] scalar_zero const &) override {
@@ -604,7 +611,7 @@ public:
       all_nonneg &= ca.contains(nonnegative{});
       all_nonpos &= ca.contains(nonpositive{});
     }
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       auto const &ca = ensure_assumptions(child);
       all_pos &= ca.contains(positive{});
       all_neg &= ca.contains(negative{});
@@ -638,7 +645,7 @@ public:
       all_nonzero &= ca.contains(nonzero{});
       all_real &= ca.contains(real_tag{});
     }
-    for (auto const &child : v.symbol_map() | std::views::values) {
+    for (auto const &child : v.symbol_map()) {
       auto const &ca = ensure_assumptions(child);
       if (ca.contains(negative{}))
         ++neg_count;
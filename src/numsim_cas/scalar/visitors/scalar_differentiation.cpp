@@ -24,9 +24,9 @@ void scalar_differentiation::operator()(scalar_mul const &visitable) {
   // accumulator invalid for a mid-iteration reader (the #305 positivity
   // read() null-deref / segfault).
   expr_holder_t expr_result = get_scalar_zero();
-  for (auto &expr_out : visitable.symbol_map() | std::views::values) {
+  for (auto &expr_out : visitable.symbol_map()) {
     expr_holder_t expr_result_in = get_scalar_one();
-    for (auto &expr_in : visitable.symbol_map() | std::views::values) {
+    for (auto &expr_in : visitable.symbol_map()) {
       if (expr_out == expr_in) {
         scalar_differentiation d(m_arg);
         expr_result_in *= d.apply(expr_in);
@@ -48,7 +48,7 @@ void scalar_differentiation::operator()(scalar_mul const &visitable) {
 void scalar_differentiation::operator()(scalar_add const &visitable) {
   // Identity-init: see scalar_mul comment above.
   expr_holder_t expr_result = get_scalar_zero();
-  for (auto &child : visitable.symbol_map() | std::views::values) {
+  for (auto &child : visitable.symbol_map()) {
     scalar_differentiation d(m_arg);
     expr_result += d.apply(child);
   }
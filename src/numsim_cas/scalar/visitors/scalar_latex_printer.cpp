@@ -17,8 +17,9 @@ void scalar_latex_printer<Stream>::apply(
     Precedence parent_precedence) {
   if (expr.is_valid()) {
     m_parent_precedence = parent_precedence;
-    static_cast<const scalar_visitable_t &>(expr.get())
-        .accept(static_cast<base_visitor &>(*this));
+    if (!this->print_let_name(expr))
+      static_cast<const scalar_visitable_t &>(expr.get())
+          .accept(static_cast<base_visitor &>(*this));
     m_first_term = false;
   }
 }
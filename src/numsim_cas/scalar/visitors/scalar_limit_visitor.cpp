@@ -9,8 +9,9 @@ namespace numsim::cas {
 using dir = limit_result::direction;
 
 scalar_limit_visitor::scalar_limit_visitor(expr_holder_t const &limit_var,
-                                           limit_target target)
-    : m_limit_var(limit_var), m_target(target) {}
+                                           limit_target target,
+                                           limit_cache *cache)
+    : m_limit_var(limit_var), m_target(target), m_cache(cache) {}
 
 namespace {
 
@@ -38,7 +39,12 @@ limit_result scalar_limit_visitor::apply(expr_holder_t const &expr) {
     m_result = target_to_limit(m_target);
     return m_result;
   }
+  if (auto const *cached = cache().find(expr, m_limit_var, m_target)) {
+    m_result = *cached;
+    return m_result;
+  }
   expr.template get<scalar_visitable_t>().accept(*this);
+  cache().insert(expr, m_limit_var, m_target, m_result);
   return m_result;
 }
 
@@ -87,7 +93,7 @@ void scalar_limit_visitor::operator()(scalar_add const &v) {
   if (v.coeff().is_valid()) {
     result = apply(v.coeff());
   }
-  for (auto const &child : v.symbol_map() | std::views::values) {
+  for (auto const &child : v.symbol_map()) {
     result = combine_add(result, apply(child));
   }
   m_result = result;
@@ -98,7 +104,7 @@ void scalar_limit_visitor::operator()(scalar_mul const &v) {
   if (v.coeff().is_valid()) {
     result = apply(v.coeff());
   }
-  for (auto const &child : v.symbol_map() | std::views::values) {
+  for (auto const &child : v.symbol_map()) {
     result = combine_mul(result, apply(child));
   }
   m_result = result;
@@ -16,8 +16,9 @@ void scalar_printer<Stream>::apply(
     [[maybe_unused]] Precedence parent_precedence) {
   if (expr.is_valid()) {
     m_parent_precedence = parent_precedence;
-    static_cast<const scalar_visitable_t &>(expr.get())
-        .accept(static_cast<base_visitor &>(*this));
+    if (!this->print_let_name(expr))
+      static_cast<const scalar_visitable_t &>(expr.get())
+          .accept(static_cast<base_visitor &>(*this));
     // std::visit([this, parent_precedence](
     //                auto &&arg) { (*this)(arg, parent_precedence); },
     //            *expr);
@@ -0,0 +1,1137 @@
+#include <numsim_cas/serialization.h>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/core/operators.h>
+#include <numsim_cas/eigen_decomposition.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_globals.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/tensor/tensor_definitions.h>
+#include <numsim_cas/tensor/tensor_functions.h>
+#include <numsim_cas/tensor/tensor_operators.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_definitions.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_functions.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_operators.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_std.h>
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace numsim::cas {
+namespace {
+
+using scalar_holder_t = expression_holder<scalar_expression>;
+using tensor_holder_t = expression_holder<tensor_expression>;
+using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+
+constexpr std::array<char, 8> dag_magic{'N', 'S', 'C', 'A', 'S', 'D', 'A', 'G'};
+constexpr std::size_t header_size = 40;
+constexpr std::size_t record_size = 20;
+
+// Record domain = variant index of serialized_expression.
+enum class dag_domain : std::uint8_t { scalar, tensor, tensor_to_scalar };
+
+// Record flags: which annotations follow the node payload, and whether the
+// first child of an n-ary node is its coefficient.
+enum dag_flag : std::uint8_t {
+  numeric_assumptions = 1,
+  space = 2,
+  algebra_assumptions = 4,
+  coefficient = 8
+};
+
+// FNV-1a over the node type names of all three domains, in list order. A
+// file only decodes with the node set it was written with, and a renamed,
+// added, removed or reordered node changes the fingerprint.
+#define NUMSIM_CAS_NODE_NAME_FIRST(T) #T
+#define NUMSIM_CAS_NODE_NAME_NEXT(T) , #T
+constexpr std::uint64_t node_set_fingerprint() {
+  std::uint64_t h = 1469598103934665603ULL;
+  auto mix = [&h](std::string_view name) {
+    for (char c : name) {
+      h ^= static_cast<unsigned char>(c);
+      h *= 1099511628211ULL;
+    }
+    h ^= static_cast<unsigned char>(';');
+    h *= 1099511628211ULL;
+  };
+  for (std::string_view name : {NUMSIM_CAS_SCALAR_NODE_LIST(
+           NUMSIM_CAS_NODE_NAME_FIRST, NUMSIM_CAS_NODE_NAME_NEXT)})
+    mix(name);
+  mix("|");
+  for (std::string_view name : {NUMSIM_CAS_TENSOR_NODE_LIST(
+           NUMSIM_CAS_NODE_NAME_FIRST, NUMSIM_CAS_NODE_NAME_NEXT)})
+    mix(name);
+  mix("|");
+  for (std::string_view name : {NUMSIM_CAS_TENSOR_TO_SCALAR_NODE_LIST(
+           NUMSIM_CAS_NODE_NAME_FIRST, NUMSIM_CAS_NODE_NAME_NEXT)})
+    mix(name);
+  return h;
+}
+#undef NUMSIM_CAS_NODE_NAME_FIRST
+#undef NUMSIM_CAS_NODE_NAME_NEXT
+
+constexpr std::uint64_t node_fingerprint = node_set_fingerprint();
+
+template <typename Node>
+constexpr std::uint16_t scalar_type = index_of_v<Node, scalar_node_types>;
+template <typename Node>
+constexpr std::uint16_t tensor_type = index_of_v<Node, tensor_node_types>;
+template <typename Node>
+constexpr std::uint16_t t2s_type =
+    index_of_v<Node, tensor_to_scalar_node_types>;
+
+// ─── Byte buffers ────────────────────────────────────────────────
+
+class byte_writer {
+public:
+  template <std::unsigned_integral T> void put(T value) {
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      m_bytes.push_back(static_cast<std::byte>(value >> (8 * i)));
+  }
+  void put_i64(std::int64_t value) {
+    put(static_cast<std::uint64_t>(value));
+  }
+  void put_f64(double value) { put(std::bit_cast<std::uint64_t>(value)); }
+  void put_size(std::size_t value) {
+    put(static_cast<std::uint64_t>(value));
+  }
+  void put_string(std::string_view value) {
+    put(checked_u32(value.size()));
+    for (char c : value)
+      m_bytes.push_back(static_cast<std::byte>(c));
+  }
+  template <std::ranges::sized_range Indices>
+  void put_indices(Indices const &indices) {
+    put(checked_u32(std::ranges::size(indices)));
+    for (std::size_t i : indices)
+      put_size(i);
+  }
+  void append(std::vector<std::byte> const &bytes) {
+    m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_bytes.size(); }
+  [[nodiscard]] std::vector<std::byte> &bytes() noexcept { return m_bytes; }
+
+  static std::uint32_t checked_u32(std::size_t value) {
+    if (value > std::numeric_limits<std::uint32_t>::max())
+      throw serialization_error("serialize_dag: table exceeds 2^32 entries");
+    return static_cast<std::uint32_t>(value);
+  }
+
+private:
+  std::vector<std::byte> m_bytes;
+};
+
+class byte_reader {
+public:
+  explicit byte_reader(std::span<std::byte const> bytes) : m_bytes(bytes) {}
+
+  template <std::unsigned_integral T> T get() {
+    auto const bytes = take(sizeof(T));
+    T value{0};
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(static_cast<T>(bytes[i]) << (8 * i));
+    return value;
+  }
+  std::int64_t get_i64() {
+    return static_cast<std::int64_t>(get<std::uint64_t>());
+  }
+  double get_f64() { return std::bit_cast<double>(get<std::uint64_t>()); }
+  std::size_t get_size() {
+    auto const value = get<std::uint64_t>();
+    if (value > std::numeric_limits<std::size_t>::max())
+      throw serialization_error("deserialize_dag: size out of range");
+    return static_cast<std::size_t>(value);
+  }
+  std::string get_string() {
+    auto const bytes = take(get<std::uint32_t>());
+    return {reinterpret_cast<char const *>(bytes.data()), bytes.size()};
+  }
+  // Element count of a list whose elements take at least `element_size`
+  // bytes each, checked before anything is allocated for it.
+  std::uint32_t get_count(std::size_t element_size) {
+    auto const count = get<std::uint32_t>();
+    if (count > remaining() / element_size)
+      throw serialization_error("deserialize_dag: truncated list");
+    return count;
+  }
+  std::vector<std::size_t> get_indices() {
+    std::vector<std::size_t> indices(get_count(sizeof(std::uint64_t)));
+    for (auto &i : indices)
+      i = get_size();
+    return indices;
+  }
+
+  std::span<std::byte const> take(std::size_t size) {
+    if (size > remaining())
+      throw serialization_error("deserialize_dag: truncated buffer");
+    auto const bytes = m_bytes.subspan(m_pos, size);
+    m_pos += size;
+    return bytes;
+  }
+  [[nodiscard]] std::size_t remaining() const noexcept {
+    return m_bytes.size() - m_pos;
+  }
+
+private:
+  std::span<std::byte const> m_bytes;
+  std::size_t m_pos{0};
+};
+
+// ─── Annotations ─────────────────────────────────────────────────
+
+template <typename Variant, typename Manager>
+void insert_mask(Manager &manager, std::uint16_t mask) {
+  if (mask >> std::variant_size_v<Variant>)
+    throw serialization_error("deserialize_dag: unknown assumption tag");
+  for (auto const &tag : tag_set<Variant>{mask})
+    manager.insert(tag);
+}
+
+void put_space(byte_writer &out, tensor_space const &sp) {
+  out.put(static_cast<std::uint8_t>(sp.perm.index()));
+  if (auto const *young = std::get_if<Young>(&sp.perm)) {
+    out.put(byte_writer::checked_u32(young->blocks.size()));
+    for (auto const &block : young->blocks) {
+      out.put(byte_writer::checked_u32(block.size()));
+      for (int i : block)
+        out.put(static_cast<std::uint32_t>(i));
+    }
+  }
+  out.put(static_cast<std::uint8_t>(sp.trace.index()));
+  if (auto const *partial = std::get_if<PartialTraceTag>(&sp.trace)) {
+    out.put(byte_writer::checked_u32(partial->pairs.size()));
+    for (auto const &[a, b] : partial->pairs) {
+      out.put(static_cast<std::uint32_t>(a));
+      out.put(static_cast<std::uint32_t>(b));
+    }
+  }
+}
+
+tensor_space get_space(byte_reader &in) {
+  tensor_space sp;
+  switch (in.get<std::uint8_t>()) {
+  case 0:
+    sp.perm = General{};
+    break;
+  case 1:
+    sp.perm = Symmetric{};
+    break;
+  case 2:
+    sp.perm = Skew{};
+    break;
+  case 3: {
+    Young young;
+    young.blocks.resize(in.get_count(4));
+    for (auto &block : young.blocks) {
+      block.resize(in.get_count(4));
+      for (auto &i : block)
+        i = static_cast<int>(in.get<std::uint32_t>());
+    }
+    sp.perm = std::move(young);
+    break;
+  }
+  case 4:
+    sp.perm = Minor{};
+    break;
+  case 5:
+    sp.perm = Major{};
+    break;
+  case 6:
+    sp.perm = MinorMajor{};
+    break;
+  default:
+    throw serialization_error("deserialize_dag: unknown permutation space");
+  }
+  switch (in.get<std::uint8_t>()) {
+  case 0:
+    sp.trace = AnyTraceTag{};
+    break;
+  case 1:
+    sp.trace = VolumetricTag{};
+    break;
+  case 2:
+    sp.trace = DeviatoricTag{};
+    break;
+  case 3:
+    sp.trace = HarmonicTag{};
+    break;
+  case 4: {
+    PartialTraceTag partial;
+    partial.pairs.resize(in.get_count(8));
+    for (auto &[a, b] : partial.pairs) {
+      a = static_cast<int>(in.get<std::uint32_t>());
+      b = static_cast<int>(in.get<std::uint32_t>());
+    }
+    sp.trace = std::move(partial);
+    break;
+  }
+  default:
+    throw serialization_error("deserialize_dag: unknown trace space");
+  }
+  return sp;
+}
+
+void put_sequence(byte_writer &out, sequence const &seq) {
+  out.put_indices(seq.indices());
+}
+
+sequence get_sequence(byte_reader &in) {
+  auto const indices = in.get_indices();
+  sequence seq(indices.size());
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    if (indices[i] > std::numeric_limits<sequence::index_t>::max())
+      throw serialization_error("deserialize_dag: sequence index out of range");
+    seq[i] = static_cast<sequence::index_t>(indices[i]);
+  }
+  return seq;
+}
+
+isotropic_kind get_kind(byte_reader &in) {
+  auto const kind = in.get<std::uint8_t>();
+  if (kind > static_cast<std::uint8_t>(isotropic_kind::sqrt))
+    throw serialization_error("deserialize_dag: unknown isotropic kind");
+  return static_cast<isotropic_kind>(kind);
+}
+
+// ─── Writer ──────────────────────────────────────────────────────
+
+struct node_record {
+  dag_domain domain;
+  std::uint8_t flags;
+  std::uint16_t type;
+  std::uint32_t first_child;
+  std::uint32_t child_count;
+  std::uint32_t payload_offset;
+  std::uint32_t payload_size;
+};
+
+// Appends every node once, children first. Each operator() adds the
+// children (recursively) and then fills m_children / m_payload for the
+// node being visited; add() turns them into a record.
+class dag_writer final : public scalar_visitor_const_t,
+                         public tensor_visitor_const_t,
+                         public tensor_to_scalar_visitor_const_t {
+public:
+  std::uint32_t add(scalar_holder_t const &expr) {
+    return add(expr, dag_domain::scalar, [&] {
+      expr.get<scalar_visitable_t>().accept(*this);
+    });
+  }
+
+  std::uint32_t add(tensor_holder_t const &expr) {
+    return add(expr, dag_domain::tensor, [&] {
+      expr.get<tensor_visitable_t>().accept(*this);
+    });
+  }
+
+  std::uint32_t add(t2s_holder_t const &expr) {
+    return add(expr, dag_domain::tensor_to_scalar, [&] {
+      expr.get<tensor_to_scalar_visitable_t>().accept(*this);
+    });
+  }
+
+  std::vector<std::byte> finish(std::vector<std::uint32_t> const &roots) {
+    byte_writer out;
+    for (char c : dag_magic)
+      out.put(static_cast<std::uint8_t>(c));
+    out.put(dag_format_version);
+    out.put(node_fingerprint);
+    out.put(byte_writer::checked_u32(m_records.size()));
+    out.put(byte_writer::checked_u32(m_edges.size()));
+    out.put(byte_writer::checked_u32(roots.size()));
+    out.put(static_cast<std::uint64_t>(m_payload_blob.size()));
+    for (auto const &r : m_records) {
+      out.put(static_cast<std::uint8_t>(r.domain));
+      out.put(r.flags);
+      out.put(r.type);
+      out.put(r.first_child);
+      out.put(r.child_count);
+      out.put(r.payload_offset);
+      out.put(r.payload_size);
+    }
+    for (auto e : m_edges)
+      out.put(e);
+    for (auto r : roots)
+      out.put(r);
+    out.append(m_payload_blob.bytes());
+    return std::move(out.bytes());
+  }
+
+  // ─── scalar ────────────────────────────────────────────────────
+  void operator()(scalar const &v) override { node({}).put_string(v.name()); }
+  void operator()(scalar_zero const &) override { node({}); }
+  void operator()(scalar_one const &) override { node({}); }
+  void operator()(scalar_constant const &v) override {
+    auto const &raw = v.value().raw();
+    auto &out = node({});
+    out.put(static_cast<std::uint8_t>(raw.index()));
+    if (auto const *i = std::get_if<std::int64_t>(&raw)) {
+      out.put_i64(*i);
+    } else if (auto const *d = std::get_if<double>(&raw)) {
+      out.put_f64(*d);
+    } else if (auto const *r = std::get_if<rational_t>(&raw)) {
+      out.put_i64(r->num);
+      out.put_i64(r->den);
+    } else {
+      throw serialization_error("serialize_dag: complex constant");
+    }
+  }
+  void operator()(scalar_add const &v) override { n_ary(v); }
+  void operator()(scalar_mul const &v) override { n_ary(v); }
+  void operator()(scalar_negative const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_named_expression const &v) override {
+    node({add(v.expr())}).put_string(v.name());
+  }
+  void operator()(scalar_sin const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_cos const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_tan const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_asin const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_acos const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_atan const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_pow const &v) override { binary(v); }
+  void operator()(scalar_sqrt const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_log const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_exp const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_sign const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_abs const &v) override { node({add(v.expr())}); }
+  void operator()(scalar_lt const &v) override { binary(v); }
+  void operator()(scalar_gt const &v) override { binary(v); }
+  void operator()(scalar_le const &v) override { binary(v); }
+  void operator()(scalar_ge const &v) override { binary(v); }
+  void operator()(scalar_eq const &v) override { binary(v); }
+  void operator()(scalar_ne const &v) override { binary(v); }
+  void operator()(scalar_max const &v) override { binary(v); }
+  void operator()(scalar_min const &v) override { binary(v); }
+  void operator()(scalar_if_then_else const &v) override { ternary(v); }
+
+  // ─── tensor ────────────────────────────────────────────────────
+  void operator()(tensor const &v) override {
+    auto &out = node({});
+    out.put_string(v.name());
+    put_shape(out, v);
+  }
+  void operator()(tensor_add const &v) override { n_ary(v); }
+  void operator()(tensor_mul const &v) override {
+    std::vector<std::uint32_t> children;
+    if (v.coeff().is_valid())
+      children.push_back(add(v.coeff()));
+    for (auto const &child : v.data())
+      children.push_back(add(child));
+    put_shape(node(std::move(children), coefficient_flag(v)), v);
+  }
+  void operator()(tensor_pow const &v) override { binary(v); }
+  void operator()(tensor_negative const &v) override { node({add(v.expr())}); }
+  void operator()(inner_product_wrapper const &v) override {
+    auto &out = node({add(v.expr_lhs()), add(v.expr_rhs())});
+    put_sequence(out, v.indices_lhs());
+    put_sequence(out, v.indices_rhs());
+  }
+  void operator()(permute_indices_wrapper const &v) override {
+    put_sequence(node({add(v.expr())}), v.indices());
+  }
+  void operator()(outer_product_wrapper const &v) override {
+    auto &out = node({add(v.expr_lhs()), add(v.expr_rhs())});
+    put_sequence(out, v.indices_lhs());
+    put_sequence(out, v.indices_rhs());
+  }
+  void operator()(simple_outer_product const &v) override {
+    std::vector<std::uint32_t> children;
+    for (auto const &child : v.data())
+      children.push_back(add(child));
+    put_shape(node(std::move(children)), v);
+  }
+  void operator()(tensor_inv const &v) override { node({add(v.expr())}); }
+  void operator()(tensor_eigenprojection const &v) override {
+    node({add(v.expr())}).put_size(v.index());
+  }
+  void operator()(tensor_eigenvector const &v) override {
+    node({add(v.expr())}).put_size(v.index());
+  }
+  void operator()(tensor_isotropic_function const &v) override {
+    node({add(v.expr())}).put(static_cast<std::uint8_t>(v.kind()));
+  }
+  void operator()(tensor_zero const &v) override { put_shape(node({}), v); }
+  void operator()(tensor_projector const &v) override {
+    auto &out = node({});
+    out.put_size(v.dim());
+    out.put_size(v.acts_on_rank());
+  }
+  void operator()(identity_tensor const &v) override { put_shape(node({}), v); }
+  void operator()(levi_civita_tensor const &v) override {
+    node({}).put_size(v.dim());
+  }
+  void operator()(tensor_scalar_mul const &v) override { binary(v); }
+  void operator()(tensor_to_scalar_with_tensor_mul const &v) override {
+    binary(v);
+  }
+  void operator()(tensor_if_then_else_scalar const &v) override { ternary(v); }
+  void operator()(tensor_if_then_else_t2s const &v) override { ternary(v); }
+
+  // ─── tensor-to-scalar ──────────────────────────────────────────
+  void operator()(tensor_trace const &v) override { node({add(v.expr())}); }
+  void operator()(tensor_dot const &v) override { node({add(v.expr())}); }
+  void operator()(tensor_det const &v) override { node({add(v.expr())}); }
+  void operator()(tensor_norm const &v) override { node({add(v.expr())}); }
+  void operator()(tensor_to_scalar_negative const &v) override {
+    node({add(v.expr())});
+  }
+  void operator()(tensor_to_scalar_add const &v) override { n_ary(v); }
+  void operator()(tensor_to_scalar_mul const &v) override { n_ary(v); }
+  void operator()(tensor_to_scalar_pow const &v) override { binary(v); }
+  void operator()(tensor_inner_product_to_scalar const &v) override {
+    auto &out = node({add(v.expr_lhs()), add(v.expr_rhs())});
+    put_sequence(out, v.indices_lhs());
+    put_sequence(out, v.indices_rhs());
+  }
+  void operator()(tensor_to_scalar_zero const &) override { node({}); }
+  void operator()(tensor_to_scalar_one const &) override { node({}); }
+  void operator()(tensor_to_scalar_log const &v) override {
+    node({add(v.expr())});
+  }
+  void operator()(tensor_to_scalar_exp const &v) override {
+    node({add(v.expr())});
+  }
+  void operator()(tensor_to_scalar_sqrt const &v) override {
+    node({add(v.expr())});
+  }
+  void operator()(tensor_to_scalar_eigenvalue const &v) override {
+    node({add(v.expr())}).put_size(v.index());
+  }
+  void operator()(tensor_to_scalar_divided_difference const &v) override {
+    auto &out = node({add(v.expr())});
+    out.put(static_cast<std::uint8_t>(v.kind()));
+    out.put_indices(v.indices());
+  }
+  void operator()(tensor_to_scalar_scalar_wrapper const &v) override {
+    node({add(v.expr())});
+  }
+  void operator()(tensor_to_scalar_if_then_else const &v) override {
+    ternary(v);
+  }
+
+private:
+  template <typename Holder, typename Visit>
+  std::uint32_t add(Holder const &expr, dag_domain domain, Visit &&visit) {
+    if (!expr.is_valid())
+      throw invalid_expression_error("serialize_dag: invalid expression");
+    auto const *key = static_cast<expression const *>(expr.data().get());
+    if (auto it = m_index.find(key); it != m_index.end())
+      return it->second;
+
+    visit();
+    auto children = std::move(m_children);
+    auto payload = std::move(m_payload);
+
+    auto const &node = expr.get();
+    std::uint8_t flags{m_flags};
+    if (node.is_symbol() && !node.assumptions().data().empty()) {
+      flags |= numeric_assumptions;
+      payload.put(static_cast<std::uint16_t>(node.assumptions().data().mask()));
+      payload.put(static_cast<std::uint8_t>(node.assumptions().inferred()));
+    }
+    if constexpr (std::is_same_v<Holder, tensor_holder_t>) {
+      if (node.space()) {
+        flags |= space;
+        put_space(payload, *node.space());
+      }
+      auto const &algebra = node.tensor_algebra_assumptions().data();
+      if (node.is_symbol() && !algebra.empty()) {
+        flags |= algebra_assumptions;
+        payload.put(static_cast<std::uint16_t>(algebra.mask()));
+      }
+    }
+
+    node_record record{domain,
+                       flags,
+                       static_cast<std::uint16_t>(node.id()),
+                       byte_writer::checked_u32(m_edges.size()),
+                       byte_writer::checked_u32(children.size()),
+                       byte_writer::checked_u32(m_payload_blob.size()),
+                       byte_writer::checked_u32(payload.size())};
+    m_edges.insert(m_edges.end(), children.begin(), children.end());
+    m_payload_blob.append(payload.bytes());
+    auto const index = byte_writer::checked_u32(m_records.size());
+    m_records.push_back(record);
+    m_index.emplace(key, index);
+    return index;
+  }
+
+  // Called after the children have been added.
+  byte_writer &node(std::vector<std::uint32_t> children,
+                    std::uint8_t flags = 0) {
+    m_children = std::move(children);
+    m_flags = flags;
+    m_payload = byte_writer{};
+    return m_payload;
+  }
+
+  template <typename Node> static std::uint8_t coefficient_flag(Node const &v) {
+    return v.coeff().is_valid() ? coefficient : 0;
+  }
+
+  template <typename Node> void n_ary(Node const &v) {
+    std::vector<std::uint32_t> children;
+    if (v.coeff().is_valid())
+      children.push_back(add(v.coeff()));
+    for (auto const &child : v.symbol_map())
+      children.push_back(add(child));
+    node(std::move(children), coefficient_flag(v));
+  }
+
+  template <typename Node> void binary(Node const &v) {
+    node({add(v.expr_lhs()), add(v.expr_rhs())});
+  }
+
+  template <typename Node> void ternary(Node const &v) {
+    node({add(v.expr_cond()), add(v.expr_then()), add(v.expr_else())});
+  }
+
+  static void put_shape(byte_writer &out, tensor_expression const &v) {
+    out.put_size(v.dim());
+    out.put_size(v.rank());
+  }
+
+  std::unordered_map<expression const *, std::uint32_t> m_index;
+  std::vector<node_record> m_records;
+  std::vector<std::uint32_t> m_edges;
+  byte_writer m_payload_blob;
+  std::vector<std::uint32_t> m_children;
+  std::uint8_t m_flags{0};
+  byte_writer m_payload;
+};
+
+// ─── Reader ──────────────────────────────────────────────────────
+
+class dag_reader {
+public:
+  explicit dag_reader(std::span<std::byte const> buffer) : m_buffer(buffer) {}
+
+  std::vector<serialized_expression> read() {
+    byte_reader header(m_buffer);
+    auto const magic = header.take(dag_magic.size());
+    if (std::memcmp(magic.data(), dag_magic.data(), dag_magic.size()) != 0)
+      throw serialization_error("deserialize_dag: not a numsim-cas DAG");
+    if (header.get<std::uint32_t>() != dag_format_version)
+      throw serialization_error("deserialize_dag: unsupported version");
+    if (header.get<std::uint64_t>() != node_fingerprint)
+      throw serialization_error(
+          "deserialize_dag: written with a different node set");
+    auto const node_count = header.get<std::uint32_t>();
+    auto const edge_count = header.get<std::uint32_t>();
+    auto const root_count = header.get<std::uint32_t>();
+    auto const payload_size = header.get<std::uint64_t>();
+
+    auto const tables = std::uint64_t{node_count} * record_size +
+                        std::uint64_t{edge_count} * 4 +
+                        std::uint64_t{root_count} * 4;
+    if (m_buffer.size() < header_size ||
+        m_buffer.size() - header_size < tables ||
+        m_buffer.size() - header_size - tables != payload_size)
+      throw serialization_error("deserialize_dag: inconsistent table sizes");
+
+    auto rest = m_buffer.subspan(header_size);
+    m_records = rest.first(node_count * record_size);
+    rest = rest.subspan(m_records.size());
+    m_edges = rest.first(std::size_t{edge_count} * 4);
+    rest = rest.subspan(m_edges.size());
+    auto const roots = rest.first(std::size_t{root_count} * 4);
+    m_payload = rest.subspan(roots.size());
+
+    m_nodes.reserve(node_count);
+    for (std::uint32_t i = 0; i < node_count; ++i)
+      m_nodes.push_back(read_node(i));
+
+    std::vector<serialized_expression> result;
+    result.reserve(root_count);
+    byte_reader root_in(roots);
+    for (std::uint32_t i = 0; i < root_count; ++i)
+      result.push_back(m_nodes.at(checked_index(root_in.get<std::uint32_t>(),
+                                                m_nodes.size())));
+    return result;
+  }
+
+private:
+  static std::size_t checked_index(std::uint32_t index, std::size_t bound) {
+    if (index >= bound)
+      throw serialization_error("deserialize_dag: index out of range");
+    return index;
+  }
+
+  serialized_expression read_node(std::uint32_t i) {
+    byte_reader in(
+        m_records.subspan(std::size_t{i} * record_size, record_size));
+    auto const domain = in.get<std::uint8_t>();
+    auto flags = in.get<std::uint8_t>();
+    m_coefficient = (flags & coefficient) != 0;
+    flags &= static_cast<std::uint8_t>(~coefficient);
+    auto const type = in.get<std::uint16_t>();
+    m_first_child = in.get<std::uint32_t>();
+    m_child_count = in.get<std::uint32_t>();
+    auto const payload_offset = in.get<std::uint32_t>();
+    auto const payload_size = in.get<std::uint32_t>();
+    if (std::uint64_t{m_first_child} + m_child_count > m_edges.size() / 4 ||
+        std::uint64_t{payload_offset} + payload_size > m_payload.size())
+      throw serialization_error("deserialize_dag: record out of range");
+
+    byte_reader payload(m_payload.subspan(payload_offset, payload_size));
+    switch (static_cast<dag_domain>(domain)) {
+    case dag_domain::scalar: {
+      auto expr = read_scalar(type, payload);
+      annotate(expr, flags, payload);
+      return expr;
+    }
+    case dag_domain::tensor: {
+      auto expr = read_tensor(type, payload, flags);
+      annotate(expr, flags, payload);
+      return expr;
+    }
+    case dag_domain::tensor_to_scalar: {
+      auto expr = read_t2s(type, payload);
+      annotate(expr, flags, payload);
+      return expr;
+    }
+    }
+    throw serialization_error("deserialize_dag: unknown domain");
+  }
+
+  // k-th child of the current record, which must lie in Holder's domain.
+  template <typename Holder> Holder const &child(std::size_t k) {
+    if (k >= m_child_count)
+      throw serialization_error("deserialize_dag: missing child");
+    byte_reader in(m_edges.subspan((std::size_t{m_first_child} + k) * 4, 4));
+    // Children precede their parents, so only earlier nodes are valid.
+    auto const index = checked_index(in.get<std::uint32_t>(), m_nodes.size());
+    auto const *holder = std::get_if<Holder>(&m_nodes[index]);
+    if (holder == nullptr)
+      throw serialization_error("deserialize_dag: child in wrong domain");
+    return *holder;
+  }
+
+  void expect_children(std::size_t count) const {
+    if (m_child_count != count)
+      throw serialization_error("deserialize_dag: wrong child count");
+  }
+
+  void expect_children_at_least(std::size_t count) const {
+    if (m_child_count < count)
+      throw serialization_error("deserialize_dag: wrong child count");
+  }
+
+  template <typename Holder, typename F> auto unary(F &&f) {
+    expect_children(1);
+    return f(child<Holder>(0));
+  }
+
+  // Operands of an n-ary record: the coefficient, if flagged, and the
+  // other children in stored order.
+  template <typename Holder>
+  std::pair<Holder, std::vector<Holder>> n_ary_operands() {
+    std::size_t const first = m_coefficient ? 1 : 0;
+    if (m_child_count < 2)
+      throw serialization_error("deserialize_dag: n-ary node with fewer than "
+                                "two operands");
+    m_coefficient = false;
+    std::pair<Holder, std::vector<Holder>> operands;
+    if (first != 0)
+      operands.first = child<Holder>(0);
+    operands.second.reserve(m_child_count - first);
+    for (std::size_t k = first; k < m_child_count; ++k)
+      operands.second.push_back(child<Holder>(k));
+    return operands;
+  }
+
+  // Rebuilds a sum or product as written, with append() instead of folding
+  // the children through operator+ / operator*, which re-simplifies and
+  // copies the node per child (quadratic for wide nodes) and may regroup it.
+  template <typename Node, typename Holder, typename... Args>
+  Holder read_n_ary(Args &&...args) {
+    auto [coeff, children] = n_ary_operands<Holder>();
+    auto result = make_expression<Node>(std::forward<Args>(args)...);
+    auto &node = result.template get<Node>();
+    if (coeff.is_valid())
+      node.set_coeff(std::move(coeff));
+    try {
+      node.append(children);
+    } catch (internal_error const &) {
+      throw serialization_error("deserialize_dag: repeated n-ary child");
+    }
+    return result;
+  }
+
+  scalar_holder_t read_scalar(std::uint16_t type, byte_reader &in) {
+    using s = scalar_holder_t;
+    switch (type) {
+    case scalar_type<scalar>:
+      expect_children(0);
+      return make_expression<scalar>(in.get_string());
+    case scalar_type<scalar_zero>:
+      expect_children(0);
+      return get_scalar_zero();
+    case scalar_type<scalar_one>:
+      expect_children(0);
+      return get_scalar_one();
+    case scalar_type<scalar_constant>:
+      expect_children(0);
+      return read_constant(in);
+    case scalar_type<scalar_add>:
+      return read_n_ary<scalar_add, s>();
+    case scalar_type<scalar_mul>:
+      return read_n_ary<scalar_mul, s>();
+    case scalar_type<scalar_negative>:
+      return unary<s>([](s const &x) { return -x; });
+    case scalar_type<scalar_named_expression>:
+      return unary<s>([&](s const &x) -> s {
+        return make_expression<scalar_named_expression>(in.get_string(), x);
+      });
+    case scalar_type<scalar_sin>:
+      return unary<s>([](s const &x) { return sin(x); });
+    case scalar_type<scalar_cos>:
+      return unary<s>([](s const &x) { return cos(x); });
+    case scalar_type<scalar_tan>:
+      return unary<s>([](s const &x) { return tan(x); });
+    case scalar_type<scalar_asin>:
+      return unary<s>([](s const &x) { return asin(x); });
+    case scalar_type<scalar_acos>:
+      return unary<s>([](s const &x) { return acos(x); });
+    case scalar_type<scalar_atan>:
+      return unary<s>([](s const &x) { return atan(x); });
+    case scalar_type<scalar_sqrt>:
+      return unary<s>([](s const &x) { return sqrt(x); });
+    case scalar_type<scalar_log>:
+      return unary<s>([](s const &x) { return log(x); });
+    case scalar_type<scalar_exp>:
+      return unary<s>([](s const &x) { return exp(x); });
+    case scalar_type<scalar_sign>:
+      return unary<s>([](s const &x) { return sign(x); });
+    case scalar_type<scalar_abs>:
+      return unary<s>([](s const &x) { return abs(x); });
+    case scalar_type<scalar_pow>:
+      expect_children(2);
+      return pow(child<s>(0), child<s>(1));
+    case scalar_type<scalar_lt>:
+      expect_children(2);
+      return lt(child<s>(0), child<s>(1));
+    case scalar_type<scalar_gt>:
+      expect_children(2);
+      return gt(child<s>(0), child<s>(1));
+    case scalar_type<scalar_le>:
+      expect_children(2);
+      return le(child<s>(0), child<s>(1));
+    case scalar_type<scalar_ge>:
+      expect_children(2);
+      return ge(child<s>(0), child<s>(1));
+    case scalar_type<scalar_eq>:
+      expect_children(2);
+      return eq(child<s>(0), child<s>(1));
+    case scalar_type<scalar_ne>:
+      expect_children(2);
+      return ne(child<s>(0), child<s>(1));
+    case scalar_type<scalar_max>:
+      expect_children(2);
+      return max(child<s>(0), child<s>(1));
+    case scalar_type<scalar_min>:
+      expect_children(2);
+      return min(child<s>(0), child<s>(1));
+    case scalar_type<scalar_if_then_else>:
+      expect_children(3);
+      return if_then_else(child<s>(0), child<s>(1), child<s>(2));
+    }
+    throw serialization_error("deserialize_dag: unknown scalar node type");
+  }
+
+  static scalar_holder_t read_constant(byte_reader &in) {
+    switch (in.get<std::uint8_t>()) {
+    case 0:
+      return make_expression<scalar_constant>(scalar_number{in.get_i64()});
+    case 1:
+      return make_expression<scalar_constant>(scalar_number{in.get_f64()});
+    case 3: {
+      auto const num = in.get_i64();
+      auto const den = in.get_i64();
+      if (den <= 0)
+        throw serialization_error("deserialize_dag: invalid rational");
+      return make_expression<scalar_constant>(scalar_number{num, den});
+    }
+    }
+    throw serialization_error("deserialize_dag: unknown constant kind");
+  }
+
+  tensor_holder_t read_tensor(std::uint16_t type, byte_reader &in,
+                              std::uint8_t &flags) {
+    using t = tensor_holder_t;
+    switch (type) {
+    case tensor_type<tensor>: {
+      expect_children(0);
+      auto name = in.get_string();
+      auto const dim = in.get_size();
+      return make_expression<tensor>(name, dim, in.get_size());
+    }
+    case tensor_type<tensor_add>: {
+      expect_children_at_least(1);
+      auto const &first = child<t>(0).get();
+      auto result = read_n_ary<tensor_add, t>(first.dim(), first.rank());
+      result.template get<tensor_add>().recompute_space();
+      return result;
+    }
+    case tensor_type<tensor_mul>: {
+      // A chain: the factors keep their order and the shape is stored.
+      auto [coeff, factors] = n_ary_operands<t>();
+      auto const dim = in.get_size();
+      auto result = make_expression<tensor_mul>(dim, in.get_size());
+      auto &mul = result.template get<tensor_mul>();
+      if (coeff.is_valid())
+        mul.set_coeff(std::move(coeff));
+      mul.reserve(factors.size());
+      for (auto &factor : factors)
+        mul.push_back(std::move(factor));
+      return result;
+    }
+    case tensor_type<tensor_pow>:
+      expect_children(2);
+      return make_expression<tensor_pow>(child<t>(0),
+                                         child<scalar_holder_t>(1));
+    case tensor_type<tensor_negative>:
+      return unary<t>([](t const &x) { return -x; });
+    case tensor_type<inner_product_wrapper>: {
+      expect_children(2);
+      auto lhs = get_sequence(in);
+      auto rhs = get_sequence(in);
+      return make_expression<inner_product_wrapper>(
+          child<t>(0), std::move(lhs), child<t>(1), std::move(rhs));
+    }
+    case tensor_type<permute_indices_wrapper>:
+      return unary<t>([&](t const &x) -> t {
+        return make_expression<permute_indices_wrapper>(x, get_sequence(in));
+      });
+    case tensor_type<outer_product_wrapper>: {
+      expect_children(2);
+      auto lhs = get_sequence(in);
+      auto rhs = get_sequence(in);
+      return make_expression<outer_product_wrapper>(
+          child<t>(0), std::move(lhs), child<t>(1), std::move(rhs));
+    }
+    case tensor_type<simple_outer_product>: {
+      auto const dim = in.get_size();
+      auto result = make_expression<simple_outer_product>(dim, in.get_size());
+      for (std::size_t k = 0; k < m_child_count; ++k)
+        result.template get<simple_outer_product>().push_back(child<t>(k));
+      return result;
+    }
+    case tensor_type<tensor_inv>:
+      return unary<t>([](t const &x) { return inv(x); });
+    case tensor_type<tensor_eigenprojection>:
+      return unary<t>([&](t const &x) {
+        return eigen_decomposition(x).basis(in.get_size());
+      });
+    case tensor_type<tensor_eigenvector>:
+      return unary<t>([&](t const &x) {
+        return eigen_decomposition(x).normal(in.get_size());
+      });
+    case tensor_type<tensor_isotropic_function>:
+      return unary<t>([&](t const &x) -> t {
+        return make_expression<tensor_isotropic_function>(x, get_kind(in));
+      });
+    case tensor_type<tensor_zero>: {
+      expect_children(0);
+      auto const dim = in.get_size();
+      return make_expression<tensor_zero>(dim, in.get_size());
+    }
+    case tensor_type<tensor_projector>: {
+      expect_children(0);
+      // The projector's space is its space annotation; consume it here.
+      auto const dim = in.get_size();
+      auto const acts_on_rank = in.get_size();
+      if (!(flags & space))
+        throw serialization_error("deserialize_dag: projector without space");
+      flags &= static_cast<std::uint8_t>(~space);
+      return make_expression<tensor_projector>(dim, acts_on_rank,
+                                               get_space(in));
+    }
+    case tensor_type<identity_tensor>: {
+      expect_children(0);
+      auto const dim = in.get_size();
+      return make_expression<identity_tensor>(dim, in.get_size());
+    }
+    case tensor_type<levi_civita_tensor>:
+      expect_children(0);
+      return make_expression<levi_civita_tensor>(in.get_size());
+    case tensor_type<tensor_scalar_mul>:
+      expect_children(2);
+      return child<scalar_holder_t>(0) * child<t>(1);
+    case tensor_type<tensor_to_scalar_with_tensor_mul>:
+      expect_children(2);
+      return make_expression<tensor_to_scalar_with_tensor_mul>(
+          child<t>(0), child<t2s_holder_t>(1));
+    case tensor_type<tensor_if_then_else_scalar>:
+      expect_children(3);
+      return if_then_else(child<scalar_holder_t>(0), child<t>(1), child<t>(2));
+    case tensor_type<tensor_if_then_else_t2s>:
+      expect_children(3);
+      return if_then_else(child<t2s_holder_t>(0), child<t>(1), child<t>(2));
+    }
+    throw serialization_error("deserialize_dag: unknown tensor node type");
+  }
+
+  t2s_holder_t read_t2s(std::uint16_t type, byte_reader &in) {
+    using u = t2s_holder_t;
+    using t = tensor_holder_t;
+    switch (type) {
+    case t2s_type<tensor_trace>:
+      return unary<t>([](t const &x) { return trace(x); });
+    case t2s_type<tensor_dot>:
+      return unary<t>([](t const &x) { return dot(x); });
+    case t2s_type<tensor_det>:
+      return unary<t>([](t const &x) { return det(x); });
+    case t2s_type<tensor_norm>:
+      return unary<t>([](t const &x) { return norm(x); });
+    case t2s_type<tensor_to_scalar_negative>:
+      return unary<u>([](u const &x) { return -x; });
+    case t2s_type<tensor_to_scalar_add>:
+      return read_n_ary<tensor_to_scalar_add, u>();
+    case t2s_type<tensor_to_scalar_mul>:
+      return read_n_ary<tensor_to_scalar_mul, u>();
+    case t2s_type<tensor_to_scalar_pow>:
+      expect_children(2);
+      return pow(child<u>(0), child<u>(1));
+    case t2s_type<tensor_inner_product_to_scalar>: {
+      expect_children(2);
+      auto lhs = get_sequence(in);
+      auto rhs = get_sequence(in);
+      return make_expression<tensor_inner_product_to_scalar>(
+          child<t>(0), std::move(lhs), child<t>(1), std::move(rhs));
+    }
+    case t2s_type<tensor_to_scalar_zero>:
+      expect_children(0);
+      return make_expression<tensor_to_scalar_zero>();
+    case t2s_type<tensor_to_scalar_one>:
+      expect_children(0);
+      return make_expression<tensor_to_scalar_one>();
+    case t2s_type<tensor_to_scalar_log>:
+      return unary<u>([](u const &x) { return log(x); });
+    case t2s_type<tensor_to_scalar_exp>:
+      return unary<u>([](u const &x) { return exp(x); });
+    case t2s_type<tensor_to_scalar_sqrt>:
+      return unary<u>([](u const &x) { return sqrt(x); });
+    case t2s_type<tensor_to_scalar_eigenvalue>:
+      return unary<t>([&](t const &x) {
+        return eigen_decomposition(x).value(in.get_size());
+      });
+    case t2s_type<tensor_to_scalar_divided_difference>:
+      return unary<t>([&](t const &x) -> u {
+        auto const kind = get_kind(in);
+        return make_expression<tensor_to_scalar_divided_difference>(
+            x, kind, in.get_indices());
+      });
+    case t2s_type<tensor_to_scalar_scalar_wrapper>:
+      return unary<scalar_holder_t>([](scalar_holder_t const &x) -> u {
+        return make_expression<tensor_to_scalar_scalar_wrapper>(x);
+      });
+    case t2s_type<tensor_to_scalar_if_then_else>:
+      expect_children(3);
+      return if_then_else(child<u>(0), child<u>(1), child<u>(2));
+    }
+    throw serialization_error("deserialize_dag: unknown tensor-to-scalar "
+                              "node type");
+  }
+
+  // Applies the annotations that follow the node payload. Only symbols
+  // carry numeric / algebra assumptions, and those are always freshly
+  // built here, so no shared node is modified.
+  template <typename Holder>
+  void annotate(Holder &expr, std::uint8_t flags, byte_reader &in) {
+    if (flags & ~(numeric_assumptions | space | algebra_assumptions))
+      throw serialization_error("deserialize_dag: unknown record flags");
+    if (m_coefficient)
+      throw serialization_error("deserialize_dag: coefficient on a node "
+                                "without one");
+    if (flags & numeric_assumptions) {
+      auto const mask = in.get<std::uint16_t>();
+      auto const inferred = in.get<std::uint8_t>();
+      if (!expr.get().is_symbol())
+        throw serialization_error("deserialize_dag: assumptions on non-symbol");
+      auto &manager = expr.data()->assumptions();
+      insert_mask<numeric_assumption>(manager, mask);
+      if (inferred)
+        manager.set_inferred();
+    }
+    if constexpr (std::is_same_v<Holder, tensor_holder_t>) {
+      if (flags & space) {
+        auto sp = get_space(in);
+        // Same rule as tensor_rebuild_visitor: never override a space the
+        // factory computed itself (tensor_add's child join, projectors).
+        if (!expr.get().space())
+          expr.data()->set_space(std::move(sp));
+      }
+      if (flags & algebra_assumptions) {
+        auto const mask = in.get<std::uint16_t>();
+        if (!expr.get().is_symbol())
+          throw serialization_error(
+              "deserialize_dag: assumptions on non-symbol");
+        insert_mask<tensor_algebra_assumption>(
+            expr.data()->tensor_algebra_assumptions(), mask);
+      }
+    } else if (flags & (space | algebra_assumptions)) {
+      throw serialization_error("deserialize_dag: tensor flags on non-tensor");
+    }
+    if (in.remaining() != 0)
+      throw serialization_error("deserialize_dag: trailing payload bytes");
+  }
+
+  std::span<std::byte const> m_buffer;
+  std::span<std::byte const> m_records;
+  std::span<std::byte const> m_edges;
+  std::span<std::byte const> m_payload;
+  std::vector<serialized_expression> m_nodes;
+  // Child range of the record being read.
+  std::uint32_t m_first_child{0};
+  std::uint32_t m_child_count{0};
+  // Record flag `coefficient`, cleared once an n-ary reader consumed it.
+  bool m_coefficient{false};
+};
+
+} // namespace
+
+std::vector<std::byte>
+serialize_dag(std::span<serialized_expression const> roots) {
+  dag_writer writer;
+  std::vector<std::uint32_t> indices;
+  indices.reserve(roots.size());
+  for (auto const &root : roots)
+    indices.push_back(
+        std::visit([&](auto const &expr) { return writer.add(expr); }, root));
+  return writer.finish(indices);
+}
+
+void write_dag(std::ostream &out,
+               std::span<serialized_expression const> roots) {
+  auto const bytes = serialize_dag(roots);
+  out.write(reinterpret_cast<char const *>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+}
+
+std::vector<serialized_expression>
+deserialize_dag(std::span<std::byte const> buffer) {
+  return dag_reader(buffer).read();
+}
+
+std::vector<serialized_expression> read_dag(std::istream &in) {
+  std::vector<char> chars{std::istreambuf_iterator<char>(in),
+                          std::istreambuf_iterator<char>()};
+  return deserialize_dag(std::as_bytes(std::span<char const>(chars)));
+}
+
+} // namespace numsim::cas
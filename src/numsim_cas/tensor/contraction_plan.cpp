@@ -0,0 +1,304 @@
+#include <numsim_cas/tensor/contraction_plan.h>
+
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/tensor/tensor_definitions.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+namespace numsim::cas {
+namespace {
+
+// Largest rank tensor_data can hold (tensor_data_eval<..., 3, 8, N>).
+constexpr std::size_t max_rank = 8;
+constexpr std::size_t infeasible = std::numeric_limits<std::size_t>::max();
+
+std::size_t ipow(std::size_t base, std::size_t exp) {
+  std::size_t result{1};
+  while (exp--)
+    result *= base;
+  return result;
+}
+
+// ─── Flattening ──────────────────────────────────────────────────
+
+// The network of one plan: operand index labels (contracted pairs share a
+// label) and, built along the way, the steps of the order as written.
+class network_builder {
+public:
+  explicit network_builder(std::size_t dim) : m_dim(dim) {}
+
+  struct partial {
+    std::size_t slot;
+    std::vector<std::size_t> labels;
+  };
+
+  partial root(inner_product_wrapper const &node) { return expand(node); }
+  partial root(tensor_mul const &node) { return expand(node); }
+
+  contraction_plan &plan() noexcept { return m_plan; }
+  std::vector<std::vector<std::size_t>> const &operand_labels() const noexcept {
+    return m_operand_labels;
+  }
+
+private:
+  partial visit(expression_holder<tensor_expression> const &expr) {
+    if (is_same<inner_product_wrapper>(expr)) {
+      auto const &ip = expr.template get<inner_product_wrapper>();
+      // Keep P:A as a unit so the evaluator's projector shortcut applies.
+      if (!is_same<tensor_projector>(ip.expr_lhs()))
+        return expand(ip);
+    } else if (is_same<tensor_mul>(expr)) {
+      auto const &mul = expr.template get<tensor_mul>();
+      if (!mul.coeff().is_valid() && !mul.data().empty())
+        return expand(mul);
+    }
+    return operand(expr);
+  }
+
+  partial operand(expression_holder<tensor_expression> const &expr) {
+    partial result{m_plan.operands.size(), {}};
+    for (std::size_t i = 0; i < expr.get().rank(); ++i)
+      result.labels.push_back(m_next_label++);
+    m_plan.operands.push_back(expr);
+    m_operand_labels.push_back(result.labels);
+    return result;
+  }
+
+  partial expand(inner_product_wrapper const &node) {
+    auto lhs = visit(node.expr_lhs());
+    auto const rhs_begin = m_plan.operands.size();
+    auto rhs = visit(node.expr_rhs());
+    return contract(std::move(lhs), std::move(rhs), rhs_begin,
+                    node.indices_lhs().indices(),
+                    node.indices_rhs().indices());
+  }
+
+  partial expand(tensor_mul const &node) {
+    auto const &children = node.data();
+    auto acc = visit(children.front());
+    for (std::size_t i = 1; i < children.size(); ++i) {
+      auto const rhs_begin = m_plan.operands.size();
+      auto next = visit(children[i]);
+      index_list const lhs_idx{
+          static_cast<std::uint8_t>(acc.labels.size() - 1)};
+      index_list const rhs_idx{0};
+      acc = contract(std::move(acc), std::move(next), rhs_begin, lhs_idx,
+                     rhs_idx);
+    }
+    return acc;
+  }
+
+  // Records the written step and merges the labels of the contracted pairs.
+  // The operands of `rhs` are the contiguous range starting at rhs_begin.
+  partial contract(partial lhs, partial rhs, std::size_t rhs_begin,
+                   index_list const &lhs_idx, index_list const &rhs_idx) {
+    if (lhs_idx.size() != rhs_idx.size())
+      throw internal_error("plan_contractions: unpaired contraction indices");
+    for (std::size_t k = 0; k < lhs_idx.size(); ++k) {
+      auto const from = rhs.labels[rhs_idx[k]];
+      auto const to = lhs.labels[lhs_idx[k]];
+      for (auto op = rhs_begin; op < m_operand_labels.size(); ++op)
+        std::ranges::replace(m_operand_labels[op], from, to);
+    }
+
+    auto const touched = lhs.labels.size() + rhs.labels.size() - lhs_idx.size();
+    m_plan.written_cost += ipow(m_dim, touched);
+
+    partial result{lhs.slot, {}};
+    auto keep = [&](partial const &p, index_list const &idx) {
+      for (std::size_t i = 0; i < p.labels.size(); ++i)
+        if (std::ranges::find(idx, i) == idx.end())
+          result.labels.push_back(p.labels[i]);
+    };
+    keep(lhs, lhs_idx);
+    keep(rhs, rhs_idx);
+
+    m_plan.steps.push_back(
+        {lhs.slot, rhs.slot, lhs_idx, rhs_idx, result.labels.size()});
+    return result;
+  }
+
+  std::size_t m_dim;
+  std::size_t m_next_label{0};
+  contraction_plan m_plan;
+  std::vector<std::vector<std::size_t>> m_operand_labels;
+};
+
+// ─── Subset DP ───────────────────────────────────────────────────
+
+class order_optimizer {
+public:
+  order_optimizer(std::size_t dim,
+                  std::vector<std::vector<std::size_t>> const &labels)
+      : m_dim(dim), m_labels(labels), m_full((1u << labels.size()) - 1),
+        m_open(m_full + 1, 0), m_best(m_full + 1, infeasible),
+        m_split(m_full + 1, 0) {
+    // Operand mask of every label; a label is open in a subset iff exactly
+    // one of its operands is inside.
+    std::vector<std::pair<std::size_t, unsigned>> label_masks;
+    for (std::size_t op = 0; op < labels.size(); ++op)
+      for (auto label : labels[op]) {
+        auto it = std::ranges::find(label_masks, label,
+                                    &std::pair<std::size_t, unsigned>::first);
+        if (it == label_masks.end())
+          label_masks.emplace_back(label, 1u << op);
+        else
+          it->second |= 1u << op;
+      }
+    for (unsigned mask = 1; mask <= m_full; ++mask)
+      for (auto const &[label, ops] : label_masks)
+        if (std::popcount(mask & ops) == 1)
+          ++m_open[mask];
+  }
+
+  // Cheapest cost of the full network, infeasible if every order needs an
+  // outer product or an oversized intermediate.
+  std::size_t solve() {
+    for (unsigned mask = 1; mask <= m_full; ++mask) {
+      if (std::has_single_bit(mask)) {
+        m_best[mask] = 0;
+        continue;
+      }
+      if (m_open[mask] == 0 || m_open[mask] > max_rank)
+        continue;
+      // Splits with the lowest operand on the left, each visited once.
+      auto const low = mask & (~mask + 1);
+      auto const rest = mask ^ low;
+      for (unsigned sub = rest;; sub = (sub - 1) & rest) {
+        auto const a = sub | low;
+        auto const b = mask ^ a;
+        if (b != 0)
+          relax(mask, a, b);
+        if (sub == 0)
+          break;
+      }
+    }
+    return m_best[m_full];
+  }
+
+  // Emits the steps of the optimal order into `plan`, returns the labels
+  // of the result slot.
+  std::vector<std::size_t> emit(contraction_plan &plan) {
+    plan.steps.clear();
+    auto result = emit(plan, m_full);
+    plan.result_slot = result.slot;
+    return std::move(result.labels);
+  }
+
+private:
+  void relax(unsigned mask, unsigned a, unsigned b) {
+    if (m_best[a] == infeasible || m_best[b] == infeasible)
+      return;
+    auto const shared = (m_open[a] + m_open[b] - m_open[mask]) / 2;
+    if (shared == 0)
+      return;
+    auto const cost =
+        m_best[a] + m_best[b] + ipow(m_dim, m_open[a] + m_open[b] - shared);
+    if (cost < m_best[mask]) {
+      m_best[mask] = cost;
+      m_split[mask] = a;
+    }
+  }
+
+  struct partial {
+    std::size_t slot;
+    std::vector<std::size_t> labels;
+  };
+
+  partial emit(contraction_plan &plan, unsigned mask) {
+    if (std::has_single_bit(mask)) {
+      auto const op = static_cast<std::size_t>(std::countr_zero(mask));
+      return {op, m_labels[op]};
+    }
+    auto lhs = emit(plan, m_split[mask]);
+    auto rhs = emit(plan, mask ^ m_split[mask]);
+
+    contraction_step step{lhs.slot, rhs.slot, {}, {}, 0};
+    partial result{lhs.slot, {}};
+    for (std::size_t i = 0; i < lhs.labels.size(); ++i) {
+      auto it = std::ranges::find(rhs.labels, lhs.labels[i]);
+      if (it == rhs.labels.end()) {
+        result.labels.push_back(lhs.labels[i]);
+      } else {
+        step.lhs_indices.push_back(static_cast<std::uint8_t>(i));
+        step.rhs_indices.push_back(
+            static_cast<std::uint8_t>(it - rhs.labels.begin()));
+      }
+    }
+    for (std::size_t j = 0; j < rhs.labels.size(); ++j)
+      if (std::ranges::find(step.rhs_indices, j) == step.rhs_indices.end())
+        result.labels.push_back(rhs.labels[j]);
+    step.result_rank = result.labels.size();
+    plan.steps.push_back(std::move(step));
+    return result;
+  }
+
+  std::size_t m_dim;
+  std::vector<std::vector<std::size_t>> const &m_labels;
+  unsigned m_full;
+  std::vector<std::size_t> m_open;
+  std::vector<std::size_t> m_best;
+  std::vector<unsigned> m_split;
+};
+
+template <typename Node> contraction_plan build_plan(Node const &node) {
+  network_builder builder(node.dim());
+  auto const written = builder.root(node);
+  auto &plan = builder.plan();
+  plan.result_slot = written.slot;
+  plan.cost = plan.written_cost;
+
+  auto const &labels = builder.operand_labels();
+  if (labels.size() < 3 ||
+      labels.size() > contraction_plan::max_planned_operands)
+    return std::move(plan);
+
+  order_optimizer optimizer(node.dim(), labels);
+  auto cost = optimizer.solve();
+  if (cost == infeasible)
+    return std::move(plan);
+
+  // The planned order may leave the free indices in a different order; a
+  // final permutation then has to pay for itself as well.
+  contraction_plan planned;
+  planned.operands = plan.operands;
+  planned.written_cost = plan.written_cost;
+  auto const final_labels = optimizer.emit(planned);
+  if (final_labels != written.labels) {
+    planned.permutation.resize(final_labels.size());
+    for (std::size_t k = 0; k < final_labels.size(); ++k)
+      planned.permutation[k] = static_cast<std::uint8_t>(
+          std::ranges::find(written.labels, final_labels[k]) -
+          written.labels.begin());
+    cost += ipow(node.dim(), final_labels.size());
+  }
+  if (cost >= plan.written_cost)
+    return std::move(plan);
+  planned.cost = cost;
+  return planned;
+}
+
+template <typename Node> contraction_plan const &cached_plan(Node const &node) {
+  auto &cache = node.contraction_plan_cache();
+  if (!cache)
+    cache = std::make_shared<contraction_plan const>(build_plan(node));
+  return *cache;
+}
+
+} // namespace
+
+contraction_plan const &plan_contractions(inner_product_wrapper const &node) {
+  return cached_plan(node);
+}
+
+contraction_plan const &plan_contractions(tensor_mul const &node) {
+  if (node.data().empty())
+    throw internal_error("plan_contractions: empty tensor_mul");
+  return cached_plan(node);
+}
+
+} // namespace numsim::cas
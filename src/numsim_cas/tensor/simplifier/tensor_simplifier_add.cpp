@@ -51,7 +51,7 @@ n_ary_add::dispatch([[maybe_unused]] Expr const &rhs) {
     pos = add.find_like(m_rhs.template get<tensor_scalar_mul>().expr_rhs());
   }
   if (pos != add.symbol_map().end()) {
-    auto combined{pos->second + m_rhs};
+    auto combined{*pos + m_rhs};
     add.symbol_map().erase(pos);
     if (!is_same<tensor_zero>(combined)) {
       // signed insert: the combined term may exactly negate another child
@@ -66,7 +66,7 @@ n_ary_add::dispatch([[maybe_unused]] Expr const &rhs) {
       return tensor_traits::zero(m_lhs);
     }
     if (add.size() == 1 && !add.coeff().is_valid()) {
-      return add.symbol_map().begin()->second;
+      return *add.symbol_map().begin();
     }
     return expr_add;
   }
@@ -81,7 +81,7 @@ n_ary_add::dispatch([[maybe_unused]] Expr const &rhs) {
     return tensor_traits::zero(m_lhs);
   }
   if (add.size() == 1 && !add.coeff().is_valid()) {
-    return add.symbol_map().begin()->second;
+    return *add.symbol_map().begin();
   }
   return expr_add;
 }
@@ -100,7 +100,7 @@ n_ary_add::dispatch(tensor_add const &rhs) {
     return tensor_traits::zero(m_lhs);
   }
   if (add.size() == 1 && !add.coeff().is_valid()) {
-    return add.symbol_map().begin()->second;
+    return *add.symbol_map().begin();
   }
   return expr;
 }
@@ -116,7 +116,7 @@ n_ary_add::dispatch(tensor_negative const &rhs) {
     add.invalidate_hash();
     add.recompute_space();
     if (add.size() == 1 && !add.coeff().is_valid()) {
-      return add.symbol_map().begin()->second;
+      return *add.symbol_map().begin();
     }
     return expr;
   }
@@ -133,7 +133,7 @@ n_ary_add::dispatch(tensor_negative const &rhs) {
     return tensor_traits::zero(m_lhs);
   }
   if (add.size() == 1 && !add.coeff().is_valid()) {
-    return add.symbol_map().begin()->second;
+    return *add.symbol_map().begin();
   }
   return expr;
 }
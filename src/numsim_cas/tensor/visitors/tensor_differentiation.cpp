@@ -12,11 +12,114 @@
 #include <numsim_cas/tensor/tensor_operators.h>
 #include <numsim_cas/tensor/tensor_std.h>
 #include <numsim_cas/tensor_to_scalar/tensor_to_scalar_diff.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_functions.h>
 #include <numsim_cas/tensor_to_scalar/tensor_to_scalar_operators.h>
 #include <numsim_cas/tensor_to_scalar/tensor_to_scalar_std.h>
 
 namespace numsim::cas {
 
+namespace {
+
+// ─── Cayley-Hamilton form of the tensor_pow derivative ───────────────
+//
+// For rank-2 A in 2D/3D every power is a combination of the basis
+// B = {I, A} (2D) or {I, A, A^2} (3D),
+//   A^r = sum_p u_p(r) B_p,
+// whose coefficients follow from the characteristic polynomial
+//   2D: A^2 = I1 A - I2 I,   3D: A^3 = I1 A^2 - I2 A + I3 I
+// as in tensor_evaluator::pow_cayley_hamilton. Substituting this into the
+// Daleckij-Krein sum gives
+//   sum_{r<n} A^r (x) A^{n-1-r} = sum_{p,q} M_pq B_p (x) B_q,
+//   M_pq = sum_{r<n} u_p(r) u_q(n-1-r)  (symmetric in p, q),
+// i.e. at most 6 rank-4 terms for any n. The u_p(r) are built by the
+// recurrence as shared tensor_to_scalar nodes, a few per step, so the
+// coefficients take O(n) nodes and evaluate like the recurrence itself.
+// Expanding them into monomials instead gives integer coefficients that
+// alternate in sign, grow exponentially and cancel in double.
+
+using t2s_holder_t = expression_holder<tensor_to_scalar_expression>;
+
+// lhs + rhs and lhs * rhs with an invalid holder standing for zero.
+t2s_holder_t add_or_zero(t2s_holder_t const &lhs, t2s_holder_t const &rhs) {
+  if (!lhs.is_valid())
+    return rhs;
+  if (!rhs.is_valid())
+    return lhs;
+  return lhs + rhs;
+}
+
+t2s_holder_t mul_or_zero(t2s_holder_t const &lhs, t2s_holder_t const &rhs) {
+  if (!lhs.is_valid() || !rhs.is_valid())
+    return {};
+  return lhs * rhs;
+}
+
+// u(r) for r = 0..n-1, one coefficient per basis element.
+std::vector<std::vector<t2s_holder_t>>
+power_coefficients(expression_holder<tensor_expression> const &A,
+                   std::size_t dim, std::int64_t n) {
+  // A^dim = sum_p reduce[p] B_p
+  std::vector<t2s_holder_t> const reduce =
+      dim == 2 ? std::vector<t2s_holder_t>{-second_invariant(A),
+                                           first_invariant(A)}
+               : std::vector<t2s_holder_t>{third_invariant(A),
+                                           -second_invariant(A),
+                                           first_invariant(A)};
+  std::vector<std::vector<t2s_holder_t>> u;
+  u.reserve(static_cast<std::size_t>(n));
+  std::vector<t2s_holder_t> current(dim);
+  current[0] = make_expression<tensor_to_scalar_one>();
+  u.push_back(current);
+  for (std::int64_t r = 1; r < n; ++r) {
+    // A * sum_p c_p B_p, with the top power reduced by Cayley-Hamilton.
+    auto const &top = current[dim - 1];
+    std::vector<t2s_holder_t> next(dim);
+    next[0] = mul_or_zero(reduce[0], top);
+    for (std::size_t p = 1; p < dim; ++p)
+      next[p] = add_or_zero(current[p - 1], mul_or_zero(reduce[p], top));
+    current = std::move(next);
+    u.push_back(current);
+  }
+  return u;
+}
+
+// Closed form of sum_{r<n} T_r : dA for rank-2 A in 2D/3D (see above).
+expression_holder<tensor_expression>
+pow_derivative_cayley_hamilton(expression_holder<tensor_expression> const &A,
+                               std::int64_t n,
+                               expression_holder<tensor_expression> const &dA) {
+  using tensor_holder_t = expression_holder<tensor_expression>;
+  auto const dim = A.get().dim();
+  auto const u = power_coefficients(A, dim, n);
+  std::vector<tensor_holder_t> const basis =
+      dim == 2 ? std::vector<tensor_holder_t>{make_expression<identity_tensor>(
+                                                  dim, std::size_t{2}),
+                                              A}
+               : std::vector<tensor_holder_t>{
+                     make_expression<identity_tensor>(dim, std::size_t{2}), A,
+                     pow(A, 2)};
+
+  tensor_holder_t sum;
+  for (std::size_t p = 0; p < dim; ++p)
+    for (std::size_t q = p; q < dim; ++q) {
+      t2s_holder_t M;
+      for (std::int64_t r = 0; r < n; ++r)
+        M = add_or_zero(M, mul_or_zero(
+                               u[static_cast<std::size_t>(r)][p],
+                               u[static_cast<std::size_t>(n - 1 - r)][q]));
+      if (!M.is_valid())
+        continue;
+      auto T = otimes(basis[p], sequence{1, 3}, basis[q], sequence{4, 2});
+      if (p != q)
+        T += otimes(basis[q], sequence{1, 3}, basis[p], sequence{4, 2});
+      auto term = inner_product(T, sequence{3, 4}, dA, sequence{1, 2}) * M;
+      sum = sum.is_valid() ? sum + term : term;
+    }
+  return sum;
+}
+
+} // namespace
+
 // tensor_pow: d(A^n)/dX = sum_{r=0}^{n-1} T_r : dA/dX
 // where T_r[i,j,p,q] = (A^r)_{ip} * (A^{n-1-r})_{qj}  (Daleckij-Krein)
 void tensor_differentiation::operator()(tensor_pow const &visitable) {
@@ -53,6 +156,13 @@ void tensor_differentiation::operator()(tensor_pow const &visitable) {
     return;
   }
 
+  // Rank-2 in 2D/3D: a fixed number of terms instead of n.
+  if (n >= 3 && A.get().rank() == 2 &&
+      (A.get().dim() == 2 || A.get().dim() == 3)) {
+    m_result = pow_derivative_cayley_hamilton(A, n, dA);
+    return;
+  }
+
   // Build sum: sum_{r=0}^{n-1} inner_product(T_r, {3,4}, dA/dX, {1,2})
   // T_r = otimes(A^r, {1,3}, A^{n-1-r}, {4,2})
   //   so T_r[i,j,p,q] = (A^r)_{ip} * (A^{n-1-r})_{qj}
@@ -74,40 +184,36 @@ void tensor_differentiation::operator()(tensor_pow const &visitable) {
 
 // tensor_mul: product rule over the data() vector
 // d(A1*A2*...*An)/dX = sum_j coeff * lhs * dAj * rhs
-// where lhs = A0*...*A_{j-1}, rhs = A_{j+1}*...*A_{n-1}
+// where lhs = A0*...*A_{j-1}, rhs = A_{j+1}*...*A_{n-1}. The prefix and
+// suffix products are built once and shared by all terms, so the result
+// grows linearly with the chain length.
 void tensor_differentiation::operator()(tensor_mul const &visitable) {
   auto const &factors = visitable.data();
+  auto const n = factors.size();
   tensor_holder_t sum;
 
-  for (std::size_t j = 0; j < factors.size(); ++j) {
-    auto dAj = diff(factors[j], m_arg);
-    if (!dAj.is_valid()) {
-      continue;
+  std::vector<tensor_holder_t> dA(n);
+  std::size_t first{n}, last{0};
+  for (std::size_t j = 0; j < n; ++j) {
+    dA[j] = diff(factors[j], m_arg);
+    if (dA[j].is_valid() && !is_same<tensor_zero>(dA[j])) {
+      first = std::min(first, j);
+      last = j;
     }
+  }
+  if (first == n) {
+    return;
+  }
 
-    // Build lhs chain: factors[0] * ... * factors[j-1]
-    tensor_holder_t lhs;
-    for (std::size_t i = 0; i < j; ++i) {
-      if (!lhs.is_valid()) {
-        lhs = factors[i];
-      } else {
-        auto rank_lhs = lhs.get().rank();
-        lhs = inner_product(std::move(lhs), sequence{rank_lhs}, factors[i],
-                            sequence{1});
-      }
-    }
+  auto const chain = make_chain_partial_products(factors, first, last);
 
-    // Build rhs chain: factors[j+1] * ... * factors[n-1]
-    tensor_holder_t rhs;
-    for (std::size_t i = j + 1; i < factors.size(); ++i) {
-      if (!rhs.is_valid()) {
-        rhs = factors[i];
-      } else {
-        auto rank_rhs = rhs.get().rank();
-        rhs = inner_product(std::move(rhs), sequence{rank_rhs}, factors[i],
-                            sequence{1});
-      }
+  for (std::size_t j = first; j <= last; ++j) {
+    auto const &dAj = dA[j];
+    if (!dAj.is_valid() || is_same<tensor_zero>(dAj)) {
+      continue;
     }
+    tensor_holder_t lhs = chain.prefix[j];
+    tensor_holder_t rhs = chain.suffix[j];
 
     // Build term = lhs * dAj * rhs
     tensor_holder_t term;
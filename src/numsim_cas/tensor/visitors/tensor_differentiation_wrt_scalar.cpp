@@ -82,45 +82,39 @@ void tensor_differentiation_wrt_scalar::operator()(
 // The j-th factor's scalar derivative dA_j/ds has the SAME rank as
 // A_j (scalar arg adds no indices), so the resulting product is
 // shape-equivalent to the original tensor_mul. No reorder permutation
-// needed.
+// needed. The partial products around dA_j are shared across terms
+// (make_chain_partial_products).
 void tensor_differentiation_wrt_scalar::operator()(
     tensor_mul const &visitable) {
   auto const &factors = visitable.data();
+  auto const n = factors.size();
   tensor_holder_t sum;
 
-  for (std::size_t j = 0; j < factors.size(); ++j) {
-    auto dAj = diff(factors[j], m_arg);
-    // Zero-suppress: skip terms whose derivative is invalid OR the
-    // canonical tensor_zero singleton. Without the singleton check,
-    // each zero summand would inflate the printed result and confuse
-    // hash lock-ins. Matches the tensor_scalar_mul rule's pattern.
-    if (!dAj.is_valid() || is_same<tensor_zero>(dAj)) {
-      continue;
-    }
-
-    // Build lhs chain: factors[0] * ... * factors[j-1]
-    tensor_holder_t lhs;
-    for (std::size_t i = 0; i < j; ++i) {
-      if (!lhs.is_valid()) {
-        lhs = factors[i];
-      } else {
-        auto rank_lhs = lhs.get().rank();
-        lhs = inner_product(std::move(lhs), sequence{rank_lhs}, factors[i],
-                            sequence{1});
-      }
+  // Zero-suppress: skip terms whose derivative is invalid OR the
+  // canonical tensor_zero singleton. Without the singleton check,
+  // each zero summand would inflate the printed result and confuse
+  // hash lock-ins. Matches the tensor_scalar_mul rule's pattern.
+  std::vector<tensor_holder_t> dA(n);
+  std::size_t first{n}, last{0};
+  for (std::size_t j = 0; j < n; ++j) {
+    dA[j] = diff(factors[j], m_arg);
+    if (dA[j].is_valid() && !is_same<tensor_zero>(dA[j])) {
+      first = std::min(first, j);
+      last = j;
     }
+  }
+  if (first == n) {
+    return;
+  }
+  auto const chain = make_chain_partial_products(factors, first, last);
 
-    // Build rhs chain: factors[j+1] * ... * factors[n-1]
-    tensor_holder_t rhs;
-    for (std::size_t i = j + 1; i < factors.size(); ++i) {
-      if (!rhs.is_valid()) {
-        rhs = factors[i];
-      } else {
-        auto rank_rhs = rhs.get().rank();
-        rhs = inner_product(std::move(rhs), sequence{rank_rhs}, factors[i],
-                            sequence{1});
-      }
+  for (std::size_t j = first; j <= last; ++j) {
+    auto const &dAj = dA[j];
+    if (!dAj.is_valid() || is_same<tensor_zero>(dAj)) {
+      continue;
     }
+    tensor_holder_t lhs = chain.prefix[j];
+    tensor_holder_t rhs = chain.suffix[j];
 
     // Build term = lhs * dAj * rhs
     tensor_holder_t term;
@@ -58,9 +58,9 @@ static bool try_fold_numeric_pow(tensor_to_scalar_mul &mul,
   if (!child_base_val || !child_exp_val)
     return false;
   for (auto it = mul.symbol_map().begin(); it != mul.symbol_map().end(); ++it) {
-    if (!is_same<tensor_to_scalar_pow>(it->second))
+    if (!is_same<tensor_to_scalar_pow>(*it))
       continue;
-    auto const &existing = it->second.template get<tensor_to_scalar_pow>();
+    auto const &existing = it->template get<tensor_to_scalar_pow>();
     auto existing_base_val = t2s_traits::try_numeric(existing.expr_lhs());
     auto existing_exp_val = t2s_traits::try_numeric(existing.expr_rhs());
     // (c1^e)*(c2^e) --> (c1*c2)^e: sound for integer e or nonneg bases (#345)
@@ -96,7 +96,7 @@ static void push_or_combine(tensor_to_scalar_mul &mul,
     return;
   auto pos = mul.symbol_map().find(child);
   if (pos != mul.symbol_map().end()) {
-    auto combined = pos->second * child;
+    auto combined = *pos * child;
     mul.symbol_map().erase(pos);
     mul.push_back(std::move(combined));
     return;
@@ -124,8 +124,8 @@ mul_base::dispatch(tensor_to_scalar_mul const &lhs) {
         mul.set_coeff(rhs_mul.coeff());
       }
     }
-    for (auto const &[k, v] : rhs_mul.symbol_map()) {
-      push_or_combine(mul, v);
+    for (auto const &child : rhs_mul.symbol_map()) {
+      push_or_combine(mul, child);
     }
     return new_mul;
   }
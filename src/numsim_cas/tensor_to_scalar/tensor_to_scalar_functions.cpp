@@ -61,7 +61,7 @@ trace(expression_holder<tensor_expression> const &expr) {
     expression_holder<tensor_to_scalar_expression> result;
     if (add.coeff().is_valid())
       result = trace(add.coeff());
-    for (auto const &child : add.symbol_map() | std::views::values) {
+    for (auto const &child : add.symbol_map()) {
       if (result.is_valid())
         result = result + trace(child);
       else
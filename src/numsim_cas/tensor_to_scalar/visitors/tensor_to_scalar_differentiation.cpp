@@ -50,7 +50,7 @@ void tensor_to_scalar_differentiation::operator()(
   // (no global zero, since rank/dim vary with m_arg; scalar diff
   // identity-inits instead). Keep new tensor accumulators consistent.
   tensor_holder_t sum;
-  for (auto &child : visitable.symbol_map() | std::views::values) {
+  for (auto &child : visitable.symbol_map()) {
     auto d = diff(child, m_arg);
     if (is_same<tensor_zero>(d))
       continue;
@@ -71,7 +71,7 @@ void tensor_to_scalar_differentiation::operator()(
   tensor_holder_t sum;
 
   for (auto it_out = factors.begin(); it_out != factors.end(); ++it_out) {
-    auto d_aj = diff(it_out->second, m_arg);
+    auto d_aj = diff(*it_out, m_arg);
     if (is_same<tensor_zero>(d_aj)) {
       continue;
     }
@@ -82,10 +82,10 @@ void tensor_to_scalar_differentiation::operator()(
     for (auto it_in = factors.begin(); it_in != factors.end(); ++it_in) {
       if (it_in == it_out)
         continue;
-      // it_in->second is a t2s expression, term is tensor
+      // *it_in is a t2s expression, term is tensor
       // Create f * A node directly
       term = make_expression<tensor_to_scalar_with_tensor_mul>(std::move(term),
-                                                               it_in->second);
+                                                               *it_in);
     }
 
     if (term.is_valid()) {
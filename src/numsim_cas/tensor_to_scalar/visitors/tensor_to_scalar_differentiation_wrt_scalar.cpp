@@ -35,7 +35,7 @@ wrap_scalar(expression_holder<scalar_expression> s) {
 expression_holder<tensor_to_scalar_expression>
 tensor_to_scalar_differentiation_wrt_scalar::apply(t2s_holder_t const &expr) {
   m_result = t2s_holder_t{};
-  if (expr.is_valid()) {
+  if (expr.is_valid() && may_depend_on(expr.get(), m_arg.get())) {
     m_expr = expr;
     expr.get<tensor_to_scalar_visitable_t>().accept(*this);
   }
@@ -80,7 +80,7 @@ void tensor_to_scalar_differentiation_wrt_scalar::operator()(
 void tensor_to_scalar_differentiation_wrt_scalar::operator()(
     tensor_to_scalar_add const &visitable) {
   t2s_holder_t sum;
-  for (auto &child : visitable.symbol_map() | std::views::values) {
+  for (auto &child : visitable.symbol_map()) {
     auto d = diff(child, m_arg);
     if (d.is_valid() && !is_same<tensor_to_scalar_zero>(d)) {
       if (sum.is_valid()) {
@@ -101,7 +101,7 @@ void tensor_to_scalar_differentiation_wrt_scalar::operator()(
   t2s_holder_t sum;
 
   for (auto it_out = factors.begin(); it_out != factors.end(); ++it_out) {
-    auto d_aj = diff(it_out->second, m_arg);
+    auto d_aj = diff(*it_out, m_arg);
     if (!d_aj.is_valid() || is_same<tensor_to_scalar_zero>(d_aj)) {
       continue;
     }
@@ -112,9 +112,9 @@ void tensor_to_scalar_differentiation_wrt_scalar::operator()(
       if (it_in == it_out)
         continue;
       if (rest.is_valid()) {
-        rest = rest * it_in->second;
+        rest = rest * *it_in;
       } else {
-        rest = it_in->second;
+        rest = *it_in;
       }
     }
 
@@ -11,14 +11,15 @@ using dir = limit_result::direction;
 // ─── Constructors ─────────────────────────────────────────────────
 
 tensor_to_scalar_limit_visitor::tensor_to_scalar_limit_visitor(
-    t2s_holder_t const &limit_var, limit_target target)
+    t2s_holder_t const &limit_var, limit_target target, limit_cache *cache)
     : m_mode(dependency_mode::exact_match), m_limit_var_t2s(limit_var),
-      m_target(target) {}
+      m_target(target), m_cache(cache) {}
 
 tensor_to_scalar_limit_visitor::tensor_to_scalar_limit_visitor(
-    tensor_holder_t const &tensor_var, limit_target target)
+    tensor_holder_t const &tensor_var, limit_target target,
+    limit_cache *cache)
     : m_mode(dependency_mode::tensor_dependency), m_tensor_var(tensor_var),
-      m_target(target) {}
+      m_target(target), m_cache(cache) {}
 
 // ─── Apply ────────────────────────────────────────────────────────
 
@@ -45,10 +46,31 @@ limit_result tensor_to_scalar_limit_visitor::apply(t2s_holder_t const &expr) {
     return m_result;
   }
 
+  if (auto const *cached = find_cached(expr)) {
+    m_result = *cached;
+    return m_result;
+  }
   expr.template get<tensor_to_scalar_visitable_t>().accept(*this);
+  store_cached(expr);
   return m_result;
 }
 
+// The two modes key the cache by their own variable, so their entries
+// cannot collide.
+limit_result const *
+tensor_to_scalar_limit_visitor::find_cached(t2s_holder_t const &expr) {
+  if (m_mode == dependency_mode::exact_match)
+    return cache().find(expr, m_limit_var_t2s, m_target);
+  return cache().find(expr, m_tensor_var, m_target);
+}
+
+void tensor_to_scalar_limit_visitor::store_cached(t2s_holder_t const &expr) {
+  if (m_mode == dependency_mode::exact_match)
+    cache().insert(expr, m_limit_var_t2s, m_target, m_result);
+  else
+    cache().insert(expr, m_tensor_var, m_target, m_result);
+}
+
 // ─── Dependency check ─────────────────────────────────────────────
 
 bool tensor_to_scalar_limit_visitor::depends_on_limit_var(
@@ -165,7 +187,7 @@ void tensor_to_scalar_limit_visitor::operator()(tensor_to_scalar_add const &v) {
   if (v.coeff().is_valid()) {
     result = apply(v.coeff());
   }
-  for (auto const &child : v.symbol_map() | std::views::values) {
+  for (auto const &child : v.symbol_map()) {
     result = combine_add(result, apply(child));
   }
   m_result = result;
@@ -176,7 +198,7 @@ void tensor_to_scalar_limit_visitor::operator()(tensor_to_scalar_mul const &v) {
   if (v.coeff().is_valid()) {
     result = apply(v.coeff());
   }
-  for (auto const &child : v.symbol_map() | std::views::values) {
+  for (auto const &child : v.symbol_map()) {
     result = combine_mul(result, apply(child));
   }
   m_result = result;
@@ -430,7 +430,7 @@ TEST(CoreBugFix, MergeOrInsertCollisionMergesIntoSingleEntry) {
   add_node->push_back(x);
   add_node->merge_or_insert(x);
   ASSERT_EQ(add_node->size(), 1u);
-  EXPECT_EQ(add_node->symbol_map().begin()->first, make_scalar_constant(2) * x);
+  EXPECT_EQ(*add_node->symbol_map().begin(), make_scalar_constant(2) * x);
 }
 
 TEST(CoreBugFix, MergeOrInsertSequentialCallsAreIndependent) {
@@ -449,7 +449,7 @@ TEST(CoreBugFix, MergeOrInsertSequentialCallsAreIndependent) {
   bool found_2x = false;
   bool found_y = false;
   auto const expected_2x = make_scalar_constant(2) * x;
-  for (auto const &[key, _] : add_node->symbol_map()) {
+  for (auto const &key : add_node->symbol_map()) {
     if (key == expected_2x)
       found_2x = true;
     else if (key == y)
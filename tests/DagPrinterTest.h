@@ -0,0 +1,72 @@
+#ifndef DAGPRINTERTEST_H
+#define DAGPRINTERTEST_H
+
+#include <gtest/gtest.h>
+
+#include "cas_test_helpers.h"
+
+#include <numsim_cas/dag_printer.h>
+#include <numsim_cas/numsim_cas.h>
+
+namespace numsim::cas {
+
+TEST(DagPrinter, PrintsTreeWithoutSharing) {
+  auto x = make_expression<scalar>("x");
+  auto y = make_expression<scalar>("y");
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto const s = sin(x) * y + x;
+  auto T = 2 * X + inv(X);
+  auto const f = det(X) + trace(X);
+  EXPECT_EQ(to_string_dag(s), to_string(s));
+  EXPECT_EQ(to_string_dag(T), to_string(T));
+  EXPECT_EQ(to_string_dag(f), to_string(f));
+  EXPECT_EQ(to_latex_dag(s), to_latex(s));
+}
+
+TEST(DagPrinter, BindsSharedScalarSubexpression) {
+  auto x = make_expression<scalar>("x");
+  auto y = make_expression<scalar>("y");
+  auto const shared = sin(x) + y;
+  auto const expr = exp(shared) * log(shared);
+  EXPECT_EQ(to_string_dag(expr), "let t1 = y+sin(x);\nexp(t1)*log(t1)");
+  EXPECT_EQ(to_string_dag(expr, {.prefix = "u"}),
+            "let u1 = y+sin(x);\nexp(u1)*log(u1)");
+  EXPECT_EQ(to_latex_dag(expr), "t_{1} = y+\\sin\\left(x\\right) \\\\\n"
+                                "\\exp\\left(t_{1}\\right) \\cdot "
+                                "\\ln\\left(t_{1}\\right)");
+  EXPECT_EQ(let_binding_hook::active(), nullptr);
+}
+
+TEST(DagPrinter, BindsAcrossDomains) {
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto const tr = trace(inv(X));
+  auto T = tr * inv(X) + pow(tr, 2) * X;
+  EXPECT_EQ(to_string_dag(T), "let t1 = tr(inv(X));\npow(t1,2)*X+t1*inv(X)");
+}
+
+TEST(DagPrinter, BindingsPrecedeTheirUses) {
+  auto x = make_expression<scalar>("x");
+  auto const e = testcas::shared_levels(
+      expression_holder<scalar_expression>{x}, 20,
+      [](auto const &level) { return sin(level) + cos(level); });
+  // The tree has 2^20 copies of x; the DAG has 20 sums.
+  auto const text = to_string_dag(e);
+  EXPECT_LT(text.size(), 1000u);
+  EXPECT_TRUE(text.starts_with("let t1 = sin(x)+cos(x);\n"));
+  for (int i = 1; i < 20; ++i) {
+    auto const name = "t" + std::to_string(i);
+    EXPECT_LT(text.find("let " + name + " "), text.find("(" + name + ")"));
+  }
+}
+
+TEST(DagPrinter, KeepsLeavesInline) {
+  auto x = make_expression<scalar>("x");
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto const I = make_expression<identity_tensor>(3, 2);
+  auto T = x * X + x * (I + X) + I;
+  EXPECT_EQ(to_string_dag(T), to_string(T));
+}
+
+} // namespace numsim::cas
+
+#endif // DAGPRINTERTEST_H
@@ -0,0 +1,119 @@
+#ifndef EVALUATORPRECISIONTEST_H
+#define EVALUATORPRECISIONTEST_H
+
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <memory>
+
+#include <numsim_cas/basic_functions.h>
+#include <numsim_cas/eigen_decomposition.h>
+#include <numsim_cas/precision_check.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/tensor/tensor_definitions.h>
+#include <numsim_cas/tensor/tensor_functions.h>
+#include <numsim_cas/tensor/tensor_operators.h>
+#include <numsim_cas/tensor/tensor_std.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_functions.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_operators.h>
+#include <numsim_cas/tensor_to_scalar/tensor_to_scalar_std.h>
+
+namespace numsim::cas {
+
+static_assert(is_promoted_v<float>);
+static_assert(std::is_same_v<promoted_value_t<float>, double>);
+static_assert(!is_promoted_v<double>);
+
+namespace {
+
+// clang-format off
+constexpr std::array<double, 9> spd_3x3{4.0,  1.0, 0.5,
+                                        1.0,  3.0, 0.25,
+                                        0.5, 0.25, 2.0};
+// clang-format on
+
+} // namespace
+
+TEST(EvalPrecision, FloatScalarPath) {
+  auto x = make_expression<scalar>("x");
+  scalar_evaluator<float> ev;
+  ev.set(x, 0.5f);
+  auto expr = sin(x) * exp(x) + pow(x, 3) - sqrt(x);
+  auto const expected = std::sin(0.5f) * std::exp(0.5f) +
+                        std::pow(0.5f, 3.0f) - std::sqrt(0.5f);
+  EXPECT_NEAR(ev.apply(expr), expected, 1e-6f);
+}
+
+TEST(EvalPrecision, FloatRationalConstantRoundedOnce) {
+  // 16777217 is not representable in float; dividing the rounded
+  // operands would give a different float than rounding the quotient.
+  auto c = make_expression<scalar_constant>(rational_t{16777217, 3});
+  scalar_evaluator<float> ev;
+  EXPECT_EQ(ev.apply(c), static_cast<float>(16777217.0 / 3.0));
+}
+
+TEST(EvalPrecision, FloatTensorPathWithinUlps) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto s = make_expression<scalar>("s");
+  precision_check<float> check;
+  check.set(A, spd_3x3.data());
+  check.set_scalar(s, 0.3);
+
+  auto stress = s * dev(A) + pow(A, 3) * trace(A) + inv(A);
+  auto err = check.compare(stress);
+  EXPECT_LT(err.ulps, 64.0) << "max_rel = " << err.max_rel;
+  EXPECT_GT(err.max_abs, 0.0); // the float path really ran in float
+
+  auto energy = det(A) + dot(A) + norm(dev(A));
+  EXPECT_LT(check.compare(energy).ulps, 64.0);
+}
+
+TEST(EvalPrecision, FloatSpectralPathWithinUlps) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  precision_check<float> check;
+  check.set(A, spd_3x3.data());
+  eigen_decomposition eig(A);
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_LT(check.compare(eig.value(i)).ulps, 16.0) << "value " << i;
+    EXPECT_LT(check.compare(eig.basis(i)).ulps, 64.0) << "basis " << i;
+  }
+}
+
+TEST(EvalPrecision, FloatDetPromotedToDouble) {
+  // All entries are exact in float. det = -3 * 2^-20 suffers complete
+  // cancellation in float arithmetic (5 * (9 + 2^-20) is not a float), but
+  // is exact when promoted to double.
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto const tiny = std::ldexp(1.0f, -20);
+  auto data = std::make_shared<tensor_data<float, 3, 2>>();
+  // clang-format off
+  std::array<float, 9> const values{1.0f, 2.0f, 3.0f,
+                                    4.0f, 5.0f, 6.0f,
+                                    7.0f, 8.0f, 9.0f + tiny};
+  // clang-format on
+  std::copy(values.begin(), values.end(), data->raw_data());
+
+  tensor_to_scalar_evaluator<float> ev;
+  ev.set(A, data);
+  EXPECT_EQ(ev.apply(det(A)), -3.0f * tiny);
+}
+
+TEST(EvalPrecision, FloatInvPromotedToDouble) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  // clang-format off
+  std::array<double, 9> ill{1.0,  2.0, 3.0,
+                            4.0,  5.0, 6.0,
+                            7.0,  8.0, 9.0 + std::ldexp(1.0, -12)};
+  // clang-format on
+  precision_check<float> check;
+  check.set(A, ill.data());
+  // cond(A) ~ 1e5: plain float elimination would lose about five digits,
+  // the promoted inverse only sees the input rounding (exact here).
+  EXPECT_LT(check.compare(inv(A)).ulps, 1.0);
+}
+
+} // namespace numsim::cas
+
+#endif // EVALUATORPRECISIONTEST_H
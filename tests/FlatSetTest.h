@@ -0,0 +1,198 @@
+#ifndef FLATSETTEST_H
+#define FLATSETTEST_H
+
+// Tests for the inline-capacity containers backing n_ary_tree children
+// and tensor index lists (core/small_vector.h, core/flat_set.h,
+// tensor/index_list.h).
+//
+// Coverage scope:
+//   - small_vector inline -> heap transition, insert/erase in the middle,
+//     copy/move in both storage modes.
+//   - flat_set ordering, lookup, erase by key and iterator, duplicate
+//     rejection, bulk insert.
+//   - sequence stays inline up to max_eval_rank and keeps its 1-based
+//     surface, ordering and hash.
+//   - n_ary_tree keeps its ordering / like-term behaviour past the inline
+//     capacity and when built with append().
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <numsim_cas/core/flat_set.h>
+#include <numsim_cas/core/small_vector.h>
+#include <numsim_cas/numsim_cas.h>
+#include <numsim_cas/tensor/sequence.h>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace numsim::cas::flat_set_test {
+
+TEST(SmallVector, StaysInlineUpToCapacity) {
+  small_vector<int, 4> v;
+  for (int i = 0; i < 4; ++i)
+    v.push_back(i);
+  EXPECT_TRUE(v.is_inline());
+  v.push_back(4);
+  EXPECT_FALSE(v.is_inline());
+  ASSERT_EQ(v.size(), 5u);
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ(v[static_cast<std::size_t>(i)], i);
+}
+
+TEST(SmallVector, InsertAndEraseShiftElements) {
+  small_vector<std::string, 2> v{"a", "c"};
+  v.insert(v.begin() + 1, "b");
+  ASSERT_EQ(v.size(), 3u);
+  EXPECT_EQ(v[0], "a");
+  EXPECT_EQ(v[1], "b");
+  EXPECT_EQ(v[2], "c");
+  auto it = v.erase(v.begin());
+  EXPECT_EQ(*it, "b");
+  EXPECT_EQ(v.size(), 2u);
+  v.erase(v.begin(), v.end());
+  EXPECT_TRUE(v.empty());
+}
+
+TEST(SmallVector, CopyAndMoveInBothModes) {
+  small_vector<std::shared_ptr<int>, 2> small{std::make_shared<int>(1)};
+  small_vector<std::shared_ptr<int>, 2> big;
+  for (int i = 0; i < 5; ++i)
+    big.push_back(std::make_shared<int>(i));
+
+  auto small_copy = small;
+  auto big_copy = big;
+  EXPECT_EQ(small_copy.size(), 1u);
+  EXPECT_EQ(*big_copy[4], 4);
+  EXPECT_EQ(big[4].use_count(), 2);
+
+  auto small_moved = std::move(small_copy);
+  auto big_moved = std::move(big_copy);
+  EXPECT_TRUE(small_copy.empty());
+  EXPECT_TRUE(big_copy.empty());
+  EXPECT_EQ(*small_moved[0], 1);
+  EXPECT_EQ(big[4].use_count(), 2);
+  EXPECT_EQ(big_moved, big);
+}
+
+TEST(SmallVector, SequenceStaysInlineUpToMaxEvalRank) {
+  static_assert(sizeof(sequence::index_t) == 1);
+  sequence seq{8, 7, 6, 5, 4, 3, 2, 1};
+  EXPECT_EQ(seq.size(), max_eval_rank);
+  EXPECT_TRUE(seq.indices().is_inline());
+  EXPECT_EQ(seq[0], 7u);
+  EXPECT_EQ(seq[7], 0u);
+
+  auto const joined = concat(seq, sequence{9});
+  EXPECT_FALSE(joined.indices().is_inline());
+  EXPECT_EQ(joined[8], 8u);
+
+  EXPECT_THROW((sequence{0}), std::out_of_range);
+  EXPECT_THROW((sequence{257}), std::out_of_range);
+  EXPECT_NO_THROW((sequence{256}));
+}
+
+TEST(SmallVector, SequenceOrderAndHashFollowIndexValues) {
+  EXPECT_LT((sequence{1, 2}), (sequence{2, 1}));
+  EXPECT_LT((sequence{1}), (sequence{1, 2}));
+  EXPECT_EQ((sequence{2, 1}),
+            permute(sequence{1, 2}, std::vector<std::size_t>{1, 0}));
+
+  std::size_t seq_hash{0}, value_hash{0};
+  hash_combine(seq_hash, sequence{3, 1, 2});
+  for (std::size_t i : {2u, 0u, 1u})
+    hash_combine(value_hash, i);
+  EXPECT_EQ(seq_hash, value_hash);
+
+  std::ostringstream os;
+  os << sequence{3, 1, 2};
+  EXPECT_EQ(os.str(), "{3, 1, 2}");
+}
+
+TEST(FlatSet, KeepsKeysSortedAndRejectsDuplicates) {
+  flat_set<std::string, 2> m;
+  EXPECT_TRUE(m.insert("c").second);
+  EXPECT_TRUE(m.insert("a").second);
+  EXPECT_TRUE(m.insert("b").second);
+  auto const [pos, inserted] = m.insert(std::string{"b"});
+  EXPECT_FALSE(inserted);
+  EXPECT_EQ(*pos, "b");
+
+  std::string order;
+  for (auto const &key : m)
+    order += key;
+  EXPECT_EQ(order, "abc");
+  EXPECT_EQ(*m.lower_bound("b"), "b");
+  EXPECT_EQ(m.find("z"), m.end());
+  EXPECT_EQ(m.size(), 3u);
+}
+
+TEST(FlatSet, EraseByKeyAndIterator) {
+  flat_set<int, 4> m;
+  for (int i = 0; i < 6; ++i)
+    m.insert(i);
+  EXPECT_EQ(m.erase(3), 1u);
+  EXPECT_EQ(m.erase(3), 0u);
+  auto it = m.erase(m.find(1));
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(m.size(), 4u);
+  EXPECT_FALSE(m.contains(1));
+  EXPECT_TRUE(m.contains(5));
+}
+
+TEST(FlatSet, BulkInsertSortsOnceAndKeepsKeysOnce) {
+  flat_set<int, 2> m;
+  m.insert(4);
+  std::vector<int> const batch{7, 1, 4, 1, 3};
+  EXPECT_EQ(m.insert(batch.begin(), batch.end()), 3u);
+  ASSERT_EQ(m.size(), 4u);
+  EXPECT_TRUE(std::ranges::is_sorted(m));
+  EXPECT_TRUE(std::ranges::equal(m, std::vector{1, 3, 4, 7}));
+}
+
+TEST(FlatSet, StoresEachChildOnce) {
+  using holder = expression_holder<scalar_expression>;
+  static_assert(std::is_same_v<scalar_add::map_t::value_type, holder>);
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const sum = x + 2 * y;
+  auto const &add = sum.get<scalar_add>();
+  EXPECT_EQ(add.size(), 2u);
+  EXPECT_TRUE(add.symbol_map().contains(x));
+  EXPECT_TRUE(add.symbol_map().contains(2 * y));
+}
+
+TEST(FlatSet, NaryTreeAppendMatchesPushBack) {
+  auto [a, b, c, d, e, f] = make_scalar_variable("a", "b", "c", "d", "e", "f");
+  auto bulk = make_expression<scalar_add>();
+  bulk.get<scalar_add>().append(std::vector{f, 2 * d, b, e, a, c});
+  EXPECT_EQ(bulk, a + b + c + 2 * d + e + f);
+  EXPECT_EQ(bulk.get().hash_value(),
+            (a + b + c + 2 * d + e + f).get().hash_value());
+  EXPECT_EQ(bulk - 2 * d, a + b + c + e + f);
+
+  auto twice = make_expression<scalar_add>();
+  EXPECT_THROW(twice.get<scalar_add>().append(std::vector{a, b, a}),
+               internal_error);
+}
+
+TEST(FlatSet, NaryTreeBeyondInlineCapacity) {
+  auto [a, b, c, d, e, f] = make_scalar_variable("a", "b", "c", "d", "e", "f");
+  auto sum = a + b + c + d + e + f;
+  ASSERT_TRUE(is_same<scalar_add>(sum));
+  auto const &add = sum.template get<scalar_add>();
+  EXPECT_EQ(add.size(), 6u);
+  EXPECT_TRUE(std::ranges::is_sorted(
+      add.symbol_map(), [](auto const &l, auto const &r) { return l < r; }));
+
+  // Order-independent construction yields the same node.
+  EXPECT_EQ(sum, f + e + d + c + b + a);
+  // Like-term merge and cancellation still find their partner.
+  EXPECT_EQ(sum + 2 * c, a + b + 3 * c + d + e + f);
+  EXPECT_EQ(sum - d, a + b + c + e + f);
+}
+
+} // namespace numsim::cas::flat_set_test
+
+#endif // FLATMAPTEST_H
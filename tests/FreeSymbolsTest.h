@@ -0,0 +1,79 @@
+#ifndef FREESYMBOLSTEST_H
+#define FREESYMBOLSTEST_H
+
+// Tests for the cached free-symbol sets (core/free_symbols.h).
+//
+// Coverage scope:
+//   - leaves: symbols contribute their own bit, constants none.
+//   - compound nodes (unary, binary, n-ary, cross-domain) take the union of
+//     their children, coefficient included.
+//   - contains_expression / depends_on_tensor and diff() give the same
+//     answers with the pre-filter in place.
+
+#include <gtest/gtest.h>
+
+#include <numsim_cas/core/contains_expression.h>
+#include <numsim_cas/core/free_symbols.h>
+#include <numsim_cas/numsim_cas.h>
+#include <tuple>
+
+namespace numsim::cas::free_symbols_test {
+
+TEST(FreeSymbols, LeavesAndConstants) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  EXPECT_EQ(x.get().free_symbols(), symbol_set::of("x"));
+  EXPECT_TRUE(make_scalar_constant(3).get().free_symbols().empty());
+  EXPECT_TRUE(get_scalar_zero().get().free_symbols().empty());
+  EXPECT_TRUE(get_scalar_one().get().free_symbols().empty());
+  EXPECT_TRUE(symbol_set::all().may_contain(symbol_set::of("anything")));
+  EXPECT_TRUE(symbol_set{}.may_contain(symbol_set{}));
+}
+
+TEST(FreeSymbols, CompoundNodesTakeTheUnion) {
+  auto [x, y, z] = make_scalar_variable("x", "y", "z");
+  auto const xy = symbol_set::of("x") | symbol_set::of("y");
+  EXPECT_EQ((sin(x) * pow(y, 2)).get().free_symbols(), xy);
+  EXPECT_EQ((3 * x + y).get().free_symbols(), xy);
+  EXPECT_TRUE((x + y).get().free_symbols().may_contain(symbol_set::of("y")));
+
+  auto [X] = make_tensor_variable(std::tuple{"X", 3, 2});
+  auto t2s = trace(X) * z;
+  EXPECT_EQ(t2s.get().free_symbols(),
+            symbol_set::of("X") | symbol_set::of("z"));
+  EXPECT_TRUE(make_expression<identity_tensor>(3, std::size_t{2})
+                  .get()
+                  .free_symbols()
+                  .empty());
+}
+
+TEST(FreeSymbols, ContainmentFilterAgreesWithTheWalk) {
+  auto [x, y, z] = make_scalar_variable("x", "y", "z");
+  auto e = exp(x * y) + sin(y);
+  EXPECT_TRUE(contains_expression(e, x));
+  EXPECT_TRUE(contains_expression(e, x * y));
+  EXPECT_FALSE(contains_expression(e, z));
+  EXPECT_FALSE(contains_expression(e, x * z));
+
+  auto [X, Y] = make_tensor_variable(std::tuple{"X", 3, 2},
+                                     std::tuple{"Y", 3, 2});
+  EXPECT_TRUE(depends_on_tensor(trace(X) + norm(X), X));
+  EXPECT_FALSE(depends_on_tensor(trace(X) + norm(X), Y));
+}
+
+TEST(FreeSymbols, DiffOfIndependentSubtreesIsZero) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  EXPECT_EQ(diff(sin(y) * exp(y), x), get_scalar_zero());
+  EXPECT_EQ(diff(sin(y) * x, x), sin(y));
+
+  auto [X, Y] = make_tensor_variable(std::tuple{"X", 3, 2},
+                                     std::tuple{"Y", 3, 2});
+  auto const dY = diff(trace(Y), X);
+  ASSERT_TRUE(is_same<tensor_zero>(dY));
+  EXPECT_EQ(dY.get().rank(), 2u);
+  EXPECT_TRUE(is_same<tensor_zero>(diff(Y * Y, X)));
+  EXPECT_EQ(diff(Y * Y, X).get().rank(), 4u);
+}
+
+} // namespace numsim::cas::free_symbols_test
+
+#endif // FREESYMBOLSTEST_H
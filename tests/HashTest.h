@@ -0,0 +1,87 @@
+#ifndef HASHTEST_H
+#define HASHTEST_H
+
+// Tests for expression hashing (core/hash_functions.h).
+//
+// Coverage scope:
+//   - value normalisation: numerically equal constants hash alike.
+//   - the bulk string hash sees every byte of a name.
+//   - symbol leaf hashes keep the alphabetical print order and never merge
+//     distinct names, even when they share the ordered prefix.
+//   - the commutative child accumulator behind n_ary_tree is order
+//     independent and undoes cleanly on erase.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <numsim_cas/core/hash_functions.h>
+#include <numsim_cas/numsim_cas.h>
+#include <string>
+
+namespace numsim::cas::hash_test {
+
+TEST(Hash, IntegralDoublesHashLikeIntegers) {
+  std::size_t i = 0, d = 0, f = 0, nz = 0, z = 0;
+  hash_combine(i, std::int64_t{2});
+  hash_combine(d, 2.0);
+  hash_combine(f, 2.5);
+  hash_combine(nz, -0.0);
+  hash_combine(z, 0);
+  EXPECT_EQ(i, d);
+  EXPECT_NE(d, f);
+  EXPECT_EQ(nz, z);
+
+  auto c_int = make_expression<scalar_constant>(scalar_number{std::int64_t{2}});
+  auto c_dbl = make_expression<scalar_constant>(scalar_number{2.0});
+  EXPECT_EQ(c_int.get().hash_value(), c_dbl.get().hash_value());
+}
+
+TEST(Hash, StringHashSeesEveryByte) {
+  std::string const base = "a_rather_long_symbol_name_";
+  std::size_t h1 = 0, h2 = 0, h3 = 0;
+  hash_combine(h1, base + "1");
+  hash_combine(h2, base + "2");
+  hash_combine(h3, base);
+  EXPECT_NE(h1, h2);
+  EXPECT_NE(h1, h3);
+}
+
+TEST(Hash, SymbolsKeepAlphabeticalOrderAndCompareByName) {
+  auto [a, b, x, s1, s2] =
+      make_scalar_variable("a", "b", "x", "sigma_1", "sigma_2");
+  EXPECT_LT(a, b);
+  EXPECT_LT(b, x);
+  EXPECT_LT(a.get().hash_value(), s1.get().hash_value());
+  EXPECT_NE(s1, s2);
+  EXPECT_EQ(s1, make_expression<scalar>("sigma_1"));
+  EXPECT_EQ(to_string(x + b + a), "a+b+x");
+}
+
+TEST(Hash, CommutativeAccumulatorIsOrderIndependent) {
+  auto [a, b, c] = make_scalar_variable("a", "b", "c");
+  detail::n_ary_child_map<expression_holder<scalar_expression>> abc, cab;
+  for (auto const &e : {a, b, c})
+    abc.insert(e);
+  for (auto const &e : {c, a, b})
+    cab.insert(e);
+  EXPECT_EQ(abc.children_hash(), cab.children_hash());
+
+  detail::n_ary_child_map<expression_holder<scalar_expression>> ab;
+  ab.insert(a);
+  ab.insert(b);
+  EXPECT_NE(ab.children_hash(), abc.children_hash());
+  EXPECT_EQ(abc.erase(c), 1u);
+  EXPECT_EQ(ab.children_hash(), abc.children_hash());
+
+  // Duplicate insertion is rejected and leaves the hash untouched.
+  EXPECT_FALSE(ab.insert(a).second);
+  EXPECT_EQ(ab.children_hash(), abc.children_hash());
+
+  // Nodes built in any order hash alike.
+  EXPECT_EQ((a + b + c).get().hash_value(), (c + a + b).get().hash_value());
+  EXPECT_EQ((a * b * c).get().hash_value(), (b * c * a).get().hash_value());
+}
+
+} // namespace numsim::cas::hash_test
+
+#endif // HASHTEST_H
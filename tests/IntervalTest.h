@@ -0,0 +1,166 @@
+#ifndef INTERVALTEST_H
+#define INTERVALTEST_H
+
+#include <cmath>
+#include <gtest/gtest.h>
+#include <numbers>
+
+#include <numsim_cas/core/interval.h>
+#include <numsim_cas/numsim_cas.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+#include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
+
+namespace numsim::cas {
+
+namespace {
+using ival = interval<double>;
+
+void expect_encloses(ival const &range, double value) {
+  EXPECT_LE(range.lower(), value) << range << " vs " << value;
+  EXPECT_GE(range.upper(), value) << range << " vs " << value;
+}
+} // namespace
+
+TEST(Interval, ArithmeticIsExactWhenRepresentable) {
+  EXPECT_EQ(ival(1, 2) + ival(3, 4), ival(4, 6));
+  EXPECT_EQ(ival(-1, 2) * ival(-3, 4), ival(-6, 8));
+  EXPECT_EQ(ival(1, 2) / ival(4, 8), ival(0.125, 0.5));
+  EXPECT_EQ(ival(1, 2) - ival(3, 4), ival(-3, -1));
+  EXPECT_EQ(sqrt(ival(4, 9)), ival(2, 3));
+}
+
+TEST(Interval, RoundsOutwardWhenInexact) {
+  auto const sum = ival(0.1) + ival(0.2);
+  EXPECT_LT(sum.lower(), sum.upper());
+  EXPECT_EQ(std::nextafter(sum.lower(), 1.0), sum.upper());
+  auto const third = ival(1) / ival(3);
+  EXPECT_LT(third.lower(), third.upper());
+  expect_encloses(third * 3.0, 1.0);
+}
+
+TEST(Interval, SharpElementaryFunctions) {
+  EXPECT_EQ(abs(ival(-2, 1)), ival(0, 2));
+  EXPECT_EQ(sign(ival(-1, 2)), ival(-1, 1));
+  EXPECT_EQ(sign(ival(0.5, 2)), ival(1));
+  EXPECT_EQ(max(ival(-1, 2), ival(0, 1)), ival(0, 2));
+  EXPECT_EQ(min(ival(-1, 2), ival(0, 1)), ival(-1, 1));
+
+  auto const sq = pow(ival(-2, 3), ival(2));
+  EXPECT_EQ(sq.lower(), 0.0);
+  expect_encloses(sq, 9.0);
+  EXPECT_LT(sq.upper(), 9.0 + 1e-12);
+  auto const cube = pow(ival(-2, 3), ival(3));
+  expect_encloses(cube, -8.0);
+  expect_encloses(cube, 27.0);
+
+  auto const s = sin(ival(0.1, 3.0));
+  EXPECT_EQ(s.upper(), 1.0); // passes pi/2
+  EXPECT_NEAR(s.lower(), std::sin(0.1), 1e-12); // sin(0.1) < sin(3)
+  auto const c = cos(ival(-0.5, 4.0));
+  EXPECT_EQ(c.upper(), 1.0);  // passes 0
+  EXPECT_EQ(c.lower(), -1.0); // passes pi
+  EXPECT_EQ(sin(ival(0, 10)), ival(-1, 1));
+
+  auto const e = exp(ival(0, 1));
+  expect_encloses(e, 1.0);
+  expect_encloses(e, std::numbers::e);
+  auto const r = pow(ival(1, 4), ival(0.5, 1.5));
+  expect_encloses(r, 1.0);
+  expect_encloses(r, 8.0);
+}
+
+TEST(Interval, DomainViolationsThrow) {
+  EXPECT_THROW(log(ival(-1, 1)), evaluation_error);
+  EXPECT_THROW(log(ival(0, 1)), evaluation_error);
+  EXPECT_THROW(sqrt(ival(-1e-12, 1)), evaluation_error);
+  EXPECT_THROW(ival(1) / ival(-1, 1), evaluation_error);
+  EXPECT_THROW(pow(ival(-1, 1), ival(-1)), evaluation_error);
+  EXPECT_THROW(pow(ival(-1, 1), ival(0.5)), evaluation_error);
+  EXPECT_THROW(asin(ival(0, 1.5)), evaluation_error);
+  EXPECT_THROW(tan(ival(1, 2)), evaluation_error);
+  EXPECT_THROW(ival(2, 1), evaluation_error);
+  EXPECT_NO_THROW(sqrt(ival(0, 1)));
+}
+
+TEST(Interval, ComparisonIndicators) {
+  EXPECT_EQ(interval_lt(ival(0, 1), ival(2, 3)), ival(1));
+  EXPECT_EQ(interval_lt(ival(2, 3), ival(0, 2)), ival(0));
+  EXPECT_EQ(interval_lt(ival(0, 2), ival(1, 3)), ival(0, 1));
+  EXPECT_EQ(interval_eq(ival(1), ival(1)), ival(1));
+  EXPECT_EQ(interval_eq(ival(0, 1), ival(0, 1)), ival(0, 1));
+}
+
+TEST(Interval, ScalarEvaluatorEnclosesSamples) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  scalar_evaluator<ival> iev;
+  iev.set(x, ival(0.5, 2.0));
+  iev.set(y, ival(-1.0, 1.0));
+  auto expr = log(x) + sqrt(x) * pow(y, 2) - abs(y) / x +
+              make_expression<scalar_constant>(rational_t{1, 3});
+  auto const range = iev.apply(expr);
+
+  scalar_evaluator<double> ev;
+  for (double xv : {0.5, 0.7, 1.0, 1.5, 2.0})
+    for (double yv : {-1.0, -0.3, 0.0, 0.4, 1.0}) {
+      ev.set(x, xv);
+      ev.set(y, yv);
+      expect_encloses(range, ev.apply(expr));
+    }
+
+  // log(y) is not defined on [-1, 1]: the proof fails.
+  EXPECT_THROW(iev.apply(log(y)), evaluation_error);
+}
+
+TEST(Interval, ScalarEvaluatorBranches) {
+  auto [x] = make_scalar_variable("x");
+  scalar_evaluator<ival> ev;
+  auto guarded = if_then_else(gt(x, make_scalar_constant(0)), log(x),
+                              make_scalar_constant(-10));
+
+  ev.set(x, ival(0.5, 2.0)); // condition certainly true: only log(x)
+  auto const taken = ev.apply(guarded);
+  EXPECT_GT(taken.lower(), -1.0);
+
+  ev.set(x, ival(-1.0, -0.5)); // certainly false: log(x) never evaluated
+  EXPECT_EQ(ev.apply(guarded), ival(-10));
+
+  ev.set(x, ival(-1.0, 1.0)); // undecided: both arms, log(x) throws
+  EXPECT_EQ(ev.apply(gt(x, make_scalar_constant(0))), ival(0, 1));
+  EXPECT_THROW(ev.apply(guarded), evaluation_error);
+
+  auto safe = if_then_else(gt(x, make_scalar_constant(0)), x * x,
+                           -x);
+  auto const hull_range = ev.apply(safe);
+  expect_encloses(hull_range, 1.0);
+  expect_encloses(hull_range, -1.0);
+}
+
+TEST(Interval, T2sEvaluatorOverInvariantRanges) {
+  auto E = make_expression<tensor>("E", 3, 2);
+  auto [k] = make_scalar_variable("k");
+  auto I1 = trace(E);
+  auto J2 = norm(dev(E));
+  auto yield = J2 - k * log(1 + I1);
+
+  tensor_to_scalar_evaluator<ival> ev;
+  ev.set_t2s(I1, ival(-0.01, 0.02));
+  ev.set_t2s(J2, ival(0.0, 0.05));
+  ev.set_scalar(k, ival(0.1));
+  auto const range = ev.apply(yield);
+  expect_encloses(range, 0.05 - 0.1 * std::log(0.99));
+  expect_encloses(range, -0.1 * std::log(1.02));
+
+  EXPECT_THROW(ev.apply(log(I1)), evaluation_error); // I1 may be <= 0
+  EXPECT_THROW(ev.apply(det(E)), evaluation_error);  // not bound
+}
+
+TEST(Interval, T2sBindingOverridesDoubleEvaluation) {
+  auto E = make_expression<tensor>("E", 3, 2);
+  tensor_to_scalar_evaluator<double> ev;
+  ev.set_t2s(trace(E), 2.0);
+  EXPECT_DOUBLE_EQ(ev.apply(trace(E) * trace(E) + 1), 5.0);
+}
+
+} // namespace numsim::cas
+
+#endif // INTERVALTEST_H
@@ -0,0 +1,215 @@
+#ifndef KERNELCACHETEST_H
+#define KERNELCACHETEST_H
+
+// kernel_cache lowers tensor models with make_kernel_program and compiles
+// them like scalar_kernel_cache. The reference values come from the
+// evaluators with the same flat input array bound as views; the
+// file/statistics checks only run for native kernels.
+
+#include <cmath>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include <numsim_cas/core/cas_error.h>
+#include <numsim_cas/core/diff.h>
+#include <numsim_cas/eigen_decomposition.h>
+#include <numsim_cas/kernel_cache.h>
+#include <numsim_cas/kernel_program.h>
+#include <numsim_cas/numsim_cas.h>
+#include <numsim_cas/tensor/tensor_diff.h>
+
+namespace numsim::cas {
+
+namespace {
+using kernel_exprs_t = std::vector<kernel_expression>;
+
+std::vector<double> evaluate_reference(kernel_exprs_t const &outputs,
+                                       kernel_exprs_t const &inputs,
+                                       std::vector<double> const &in) {
+  scalar_evaluator<double> scalars;
+  tensor_evaluator<double> tensors;
+  tensor_to_scalar_evaluator<double> t2s;
+  auto const *value = in.data();
+  for (auto const &input : inputs) {
+    if (auto const *s =
+            std::get_if<expression_holder<scalar_expression>>(&input)) {
+      scalars.set(*s, *value);
+      tensors.set_scalar(*s, *value);
+      t2s.set_scalar(*s, *value);
+    } else {
+      auto const &t = std::get<expression_holder<tensor_expression>>(input);
+      tensors.set_view(t, value);
+      t2s.set_view(t, value);
+    }
+    value += kernel_size(input);
+  }
+  std::vector<double> out;
+  for (auto const &output : outputs) {
+    auto const offset = out.size();
+    out.resize(offset + kernel_size(output));
+    if (auto const *s =
+            std::get_if<expression_holder<scalar_expression>>(&output))
+      out[offset] = scalars.apply(*s);
+    else if (auto const *f = std::get_if<
+                 expression_holder<tensor_to_scalar_expression>>(&output))
+      out[offset] = t2s.apply(*f);
+    else
+      tensors.apply_into(std::get<expression_holder<tensor_expression>>(output),
+                         out.data() + offset);
+  }
+  return out;
+}
+
+void expect_matches_evaluators(scalar_kernel const &kernel,
+                               kernel_exprs_t const &outputs,
+                               kernel_exprs_t const &inputs,
+                               std::vector<double> const &in) {
+  auto const expected = evaluate_reference(outputs, inputs, in);
+  ASSERT_EQ(kernel.outputs(), expected.size());
+  std::vector<double> out(expected.size());
+  kernel(in.data(), out.data());
+  for (std::size_t j{0}; j < out.size(); ++j)
+    EXPECT_NEAR(out[j], expected[j], 1e-11 * (1 + std::abs(expected[j])))
+        << "output component " << j;
+}
+
+// A stretch with a little shear, followed by the given scalars.
+std::vector<double> right_cauchy_green(std::size_t dim,
+                                       std::vector<double> scalars) {
+  std::vector<double> in(dim * dim, 0.0);
+  for (std::size_t i{0}; i < dim; ++i)
+    in[i * dim + i] = 1.1 + 0.15 * static_cast<double>(i);
+  in[1] = in[dim] = 0.2;
+  in.insert(in.end(), scalars.begin(), scalars.end());
+  return in;
+}
+} // namespace
+
+class KernelCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() /
+            ("numsim_cas_kernels_" + std::to_string(std::random_device{}()));
+  }
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(m_dir, ec);
+  }
+
+  scalar_kernel_cache_options options() const {
+    scalar_kernel_cache_options opts;
+    opts.directory = m_dir;
+    return opts;
+  }
+
+  // Compressible Neo-Hooke in the right Cauchy-Green tensor: energy,
+  // second Piola-Kirchhoff stress and tangent, built fresh on every call.
+  static std::pair<kernel_exprs_t, kernel_exprs_t> model(std::size_t dim) {
+    auto [C] = make_tensor_variable(std::tuple{"C", dim, std::size_t{2}});
+    auto [mu, lambda] = make_scalar_variable("mu", "lambda");
+    auto const lnJ = log(det(C)) / 2;
+    auto const psi = mu / 2 * (trace(C) - static_cast<double>(dim)) -
+                     mu * lnJ + lambda / 2 * pow(lnJ, 2);
+    auto const S = 2 * diff(psi, C);
+    return {{psi, S, 2 * diff(S, C)}, {C, mu, lambda}};
+  }
+
+  std::filesystem::path m_dir;
+};
+
+TEST_F(KernelCacheTest, CompilesOnceAndLoadsFromDisk) {
+  auto const [outputs, inputs] = model(3);
+  auto const in = right_cauchy_green(3, {0.8, 1.7});
+  {
+    kernel_cache cache(options());
+    auto const kernel = cache.load(outputs, inputs);
+    EXPECT_EQ(kernel.inputs(), 11u);
+    EXPECT_EQ(kernel.outputs(), 1u + 9u + 81u);
+    expect_matches_evaluators(kernel, outputs, inputs, in);
+    if (!kernel.is_native())
+      GTEST_SKIP() << "no C compiler or dlopen";
+
+    EXPECT_EQ(cache.stats().compiled, 1u);
+    auto const key = cache.key(outputs, inputs);
+    EXPECT_TRUE(std::filesystem::exists(m_dir / (key + ".so")));
+
+    (void)cache.load(outputs, inputs);
+    EXPECT_EQ(cache.stats().memory_hits, 1u);
+  }
+
+  auto const [outputs2, inputs2] = model(3);
+  kernel_cache cache(options());
+  auto const kernel = cache.load(outputs2, inputs2);
+  EXPECT_TRUE(kernel.is_native());
+  EXPECT_EQ(cache.stats().disk_hits, 1u);
+  EXPECT_EQ(cache.stats().compiled, 0u);
+  expect_matches_evaluators(kernel, outputs2, inputs2, in);
+}
+
+TEST_F(KernelCacheTest, PlaneModelIsItsOwnEntry) {
+  auto const [outputs, inputs] = model(2);
+  kernel_cache cache(options());
+  auto const kernel = cache.load(outputs, inputs);
+  EXPECT_EQ(kernel.inputs(), 6u);
+  EXPECT_EQ(kernel.outputs(), 1u + 4u + 16u);
+  expect_matches_evaluators(kernel, outputs, inputs,
+                            right_cauchy_green(2, {0.8, 1.7}));
+}
+
+TEST_F(KernelCacheTest, KeyCoversDimensionAndInputs) {
+  auto const [outputs, inputs] = model(3);
+  auto const [outputs2, inputs2] = model(3);
+  auto const [outputs_2d, inputs_2d] = model(2);
+  kernel_cache cache(options());
+  auto const key = cache.key(outputs, inputs);
+  EXPECT_EQ(key.size(), 16u);
+  EXPECT_EQ(cache.key(outputs2, inputs2), key);
+  EXPECT_NE(cache.key(outputs_2d, inputs_2d), key);
+  EXPECT_NE(cache.key(outputs, {inputs[0], inputs[2], inputs[1]}), key);
+  EXPECT_NE(cache.key({outputs[0], outputs[1]}, inputs), key);
+}
+
+TEST_F(KernelCacheTest, TensorProductsMatchEvaluators) {
+  auto [A, B] = make_tensor_variable(std::tuple{"A", 3, 2},
+                                     std::tuple{"B", 3, 2});
+  auto [x, y] = make_scalar_variable("x", "y");
+  kernel_exprs_t const outputs{dev(A),
+                               A * B,
+                               otimes(A, B),
+                               otimesu(A, B),
+                               trans(A),
+                               inv(A),
+                               pow(A, 3),
+                               sym(A) + x * skew(B),
+                               if_then_else(lt(x, y), A, B),
+                               dot(A) + norm(B) * x,
+                               second_invariant(A)};
+  kernel_exprs_t const inputs{A, B, x, y};
+  std::vector<double> in{2.0, 0.3, -0.1, 0.4, 1.5, 0.2, 0.1, -0.3, 1.2,
+                         0.7, 1.1, 0.5,  -0.2, 0.9, 1.3, 0.6, 0.4, -0.8};
+  in.insert(in.end(), {0.3, 0.5});
+
+  kernel_cache cache(options());
+  auto const kernel = cache.load(outputs, inputs);
+  expect_matches_evaluators(kernel, outputs, inputs, in);
+  in[18] = 0.9;
+  expect_matches_evaluators(kernel, outputs, inputs, in);
+}
+
+TEST_F(KernelCacheTest, RejectsUnsupportedNodesAndForeignSymbols) {
+  auto [A, B] = make_tensor_variable(std::tuple{"A", 3, 2},
+                                     std::tuple{"B", 3, 2});
+  kernel_cache cache(options());
+  EXPECT_THROW((void)cache.load({eigen_decomposition(A).value(0)}, {A}),
+               invalid_expression_error);
+  EXPECT_THROW((void)cache.load({A * B}, {A}), invalid_expression_error);
+  EXPECT_THROW((void)cache.load({A}, {A * B}), invalid_expression_error);
+  EXPECT_THROW((void)make_kernel_program({A}, {A, A}),
+               invalid_expression_error);
+}
+
+} // namespace numsim::cas
+
+#endif // KERNELCACHETEST_H
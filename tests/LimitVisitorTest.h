@@ -3,8 +3,11 @@
 
 #include <gtest/gtest.h>
 
+#include "cas_test_helpers.h"
+
 #include <numsim_cas/basic_functions.h>
 #include <numsim_cas/core/contains_expression.h>
+#include <numsim_cas/core/limit_cache.h>
 #include <numsim_cas/core/limit_result.h>
 #include <numsim_cas/scalar/scalar_all.h>
 #include <numsim_cas/scalar/scalar_operators.h>
@@ -444,6 +447,79 @@ TEST(T2sLimit, NeoHookeanCompressionLimit) {
   EXPECT_EQ(result.dir, dir::pos_infinity);
 }
 
+// ═══════════════════════════════════════════════════════════════════
+// Memoization
+// ═══════════════════════════════════════════════════════════════════
+
+TEST(LimitCache, SharedSubtreesCachedPerTarget) {
+  auto x = make_expression<scalar>("x");
+  auto const e = testcas::shared_levels(
+      expression_holder<scalar_expression>{x}, 48,
+      [](auto const &level) { return log(level) + exp(level); });
+
+  limit_cache cache;
+  auto const result =
+      scalar_limit_visitor(x, {pt::pos_infinity}, &cache).apply(e);
+  EXPECT_EQ(result.dir, dir::pos_infinity);
+  EXPECT_EQ(result.rate.rate, gtype::exponential);
+  // One entry per distinct node (x itself is answered before the cache).
+  EXPECT_EQ(cache.size(), 3u * 48u);
+
+  // A second target gets entries of its own; asking again adds none.
+  (void)scalar_limit_visitor(x, {pt::zero_plus}, &cache).apply(e);
+  EXPECT_EQ(cache.size(), 2u * 3u * 48u);
+  EXPECT_EQ(scalar_limit_visitor(x, {pt::pos_infinity}, &cache).apply(e).dir,
+            dir::pos_infinity);
+  EXPECT_EQ(cache.size(), 2u * 3u * 48u);
+}
+
+TEST(LimitCache, ReusedAcrossTargetsAndVariables) {
+  auto x = make_expression<scalar>("x");
+  auto y = make_expression<scalar>("y");
+  auto e = log(x) + pow(y, 2) * exp(x);
+
+  limit_cache cache;
+  scalar_limit_visitor at_zero(x, {pt::zero_plus}, &cache);
+  scalar_limit_visitor at_inf(x, {pt::pos_infinity}, &cache);
+  scalar_limit_visitor y_inf(y, {pt::pos_infinity}, &cache);
+  auto const zero = at_zero.apply(e);
+  auto const inf = at_inf.apply(e);
+  auto const yinf = y_inf.apply(e);
+  auto const entries = cache.size();
+
+  // Same answers as uncached visitors; repeated queries add nothing.
+  EXPECT_EQ(zero.dir, scalar_limit_visitor(x, {pt::zero_plus}).apply(e).dir);
+  EXPECT_EQ(inf.dir, scalar_limit_visitor(x, {pt::pos_infinity}).apply(e).dir);
+  EXPECT_EQ(yinf.dir, scalar_limit_visitor(y, {pt::pos_infinity}).apply(e).dir);
+  EXPECT_EQ(at_zero.apply(e).dir, zero.dir);
+  EXPECT_EQ(scalar_limit_visitor(x, {pt::pos_infinity}, &cache).apply(e).dir,
+            inf.dir);
+  EXPECT_EQ(cache.size(), entries);
+  EXPECT_EQ(zero.dir, dir::neg_infinity);
+  EXPECT_EQ(inf.dir, dir::pos_infinity);
+}
+
+TEST(LimitCache, T2sModesShareOneCache) {
+  auto F = make_expression<tensor>("F", 3, 2);
+  auto J = det(F);
+  auto mu =
+      make_expression<tensor_to_scalar_scalar_wrapper>(make_scalar_constant(1));
+  auto W = -(mu * log(J)) + norm(F);
+
+  limit_cache cache;
+  tensor_to_scalar_limit_visitor exact(J, {pt::zero_plus}, &cache);
+  tensor_to_scalar_limit_visitor dependent(F, {pt::pos_infinity}, &cache);
+  auto const a = exact.apply(W);
+  auto const b = dependent.apply(W);
+  EXPECT_EQ(a.dir, tensor_to_scalar_limit_visitor(J, {pt::zero_plus})
+                       .apply(W)
+                       .dir);
+  EXPECT_EQ(b.dir, tensor_to_scalar_limit_visitor(F, {pt::pos_infinity})
+                       .apply(W)
+                       .dir);
+  EXPECT_EQ(exact.apply(W).dir, a.dir);
+}
+
 } // namespace numsim::cas
 
 #endif // LIMITVISITORTEST_H
@@ -0,0 +1,106 @@
+#ifndef NODEHEADERTEST_H
+#define NODEHEADERTEST_H
+
+// Tests for the node header stored in the expression base (type id,
+// domain, symbol / number / scaled flags).
+//
+// Coverage scope:
+//   - id() matches the static get_id() of every kind of node, domain()
+//     matches the node's domain.
+//   - flags for symbols, numbers, n-ary trees and tensor_scalar_mul; the
+//     t2s scalar wrapper forwards its payload's flags.
+//   - copies keep the header; like-term merging still goes through
+//     like_term_of for scaled nodes.
+
+#include <gtest/gtest.h>
+
+#include <numsim_cas/numsim_cas.h>
+#include <tuple>
+
+namespace numsim::cas::node_header_test {
+
+TEST(NodeHeader, IdAndDomainMatchTheNodeType) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto [X] = make_tensor_variable(std::tuple{"X", 3, 2});
+
+  EXPECT_EQ(x.get().id(), scalar::get_id());
+  EXPECT_EQ((x + y).get().id(), scalar_add::get_id());
+  EXPECT_EQ((x * y).get().id(), scalar_mul::get_id());
+  EXPECT_EQ(sin(x).get().id(), scalar_sin::get_id());
+  EXPECT_EQ(make_scalar_constant(3).get().id(), scalar_constant::get_id());
+  EXPECT_EQ(x.get().domain(), expression_domain::scalar);
+
+  EXPECT_EQ(X.get().id(), tensor::get_id());
+  EXPECT_EQ((X + X * X).get().id(), tensor_add::get_id());
+  EXPECT_EQ(X.get().domain(), expression_domain::tensor);
+
+  auto const t = trace(X);
+  EXPECT_EQ(t.get().id(), tensor_trace::get_id());
+  EXPECT_EQ(t.get().domain(), expression_domain::tensor_to_scalar);
+}
+
+TEST(NodeHeader, SymbolNumberAndScaledFlags) {
+  auto [x] = make_scalar_variable("x");
+  auto [X] = make_tensor_variable(std::tuple{"X", 3, 2});
+
+  EXPECT_TRUE(x.get().is_symbol());
+  EXPECT_FALSE(x.get().is_number());
+  EXPECT_TRUE(X.get().is_symbol());
+
+  EXPECT_TRUE(get_scalar_zero().get().is_number());
+  EXPECT_TRUE(get_scalar_one().get().is_number());
+  EXPECT_TRUE(make_scalar_constant(3).get().is_number());
+  EXPECT_FALSE(make_scalar_constant(-3).get().is_number());
+  EXPECT_FALSE(sin(x).get().is_number());
+
+  EXPECT_TRUE((2 * x).get().is_scaled());
+  EXPECT_TRUE((x + 1).get().is_scaled());
+  EXPECT_FALSE(x.get().is_scaled());
+  EXPECT_TRUE(make_expression<tensor_scalar_mul>(x, X).get().is_scaled());
+}
+
+TEST(NodeHeader, ScalarWrapperForwardsPayloadFlags) {
+  auto [x] = make_scalar_variable("x");
+  auto const wrapped_symbol =
+      make_expression<tensor_to_scalar_scalar_wrapper>(x);
+  auto const wrapped_number = make_expression<tensor_to_scalar_scalar_wrapper>(
+      make_scalar_constant(2));
+  auto const wrapped_sin =
+      make_expression<tensor_to_scalar_scalar_wrapper>(sin(x));
+
+  EXPECT_TRUE(wrapped_symbol.get().is_symbol());
+  EXPECT_FALSE(wrapped_symbol.get().is_number());
+  EXPECT_TRUE(wrapped_number.get().is_number());
+  EXPECT_FALSE(wrapped_sin.get().is_symbol());
+  EXPECT_FALSE(wrapped_sin.get().is_number());
+  EXPECT_EQ(wrapped_sin.get().id(), tensor_to_scalar_scalar_wrapper::get_id());
+}
+
+TEST(NodeHeader, CopiesKeepTheHeader) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const sum = x + y;
+  auto const copy = make_expression<scalar_add>(sum.get<scalar_add>());
+  EXPECT_EQ(copy.get().id(), scalar_add::get_id());
+  EXPECT_TRUE(copy.get().is_scaled());
+  EXPECT_EQ(copy, sum);
+
+  auto const c = make_scalar_constant(5);
+  auto const c_copy =
+      make_expression<scalar_constant>(c.get<scalar_constant>());
+  EXPECT_TRUE(c_copy.get().is_number());
+  EXPECT_EQ(c_copy, c);
+}
+
+TEST(NodeHeader, LikeTermsStillMerge) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  EXPECT_EQ(x + 2 * x, 3 * x);
+  EXPECT_EQ(2 * x * y + x * y, 3 * x * y);
+  EXPECT_EQ(x + y + x, 2 * x + y);
+
+  auto [X] = make_tensor_variable(std::tuple{"X", 3, 2});
+  EXPECT_EQ(x * X + X, (x + 1) * X);
+}
+
+} // namespace numsim::cas::node_header_test
+
+#endif // NODEHEADERTEST_H
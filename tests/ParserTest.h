@@ -26,6 +26,8 @@
 #include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_evaluator.h>
 
 #include <cmath>
+#include <filesystem>
+#include <fstream>
 #include <locale>
 #include <memory>
 #include <stdexcept>
@@ -40,7 +42,9 @@ namespace numsim::cas::parser_test {
 using numsim::cas::parser::arity_error;
 using numsim::cas::parser::lexical_error;
 using numsim::cas::parser::parse;
+using numsim::cas::parser::parse_all;
 using numsim::cas::parser::parse_error;
+using numsim::cas::parser::parse_file;
 using numsim::cas::parser::parse_scalar;
 using numsim::cas::parser::parse_t2s;
 using numsim::cas::parser::parse_tensor;
@@ -2147,6 +2151,84 @@ TEST(ParserFunctions, SpectralConstructionErrorsPropagate) {
       invalid_expression_error); // index out of range
 }
 
+// ─── parse_all: `;`-separated statement lists ──────────────────────
+
+TEST(ParserBatch, ParsesStatementsInOrderWithSharedTable) {
+  symbol_table st;
+  auto batch = parse_all("C{rank=2, dim=3}; trace(C) * 2;\n\n det(C) ;", st);
+  ASSERT_EQ(batch.expressions.size(), 3u);
+  EXPECT_TRUE(std::holds_alternative<
+              numsim::cas::expression_holder<numsim::cas::tensor_expression>>(
+      batch.expressions[0]));
+  EXPECT_TRUE(std::holds_alternative<numsim::cas::expression_holder<
+                  numsim::cas::tensor_to_scalar_expression>>(
+      batch.expressions[2]));
+  EXPECT_EQ(batch.statistics.statements, 3u);
+  EXPECT_GT(batch.statistics.bytes, 0u);
+  EXPECT_TRUE(st.has("C"));
+}
+
+TEST(ParserBatch, EmptyInputAndEmptyStatements) {
+  symbol_table st;
+  EXPECT_TRUE(parse_all("", st).expressions.empty());
+  EXPECT_EQ(parse_all(" ; x ;; y; ", st).expressions.size(), 2u);
+}
+
+TEST(ParserBatch, MatchesSingleStatementParse) {
+  symbol_table st;
+  auto batch = parse_all("sin(x)^2 + cos(x)^2; a*x + b", st);
+  ASSERT_EQ(batch.expressions.size(), 2u);
+  EXPECT_EQ(batch.expressions[1], parse("a*x + b", st));
+}
+
+TEST(ParserBatch, FailureRollsBackWholeBatch) {
+  symbol_table st;
+  try {
+    [[maybe_unused]] auto b =
+        parse_all("A{rank=2, dim=3};\nB{rank=2, dim=3} +", st);
+    FAIL() << "expected a parse error";
+  } catch (parse_error const &e) {
+    EXPECT_EQ(e.line(), 2u);
+  }
+  EXPECT_FALSE(st.has("A"));
+  EXPECT_FALSE(st.has("B"));
+}
+
+TEST(ParserBatch, StatementsNeedSeparators) {
+  symbol_table st;
+  try {
+    [[maybe_unused]] auto b = parse_all("x + 1;\ny z", st);
+    FAIL() << "expected a parse error";
+  } catch (parse_error const &e) {
+    EXPECT_EQ(e.line(), 2u);
+  }
+}
+
+TEST(ParserBatch, ParseFileMatchesParseAll) {
+  auto const path = std::filesystem::temp_directory_path() /
+                    "numsim_cas_parser_batch_test.cas";
+  std::string const source = "F{rank=2, dim=3};\n2*trace(F);\nmu*det(F)\n";
+  std::ofstream(path) << source;
+  symbol_table st;
+  auto const from_file = parse_file(path, st);
+  std::filesystem::remove(path);
+  ASSERT_EQ(from_file.expressions.size(), 3u);
+  EXPECT_EQ(from_file.statistics.bytes, source.size());
+  EXPECT_TRUE(st.has("F"));
+  EXPECT_TRUE(st.has("mu"));
+
+  auto const from_string = parse_all(source, st);
+  for (std::size_t i{0}; i < 3; ++i)
+    EXPECT_EQ(from_file.expressions[i], from_string.expressions[i]);
+}
+
+TEST(ParserBatch, MissingFileThrows) {
+  symbol_table st;
+  EXPECT_THROW(
+      { [[maybe_unused]] auto b = parse_file("/nonexistent/defs.cas", st); },
+      parse_error);
+}
+
 } // namespace numsim::cas::parser_test
 
 #endif // NUMSIM_CAS_PARSER_ENABLED
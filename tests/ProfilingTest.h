@@ -0,0 +1,101 @@
+#ifndef PROFILINGTEST_H
+#define PROFILINGTEST_H
+
+// Tests for the optional simplifier instrumentation (core/profiling.h).
+//
+// The registry API is compiled in every configuration, so the report /
+// reset tests always run. Counter assertions that need the macros are
+// skipped unless the library was configured with
+// NUMSIM_CAS_ENABLE_PROFILING=ON.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numsim_cas/core/profiling.h>
+#include <numsim_cas/numsim_cas.h>
+
+namespace numsim::cas::profiling_test {
+
+inline std::uint64_t rule_attempts(profiling::snapshot_t const &snap,
+                                   std::string_view name) {
+  auto it = std::ranges::find(snap.rules, name, &profiling::rule_entry::name);
+  return it == snap.rules.end() ? 0 : it->attempts;
+}
+
+inline std::uint64_t rule_hits(profiling::snapshot_t const &snap,
+                               std::string_view name) {
+  auto it = std::ranges::find(snap.rules, name, &profiling::rule_entry::name);
+  return it == snap.rules.end() ? 0 : it->hits;
+}
+
+TEST(Profiling, RegistryCountsAndResets) {
+  auto &c = profiling::rule("profiling_test::manual");
+  profiling::reset();
+  c.attempts += 3;
+  c.hits += 1;
+  auto snap = profiling::snapshot();
+  EXPECT_EQ(rule_attempts(snap, "profiling_test::manual"), 3u);
+  EXPECT_EQ(rule_hits(snap, "profiling_test::manual"), 1u);
+
+  // Same name resolves to the same counter.
+  EXPECT_EQ(&profiling::rule("profiling_test::manual"), &c);
+
+  profiling::reset();
+  snap = profiling::snapshot();
+  EXPECT_EQ(rule_attempts(snap, "profiling_test::manual"), 0u);
+}
+
+TEST(Profiling, ScopeTimerRecordsCall) {
+  auto &d = profiling::dispatch("profiling_test::scope");
+  profiling::reset();
+  { profiling::scope_timer t{d}; }
+  { profiling::scope_timer t{d}; }
+  EXPECT_EQ(d.calls.load(), 2u);
+}
+
+TEST(Profiling, ReportFormats) {
+  profiling::reset();
+  profiling::rule("profiling_test::\"quoted\"").attempts += 1;
+  profiling::allocation("profiling_test_node").count += 2;
+
+  auto const json = profiling::report(profiling::report_format::json);
+  EXPECT_EQ(json.front(), '{');
+  EXPECT_NE(json.find("\"rules\": ["), std::string::npos);
+  EXPECT_NE(json.find("\"dispatch\": ["), std::string::npos);
+  EXPECT_NE(json.find("\"allocations\": ["), std::string::npos);
+  EXPECT_NE(json.find("profiling_test::\\\"quoted\\\""), std::string::npos);
+  EXPECT_NE(json.find("{\"type\": \"profiling_test_node\", \"count\": 2}"),
+            std::string::npos);
+
+  auto const table = profiling::report();
+  EXPECT_NE(table.find("profiling_test_node"), std::string::npos);
+  EXPECT_NE(table.find("attempts"), std::string::npos);
+}
+
+TEST(Profiling, SimplifierPathsAreCounted) {
+  if (!profiling::enabled())
+    GTEST_SKIP() << "built without NUMSIM_CAS_ENABLE_PROFILING";
+
+  auto [x, y] = make_scalar_variable("x", "y");
+  profiling::reset();
+  // x + y + 2*x: the 2*x entry merges with x inside the n-ary add.
+  auto e = x + y + 2 * x;
+  (void)e;
+
+  auto const snap = profiling::snapshot();
+  EXPECT_GT(rule_attempts(snap, "n_ary_tree::merge_or_insert") +
+                rule_attempts(snap, "add_dispatch::try_merge_like"),
+            0u);
+  auto add = std::ranges::find(snap.dispatches, "scalar::add_base",
+                               &profiling::dispatch_entry::name);
+  ASSERT_NE(add, snap.dispatches.end());
+  EXPECT_GE(add->calls, 2u);
+  auto alloc = std::ranges::find(snap.allocations, "scalar_add",
+                                 &profiling::allocation_entry::type_name);
+  ASSERT_NE(alloc, snap.allocations.end());
+  EXPECT_GE(alloc->count, 1u);
+}
+
+} // namespace numsim::cas::profiling_test
+
+#endif // PROFILINGTEST_H
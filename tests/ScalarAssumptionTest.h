@@ -911,4 +911,105 @@ TEST_F(AssumptionFixture, Step6_ScalarAssumeUniformGuardSampling) {
                numsim::cas::invalid_assumption_error);
 }
 
+// ═══════════════════════════════════════════════════════════════════════
+//  Bitset managers
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST(AssumptionManager, InsertImpliedAppliesClosure) {
+  using namespace numsim::cas;
+  numeric_assumption_manager m;
+  m.insert_implied(prime{});
+  for (numeric_assumption tag :
+       {numeric_assumption{prime{}}, numeric_assumption{integer{}},
+        numeric_assumption{rational{}}, numeric_assumption{real_tag{}},
+        numeric_assumption{positive{}}, numeric_assumption{nonnegative{}},
+        numeric_assumption{nonzero{}}})
+    EXPECT_TRUE(m.contains(tag)) << tag.index();
+  EXPECT_EQ(m.data().size(), 7u);
+  EXPECT_FALSE(m.contains(even{}));
+
+  // Plain insert/erase touch one tag only.
+  m.erase(positive{});
+  EXPECT_FALSE(m.contains(positive{}));
+  EXPECT_TRUE(m.contains(nonnegative{}));
+  numeric_assumption_manager plain;
+  plain.insert(even{});
+  EXPECT_EQ(plain.data().size(), 1u);
+}
+
+TEST(AssumptionManager, IteratesInVariantOrder) {
+  using namespace numsim::cas;
+  numeric_assumption_manager m;
+  m.insert(real_tag{});
+  m.insert(negative{});
+  m.insert(odd{});
+  std::vector<std::size_t> order;
+  for (auto const &tag : m.data())
+    order.push_back(tag.index());
+  EXPECT_EQ(order, (std::vector<std::size_t>{
+                       numeric_assumption{negative{}}.index(),
+                       numeric_assumption{odd{}}.index(),
+                       numeric_assumption{real_tag{}}.index()}));
+
+  numeric_assumption_manager other;
+  other.insert(nonzero{});
+  m.merge(other);
+  EXPECT_TRUE(m.contains(nonzero{}));
+  m.clear();
+  EXPECT_TRUE(m.data().empty());
+}
+
+TEST(AssumptionManager, TensorAlgebraClosure) {
+  using namespace numsim::cas;
+  tensor_algebra_assumption_manager m;
+  m.insert_implied(positive_definite{});
+  EXPECT_TRUE(m.contains(positive_semidefinite{}));
+  EXPECT_FALSE(m.contains(orthogonal{}));
+  m.insert_implied(proper_rotation{});
+  EXPECT_FALSE(m.contains(orthogonal{}));
+  EXPECT_EQ(m.data().size(), 3u);
+}
+
+// ═══════════════════════════════════════════════════════════════════════
+//  Inference cache
+// ═══════════════════════════════════════════════════════════════════════
+
+TEST_F(AssumptionFixture, SharedSubtreesReinferredAfterAssumptionChange) {
+  using namespace numsim::cas;
+  auto const e = testcas::shared_levels(
+      scalar_expr{x}, 64, [](scalar_expr const &level) {
+        return pow(level, 3) + exp(level);
+      });
+  x.assumption(positive{});
+  EXPECT_TRUE(is_positive(e));
+  EXPECT_TRUE(e.data()->assumptions().inferred());
+
+  // Every cached level depends on x; a stale one would keep the sum
+  // positive.
+  remove_assumption(x, positive{});
+  remove_assumption(x, nonnegative{});
+  EXPECT_FALSE(is_positive(e));
+  x.assumption(positive{});
+  EXPECT_TRUE(propagate_assumptions(e).contains(positive{}));
+}
+
+TEST_F(AssumptionFixture, InferenceCacheInvalidatedByAssumptionChanges) {
+  using namespace numsim::cas;
+  scalar_expr e = x + y;
+  EXPECT_FALSE(is_positive(e));
+  EXPECT_FALSE(propagate_assumptions(e).contains(positive{}));
+
+  x.assumption(positive{});
+  y.assumption(positive{});
+  EXPECT_TRUE(is_positive(e));
+  EXPECT_TRUE(propagate_assumptions(e).contains(nonzero{}));
+
+  // Removing a fact must not leave the sum's cached positivity behind.
+  remove_assumption(y, positive{});
+  remove_assumption(y, nonnegative{});
+  EXPECT_FALSE(is_positive(e));
+  EXPECT_FALSE(propagate_assumptions(e).contains(positive{}));
+  EXPECT_TRUE(is_positive(x));
+}
+
 #endif // SCALARASSUMPTIONTEST_H
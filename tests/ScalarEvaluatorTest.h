@@ -341,6 +341,27 @@ TEST(ScalarEval, EvaluationErrorCarriesMessage) {
   }
 }
 
+// The switch on the node id has to give the same values and errors as the
+// default accept() path.
+TEST(ScalarEval, DispatchModesAgree) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const expr = sin(x) * pow(y, 3) + exp(-x) / sqrt(y) +
+                    log(abs(x - y) + 2) - cos(x * y) + tan(x / 4);
+
+  scalar_evaluator<double> ev;
+  EXPECT_EQ(ev.dispatch_mode(), evaluator_dispatch::virtual_call);
+  ev.set(x, 0.7);
+  ev.set(y, 1.3);
+  auto const by_accept = ev.apply(expr);
+  ev.set_dispatch(evaluator_dispatch::type_tag);
+  EXPECT_EQ(ev.apply(expr), by_accept);
+
+  auto [z] = make_scalar_variable("z");
+  EXPECT_THROW(ev.apply(x + z), evaluation_error);
+  ev.set_dispatch(evaluator_dispatch::virtual_call);
+  EXPECT_THROW(ev.apply(x + z), evaluation_error);
+}
+
 } // namespace numsim::cas
 
 #endif // SCALAREVALUATORTEST_H
@@ -0,0 +1,93 @@
+#ifndef SCALAREXPANDTEST_H
+#define SCALAREXPANDTEST_H
+
+#include "cas_test_helpers.h"
+#include "numsim_cas/numsim_cas.h"
+#include "gtest/gtest.h"
+
+#include <cmath>
+
+namespace numsim::cas {
+
+namespace {
+// expand() must not change the value; check at a point with distinct,
+// non-trivial values for every symbol.
+void expect_same_value(expression_holder<scalar_expression> const &lhs,
+                       expression_holder<scalar_expression> const &rhs,
+                       std::initializer_list<
+                           expression_holder<scalar_expression>> symbols) {
+  scalar_evaluator<double> ev;
+  double value{0.3};
+  for (auto const &symbol : symbols) {
+    ev.set(symbol, value);
+    value += 0.41;
+  }
+  auto const expected{ev.apply(lhs)};
+  EXPECT_NEAR(ev.apply(rhs), expected, 1e-10 * (1.0 + std::abs(expected)));
+}
+} // namespace
+
+TEST(ScalarExpand, DistributesProductsAndPowers) {
+  auto [a, b, c, x, y] = make_scalar_variable("a", "b", "c", "x", "y");
+  EXPECT_EQ(expand(a * (b + c)), a * b + a * c);
+  EXPECT_EQ(expand(pow(x + y, 2)), pow(x, 2) + 2 * x * y + pow(y, 2));
+  EXPECT_EQ(expand((x + 1) * (x - 1)), pow(x, 2) - 1);
+  EXPECT_EQ(expand(pow(x + 1, 2) - pow(x, 2) - 2 * x), make_scalar_constant(1));
+  EXPECT_EQ(expand(x + y), x + y);
+  EXPECT_EQ(expand(x), x);
+}
+
+TEST(ScalarExpand, ResultIsOneFlatSum) {
+  auto [a, b, c] = make_scalar_variable("a", "b", "c");
+  auto const expanded{expand(pow(a + b + c, 6))};
+  ASSERT_TRUE(is_same<scalar_add>(expanded));
+  // Monomials of degree 6 in three variables.
+  EXPECT_EQ(expanded.get<scalar_add>().size(), 28u);
+  for (auto const &term : expanded.get<scalar_add>().symbol_map())
+    EXPECT_FALSE(is_same<scalar_add>(term));
+  expect_same_value(pow(a + b + c, 6), expanded, {a, b, c});
+}
+
+TEST(ScalarExpand, ExpandsInsideAtoms) {
+  auto [a, b, c, x] = make_scalar_variable("a", "b", "c", "x");
+  EXPECT_EQ(expand(sin(a * (b + c))), sin(a * b + a * c));
+  auto const mixed{(sin(x) + a) * (sin(x) - a) * exp(b * (c + 1))};
+  auto const expanded{expand(mixed)};
+  expect_same_value(mixed, expanded, {a, b, c, x});
+  // Non-integer powers stay atoms.
+  EXPECT_EQ(expand(pow(x + a, make_scalar_constant(scalar_number{1, 2}))),
+            pow(x + a, make_scalar_constant(scalar_number{1, 2})));
+}
+
+TEST(ScalarExpand, ParallelProductMatchesSequential) {
+  auto [a, b, c, d] = make_scalar_variable("a", "b", "c", "d");
+  auto const expr{pow(a + b + c + d + 1, 5) * pow(a - 2 * b + c * d, 3)};
+  auto const sequential{expand(expr)};
+  auto const parallel{
+      expand(expr, expand_options{.parallel_threshold = 1, .max_threads = 4})};
+  EXPECT_EQ(sequential, parallel);
+  expect_same_value(expr, parallel, {a, b, c, d});
+}
+
+TEST(ScalarExpand, ManyGeneratorsFallBackCorrectly) {
+  // 60 generators with 10-bit exponent fields need more than eight words,
+  // so this goes through the operator-based fallback.
+  std::vector<expression_holder<scalar_expression>> symbols;
+  expression_holder<scalar_expression> sum;
+  for (int i = 0; i < 60; ++i) {
+    symbols.push_back(make_expression<scalar>("s" + std::to_string(i)));
+    sum += symbols.back();
+  }
+  auto const expr{pow(symbols[0], 1000) * (sum + 1)};
+  auto const expanded{expand(expr)};
+  ASSERT_TRUE(is_same<scalar_add>(expanded));
+  EXPECT_EQ(expanded.get<scalar_add>().size(), 61u);
+  scalar_evaluator<double> ev;
+  for (std::size_t i = 0; i < symbols.size(); ++i)
+    ev.set(symbols[i], i == 0 ? 1.0 : 0.01 * static_cast<double>(i));
+  EXPECT_NEAR(ev.apply(expanded), ev.apply(expr), 1e-10);
+}
+
+} // namespace numsim::cas
+
+#endif // SCALAREXPANDTEST_H
@@ -305,8 +305,8 @@ TEST_F(ScalarFixture, PRINT_Functions) {
               (two / x);
 
   EXPECT_PRINT(expr,
-               "2*pow(x,x)*atan(x)*acos(x)*asin(x)*tan(x)*cos(x)*sin(x)*abs(x)*"
-               "sign(x)*exp(x)*log(x)*sqrt(x)");
+               "2*pow(x,x)*atan(x)*tan(x)*sin(x)*abs(x)*sign(x)*acos(x)*log(x)*"
+               "exp(x)*asin(x)*sqrt(x)*cos(x)");
 }
 
 //
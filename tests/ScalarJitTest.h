@@ -0,0 +1,173 @@
+#ifndef SCALARJITTEST_H
+#define SCALARJITTEST_H
+
+// scalar_jit has to give the values of scalar_evaluator whether or not the
+// build has the LLVM backend (NUMSIM_CAS_ENABLE_JIT), so every test here
+// runs in both configurations.
+
+#include <array>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include <numsim_cas/core/diff.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_diff.h>
+#include <numsim_cas/scalar/scalar_jit.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+
+namespace numsim::cas {
+
+namespace {
+
+using expr_t = expression_holder<scalar_expression>;
+
+// libm calls may round differently from the std:: functions.
+void expect_kernel_matches(scalar_kernel const &kernel, expr_t const &expr,
+                           std::vector<expr_t> const &inputs,
+                           std::vector<double> const &values) {
+  scalar_evaluator<double> ev;
+  for (std::size_t i{0}; i < inputs.size(); ++i)
+    ev.set(inputs[i], values[i]);
+  auto const expected = ev.apply(expr);
+  auto const actual = kernel(values);
+  EXPECT_NEAR(actual, expected, 1e-13 * (1 + std::abs(expected)))
+      << to_string(expr);
+}
+
+} // namespace
+
+TEST(ScalarJit, MatchesEvaluator) {
+  auto [x, y, z] = make_scalar_variable("x", "y", "z");
+  std::vector<expr_t> const inputs{x, y, z};
+  std::vector<expr_t> const exprs{
+      x + y * z + 3,
+      x * y * z - x / 3,
+      pow(x, 3) + pow(y, z) - sqrt(z),
+      sin(x) * cos(y) + tan(z / 4),
+      asin(x / 2) + acos(y / 4) + atan(z),
+      exp(-x * x) + log(abs(y) + 1),
+      sign(x - y) * abs(z - x),
+      -(x + y) / (1 + z * z)};
+  std::array<std::vector<double>, 3> const points{
+      {{0.3, 1.7, 2.5}, {-0.9, 0.2, 0.8}, {1.1, -3.0, 1.0}}};
+
+  scalar_jit jit;
+  for (auto const &expr : exprs) {
+    auto const kernel = jit.compile(expr, inputs);
+    ASSERT_TRUE(kernel.is_valid());
+    EXPECT_EQ(kernel.inputs(), 3u);
+    EXPECT_EQ(kernel.outputs(), 1u);
+    for (auto const &p : points)
+      expect_kernel_matches(kernel, expr, inputs, p);
+  }
+}
+
+TEST(ScalarJit, ComparisonsAndBranches) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  std::vector<expr_t> const inputs{x, y};
+  std::vector<expr_t> const exprs{
+      lt(x, y),  gt(x, y),  le(x, y),  ge(x, y),
+      eq(x, y),  ne(x, y),  max(x, y), min(x, y) * 2,
+      if_then_else(lt(x, y), x * x, y + 1),
+      if_then_else(x - y, sin(x), cos(y))};
+  std::array<std::vector<double>, 4> const points{
+      {{1.0, 2.0}, {2.0, 1.0}, {1.5, 1.5}, {-1.0, 0.0}}};
+
+  scalar_jit jit;
+  for (auto const &expr : exprs) {
+    auto const kernel = jit.compile(expr, inputs);
+    for (auto const &p : points)
+      expect_kernel_matches(kernel, expr, inputs, p);
+  }
+}
+
+TEST(ScalarJit, MultipleOutputs) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const f = pow(x, 2) * sin(y) + exp(x * y);
+  auto const dfdx = diff(f, x);
+  auto const dfdy = diff(f, y);
+
+  scalar_jit jit;
+  auto const kernel = jit.compile({f, dfdx, dfdy}, {x, y});
+  EXPECT_EQ(kernel.outputs(), 3u);
+
+  std::array<double, 2> const in{0.4, 1.3};
+  std::array<double, 3> out{};
+  kernel(in.data(), out.data());
+
+  scalar_evaluator<double> ev;
+  ev.set(x, in[0]);
+  ev.set(y, in[1]);
+  EXPECT_NEAR(out[0], ev.apply(f), 1e-13);
+  EXPECT_NEAR(out[1], ev.apply(dfdx), 1e-13);
+  EXPECT_NEAR(out[2], ev.apply(dfdy), 1e-13);
+}
+
+TEST(ScalarJit, InputOrderIsTheCallOrder) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  scalar_jit jit;
+  auto const xy = jit.compile(x - 2 * y, {x, y});
+  auto const yx = jit.compile(x - 2 * y, {y, x});
+  EXPECT_DOUBLE_EQ(xy(std::vector<double>{5, 1}), 3);
+  EXPECT_DOUBLE_EQ(yx(std::vector<double>{5, 1}), -9);
+  EXPECT_EQ(jit.cache_size(), 2u);
+}
+
+TEST(ScalarJit, CacheReturnsExistingKernel) {
+  scalar_jit jit;
+  auto build = [] {
+    auto [x, y] = make_scalar_variable("x", "y");
+    return std::pair{sin(x) * y + 1, std::vector<expr_t>{x, y}};
+  };
+  auto const [e1, in1] = build();
+  auto const [e2, in2] = build();
+
+  auto const k1 = jit.compile(e1, in1);
+  auto const k2 = jit.compile(e2, in2);
+  EXPECT_EQ(jit.cache_size(), 1u);
+  EXPECT_EQ(k1.is_native(), k2.is_native());
+  EXPECT_DOUBLE_EQ(k1(std::vector<double>{0.5, 2}),
+                   k2(std::vector<double>{0.5, 2}));
+
+  jit.clear_cache();
+  EXPECT_EQ(jit.cache_size(), 0u);
+  // Kernels outlive the cache entry they came from.
+  EXPECT_DOUBLE_EQ(k1(std::vector<double>{0.5, 2}), std::sin(0.5) * 2 + 1);
+}
+
+TEST(ScalarJit, BackendSelection) {
+  auto [x] = make_scalar_variable("x");
+  auto const expr = exp(x) - x;
+
+  scalar_jit jit;
+  auto const native = jit.compile(expr, {x});
+  EXPECT_EQ(native.is_native(), scalar_jit::native_available());
+
+  scalar_jit fallback(scalar_jit_options{.native = false});
+  auto const evaluated = fallback.compile(expr, {x});
+  EXPECT_FALSE(evaluated.is_native());
+  EXPECT_NEAR(native(std::vector<double>{0.7}),
+              evaluated(std::vector<double>{0.7}), 1e-14);
+}
+
+TEST(ScalarJit, RejectsInvalidInputs) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  scalar_jit jit;
+  EXPECT_THROW((void)jit.compile(x + y, {x}), invalid_expression_error);
+  EXPECT_THROW((void)jit.compile(x + y, {x, y, x}), invalid_expression_error);
+  EXPECT_THROW((void)jit.compile(x, {x + y}), invalid_expression_error);
+  EXPECT_EQ(jit.cache_size(), 0u);
+
+  auto const kernel = jit.compile({x, y}, {x, y});
+  EXPECT_THROW((void)kernel(std::vector<double>{1, 2}), evaluation_error);
+  auto const single = jit.compile(x * y, {x, y});
+  EXPECT_THROW((void)single(std::vector<double>{1}), evaluation_error);
+  EXPECT_THROW((void)scalar_kernel{}(std::vector<double>{}), evaluation_error);
+}
+
+} // namespace numsim::cas
+
+#endif // SCALARJITTEST_H
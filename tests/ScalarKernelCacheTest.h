@@ -0,0 +1,220 @@
+#ifndef SCALARKERNELCACHETEST_H
+#define SCALARKERNELCACHETEST_H
+
+// scalar_kernel_cache compiles with the system C compiler. Without one (or
+// without dlopen) the kernels fall back to scalar_evaluator, so the value
+// checks always run and the file/statistics checks only for native kernels.
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <random>
+#include <vector>
+
+#include <numsim_cas/core/diff.h>
+#include <numsim_cas/scalar/scalar_all.h>
+#include <numsim_cas/scalar/scalar_diff.h>
+#include <numsim_cas/scalar/scalar_kernel_cache.h>
+#include <numsim_cas/scalar/scalar_operators.h>
+#include <numsim_cas/scalar/scalar_program.h>
+#include <numsim_cas/scalar/scalar_std.h>
+#include <numsim_cas/scalar/visitors/scalar_evaluator.h>
+
+namespace numsim::cas {
+
+namespace {
+using expr_t = expression_holder<scalar_expression>;
+
+void expect_matches_evaluator(scalar_kernel const &kernel,
+                              std::vector<expr_t> const &outputs,
+                              std::vector<expr_t> const &inputs,
+                              std::vector<double> const &in) {
+  std::vector<double> out(outputs.size());
+  kernel(in.data(), out.data());
+  scalar_evaluator<double> ev;
+  for (std::size_t i{0}; i < inputs.size(); ++i)
+    ev.set(inputs[i], in[i]);
+  for (std::size_t j{0}; j < outputs.size(); ++j) {
+    auto const expected = ev.apply(outputs[j]);
+    EXPECT_NEAR(out[j], expected, 1e-13 * (1 + std::abs(expected)));
+  }
+}
+} // namespace
+
+class ScalarKernelCacheTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    m_dir = std::filesystem::temp_directory_path() /
+            ("numsim_cas_kernels_" + std::to_string(std::random_device{}()));
+  }
+  void TearDown() override {
+    std::error_code ec;
+    std::filesystem::remove_all(m_dir, ec);
+  }
+
+  scalar_kernel_cache_options options() const {
+    scalar_kernel_cache_options opts;
+    opts.directory = m_dir;
+    return opts;
+  }
+
+  // A fresh copy of the same expressions, to check that the cache works
+  // structurally and not by node identity.
+  static std::pair<std::vector<expr_t>, std::vector<expr_t>> model() {
+    auto [x, y, mu] = make_scalar_variable("x", "y", "mu");
+    auto const psi = mu / 2 * (pow(x, 2) + pow(y, 2) - 2) - mu * log(x * y) +
+                     if_then_else(lt(x, y), sin(x), exp(-y) / 3);
+    return {{psi, diff(psi, x), diff(psi, y)}, {x, y, mu}};
+  }
+
+  std::filesystem::path m_dir;
+};
+
+TEST_F(ScalarKernelCacheTest, CompilesOnceAndLoadsFromDisk) {
+  auto const [outputs, inputs] = model();
+  {
+    scalar_kernel_cache cache(options());
+    auto const kernel = cache.load(outputs, inputs);
+    EXPECT_EQ(kernel.outputs(), 3u);
+    expect_matches_evaluator(kernel, outputs, inputs, {0.8, 1.4, 2.0});
+    expect_matches_evaluator(kernel, outputs, inputs, {1.3, 0.6, 0.5});
+    if (!kernel.is_native())
+      GTEST_SKIP() << "no C compiler or dlopen";
+
+    EXPECT_EQ(cache.stats().compiled, 1u);
+    auto const key = cache.key(outputs, inputs);
+    EXPECT_TRUE(std::filesystem::exists(m_dir / (key + ".so")));
+    EXPECT_TRUE(std::filesystem::exists(m_dir / (key + ".c")));
+
+    (void)cache.load(outputs, inputs);
+    EXPECT_EQ(cache.stats().memory_hits, 1u);
+  }
+
+  // A new cache on the same directory, as in the next run.
+  auto const [outputs2, inputs2] = model();
+  scalar_kernel_cache cache(options());
+  auto const kernel = cache.load(outputs2, inputs2);
+  EXPECT_TRUE(kernel.is_native());
+  EXPECT_EQ(cache.stats().disk_hits, 1u);
+  EXPECT_EQ(cache.stats().compiled, 0u);
+  expect_matches_evaluator(kernel, outputs2, inputs2, {0.8, 1.4, 2.0});
+}
+
+TEST_F(ScalarKernelCacheTest, KeyCoversStructureInputsAndCompiler) {
+  auto const [outputs, inputs] = model();
+  auto const [outputs2, inputs2] = model();
+  scalar_kernel_cache cache(options());
+  auto const key = cache.key(outputs, inputs);
+  EXPECT_EQ(key.size(), 16u);
+  EXPECT_EQ(cache.key(outputs2, inputs2), key);
+  EXPECT_NE(cache.key(outputs, {inputs[1], inputs[0], inputs[2]}), key);
+  EXPECT_NE(cache.key({outputs[0], outputs[1]}, inputs), key);
+  EXPECT_NE(cache.key({outputs[0] + 1, outputs[1], outputs[2]}, inputs), key);
+
+  auto opts = options();
+  opts.flags += " -ffp-contract=off";
+  EXPECT_NE(scalar_kernel_cache(opts).key(outputs, inputs), key);
+}
+
+TEST_F(ScalarKernelCacheTest, MismatchingEntryIsRebuilt) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const f = sqrt(x * x + y * y);
+  std::string key;
+  {
+    scalar_kernel_cache cache(options());
+    if (!cache.load(f, {x, y}).is_native())
+      GTEST_SKIP() << "no C compiler or dlopen";
+    key = cache.key({f}, {x, y});
+  }
+  std::ofstream(m_dir / (key + ".c")) << "/* something else */\n";
+
+  scalar_kernel_cache cache(options());
+  auto const kernel = cache.load(f, {x, y});
+  EXPECT_EQ(cache.stats().disk_hits, 0u);
+  EXPECT_EQ(cache.stats().compiled, 1u);
+  EXPECT_DOUBLE_EQ(kernel(std::vector<double>{3, 4}), 5);
+}
+
+TEST_F(ScalarKernelCacheTest, FailedCompileFallsBackToEvaluator) {
+  auto [x] = make_scalar_variable("x");
+  auto opts = options();
+  opts.compiler = "numsim_cas_no_such_compiler";
+  scalar_kernel_cache cache(opts);
+  auto const kernel = cache.load(atan(x) * 2, {x});
+  EXPECT_FALSE(kernel.is_native());
+  EXPECT_EQ(cache.stats().failed, 1u);
+  EXPECT_DOUBLE_EQ(kernel(std::vector<double>{1}), std::atan(1.0) * 2);
+  EXPECT_THROW((void)cache.load(x, {}), invalid_expression_error);
+}
+
+TEST_F(ScalarKernelCacheTest, DirectoryIsAbsolute) {
+  scalar_kernel_cache_options opts;
+  auto const fallback = scalar_kernel_cache(opts).directory();
+  if (!fallback.empty()) {
+    EXPECT_TRUE(fallback.is_absolute());
+    EXPECT_NE(fallback.string().find("numsim_cas"), std::string::npos);
+  }
+
+  opts.directory = "numsim_cas_relative_kernels";
+  auto const dir = scalar_kernel_cache(opts).directory();
+  EXPECT_TRUE(dir.is_absolute());
+  EXPECT_EQ(dir, std::filesystem::current_path() / opts.directory);
+}
+
+TEST_F(ScalarKernelCacheTest, SharedDirectoryIsNotUsed) {
+  if (!scalar_kernel_cache::native_available())
+    GTEST_SKIP() << "no dlopen";
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const f = x * y + 1;
+  std::filesystem::create_directories(m_dir);
+  using perms = std::filesystem::perms;
+  std::filesystem::permissions(m_dir, perms::owner_all | perms::group_all |
+                                          perms::others_all);
+
+  scalar_kernel_cache cache(options());
+  auto const kernel = cache.load(f, {x, y});
+  EXPECT_FALSE(kernel.is_native());
+  EXPECT_EQ(cache.stats().failed, 1u);
+  EXPECT_DOUBLE_EQ(kernel(std::vector<double>{2, 3}), 7);
+  EXPECT_TRUE(std::filesystem::is_empty(m_dir));
+}
+
+TEST_F(ScalarKernelCacheTest, WritableEntryIsRebuilt) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto const f = x / y;
+  std::string key;
+  {
+    scalar_kernel_cache cache(options());
+    if (!cache.load(f, {x, y}).is_native())
+      GTEST_SKIP() << "no C compiler or dlopen";
+    key = cache.key({f}, {x, y});
+  }
+  using perms = std::filesystem::perms;
+  EXPECT_EQ(std::filesystem::status(m_dir).permissions(), perms::owner_all);
+  std::filesystem::permissions(m_dir / (key + ".so"), perms::group_write,
+                               std::filesystem::perm_options::add);
+
+  scalar_kernel_cache cache(options());
+  auto const kernel = cache.load(f, {x, y});
+  EXPECT_TRUE(kernel.is_native());
+  EXPECT_EQ(cache.stats().disk_hits, 0u);
+  EXPECT_EQ(cache.stats().compiled, 1u);
+  EXPECT_EQ(std::filesystem::status(m_dir / (key + ".so")).permissions() &
+                perms::group_write,
+            perms::none);
+  EXPECT_DOUBLE_EQ(kernel(std::vector<double>{3, 4}), 0.75);
+}
+
+TEST(ScalarProgram, CSourceUsesExactConstants) {
+  auto [x] = make_scalar_variable("x");
+  auto const src =
+      to_c_source(make_scalar_program({x * 0.1 - 3}, {x}), "kernel");
+  EXPECT_NE(src.find("void kernel("), std::string::npos);
+  EXPECT_NE(src.find("0x1.999999999999ap-4"), std::string::npos) << src;
+  EXPECT_NE(src.find("out[0] = "), std::string::npos);
+}
+
+} // namespace numsim::cas
+
+#endif // SCALARKERNELCACHETEST_H
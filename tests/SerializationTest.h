@@ -0,0 +1,175 @@
+#ifndef SERIALIZATIONTEST_H
+#define SERIALIZATIONTEST_H
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include <numsim_cas/numsim_cas.h>
+#include <numsim_cas/serialization.h>
+#include <numsim_cas/tensor/isotropic_kind.h>
+#include <numsim_cas/tensor/projection_tensor.h>
+#include <numsim_cas/tensor/tensor_isotropic_functions.h>
+
+namespace numsim::cas {
+
+namespace {
+using scalar_t = expression_holder<scalar_expression>;
+using tensor_t = expression_holder<tensor_expression>;
+using t2s_t = expression_holder<tensor_to_scalar_expression>;
+
+std::vector<serialized_expression>
+round_trip(std::initializer_list<serialized_expression> roots) {
+  auto const bytes = serialize_dag(roots);
+  return deserialize_dag(bytes);
+}
+
+// Node count from the header (bytes 20..23, little-endian).
+std::uint32_t node_count(std::vector<std::byte> const &bytes) {
+  std::uint32_t count{0};
+  for (std::size_t i = 0; i < 4; ++i)
+    count |= std::to_integer<std::uint32_t>(bytes[20 + i]) << (8 * i);
+  return count;
+}
+} // namespace
+
+TEST(Serialization, RoundTripsAllDomains) {
+  auto x = make_expression<scalar>("x");
+  auto y = make_expression<scalar>("y");
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto Y = make_expression<tensor>("Y", 3, 2);
+
+  scalar_t s = sin(x) * pow(y, 2) + x / y +
+               if_then_else(lt(x, y), max(x, y), sqrt(abs(x))) +
+               make_expression<scalar_constant>(scalar_number{3, 7});
+  tensor_t T = 2 * X * Y + inv(X) + trace(X) * Y + pow(X, 3) +
+               permute_indices(otimes(X, Y), sequence{1, 3, 2, 4}) -
+               x * make_expression<identity_tensor>(3, 2);
+  t2s_t f = det(X) + dot(X) * norm(Y) +
+            log(eigen_decomposition(X).value(1)) +
+            make_expression<tensor_inner_product_to_scalar>(
+                X, sequence{1, 2}, Y, sequence{1, 2});
+
+  auto roots = round_trip({s, T, f});
+  ASSERT_EQ(roots.size(), 3u);
+  EXPECT_EQ(std::get<scalar_t>(roots[0]), s);
+  EXPECT_EQ(std::get<tensor_t>(roots[1]), T);
+  EXPECT_EQ(std::get<t2s_t>(roots[2]), f);
+}
+
+TEST(Serialization, RoundTripsPayloadNodes) {
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto a = make_expression<scalar>("a");
+  auto eig = eigen_decomposition(X);
+
+  tensor_t T = eig.basis(0) + otimes(eig.normal(2), eig.normal(2)) +
+               inner_product(P_devi(3), sequence{3, 4}, X, sequence{1, 2}) +
+               log(X) +
+               make_expression<levi_civita_tensor>(3) *
+                   make_expression<tensor>("v", 3, 1);
+  t2s_t f = make_expression<tensor_to_scalar_divided_difference>(
+                X, isotropic_kind::exp, std::vector<std::size_t>{0, 0, 2}) +
+            make_expression<tensor_to_scalar_scalar_wrapper>(
+                make_expression<scalar_named_expression>("psi", exp(a)));
+
+  auto roots = round_trip({T, f});
+  EXPECT_EQ(std::get<tensor_t>(roots[0]), T);
+  EXPECT_EQ(std::get<t2s_t>(roots[1]), f);
+}
+
+TEST(Serialization, PreservesSharedSubexpressions) {
+  auto x = make_expression<scalar>("x");
+  auto y = make_expression<scalar>("y");
+  scalar_t shared = sin(x) + y;
+  scalar_t lhs = exp(shared);
+  scalar_t rhs = log(shared);
+
+  auto const bytes = serialize_dag({lhs, rhs, shared});
+  // Everything below exp(shared) is written once; log adds one record.
+  EXPECT_EQ(node_count(bytes), node_count(serialize_dag({lhs})) + 1);
+
+  auto roots = deserialize_dag(bytes);
+  auto const &exp_node = std::get<scalar_t>(roots[0]).get<scalar_exp>();
+  auto const &log_node = std::get<scalar_t>(roots[1]).get<scalar_log>();
+  EXPECT_EQ(exp_node.expr().data(), log_node.expr().data());
+  EXPECT_EQ(std::get<scalar_t>(roots[2]).data(), exp_node.expr().data());
+}
+
+TEST(Serialization, PreservesAssumptionsAndSpaces) {
+  auto x = make_expression<scalar>("x");
+  x.assumption(positive{});
+  auto S = make_expression<tensor>("S", 3, 2);
+  S.assumption(Symmetric{});
+  auto C = make_expression<tensor>("C", 3, 2);
+  C.assumption(positive_definite{});
+
+  auto roots = round_trip({x, S + C});
+  auto const &x2 = std::get<scalar_t>(roots[0]);
+  EXPECT_TRUE(x2.get().assumptions().contains(positive{}));
+
+  tensor_t S2, C2;
+  for (auto const &child :
+       std::get<tensor_t>(roots[1]).get<tensor_add>().symbol_map())
+    (child.get<tensor>().name() == "S" ? S2 : C2) = child;
+  ASSERT_TRUE(S2.is_valid() && C2.is_valid());
+  EXPECT_TRUE(is_symmetric(S2));
+  EXPECT_TRUE(is_positive_definite(C2));
+  EXPECT_TRUE(is_symmetric(C2));
+}
+
+TEST(Serialization, LoadsWideSumsAsWritten) {
+  constexpr std::size_t n = 4000;
+  std::vector<scalar_t> terms;
+  terms.reserve(n);
+  for (std::size_t i = 0; i < n; ++i)
+    terms.push_back(pow(make_expression<scalar>("x" + std::to_string(i)),
+                        static_cast<int>(i % 5 + 2)));
+  auto sum = make_expression<scalar_add>();
+  sum.get<scalar_add>().append(terms);
+  sum.get<scalar_add>().set_coeff(make_expression<scalar_constant>(3));
+  auto const t = make_expression<tensor>("T", 3, 2);
+  t2s_t f = trace(t) * det(t) * norm(t) * 2;
+
+  auto roots = round_trip({sum, f});
+  auto const &loaded = std::get<scalar_t>(roots[0]);
+  EXPECT_EQ(loaded, sum);
+  EXPECT_EQ(loaded.get<scalar_add>().size(), n);
+  EXPECT_EQ(loaded.get<scalar_add>().coeff(), sum.get<scalar_add>().coeff());
+  EXPECT_EQ(std::get<t2s_t>(roots[1]), f);
+}
+
+TEST(Serialization, StreamRoundTrip) {
+  auto X = make_expression<tensor>("X", 2, 2);
+  t2s_t f = pow(trace(X), 2) + det(X);
+  std::vector<serialized_expression> roots{f};
+
+  std::stringstream stream;
+  write_dag(stream, roots);
+  auto loaded = read_dag(stream);
+  ASSERT_EQ(loaded.size(), 1u);
+  EXPECT_EQ(std::get<t2s_t>(loaded[0]), f);
+}
+
+TEST(Serialization, RejectsCorruptBuffers) {
+  auto x = make_expression<scalar>("x");
+  auto bytes = serialize_dag({sin(x) + x});
+
+  auto truncated = bytes;
+  truncated.pop_back();
+  EXPECT_THROW((void)deserialize_dag(truncated), serialization_error);
+
+  auto foreign = bytes;
+  foreign[0] = std::byte{'X'};
+  EXPECT_THROW((void)deserialize_dag(foreign), serialization_error);
+
+  // The node-set fingerprint follows the version (bytes 12..19).
+  auto other_nodes = bytes;
+  other_nodes[12] ^= std::byte{1};
+  EXPECT_THROW((void)deserialize_dag(other_nodes), serialization_error);
+
+  EXPECT_THROW((void)deserialize_dag({}), serialization_error);
+  EXPECT_THROW((void)serialize_dag({scalar_t{}}), invalid_expression_error);
+}
+
+} // namespace numsim::cas
+
+#endif // SERIALIZATIONTEST_H
@@ -0,0 +1,134 @@
+#ifndef SPARSEPOLYNOMIALTEST_H
+#define SPARSEPOLYNOMIALTEST_H
+
+#include "cas_test_helpers.h"
+#include "numsim_cas/numsim_cas.h"
+#include "gtest/gtest.h"
+
+namespace numsim::cas {
+
+namespace {
+sparse_polynomial poly_var(std::size_t index, unsigned degree = 1) {
+  return sparse_polynomial::variable(index, degree);
+}
+sparse_polynomial poly_const(scalar_number const &value) {
+  return sparse_polynomial{value};
+}
+} // namespace
+
+TEST(SparsePolynomial, MonomialPackingIsLexicographic) {
+  auto const x2{monomial::variable(0, 2)};
+  auto const xy{monomial::variable(0) * monomial::variable(1)};
+  auto const y5{monomial::variable(1, 5)};
+  EXPECT_GT(x2, xy);
+  EXPECT_GT(xy, y5);
+  EXPECT_EQ(xy.degree(0), 1u);
+  EXPECT_EQ(xy.degree(1), 1u);
+  EXPECT_EQ((x2 * xy).total_degree(), 4u);
+  EXPECT_TRUE((x2 * xy).divisible_by(xy));
+  EXPECT_FALSE(x2.divisible_by(xy));
+  EXPECT_EQ((x2 * xy) / xy, x2);
+}
+
+TEST(SparsePolynomial, MonomialLimitsThrow) {
+  EXPECT_THROW((void)monomial::variable(monomial::max_variables),
+               polynomial_error);
+  EXPECT_THROW((void)monomial::variable(0, 256), polynomial_error);
+  auto const high{monomial::variable(3, 200)};
+  EXPECT_NO_THROW((void)(high * monomial::variable(3, 55)));
+  EXPECT_THROW((void)(high * monomial::variable(3, 56)), polynomial_error);
+  // A full byte next to an empty one does not carry into it.
+  auto const full{monomial::variable(7, 255)};
+  EXPECT_EQ((full * monomial::variable(6)).degree(6), 1u);
+}
+
+TEST(SparsePolynomial, ArithmeticCombinesAndDropsTerms) {
+  auto const x{poly_var(0)};
+  auto const y{poly_var(1)};
+  auto const square{pow(x + y, 2)};
+  EXPECT_EQ(square.size(), 3u);
+  EXPECT_EQ(square - x * x - poly_const(2) * x * y, y * y);
+  EXPECT_TRUE((x - x).is_zero());
+  EXPECT_EQ((x + poly_const(1)) * (x - poly_const(1)),
+            x * x - poly_const(1));
+  EXPECT_EQ(square.leading_term().exponents, monomial::variable(0, 2));
+  EXPECT_EQ(*(y * y).main_variable(), 1u);
+}
+
+TEST(SparsePolynomial, ExactDivision) {
+  auto const x{poly_var(0)};
+  auto const one{poly_const(1)};
+  auto quotient{divide_exact(x * x - one, x - one)};
+  ASSERT_TRUE(quotient.has_value());
+  EXPECT_EQ(*quotient, x + one);
+  EXPECT_FALSE(divide_exact(x * x + one, x - one).has_value());
+  EXPECT_THROW((void)divide_exact(x, sparse_polynomial{}), polynomial_error);
+}
+
+TEST(SparsePolynomial, GcdAndCancel) {
+  auto const x{poly_var(0)};
+  auto const y{poly_var(1)};
+  auto const one{poly_const(1)};
+
+  EXPECT_EQ(gcd(x * x - one, x * x + poly_const(2) * x + one), x + one);
+  EXPECT_EQ(gcd(poly_const(6) * x, poly_const(4) * x * x), x);
+  EXPECT_EQ(gcd(x + one, x - one), one);
+
+  // (x^2 - y^2) / (2x - 2y) = (x + y) / 2
+  auto const reduced{
+      cancel(x * x - y * y, poly_const(2) * x - poly_const(2) * y)};
+  EXPECT_EQ(reduced.numerator, poly_const(scalar_number{1, 2}) * (x + y));
+  EXPECT_EQ(reduced.denominator, one);
+
+  auto const common{x * y + one};
+  auto const fraction{
+      cancel(common * (x + y), common * (x - poly_const(3) * y))};
+  EXPECT_EQ(fraction.numerator, x + y);
+  EXPECT_EQ(fraction.denominator, x - poly_const(3) * y);
+  EXPECT_THROW((void)cancel(x, sparse_polynomial{}), polynomial_error);
+}
+
+TEST(SparsePolynomial, ConverterRoundTrip) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  polynomial_converter converter({x}, true);
+  auto poly{converter.to_polynomial(pow(x + sin(y), 2))};
+  ASSERT_TRUE(poly.has_value());
+  EXPECT_EQ(poly->size(), 3u);
+  ASSERT_EQ(converter.generators().size(), 2u);
+  EXPECT_PRINT(converter.generators()[1], "sin(y)");
+  EXPECT_EQ(*converter.to_polynomial(converter.to_expression(*poly)), *poly);
+
+  EXPECT_FALSE(converter.to_polynomial(sin(x)).has_value());
+  EXPECT_FALSE(polynomial_converter({x}).to_polynomial(x * y).has_value());
+}
+
+TEST(SparsePolynomial, CancelExpressions) {
+  auto [x, y] = make_scalar_variable("x", "y");
+  auto _1 = make_scalar_constant(1);
+  EXPECT_PRINT(cancel(pow(x, 2) - _1, x - _1), testcas::S(x + _1));
+  // Not polynomial: returned as the plain quotient.
+  EXPECT_PRINT(cancel(sin(x), y), testcas::S(sin(x) / y));
+}
+
+TEST(SparsePolynomial, SolverExpandsPowersOfSums) {
+  auto [x, a] = make_scalar_variable("x", "a");
+  auto _1 = make_scalar_constant(1);
+  auto _4 = make_scalar_constant(4);
+  // (x+1)^2 - 4 = x^2 + 2x - 3 = 0  →  x ∈ {1, -3}
+  auto coeffs = polynomial_coefficients(pow(x + _1, 2) - _4, x);
+  ASSERT_TRUE(coeffs.has_value());
+  EXPECT_PRINT(coeffs->at(2), "1");
+  EXPECT_PRINT(coeffs->at(1), "2");
+  EXPECT_PRINT(coeffs->at(0), "-3");
+  EXPECT_EQ(solve(pow(x + _1, 2) - _4, x).size(), 2u);
+
+  // Symbolic coefficients are grouped per power of x.
+  auto sym = polynomial_coefficients(pow(x + a, 2), x);
+  ASSERT_TRUE(sym.has_value());
+  EXPECT_PRINT(sym->at(1), testcas::S(make_scalar_constant(2) * a));
+  EXPECT_PRINT(sym->at(0), testcas::S(pow(a, 2)));
+}
+
+} // namespace numsim::cas
+
+#endif // SPARSEPOLYNOMIALTEST_H
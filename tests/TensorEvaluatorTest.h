@@ -1,6 +1,9 @@
 #ifndef TENSOREVALUATORTEST_H
 #define TENSOREVALUATORTEST_H
 
+#include <array>
+#include <cmath>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -885,6 +888,358 @@ TEST(TensorEval, CompoundOuterInnerMixed) {
   EXPECT_TRUE(tmech::almost_equal(as_tmech<3, 1>(*result), expected, tol));
 }
 
+// --- Contraction planning (tensor/contraction_plan.h) ---
+
+namespace {
+
+template <std::size_t Dim, std::size_t Rank>
+auto make_filled_data(double seed) {
+  auto ptr = std::make_shared<tensor_data<double, Dim, Rank>>();
+  std::size_t size{1};
+  for (std::size_t r = 0; r < Rank; ++r)
+    size *= Dim;
+  auto *raw = ptr->raw_data();
+  for (std::size_t i = 0; i < size; ++i)
+    raw[i] = std::sin(seed + 0.7 * static_cast<double>(i));
+  return ptr;
+}
+
+} // namespace
+
+TEST(TensorEval, ContractionPlanReordersMatrixVectorChain) {
+  // A * B * v: (A·B)·v costs 27 + 9 multiplies, A·(B·v) only 9 + 9.
+  tensor_evaluator<double> ev;
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto B = make_expression<tensor>("B", 3, 2);
+  auto v = make_expression<tensor>("v", 3, 1);
+  auto A_val = make_filled_data<3, 2>(0.1);
+  auto B_val = make_filled_data<3, 2>(1.3);
+  auto v_val = make_filled_data<3, 1>(2.9);
+  ev.set(A, A_val);
+  ev.set(B, B_val);
+  ev.set(v, v_val);
+
+  auto expr = A * B * v;
+  ASSERT_TRUE(is_same<tensor_mul>(expr));
+  auto const &plan = plan_contractions(expr.get<tensor_mul>());
+  EXPECT_EQ(plan.operands.size(), 3u);
+  EXPECT_EQ(plan.written_cost, 36u);
+  EXPECT_EQ(plan.cost, 18u);
+  EXPECT_TRUE(plan.permutation.empty());
+  EXPECT_EQ(&plan, &plan_contractions(expr.get<tensor_mul>()));
+
+  auto result = ev.apply(expr);
+  ASSERT_NE(result, nullptr);
+  auto expected = tmech_test_helpers::matmul(
+      A_val->data(), tmech::eval(tmech_test_helpers::matmul(B_val->data(),
+                                                             v_val->data())));
+  EXPECT_TRUE(tmech::almost_equal(as_tmech<3, 1>(*result), expected, tol));
+}
+
+TEST(TensorEval, ContractionPlanPermutesIndices) {
+  // A_ij T_klm B_mn U_nop contracted as written right to left; the cheaper
+  // order contracts A with U first and has to restore the index order.
+  tensor_evaluator<double> ev;
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto T = make_expression<tensor>("T", 3, 3);
+  auto B = make_expression<tensor>("B", 3, 2);
+  auto U = make_expression<tensor>("U", 3, 3);
+  ev.set(A, make_filled_data<3, 2>(0.2));
+  ev.set(T, make_filled_data<3, 3>(1.1));
+  ev.set(B, make_filled_data<3, 2>(2.3));
+  ev.set(U, make_filled_data<3, 3>(3.7));
+
+  auto BU = inner_product(B, sequence{2}, U, sequence{1});
+  auto TBU = inner_product(T, sequence{1}, BU, sequence{2});
+  auto expr = inner_product(A, sequence{2}, TBU, sequence{3});
+  ASSERT_TRUE(is_same<inner_product_wrapper>(expr));
+  auto const &plan = plan_contractions(expr.get<inner_product_wrapper>());
+  EXPECT_EQ(plan.operands.size(), 4u);
+  EXPECT_LT(plan.cost, plan.written_cost);
+  EXPECT_FALSE(plan.permutation.empty());
+
+  auto result = ev.apply(expr);
+  ASSERT_NE(result, nullptr);
+
+  // Reference: one two-operand product at a time, in the written order.
+  auto BU_sym = make_expression<tensor>("BU", 3, 3);
+  auto TBU_sym = make_expression<tensor>("TBU", 3, 4);
+  ev.set(BU_sym, std::shared_ptr<tensor_data_base<double>>(ev.apply(BU)));
+  ev.set(TBU_sym, std::shared_ptr<tensor_data_base<double>>(ev.apply(
+                      inner_product(T, sequence{1}, BU_sym, sequence{2}))));
+  auto expected =
+      ev.apply(inner_product(A, sequence{2}, TBU_sym, sequence{3}));
+  EXPECT_TRUE(tmech::almost_equal(as_tmech<3, 4>(*result),
+                                  as_tmech<3, 4>(*expected), tol));
+}
+
+// --- tensor_pow: Cayley-Hamilton (rank-2, 2D/3D) and squaring ---
+
+namespace {
+
+template <std::size_t Dim> void check_pow_against_repeated_product() {
+  tensor_evaluator<double> ev;
+  auto A = make_expression<tensor>("A", Dim, 2);
+  auto A_val = make_filled_data<Dim, 2>(0.4);
+  ev.set(A, A_val);
+  auto expected = tmech::eval(A_val->data());
+  for (int n = 2; n <= 9; ++n) {
+    expected = tmech_test_helpers::matmul(expected, A_val->data());
+    auto result = ev.apply(pow(A, n));
+    ASSERT_NE(result, nullptr);
+    EXPECT_TRUE(tmech::almost_equal(as_tmech<Dim, 2>(*result), expected, 1e-10))
+        << "dim " << Dim << ", n = " << n;
+  }
+}
+
+} // namespace
+
+TEST(TensorEval, EvalPowMatchesRepeatedProduct) {
+  check_pow_against_repeated_product<1>();
+  check_pow_against_repeated_product<2>();
+  check_pow_against_repeated_product<3>();
+}
+
+TEST(TensorEval, EvalPowOfSingularAndNilpotent) {
+  // Cayley-Hamilton with vanishing invariants: N^3 = 0, P^n = P.
+  tensor_evaluator<double> ev;
+  auto N = make_expression<tensor>("N", 3, 2);
+  auto P = make_expression<tensor>("P", 3, 2);
+  // clang-format off
+  ev.set(N, make_test_data<3, 2>({0.0, 1.0, 2.0,
+                                   0.0, 0.0, 3.0,
+                                   0.0, 0.0, 0.0}));
+  ev.set(P, make_test_data<3, 2>({1.0, 0.0, 0.0,
+                                   0.0, 1.0, 0.0,
+                                   0.0, 0.0, 0.0}));
+  // clang-format on
+  auto N3 = ev.apply(pow(N, 3));
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(N3->raw_data()[i], 0.0, tol);
+  auto P5 = ev.apply(pow(P, 5));
+  auto P_val = ev.apply(P);
+  EXPECT_TRUE(tmech::almost_equal(as_tmech<3, 2>(*P5),
+                                  as_tmech<3, 2>(*P_val), tol));
+}
+
+// --- Caller-owned memory (set_view / apply_into) ---
+
+TEST(TensorEval, LayoutVoigtAndMandelRoundTrip) {
+  // clang-format off
+  const std::array<double, 9> S{1.0, 6.0, 5.0,
+                                6.0, 2.0, 4.0,
+                                5.0, 4.0, 3.0};
+  // clang-format on
+  EXPECT_EQ(tensor_layout_size(3, 2, tensor_layout::voigt), 6u);
+  EXPECT_EQ(tensor_layout_size(2, 4, tensor_layout::mandel), 9u);
+
+  std::array<double, 6> voigt{};
+  tensor_layout_pack(voigt.data(), S.data(), 3, 2, tensor_layout::voigt);
+  for (std::size_t k = 0; k < 6; ++k)
+    EXPECT_NEAR(voigt[k], static_cast<double>(k + 1), tol);
+
+  std::array<double, 6> mandel{};
+  tensor_layout_pack(mandel.data(), S.data(), 3, 2, tensor_layout::mandel);
+  EXPECT_NEAR(mandel[0], 1.0, tol);
+  EXPECT_NEAR(mandel[5], 6.0 * std::sqrt(2.0), tol);
+
+  std::array<double, 9> back{};
+  tensor_layout_unpack(back.data(), mandel.data(), 3, 2,
+                       tensor_layout::mandel);
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(back[i], S[i], tol);
+
+  EXPECT_THROW(tensor_layout_size(3, 3, tensor_layout::voigt),
+               evaluation_error);
+}
+
+TEST(TensorEval, LayoutVoigtStrainEngineeringShear) {
+  // clang-format off
+  const std::array<double, 9> eps{0.1, 0.6, 0.5,
+                                  0.6, 0.2, 0.4,
+                                  0.5, 0.4, 0.3};
+  const std::array<double, 9> sig{1.0, 6.0, 5.0,
+                                  6.0, 2.0, 4.0,
+                                  5.0, 4.0, 3.0};
+  // clang-format on
+  std::array<double, 6> gamma{};
+  tensor_layout_pack(gamma.data(), eps.data(), 3, 2,
+                     tensor_layout::voigt_strain);
+  EXPECT_NEAR(gamma[2], 0.3, tol);
+  EXPECT_NEAR(gamma[3], 0.8, tol); // 2 e_23
+  EXPECT_NEAR(gamma[5], 1.2, tol); // 2 e_12
+
+  std::array<double, 9> back{};
+  tensor_layout_unpack(back.data(), gamma.data(), 3, 2,
+                       tensor_layout::voigt_strain);
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(back[i], eps[i], tol);
+
+  // Stress in voigt times strain in voigt_strain is sig:eps.
+  std::array<double, 6> s{};
+  tensor_layout_pack(s.data(), sig.data(), 3, 2, tensor_layout::voigt);
+  double full_dot{0}, voigt_dot{0};
+  for (std::size_t i = 0; i < 9; ++i)
+    full_dot += sig[i] * eps[i];
+  for (std::size_t k = 0; k < 6; ++k)
+    voigt_dot += s[k] * gamma[k];
+  EXPECT_NEAR(voigt_dot, full_dot, 1e-12);
+
+  // Through the evaluator: a strain view and a stress result.
+  auto E = make_expression<tensor>("E", 3, 2);
+  auto S = make_expression<tensor>("S", 3, 2);
+  tensor_evaluator<double> ev;
+  ev.set_view(E, gamma.data(), tensor_layout::voigt_strain);
+  ev.set_view(S, s.data(), tensor_layout::voigt);
+  std::array<double, 9> E_full{};
+  ev.apply_into(E, E_full.data());
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(E_full[i], eps[i], tol);
+  std::array<double, 6> mandel{};
+  ev.apply_into(E, mandel.data(), tensor_layout::mandel);
+  EXPECT_NEAR(mandel[5], 0.6 * std::sqrt(2.0), tol);
+  auto tr = ev.apply(E + S);
+  EXPECT_NEAR(tr->raw_data()[1], 6.6, tol);
+}
+
+TEST(TensorEval, ApplyIntoMandelMatchesDoubleContraction) {
+  // Mandel turns C:E into a plain 6x6 matrix-vector product.
+  tensor_evaluator<double> ev;
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto B = make_expression<tensor>("B", 3, 2);
+  auto A_val = make_filled_data<3, 2>(0.4);
+  auto B_val = make_filled_data<3, 2>(1.9);
+  ev.set(A, A_val);
+  ev.set(B, B_val);
+
+  auto C = otimes(sym(A), sym(B)) + otimes(sym(B), sym(A));
+  std::array<double, 36> C_mandel{};
+  ev.apply_into(C, C_mandel.data(), tensor_layout::mandel);
+  std::array<double, 6> A_mandel{};
+  ev.apply_into(sym(A), A_mandel.data(), tensor_layout::mandel);
+
+  std::array<double, 9> expected{};
+  ev.apply_into(inner_product(C, sequence{3, 4}, sym(A), sequence{1, 2}),
+                expected.data());
+  std::array<double, 6> expected_mandel{};
+  tensor_layout_pack(expected_mandel.data(), expected.data(), 3, 2,
+                     tensor_layout::mandel);
+  for (std::size_t K = 0; K < 6; ++K) {
+    double sum{0};
+    for (std::size_t L = 0; L < 6; ++L)
+      sum += C_mandel[K * 6 + L] * A_mandel[L];
+    EXPECT_NEAR(sum, expected_mandel[K], 1e-10);
+  }
+}
+
+TEST(TensorEval, SetViewMatchesOwnedBinding) {
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto expr = pow(X, 3) * trace(X) + inv(X);
+  auto X_val = make_filled_data<3, 2>(0.3);
+  X_val->raw_data()[0] += 3.0; // keep X invertible
+
+  tensor_evaluator<double> owned;
+  owned.set(X, X_val);
+  auto expected = owned.apply(expr);
+
+  std::array<double, 9> x{};
+  std::memcpy(x.data(), X_val->raw_data(), sizeof(x));
+  tensor_evaluator<double> viewed;
+  viewed.set_view(X, x.data());
+  std::array<double, 9> out{};
+  viewed.apply_into(expr, out.data());
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(out[i], expected->raw_data()[i], 1e-10);
+
+  // The view is read on every evaluation, not copied at binding time.
+  x[4] += 1.0;
+  X_val->raw_data()[4] += 1.0;
+  viewed.apply_into(expr, out.data());
+  expected = owned.apply(expr);
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(out[i], expected->raw_data()[i], 1e-10);
+}
+
+TEST(TensorEval, SetViewUnpacksVoigt) {
+  auto S = make_expression<tensor>("S", 2, 2);
+  const std::array<double, 3> s{1.0, 2.0, 3.0}; // 11, 22, 12
+  tensor_evaluator<double> ev;
+  ev.set_view(S, s.data(), tensor_layout::voigt);
+  auto result = ev.apply(S);
+  ASSERT_NE(result, nullptr);
+  EXPECT_NEAR(result->raw_data()[0], 1.0, tol);
+  EXPECT_NEAR(result->raw_data()[1], 3.0, tol);
+  EXPECT_NEAR(result->raw_data()[2], 3.0, tol);
+  EXPECT_NEAR(result->raw_data()[3], 2.0, tol);
+}
+
+TEST(TensorEval, OperandReadsBoundSymbolsInPlace) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto X = make_expression<tensor>("X", 3, 2);
+  auto A_val = make_filled_data<3, 2>(0.7);
+  std::array<double, 9> x{};
+  x[0] = 2.0;
+  tensor_evaluator<double> ev;
+  ev.set(A, A_val);
+  ev.set_view(X, x.data());
+
+  auto a = ev.operand(A);
+  EXPECT_EQ(&*a, A_val.get());
+  EXPECT_FALSE(a.is_owned());
+
+  // A view is unpacked into the same working tensor on every read.
+  auto x1 = ev.operand(X);
+  x[0] = 5.0;
+  auto x2 = ev.operand(X);
+  EXPECT_EQ(&*x1, &*x2);
+  EXPECT_NEAR(x2->raw_data()[0], 5.0, tol);
+
+  EXPECT_TRUE(ev.operand(A + X).is_owned());
+  // apply() still hands out a tensor of its own.
+  auto copy = ev.apply(A);
+  EXPECT_NE(copy.get(), A_val.get());
+  EXPECT_NEAR(copy->raw_data()[4], A_val->raw_data()[4], tol);
+}
+
+TEST(TensorEval, ApplyIntoConvertsViewedSymbol) {
+  auto S = make_expression<tensor>("S", 3, 2);
+  const std::array<double, 6> s{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  tensor_evaluator<double> ev;
+  ev.set_view(S, s.data(), tensor_layout::voigt);
+
+  std::array<double, 9> full{};
+  ev.apply_into(S, full.data());
+  std::array<double, 9> unpacked{};
+  tensor_layout_unpack(unpacked.data(), s.data(), 3, 2, tensor_layout::voigt);
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_NEAR(full[i], unpacked[i], tol);
+
+  std::array<double, 6> mandel{};
+  ev.apply_into(S, mandel.data(), tensor_layout::mandel);
+  std::array<double, 6> expected{};
+  tensor_layout_pack(expected.data(), unpacked.data(), 3, 2,
+                     tensor_layout::mandel);
+  for (std::size_t k = 0; k < 6; ++k)
+    EXPECT_NEAR(mandel[k], expected[k], tol);
+
+  // voigt <-> mandel for a rank-4 matrix only rescales the shear rows and
+  // columns.
+  std::array<double, 36> C_voigt{};
+  for (std::size_t i = 0; i < 36; ++i)
+    C_voigt[i] = 0.1 * static_cast<double>(i + 1);
+  std::array<double, 36> C_mandel{};
+  tensor_layout_convert(C_mandel.data(), tensor_layout::mandel,
+                        C_voigt.data(), tensor_layout::voigt, 3, 4);
+  std::array<double, 81> C_full{};
+  tensor_layout_unpack(C_full.data(), C_voigt.data(), 3, 4,
+                       tensor_layout::voigt);
+  std::array<double, 36> C_expected{};
+  tensor_layout_pack(C_expected.data(), C_full.data(), 3, 4,
+                     tensor_layout::mandel);
+  for (std::size_t i = 0; i < 36; ++i)
+    EXPECT_NEAR(C_mandel[i], C_expected[i], 1e-12);
+}
+
 // --- Projector tests ---
 
 TEST(TensorEval, EvalSkew) {
@@ -1501,6 +1856,24 @@ TEST(TensorEval, EigenprojectionDerivativeWrtScalar) {
   }
 }
 
+// Both dispatch paths, including the scalar and tensor_to_scalar evaluators
+// the tensor evaluator runs below trace(A) * A.
+TEST(TensorEval, DispatchModesAgree) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto s = make_expression<scalar>("s");
+  auto const expr = trace(A) * A + s * (A * A) - dev(A);
+
+  tensor_evaluator<double> ev;
+  EXPECT_EQ(ev.dispatch_mode(), evaluator_dispatch::virtual_call);
+  ev.set(A, make_test_data<3, 2>({1, 2, 0, -1, 3, 4, 0.5, 0, 2}));
+  ev.set_scalar(s, 0.25);
+  auto const by_accept = ev.apply(expr);
+  ev.set_dispatch(evaluator_dispatch::type_tag);
+  auto const by_tag = ev.apply(expr);
+  for (std::size_t i = 0; i < 9; ++i)
+    EXPECT_EQ(by_tag->raw_data()[i], by_accept->raw_data()[i]);
+}
+
 } // namespace numsim::cas
 
 #endif // TENSOREVALUATORTEST_H
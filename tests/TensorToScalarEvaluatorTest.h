@@ -5,6 +5,8 @@
 #include <gtest/gtest.h>
 #include <memory>
 
+#include "cas_test_helpers.h"
+
 #include <numsim_cas/basic_functions.h>
 #include <numsim_cas/core/cas_error.h>
 #include <numsim_cas/eigen_decomposition.h>
@@ -480,6 +482,43 @@ TEST(T2sEval, SpectralCacheInterleavedTensors) {
   }
 }
 
+// 2^64 paths through 64 shared levels: only terminates if each shared node
+// is evaluated once, and the memo must not outlive one apply().
+TEST(T2sEval, SharedNodesEvaluatedOncePerApply) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto const e = testcas::shared_levels(
+      trace(A), 64, [](auto const &level) {
+        return log(level) + sqrt(level);
+      });
+  auto expected = [](double value) {
+    for (int i = 0; i < 64; ++i)
+      value = std::log(value) + std::sqrt(value);
+    return value;
+  };
+
+  tensor_to_scalar_evaluator<double> ev;
+  ev.set(A, make_test_data<3, 2>({2, 0, 0, 0, 3, 0, 0, 0, 4}));
+  EXPECT_NEAR(ev.apply(e), expected(9.0), t2s_tol);
+  ev.set(A, make_test_data<3, 2>({5, 0, 0, 0, 3, 0, 0, 0, 4}));
+  EXPECT_NEAR(ev.apply(e), expected(12.0), t2s_tol);
+}
+
+TEST(T2sEval, DispatchModesAgree) {
+  auto A = make_expression<tensor>("A", 3, 2);
+  auto [mu, lambda] = make_scalar_variable("mu", "lambda");
+  auto const psi = lambda / 2 * pow(trace(A), 2) + mu * dot(dev(A)) +
+                   log(det(A)) + sqrt(norm(A));
+
+  tensor_to_scalar_evaluator<double> ev;
+  EXPECT_EQ(ev.dispatch_mode(), evaluator_dispatch::virtual_call);
+  ev.set(A, make_test_data<3, 2>({2, 0.1, 0, 0.1, 3, 0.2, 0, 0.2, 4}));
+  ev.set_scalar(mu, 1.5);
+  ev.set_scalar(lambda, 0.5);
+  auto const by_accept = ev.apply(psi);
+  ev.set_dispatch(evaluator_dispatch::type_tag);
+  EXPECT_EQ(ev.apply(psi), by_accept);
+}
+
 } // namespace numsim::cas
 
 #endif // TENSORTOSCALAREVALUATORTEST_H
@@ -8,6 +8,7 @@
 #include "gtest/gtest.h"
 
 #include <numsim_cas/core/substitute.h>
+#include <numsim_cas/core/substitution_map.h>
 #include <numsim_cas/tensor_to_scalar/visitors/tensor_to_scalar_substitution.h>
 
 namespace {
@@ -101,4 +102,85 @@ TYPED_TEST(TensorToScalarSubstitutionTest, EigenvalueTensorSub) {
       << "Expected " << testcas::S(expected) << ", got: " << testcas::S(result);
 }
 
+// ─── Batch substitution (core/substitution_map.h) ─────────────────
+
+// Several scalar parameters in one call agree with one call per parameter.
+TYPED_TEST(TensorToScalarSubstitutionTest, BatchMatchesSequential) {
+  using namespace numsim::cas;
+  auto &x = this->x;
+  auto &y = this->y;
+  auto [E, nu] = make_scalar_variable("E", "nu");
+
+  auto expr = E * x + nu * pow(y, 2) + E * nu;
+  auto const cE = make_scalar_constant(210);
+  auto const cnu = make_scalar_constant(3);
+  auto result = substitute(expr, {{E, cE}, {nu, cnu}});
+  auto expected = substitute(substitute(expr, E, cE), nu, cnu);
+  EXPECT_TRUE(result == expected)
+      << "Expected " << testcas::S(expected) << ", got: " << testcas::S(result);
+}
+
+// The pairs are applied simultaneously, so a swap does not collapse.
+TYPED_TEST(TensorToScalarSubstitutionTest, BatchIsSimultaneous) {
+  using namespace numsim::cas;
+  auto &x = this->x;
+  auto &y = this->y;
+
+  auto result = substitute(x + 2 * y, {{x, y}, {y, x}});
+  auto expected = y + 2 * x;
+  EXPECT_TRUE(result == expected)
+      << "Expected " << testcas::S(expected) << ", got: " << testcas::S(result);
+}
+
+// Untouched subtrees come back as the very same node.
+TYPED_TEST(TensorToScalarSubstitutionTest, BatchKeepsUntouchedNodes) {
+  using namespace numsim::cas;
+  auto &X = this->X;
+  auto &x = this->x;
+  auto &z = this->z;
+
+  auto expr = trace(X) * sin(z);
+  auto result = substitute(expr, {{x, z}});
+  EXPECT_EQ(result.data(), expr.data());
+
+  auto sum = sin(z) + x;
+  auto replaced = substitute(sum, {{x, z}});
+  ASSERT_TRUE(is_same<scalar_add>(replaced));
+  bool shared = false;
+  for (auto const &child : replaced.template get<scalar_add>().symbol_map())
+    for (auto const &orig : sum.template get<scalar_add>().symbol_map())
+      shared = shared || child.data() == orig.data();
+  EXPECT_TRUE(shared);
+}
+
+// One map mixing scalar, tensor and t2s targets, applied to a t2s tree
+// whose tensor and scalar children are reached through the other domains.
+TYPED_TEST(TensorToScalarSubstitutionTest, BatchAcrossDomains) {
+  using namespace numsim::cas;
+  auto &X = this->X;
+  auto &Y = this->Y;
+  auto &Z = this->Z;
+  auto &x = this->x;
+  auto &y = this->y;
+
+  substitution_map subs;
+  subs.add(X, Z).add(x, y).add(norm(Y), det(Y));
+  EXPECT_EQ(subs.size(), 3u);
+
+  auto expr = trace(X * x) + norm(Y);
+  auto result = substitute(expr, subs);
+  auto expected = trace(Z * y) + det(Y);
+  EXPECT_TRUE(result == expected)
+      << "Expected " << testcas::S(expected) << ", got: " << testcas::S(result);
+
+  auto tensor_result = substitute(X * trace(Y) + Y, subs);
+  auto tensor_expected = Z * trace(Y) + Y;
+  EXPECT_TRUE(tensor_result == tensor_expected)
+      << "Expected " << testcas::S(tensor_expected)
+      << ", got: " << testcas::S(tensor_result);
+
+  EXPECT_THROW(subs.add(x, expression_holder<scalar_expression>{}),
+               invalid_expression_error);
+}
+
 #endif // TENSORTOSCALARSUBSTITUTIONTEST_H
@@ -34,6 +34,16 @@ template <class E> inline std::string S(const E &e) {
   EXPECT_EQ(::testcas::S((lhs)), ::testcas::S((rhs)))
 #endif
 
+// `levels` applications of `step`, starting from `e`. A step that uses its
+// argument twice gives a DAG with a few nodes per level but 2^levels paths
+// through the tree, so only visitors that handle each node once finish.
+template <class E, class Step>
+inline E shared_levels(E e, int levels, Step step) {
+  for (int i = 0; i < levels; ++i)
+    e = step(e);
+  return e;
+}
+
 } // namespace testcas
 
 #endif // CAS_TEST_HELPERS_H
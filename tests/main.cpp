@@ -1,18 +1,32 @@
 #include "CoreBugFixTest.h"
+#include "DagPrinterTest.h"
+#include "EvaluatorPrecisionTest.h"
+#include "FlatSetTest.h"
+#include "FreeSymbolsTest.h"
+#include "HashTest.h"
+#include "IntervalTest.h"
 #include "IsotropicTensorFunctionTest.h"
+#include "KernelCacheTest.h"
 #include "LeviCivitaTest.h"
 #include "LimitVisitorTest.h"
+#include "NodeHeaderTest.h"
 #include "NumericalDiffTest.h"
 #include "ParserTest.h"
+#include "ProfilingTest.h"
 #include "ScalarAssumptionTest.h"
 #include "ScalarComparisonTest.h"
 #include "ScalarDifferentiationTest.h"
 #include "ScalarEvaluatorTest.h"
+#include "ScalarExpandTest.h"
 #include "ScalarExpressionTest.h"
+#include "ScalarJitTest.h"
+#include "ScalarKernelCacheTest.h"
 #include "ScalarLatexPrinterTest.h"
 #include "ScalarPrinterTest.h"
 #include "ScalarSubstitutionTest.h"
+#include "SerializationTest.h"
 #include "SolveTest.h"
+#include "SparsePolynomialTest.h"
 #include "TensorAlgebraAssumeTest.h"
 #include "TensorAnnotationMatrixTest.h"
 #include "TensorDifferentiationTest.h"